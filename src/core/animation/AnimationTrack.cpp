@@ -0,0 +1,10 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file AnimationTrack.cpp
+ * @brief All implementation contains in header file AnimationTrack.h
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include "core/animation/AnimationTrack.h"
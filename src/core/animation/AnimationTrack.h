@@ -0,0 +1,505 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file AnimationTrack.h
+ * @brief Keyframe tracks of Vector3 or Quaternion values with reduction and quantized storage
+ *
+ * A track is built once from sorted keyframes. Keys which the chosen interpolation reproduces
+ * within a tolerance from their remaining neighbors are removed greedily; every removal is checked
+ * against all original keys whose interpolation it changes, so the bound holds for the whole
+ * track. The remaining keys are quantized to 16 bits: times as ticks between the first and the
+ * last key, vectors per component within the bounds of the track and rotations with the smallest
+ * three encoding, which drops the largest component and stores the other three in 15 bits each.
+ * A key then takes 8 bytes whatever its type.
+ *
+ * Cubic interpolation is a Hermite spline with finite difference tangents over neighboring keys,
+ * rotations are interpolated on sign aligned components and renormalized. Sampling with a
+ * TrackCursor remembers the key of the previous sample and walks forward from it, so playing a
+ * track costs no binary search and reads keys sequentially.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/math/Quaternion.h"
+#include "core/math/Vector3.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace Engine::Core::Animation
+{
+
+using Math::Quaternion;
+using Math::Vector3;
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+struct AnimationTrackSettings
+{
+  /// Largest value of a quantized time or vector component
+  static constexpr u32 maxQuantized = 65535;
+  /// Largest magnitude of a smallest three component
+  static constexpr u32 maxRotationQuantized = 32767;
+};
+
+enum class Interpolation : u8
+{
+  Constant,
+  Linear,
+  Cubic
+};
+
+template <typename Value>
+struct Keyframe
+{
+  decltype(Value::x) time;
+  Value value;
+};
+
+/// Key of the previous sample, one per track and playing instance
+struct TrackCursor
+{
+  u32 key = 0;
+};
+
+/// Value is Vector3<T> (translation, scale) or Quaternion<T> (rotation)
+template <typename Value>
+class AnimationTrack
+{
+ public:
+  using Scalar = decltype(Value::x);
+
+  AnimationTrack() noexcept = default;
+
+  /**
+   * @brief Reduces and quantizes keys, previous content is dropped
+   * @param keys sorted by time
+   * @param tolerance largest error of the kept keys at any original key, the distance for
+   * vectors and the angle in radians for rotations, quantization adds up to half a step
+   */
+  void Build(
+      const Keyframe<Value>* keys,
+      std::size_t count,
+      Interpolation interpolation,
+      Scalar tolerance = Scalar(0)
+  ) noexcept;
+  void Clear() noexcept;
+
+  std::size_t KeyCount() const noexcept;
+  Interpolation GetInterpolation() const noexcept;
+  Scalar StartTime() const noexcept;
+  Scalar EndTime() const noexcept;
+  /// Bytes of quantized key storage
+  std::size_t MemorySize() const noexcept;
+  /// Time of a kept key after quantization
+  Scalar KeyTime(u32 key) const noexcept;
+
+  /// Value at time clamped to [StartTime(), EndTime()]
+  Value Sample(Scalar time) const noexcept;
+  /// Same as Sample, searches from the key of the previous sample taken with cursor
+  Value Sample(Scalar time, TrackCursor& cursor) const noexcept;
+
+ private:
+  /// Nearest time tick, keys are located in ticks so sampling at a key time finds that key
+  u16 TimeTick(Scalar time) const noexcept;
+  /// Last key at or before tick
+  u32 FindKey(u16 tick) const noexcept;
+  Value Decode(u32 key) const noexcept;
+  Value Interpolate(u32 key, Scalar time) const noexcept;
+
+  Interpolation interpolation = Interpolation::Linear;
+  Scalar startTime = Scalar(0);
+  /// Seconds per time tick
+  Scalar timeStep = Scalar(0);
+  /// Vector components are minimum + quantized * step
+  Vector3<Scalar> minimum;
+  Vector3<Scalar> step;
+  std::vector<u16> times;
+  /// Three quantized components per key
+  std::vector<u16> values;
+};
+
+/* ------------------------------------------- Usings ------------------------------------------ */
+using VectorTrackf = AnimationTrack<Vector3<f32>>;
+using VectorTrackd = AnimationTrack<Vector3<f64>>;
+using RotationTrackf = AnimationTrack<Quaternion<f32>>;
+using RotationTrackd = AnimationTrack<Quaternion<f64>>;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+namespace Internal
+{
+
+template <typename T>
+T Error(const Vector3<T>& a, const Vector3<T>& b) noexcept
+{
+  return a.DistanceTo(b);
+}
+
+/// Angle of the rotation between a and b
+template <typename T>
+T Error(const Quaternion<T>& a, const Quaternion<T>& b) noexcept
+{
+  // the chord between unit quaternions is 2 sin(angle / 4), exact for small angles unlike acos
+  Quaternion<T> p = a.Normalized();
+  Quaternion<T> q = b.Normalized();
+  if (p.Dot(q) < T(0))
+    q = -q;
+  return T(4) * std::asin(std::min((p - q).Length() * T(0.5), T(1)));
+}
+
+template <typename T>
+void Align(Vector3<T>&, const Vector3<T>&) noexcept
+{
+}
+
+/// Moves q to the hemisphere of reference so component interpolation takes the shorter arc
+template <typename T>
+void Align(Quaternion<T>& q, const Quaternion<T>& reference) noexcept
+{
+  if (q.Dot(reference) < T(0))
+    q = -q;
+}
+
+template <typename T>
+Vector3<T> Finish(const Vector3<T>& v) noexcept
+{
+  return v;
+}
+
+template <typename T>
+Quaternion<T> Finish(const Quaternion<T>& q) noexcept
+{
+  return q.Normalized();
+}
+
+/**
+ * @brief Interpolates between keys 1 and 2 of four consecutive keys, the outer keys are only
+ * used for cubic tangents and repeat keys 1 and 2 at the ends of a track
+ */
+template <typename Value, typename T>
+Value InterpolateKeys(
+    Interpolation interpolation,
+    const T (&times)[4],
+    Value (&values)[4],
+    T time
+) noexcept
+{
+  if (interpolation == Interpolation::Constant || !(times[2] > times[1]))
+    return values[1];
+  for (u32 i : {0u, 2u, 3u})
+    Align(values[i], values[1]);
+  T h = times[2] - times[1];
+  T u = std::clamp((time - times[1]) / h, T(0), T(1));
+  if (interpolation == Interpolation::Linear)
+    return Finish(values[1] * (T(1) - u) + values[2] * u);
+
+  // Hermite basis with tangents scaled to the key interval
+  auto tangent = [&](u32 before, u32 after) {
+    T span = times[after] - times[before];
+    return span > T(0) ? (values[after] - values[before]) * (h / span) : values[1] * T(0);
+  };
+  T u2 = u * u;
+  T u3 = u2 * u;
+  return Finish(values[1] * (T(2) * u3 - T(3) * u2 + T(1)) +
+                tangent(0, 2) * (u3 - T(2) * u2 + u) + values[2] * (T(3) * u2 - T(2) * u3) +
+                tangent(1, 3) * (u3 - u2));
+}
+
+template <typename T>
+u16 Quantize(T value, T minimum, T step) noexcept
+{
+  if (!(step > T(0)))
+    return 0;
+  T scaled = std::round((value - minimum) / step);
+  return static_cast<u16>(std::clamp(scaled, T(0), T(AnimationTrackSettings::maxQuantized)));
+}
+
+template <typename T>
+void Encode(
+    const Vector3<T>& v,
+    const Vector3<T>& minimum,
+    const Vector3<T>& step,
+    u16* out
+) noexcept
+{
+  out[0] = Quantize(v.x, minimum.x, step.x);
+  out[1] = Quantize(v.y, minimum.y, step.y);
+  out[2] = Quantize(v.z, minimum.z, step.z);
+}
+
+/// Smallest three, the index of the dropped component is kept in the top bits of out[0, 1]
+template <typename T>
+void Encode(const Quaternion<T>& rotation, const Vector3<T>&, const Vector3<T>&, u16* out) noexcept
+{
+  Quaternion<T> q = rotation.Normalized();
+  T components[4] = {q.x, q.y, q.z, q.w};
+  u32 largest = 0;
+  for (u32 i = 1; i < 4; ++i) {
+    if (std::abs(components[i]) > std::abs(components[largest]))
+      largest = i;
+  }
+  T sign = components[largest] < T(0) ? T(-1) : T(1);
+
+  // the other components lie in [-1 / sqrt(2), 1 / sqrt(2)]
+  constexpr T range = T(0.707106781186548);
+  constexpr T scale = T(AnimationTrackSettings::maxRotationQuantized) / (range * T(2));
+  for (u32 i = 0, slot = 0; i < 4; ++i) {
+    if (i == largest)
+      continue;
+    T scaled = std::round((components[i] * sign + range) * scale);
+    out[slot++] = static_cast<u16>(
+        std::clamp(scaled, T(0), T(AnimationTrackSettings::maxRotationQuantized)));
+  }
+  out[0] = static_cast<u16>(out[0] | ((largest & 1u) << 15));
+  out[1] = static_cast<u16>(out[1] | ((largest >> 1) << 15));
+}
+
+template <typename T>
+void Decode(
+    const u16* in,
+    const Vector3<T>& minimum,
+    const Vector3<T>& step,
+    Vector3<T>& out
+) noexcept
+{
+  out = Vector3<T>(minimum.x + static_cast<T>(in[0]) * step.x,
+                   minimum.y + static_cast<T>(in[1]) * step.y,
+                   minimum.z + static_cast<T>(in[2]) * step.z);
+}
+
+template <typename T>
+void Decode(const u16* in, const Vector3<T>&, const Vector3<T>&, Quaternion<T>& out) noexcept
+{
+  constexpr T range = T(0.707106781186548);
+  constexpr T scale = (range * T(2)) / T(AnimationTrackSettings::maxRotationQuantized);
+  u32 largest = (in[0] >> 15) | ((in[1] >> 15) << 1);
+  T components[4];
+  T sum = T(0);
+  for (u32 i = 0, slot = 0; i < 4; ++i) {
+    if (i == largest)
+      continue;
+    components[i] = static_cast<T>(in[slot++] & 0x7fffu) * scale - range;
+    sum += components[i] * components[i];
+  }
+  components[largest] = std::sqrt(std::max(T(1) - sum, T(0)));
+  out = Quaternion<T>(components[0], components[1], components[2], components[3]);
+}
+
+template <typename T>
+void Bounds(
+    const Keyframe<Vector3<T>>* keys,
+    const std::vector<u32>& kept,
+    Vector3<T>& minimum,
+    Vector3<T>& step
+) noexcept
+{
+  Vector3<T> low = keys[kept[0]].value;
+  Vector3<T> high = low;
+  for (u32 key : kept) {
+    const Vector3<T>& v = keys[key].value;
+    low = Vector3<T>(std::min(low.x, v.x), std::min(low.y, v.y), std::min(low.z, v.z));
+    high = Vector3<T>(std::max(high.x, v.x), std::max(high.y, v.y), std::max(high.z, v.z));
+  }
+  minimum = low;
+  step = (high - low) / T(AnimationTrackSettings::maxQuantized);
+}
+
+template <typename T>
+void Bounds(
+    const Keyframe<Quaternion<T>>*,
+    const std::vector<u32>&,
+    Vector3<T>& minimum,
+    Vector3<T>& step
+) noexcept
+{
+  minimum = Vector3<T>::Zero();
+  step = Vector3<T>::Zero();
+}
+
+} // namespace Internal
+
+template <typename Value>
+void AnimationTrack<Value>::Build(
+    const Keyframe<Value>* keys,
+    std::size_t count,
+    Interpolation mode,
+    Scalar tolerance
+) noexcept
+{
+  Clear();
+  interpolation = mode;
+  if (count == 0)
+    return;
+
+  // doubly linked list of kept keys, removal is undone when an original key moves too far
+  std::vector<u32> previous(count);
+  std::vector<u32> next(count);
+  for (u32 i = 0; i < count; ++i) {
+    previous[i] = i == 0 ? 0 : i - 1;
+    next[i] = i + 1 == count ? i : i + 1;
+  }
+  auto sampleKept = [&](u32 key, Scalar time) {
+    u32 k0 = previous[key];
+    u32 k2 = next[key];
+    u32 k3 = next[k2];
+    Scalar keyTimes[4] = {keys[k0].time, keys[key].time, keys[k2].time, keys[k3].time};
+    Value keyValues[4] = {keys[k0].value, keys[key].value, keys[k2].value, keys[k3].value};
+    return Internal::InterpolateKeys(interpolation, keyTimes, keyValues, time);
+  };
+
+  for (u32 i = 1; i + 1 < count; ++i) {
+    u32 before = previous[i];
+    u32 after = next[i];
+    next[before] = after;
+    previous[after] = before;
+
+    // cubic tangents of the neighbors depend on the removed key as well
+    u32 first = interpolation == Interpolation::Cubic ? previous[before] : before;
+    u32 last = interpolation == Interpolation::Cubic ? next[after] : after;
+    bool fits = true;
+    for (u32 j = first, key = first; j <= last && fits; ++j) {
+      while (next[key] != key && next[key] <= j)
+        key = next[key];
+      fits = Internal::Error(sampleKept(key, keys[j].time), keys[j].value) <= tolerance;
+    }
+    if (!fits) {
+      next[before] = i;
+      previous[after] = i;
+    }
+  }
+
+  std::vector<u32> kept;
+  for (u32 key = 0;; key = next[key]) {
+    kept.push_back(key);
+    if (next[key] == key)
+      break;
+  }
+
+  startTime = keys[0].time;
+  Scalar duration = keys[count - 1].time - startTime;
+  timeStep = duration / Scalar(AnimationTrackSettings::maxQuantized);
+  Internal::Bounds(keys, kept, minimum, step);
+  times.resize(kept.size());
+  values.resize(kept.size() * 3);
+  for (std::size_t i = 0; i < kept.size(); ++i) {
+    times[i] = Internal::Quantize(keys[kept[i]].time, startTime, timeStep);
+    Internal::Encode(keys[kept[i]].value, minimum, step, &values[i * 3]);
+  }
+}
+
+template <typename Value>
+void AnimationTrack<Value>::Clear() noexcept
+{
+  startTime = Scalar(0);
+  timeStep = Scalar(0);
+  times.clear();
+  values.clear();
+}
+
+template <typename Value>
+std::size_t AnimationTrack<Value>::KeyCount() const noexcept
+{
+  return times.size();
+}
+
+template <typename Value>
+Interpolation AnimationTrack<Value>::GetInterpolation() const noexcept
+{
+  return interpolation;
+}
+
+template <typename Value>
+typename AnimationTrack<Value>::Scalar AnimationTrack<Value>::StartTime() const noexcept
+{
+  return startTime;
+}
+
+template <typename Value>
+typename AnimationTrack<Value>::Scalar AnimationTrack<Value>::EndTime() const noexcept
+{
+  return times.empty() ? startTime : KeyTime(static_cast<u32>(times.size() - 1));
+}
+
+template <typename Value>
+std::size_t AnimationTrack<Value>::MemorySize() const noexcept
+{
+  return (times.size() + values.size()) * sizeof(u16);
+}
+
+template <typename Value>
+typename AnimationTrack<Value>::Scalar AnimationTrack<Value>::KeyTime(u32 key) const noexcept
+{
+  return startTime + static_cast<Scalar>(times[key]) * timeStep;
+}
+
+template <typename Value>
+Value AnimationTrack<Value>::Sample(Scalar time) const noexcept
+{
+  assert(!times.empty() && "Sampling an empty track");
+  if (times.empty())
+    return Value();
+  return Interpolate(FindKey(TimeTick(time)), time);
+}
+
+template <typename Value>
+Value AnimationTrack<Value>::Sample(Scalar time, TrackCursor& cursor) const noexcept
+{
+  assert(!times.empty() && "Sampling an empty track");
+  if (times.empty())
+    return Value();
+
+  u16 tick = TimeTick(time);
+  u32 last = static_cast<u32>(times.size() - 1);
+  u32 key = std::min(cursor.key, last);
+  if (tick < times[key]) {
+    key = FindKey(tick);
+  } else {
+    while (key < last && times[key + 1] <= tick)
+      ++key;
+  }
+  cursor.key = key;
+  return Interpolate(key, time);
+}
+
+template <typename Value>
+u16 AnimationTrack<Value>::TimeTick(Scalar time) const noexcept
+{
+  return Internal::Quantize(time, startTime, timeStep);
+}
+
+template <typename Value>
+u32 AnimationTrack<Value>::FindKey(u16 tick) const noexcept
+{
+  u32 key = static_cast<u32>(std::upper_bound(times.begin(), times.end(), tick) - times.begin());
+  return key == 0 ? 0 : key - 1;
+}
+
+template <typename Value>
+Value AnimationTrack<Value>::Decode(u32 key) const noexcept
+{
+  Value value;
+  Internal::Decode(&values[key * 3], minimum, step, value);
+  return value;
+}
+
+template <typename Value>
+Value AnimationTrack<Value>::Interpolate(u32 key, Scalar time) const noexcept
+{
+  u32 last = static_cast<u32>(times.size() - 1);
+  if (interpolation == Interpolation::Constant || key == last)
+    return Decode(key);
+
+  u32 k0 = key == 0 ? 0 : key - 1;
+  u32 k2 = key + 1;
+  u32 k3 = std::min(key + 2, last);
+  Scalar keyTimes[4] = {KeyTime(k0), KeyTime(key), KeyTime(k2), KeyTime(k3)};
+  Value keyValues[4] = {Decode(k0), Decode(key), Decode(k2), Decode(k3)};
+  return Internal::InterpolateKeys(interpolation, keyTimes, keyValues, time);
+}
+
+} // namespace Engine::Core::Animation
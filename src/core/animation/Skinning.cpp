@@ -0,0 +1,516 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Skinning.cpp
+ * @brief Implementation of skinning kernels
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include "core/animation/Skinning.h"
+
+#include "core/math/SimdFloat.h"
+
+#include <algorithm>
+#include <cassert>
+#include <type_traits>
+
+namespace Engine::Core::Animation
+{
+
+namespace
+{
+
+using Math::ForEachLane;
+using Math::laneWidth;
+using Math::Load;
+using Math::MulAdd;
+using Math::Select;
+using Math::Store;
+using Math::Vector3Arrayf;
+
+constexpr u32 stride = SkinPose::stride;
+
+/// Loads the bone records of the lane vertices transposed, out[c] holds component c of all lanes
+template <typename V>
+void Gather(const f32* records, const u16* bones, V (&out)[stride]) noexcept
+{
+  if constexpr (std::is_same_v<V, f32>) {
+    const f32* record = records + std::size_t(*bones) * stride;
+    for (u32 c = 0; c < stride; ++c)
+      out[c] = record[c];
+  } else {
+    alignas(32) f32 lanes[stride][V::width];
+    for (u32 lane = 0; lane < V::width; ++lane) {
+      const f32* record = records + std::size_t(bones[lane]) * stride;
+      for (u32 c = 0; c < stride; ++c)
+        lanes[c][lane] = record[c];
+    }
+    for (u32 c = 0; c < stride; ++c)
+      out[c] = V::Load(lanes[c]);
+  }
+}
+
+bool AnyWeight(const f32* weights, u32 width) noexcept
+{
+  for (u32 lane = 0; lane < width; ++lane) {
+    if (weights[lane] != 0.0f)
+      return true;
+  }
+  return false;
+}
+
+template <typename V>
+void Normalize(V& x, V& y, V& z) noexcept
+{
+  V lengthSquared = MulAdd(x, x, MulAdd(y, y, z * z));
+  V inverse = V(1.0f) / Math::Sqrt(Math::Max(lengthSquared, V(1e-30f)));
+  x = x * inverse;
+  y = y * inverse;
+  z = z * inverse;
+}
+
+/// Vertex arrays of one Skin call, normal pointers are null when normals are not skinned
+struct Streams
+{
+  const f32* px;
+  const f32* py;
+  const f32* pz;
+  const f32* nx = nullptr;
+  const f32* ny = nullptr;
+  const f32* nz = nullptr;
+  f32* outPx;
+  f32* outPy;
+  f32* outPz;
+  f32* outNx = nullptr;
+  f32* outNy = nullptr;
+  f32* outNz = nullptr;
+};
+
+template <typename V>
+void SkinLinear(
+    const SkinPose& pose,
+    const SkinWeights& weights,
+    const Streams& streams,
+    std::size_t i
+) noexcept
+{
+  V m[stride];
+  for (V& component : m)
+    component = V(0.0f);
+  V record[stride];
+  for (u32 slot = 0; slot < weights.SlotCount(); ++slot) {
+    const f32* slotWeights = weights.Weights(slot) + i;
+    if (!AnyWeight(slotWeights, laneWidth<V>))
+      continue;
+    Gather(pose.Matrices(), weights.Bones(slot) + i, record);
+    V weight = Load<V>(slotWeights);
+    for (u32 c = 0; c < stride; ++c)
+      m[c] = MulAdd(weight, record[c], m[c]);
+  }
+
+  V x = Load<V>(streams.px + i);
+  V y = Load<V>(streams.py + i);
+  V z = Load<V>(streams.pz + i);
+  Store(MulAdd(m[0], x, MulAdd(m[1], y, MulAdd(m[2], z, m[3]))), streams.outPx + i);
+  Store(MulAdd(m[4], x, MulAdd(m[5], y, MulAdd(m[6], z, m[7]))), streams.outPy + i);
+  Store(MulAdd(m[8], x, MulAdd(m[9], y, MulAdd(m[10], z, m[11]))), streams.outPz + i);
+  if (!streams.nx)
+    return;
+
+  x = Load<V>(streams.nx + i);
+  y = Load<V>(streams.ny + i);
+  z = Load<V>(streams.nz + i);
+  V nx = MulAdd(m[0], x, MulAdd(m[1], y, m[2] * z));
+  V ny = MulAdd(m[4], x, MulAdd(m[5], y, m[6] * z));
+  V nz = MulAdd(m[8], x, MulAdd(m[9], y, m[10] * z));
+  Normalize(nx, ny, nz);
+  Store(nx, streams.outNx + i);
+  Store(ny, streams.outNy + i);
+  Store(nz, streams.outNz + i);
+}
+
+/// Rotates v by the unit quaternion (q, w): v + 2 q x (q x v + w v)
+template <typename V>
+void Rotate(const V (&q)[4], V& x, V& y, V& z) noexcept
+{
+  V cx = MulAdd(q[3], x, q[1] * z - q[2] * y);
+  V cy = MulAdd(q[3], y, q[2] * x - q[0] * z);
+  V cz = MulAdd(q[3], z, q[0] * y - q[1] * x);
+  V two(2.0f);
+  x = MulAdd(two, q[1] * cz - q[2] * cy, x);
+  y = MulAdd(two, q[2] * cx - q[0] * cz, y);
+  z = MulAdd(two, q[0] * cy - q[1] * cx, z);
+}
+
+template <typename V>
+void SkinDualQuaternion(
+    const SkinPose& pose,
+    const SkinWeights& weights,
+    const Streams& streams,
+    std::size_t i
+) noexcept
+{
+  V real[4];
+  V dual[4];
+  V scale[3];
+  V pivot[4];
+  for (u32 c = 0; c < 4; ++c) {
+    real[c] = V(0.0f);
+    dual[c] = V(0.0f);
+  }
+  for (V& component : scale)
+    component = V(0.0f);
+  V record[stride];
+  bool first = true;
+  for (u32 slot = 0; slot < weights.SlotCount(); ++slot) {
+    const f32* slotWeights = weights.Weights(slot) + i;
+    if (!AnyWeight(slotWeights, laneWidth<V>))
+      continue;
+    Gather(pose.DualQuaternions(), weights.Bones(slot) + i, record);
+    V weight = Load<V>(slotWeights);
+    if (first) {
+      for (u32 c = 0; c < 4; ++c)
+        pivot[c] = record[c];
+      first = false;
+    }
+    for (u32 c = 0; c < 3; ++c)
+      scale[c] = MulAdd(weight, record[8 + c], scale[c]);
+
+    // q and -q are the same rotation, blend the one in the hemisphere of the first bone
+    V dot = MulAdd(pivot[0], record[0], MulAdd(pivot[1], record[1], pivot[2] * record[2]));
+    dot = MulAdd(pivot[3], record[3], dot);
+    weight = Select(dot < V(0.0f), -weight, weight);
+    for (u32 c = 0; c < 4; ++c) {
+      real[c] = MulAdd(weight, record[c], real[c]);
+      dual[c] = MulAdd(weight, record[4 + c], dual[c]);
+    }
+  }
+
+  V lengthSquared = MulAdd(real[0], real[0], MulAdd(real[1], real[1], real[2] * real[2]));
+  lengthSquared = MulAdd(real[3], real[3], lengthSquared);
+  V inverse = V(1.0f) / Math::Sqrt(Math::Max(lengthSquared, V(1e-30f)));
+  for (u32 c = 0; c < 4; ++c) {
+    real[c] = real[c] * inverse;
+    dual[c] = dual[c] * inverse;
+  }
+  // translation 2 (w_r d - w_d r + r x d) of the normalized dual quaternion
+  V two(2.0f);
+  V tx = two * (real[3] * dual[0] - dual[3] * real[0] + real[1] * dual[2] - real[2] * dual[1]);
+  V ty = two * (real[3] * dual[1] - dual[3] * real[1] + real[2] * dual[0] - real[0] * dual[2]);
+  V tz = two * (real[3] * dual[2] - dual[3] * real[2] + real[0] * dual[1] - real[1] * dual[0]);
+
+  V x = Load<V>(streams.px + i) * scale[0];
+  V y = Load<V>(streams.py + i) * scale[1];
+  V z = Load<V>(streams.pz + i) * scale[2];
+  Rotate(real, x, y, z);
+  Store(x + tx, streams.outPx + i);
+  Store(y + ty, streams.outPy + i);
+  Store(z + tz, streams.outPz + i);
+  if (!streams.nx)
+    return;
+
+  // normals scale by the inverse scale, here by the cofactors which only differ in length
+  x = Load<V>(streams.nx + i) * scale[1] * scale[2];
+  y = Load<V>(streams.ny + i) * scale[0] * scale[2];
+  z = Load<V>(streams.nz + i) * scale[0] * scale[1];
+  Rotate(real, x, y, z);
+  Normalize(x, y, z);
+  Store(x, streams.outNx + i);
+  Store(y, streams.outNy + i);
+  Store(z, streams.outNz + i);
+}
+
+void SkinRange(
+    SkinningMethod method,
+    const SkinPose& pose,
+    const SkinWeights& weights,
+    const Streams& streams,
+    std::size_t begin,
+    std::size_t end
+) noexcept
+{
+  if (method == SkinningMethod::LinearBlend) {
+    ForEachLane(begin, end, [&](auto lanes, std::size_t i) {
+      SkinLinear<decltype(lanes)>(pose, weights, streams, i);
+    });
+  } else {
+    ForEachLane(begin, end, [&](auto lanes, std::size_t i) {
+      SkinDualQuaternion<decltype(lanes)>(pose, weights, streams, i);
+    });
+  }
+}
+
+/// Sizes the outputs, copies the input to them and returns false when the skin does not match
+bool Prepare(
+    const SkinPose& pose,
+    const SkinWeights& weights,
+    const Vector3Arrayf& positions,
+    Vector3Arrayf& outPositions
+) noexcept
+{
+  bool valid =
+      weights.VertexCount() == positions.Size() && weights.BoneCount() <= pose.BoneCount();
+  assert(valid && "Skin weights do not match the vertices or the pose");
+  if (!valid) {
+    if (&outPositions != &positions)
+      outPositions = positions;
+    return false;
+  }
+  outPositions.Resize(positions.Size());
+  return true;
+}
+
+Streams MakeStreams(const Vector3Arrayf& positions, Vector3Arrayf& outPositions) noexcept
+{
+  Streams streams;
+  streams.px = positions.x.data();
+  streams.py = positions.y.data();
+  streams.pz = positions.z.data();
+  streams.outPx = outPositions.x.data();
+  streams.outPy = outPositions.y.data();
+  streams.outPz = outPositions.z.data();
+  return streams;
+}
+
+void AddNormals(
+    const Vector3Arrayf& normals,
+    Vector3Arrayf& outNormals,
+    Streams& streams
+) noexcept
+{
+  streams.nx = normals.x.data();
+  streams.ny = normals.y.data();
+  streams.nz = normals.z.data();
+  streams.outNx = outNormals.x.data();
+  streams.outNy = outNormals.y.data();
+  streams.outNz = outNormals.z.data();
+}
+
+} // namespace
+
+void SkinPose::Set(const Math::Transformf* bones, std::size_t count) noexcept
+{
+  matrices.resize(count * stride);
+  dualQuaternions.resize(count * stride);
+  for (std::size_t bone = 0; bone < count; ++bone) {
+    const Math::Vector3f& t = bones[bone].position;
+    const Math::Vector3f& s = bones[bone].scale;
+    Math::Quaternionf q = bones[bone].rotation.Normalized();
+
+    f32* m = matrices.data() + bone * stride;
+    m[0] = (1.0f - 2.0f * (q.y * q.y + q.z * q.z)) * s.x;
+    m[1] = 2.0f * (q.x * q.y - q.z * q.w) * s.y;
+    m[2] = 2.0f * (q.x * q.z + q.y * q.w) * s.z;
+    m[3] = t.x;
+    m[4] = 2.0f * (q.x * q.y + q.z * q.w) * s.x;
+    m[5] = (1.0f - 2.0f * (q.x * q.x + q.z * q.z)) * s.y;
+    m[6] = 2.0f * (q.y * q.z - q.x * q.w) * s.z;
+    m[7] = t.y;
+    m[8] = 2.0f * (q.x * q.z - q.y * q.w) * s.x;
+    m[9] = 2.0f * (q.y * q.z + q.x * q.w) * s.y;
+    m[10] = (1.0f - 2.0f * (q.x * q.x + q.y * q.y)) * s.z;
+    m[11] = t.z;
+
+    // dual part t q / 2 with t as a pure quaternion
+    Math::Quaternionf d = Math::Quaternionf(t, 0.0f) * q * 0.5f;
+    f32* record = dualQuaternions.data() + bone * stride;
+    record[0] = q.x;
+    record[1] = q.y;
+    record[2] = q.z;
+    record[3] = q.w;
+    record[4] = d.x;
+    record[5] = d.y;
+    record[6] = d.z;
+    record[7] = d.w;
+    record[8] = s.x;
+    record[9] = s.y;
+    record[10] = s.z;
+    record[11] = 0.0f;
+  }
+}
+
+void SkinPose::Clear() noexcept
+{
+  matrices.clear();
+  dualQuaternions.clear();
+}
+
+std::size_t SkinPose::BoneCount() const noexcept
+{
+  return matrices.size() / stride;
+}
+
+const f32* SkinPose::Matrices() const noexcept
+{
+  return matrices.data();
+}
+
+const f32* SkinPose::DualQuaternions() const noexcept
+{
+  return dualQuaternions.data();
+}
+
+void SkinWeights::Build(
+    const u16* vertexBones,
+    const f32* vertexWeights,
+    std::size_t vertexCount,
+    u32 influences
+) noexcept
+{
+  constexpr u32 maxInfluences = SkinningSettings::maxInfluences;
+  for (u32 slot = 0; slot < maxInfluences; ++slot) {
+    bones[slot].assign(vertexCount, 0);
+    weights[slot].assign(vertexCount, 0.0f);
+  }
+  this->vertexCount = vertexCount;
+  slotCount = 0;
+  boneCount = 0;
+
+  struct Influence
+  {
+    u16 bone;
+    f32 weight;
+  };
+  for (std::size_t vertex = 0; vertex < vertexCount; ++vertex) {
+    const u16* sourceBones = vertexBones + vertex * influences;
+    const f32* sourceWeights = vertexWeights + vertex * influences;
+    // insertion into the largest weights in descending order
+    Influence top[maxInfluences];
+    u32 used = 0;
+    for (u32 k = 0; k < influences; ++k) {
+      f32 weight = sourceWeights[k];
+      if (!(weight > 0.0f) || (used == maxInfluences && weight <= top[used - 1].weight))
+        continue;
+      u32 j = used < maxInfluences ? used++ : maxInfluences - 1;
+      for (; j > 0 && top[j - 1].weight < weight; --j)
+        top[j] = top[j - 1];
+      top[j] = {sourceBones[k], weight};
+    }
+    if (used == 0) {
+      top[0] = {influences > 0 ? sourceBones[0] : u16(0), 1.0f};
+      used = 1;
+    }
+
+    f32 sum = 0.0f;
+    for (u32 j = 0; j < used; ++j)
+      sum += top[j].weight;
+    for (u32 j = 0; j < used; ++j) {
+      bones[j][vertex] = top[j].bone;
+      weights[j][vertex] = top[j].weight / sum;
+      boneCount = std::max(boneCount, u32(top[j].bone) + 1);
+    }
+    slotCount = std::max(slotCount, used);
+  }
+}
+
+void SkinWeights::Clear() noexcept
+{
+  for (u32 slot = 0; slot < SkinningSettings::maxInfluences; ++slot) {
+    bones[slot].clear();
+    weights[slot].clear();
+  }
+  vertexCount = 0;
+  slotCount = 0;
+  boneCount = 0;
+}
+
+std::size_t SkinWeights::VertexCount() const noexcept
+{
+  return vertexCount;
+}
+
+u32 SkinWeights::SlotCount() const noexcept
+{
+  return slotCount;
+}
+
+u32 SkinWeights::BoneCount() const noexcept
+{
+  return boneCount;
+}
+
+const u16* SkinWeights::Bones(u32 slot) const noexcept
+{
+  assert(slot < SkinningSettings::maxInfluences && "Influence slot out of range");
+  return bones[slot].data();
+}
+
+const f32* SkinWeights::Weights(u32 slot) const noexcept
+{
+  assert(slot < SkinningSettings::maxInfluences && "Influence slot out of range");
+  return weights[slot].data();
+}
+
+void Skin(
+    SkinningMethod method,
+    const SkinPose& pose,
+    const SkinWeights& weights,
+    const Vector3Arrayf& positions,
+    Vector3Arrayf& outPositions
+) noexcept
+{
+  if (!Prepare(pose, weights, positions, outPositions))
+    return;
+  SkinRange(method, pose, weights, MakeStreams(positions, outPositions), 0, positions.Size());
+}
+
+void Skin(
+    SkinningMethod method,
+    const SkinPose& pose,
+    const SkinWeights& weights,
+    const Vector3Arrayf& positions,
+    Vector3Arrayf& outPositions,
+    Parallel::ThreadPool& pool,
+    std::size_t grain
+) noexcept
+{
+  if (!Prepare(pose, weights, positions, outPositions))
+    return;
+  Streams streams = MakeStreams(positions, outPositions);
+  pool.ParallelFor(positions.Size(), grain, [&](std::size_t begin, std::size_t end) {
+    SkinRange(method, pose, weights, streams, begin, end);
+  });
+}
+
+void Skin(
+    SkinningMethod method,
+    const SkinPose& pose,
+    const SkinWeights& weights,
+    const Vector3Arrayf& positions,
+    const Vector3Arrayf& normals,
+    Vector3Arrayf& outPositions,
+    Vector3Arrayf& outNormals
+) noexcept
+{
+  bool valid = Prepare(pose, weights, positions, outPositions);
+  if (!Prepare(pose, weights, normals, outNormals) || !valid)
+    return;
+  Streams streams = MakeStreams(positions, outPositions);
+  AddNormals(normals, outNormals, streams);
+  SkinRange(method, pose, weights, streams, 0, positions.Size());
+}
+
+void Skin(
+    SkinningMethod method,
+    const SkinPose& pose,
+    const SkinWeights& weights,
+    const Vector3Arrayf& positions,
+    const Vector3Arrayf& normals,
+    Vector3Arrayf& outPositions,
+    Vector3Arrayf& outNormals,
+    Parallel::ThreadPool& pool,
+    std::size_t grain
+) noexcept
+{
+  bool valid = Prepare(pose, weights, positions, outPositions);
+  if (!Prepare(pose, weights, normals, outNormals) || !valid)
+    return;
+  Streams streams = MakeStreams(positions, outPositions);
+  AddNormals(normals, outNormals, streams);
+  pool.ParallelFor(positions.Size(), grain, [&](std::size_t begin, std::size_t end) {
+    SkinRange(method, pose, weights, streams, begin, end);
+  });
+}
+
+} // namespace Engine::Core::Animation
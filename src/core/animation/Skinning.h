@@ -0,0 +1,155 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Skinning.h
+ * @brief Linear blend and dual quaternion skinning of vertex arrays
+ *
+ * SkinPose keeps the skinning transform of every bone (bone world transform times inverse bind
+ * transform) as a 3x4 matrix and as a dual quaternion with a separate scale, each packed into 12
+ * floats so a vertex influence fetches one contiguous record. SkinWeights stores up to four
+ * influences per vertex as one array per influence slot. The kernels work on structure of arrays
+ * positions and normals in SIMD lanes of consecutive vertices: bone records are gathered and
+ * transposed into lanes, blended by the weights and applied to the vertices of all lanes at once.
+ * Influence slots whose weights are zero for every vertex of the lanes are skipped, so meshes
+ * with mostly one or two influences per vertex do not pay for four.
+ *
+ * Linear blend transforms normals by the blended 3x3 part, which is exact for uniform scale only.
+ * Dual quaternion skinning blends rotations and translations without the volume loss of linear
+ * blending on twisting joints; bone scales are blended linearly and applied before the rotation.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/math/Transform.h"
+#include "core/math/Vector3Array.h"
+#include "core/memory/AlignedAllocator.h"
+#include "core/parallel/ThreadPool.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace Engine::Core::Animation
+{
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+struct SkinningSettings
+{
+  static constexpr u32 maxInfluences = 4;
+  /// Default number of vertices per parallel task
+  static constexpr std::size_t grain = 2048;
+};
+
+enum class SkinningMethod : u8
+{
+  LinearBlend,
+  DualQuaternion
+};
+
+class SkinPose
+{
+ public:
+  /// Floats per bone record of Matrices and DualQuaternions
+  static constexpr u32 stride = 12;
+
+  /// Sets the skinning transforms, bone world transform times inverse bind transform
+  void Set(const Math::Transformf* bones, std::size_t count) noexcept;
+  void Clear() noexcept;
+
+  std::size_t BoneCount() const noexcept;
+  /// Row major 3x4 matrices
+  const f32* Matrices() const noexcept;
+  /// Rotation quaternion (x, y, z, w), dual part (x, y, z, w) and scale (x, y, z) with padding
+  const f32* DualQuaternions() const noexcept;
+
+ private:
+  std::vector<f32> matrices;
+  std::vector<f32> dualQuaternions;
+};
+
+class SkinWeights
+{
+ public:
+  using Storage = std::vector<f32, Memory::AlignedAllocator<f32>>;
+
+  /**
+   * @brief Takes influences interleaved per vertex, influences entries for every vertex
+   *
+   * The largest maxInfluences weights of a vertex are kept and normalized to sum one. A vertex
+   * without positive weights is bound to its first listed bone.
+   */
+  void Build(
+      const u16* bones,
+      const f32* weights,
+      std::size_t vertexCount,
+      u32 influences
+  ) noexcept;
+  void Clear() noexcept;
+
+  std::size_t VertexCount() const noexcept;
+  /// Number of used influence slots, the most influences of any vertex
+  u32 SlotCount() const noexcept;
+  /// Largest referenced bone index plus one
+  u32 BoneCount() const noexcept;
+
+  const u16* Bones(u32 slot) const noexcept;
+  const f32* Weights(u32 slot) const noexcept;
+
+ private:
+  std::vector<u16> bones[SkinningSettings::maxInfluences];
+  Storage weights[SkinningSettings::maxInfluences];
+  std::size_t vertexCount = 0;
+  u32 slotCount = 0;
+  u32 boneCount = 0;
+};
+
+/**
+ * @brief Writes skinned positions, outPositions may be positions itself
+ *
+ * Vertices are left unchanged if weights does not match positions or references bones missing
+ * from pose.
+ */
+void Skin(
+    SkinningMethod method,
+    const SkinPose& pose,
+    const SkinWeights& weights,
+    const Math::Vector3Arrayf& positions,
+    Math::Vector3Arrayf& outPositions
+) noexcept;
+
+void Skin(
+    SkinningMethod method,
+    const SkinPose& pose,
+    const SkinWeights& weights,
+    const Math::Vector3Arrayf& positions,
+    Math::Vector3Arrayf& outPositions,
+    Parallel::ThreadPool& pool,
+    std::size_t grain = SkinningSettings::grain
+) noexcept;
+
+/// Writes skinned positions and unit normals
+void Skin(
+    SkinningMethod method,
+    const SkinPose& pose,
+    const SkinWeights& weights,
+    const Math::Vector3Arrayf& positions,
+    const Math::Vector3Arrayf& normals,
+    Math::Vector3Arrayf& outPositions,
+    Math::Vector3Arrayf& outNormals
+) noexcept;
+
+void Skin(
+    SkinningMethod method,
+    const SkinPose& pose,
+    const SkinWeights& weights,
+    const Math::Vector3Arrayf& positions,
+    const Math::Vector3Arrayf& normals,
+    Math::Vector3Arrayf& outPositions,
+    Math::Vector3Arrayf& outNormals,
+    Parallel::ThreadPool& pool,
+    std::size_t grain = SkinningSettings::grain
+) noexcept;
+
+} // namespace Engine::Core::Animation
@@ -0,0 +1,10 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file FlatHashMap.cpp
+ * @brief All implementation contains in header file FlatHashMap.h
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include "core/container/FlatHashMap.h"
@@ -0,0 +1,530 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file FlatHashMap.h
+ * @brief Open addressing hash map with Swiss table control bytes and stable handles
+ *
+ * The table is split into groups of 16 slots with one control byte per slot: empty, deleted or
+ * the low 7 bits of the key hash. A lookup compares the tag with all control bytes of a group at
+ * once (SSE2 when available) and touches keys of matching slots only, so most failed probes never
+ * leave the control array. Groups are probed triangularly, which visits every group of a power of
+ * two table.
+ *
+ * Slots hold indices into dense key and value arrays instead of the pairs themselves. Rehashing
+ * moves only indices, hence an index is a handle which stays valid until its entry is erased and
+ * gives access to the entry without hashing. Erased entries are recycled through a free list.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/container/Hash.h"
+#include "core/memory/AlignedAllocator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+  #include <emmintrin.h>
+#endif
+#if defined(_MSC_VER)
+  #include <intrin.h>
+#endif
+
+namespace Engine::Core::Container
+{
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+struct FlatHashMapSettings
+{
+  /// Slots of one probed group, matches one SSE2 register of control bytes
+  static constexpr u32 groupWidth = 16;
+  /// Table never fills above maxLoadNumerator / maxLoadDenominator
+  static constexpr u32 maxLoadNumerator = 7;
+  static constexpr u32 maxLoadDenominator = 8;
+};
+
+/**
+ * @brief Map of unique keys to values
+ * @tparam Value must be default constructible, erased values are reset to Value()
+ */
+template <
+    typename Key,
+    typename Value,
+    typename Hasher = Hash<Key>,
+    typename KeyEqual = Equal<Key>>
+class FlatHashMap
+{
+ public:
+  using Handle = u32;
+
+  static constexpr Handle invalidHandle = ~Handle(0);
+
+  FlatHashMap() noexcept = default;
+  explicit FlatHashMap(u32 capacity) noexcept;
+
+  /// Prepares for count entries without rehashing or reallocation
+  void Reserve(u32 count) noexcept;
+  void Clear() noexcept;
+
+  /**
+   * @brief Inserts key with value unless the key is present
+   * @return handle of the entry with key and true when it was inserted
+   */
+  std::pair<Handle, bool> Insert(const Key& key, const Value& value) noexcept;
+  Handle InsertOrAssign(const Key& key, const Value& value) noexcept;
+  /// Value of key, inserted as Value() when missing
+  Value& operator[](const Key& key) noexcept;
+
+  Handle Find(const Key& key) const noexcept;
+  bool Contains(const Key& key) const noexcept;
+  /// Value of key or nullptr, valid until the next insertion
+  Value* Get(const Key& key) noexcept;
+  const Value* Get(const Key& key) const noexcept;
+
+  bool Erase(const Key& key) noexcept;
+  void EraseAt(Handle handle) noexcept;
+
+  bool IsValid(Handle handle) const noexcept;
+  const Key& KeyAt(Handle handle) const noexcept;
+  Value& ValueAt(Handle handle) noexcept;
+  const Value& ValueAt(Handle handle) const noexcept;
+
+  /// Calls func(const Key&, Value&) for every entry in handle order
+  template <typename Func>
+  void ForEach(Func&& func) noexcept;
+
+  u32 Size() const noexcept;
+  bool Empty() const noexcept;
+  /// Number of table slots
+  u32 Capacity() const noexcept;
+
+ private:
+  static constexpr u32 invalidSlot = ~u32(0);
+
+  /// Slot holding key or, when missing, the slot a new key has to go to
+  u32 FindSlot(const Key& key, u64 hash, bool& found) const noexcept;
+  /// Entries the table holds before it has to grow
+  u32 MaxLoad() const noexcept;
+  void Rehash(u32 capacity) noexcept;
+  Handle AllocateEntry(const Key& key, const Value& value) noexcept;
+  std::pair<Handle, bool> FindOrInsert(const Key& key, const Value& value) noexcept;
+
+  std::vector<i8, Memory::AlignedAllocator<i8>> control;
+  /// Entry index of every full slot
+  std::vector<u32> slots;
+  u32 capacity = 0;
+  /// Insertions into empty slots left before rehashing
+  u32 growthLeft = 0;
+
+  std::vector<Key> keys;
+  std::vector<Value> values;
+  /// Table slot of every entry, invalidSlot for erased entries
+  std::vector<u32> entrySlots;
+  std::vector<Handle> freeEntries;
+  u32 size = 0;
+
+  Hasher hasher;
+  KeyEqual equal;
+};
+
+/* --------------------------------------- Implementation -------------------------------------- */
+namespace Internal
+{
+
+constexpr i8 emptyControl = -128;
+constexpr i8 deletedControl = -2;
+
+inline u32 LowestBit(u32 mask) noexcept
+{
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return static_cast<u32>(index);
+#else
+  return static_cast<u32>(__builtin_ctz(mask));
+#endif
+}
+
+/// Bit masks of slots in a group of control bytes matching a condition
+class Group
+{
+ public:
+  explicit Group(const i8* control) noexcept;
+
+  u32 Match(i8 tag) const noexcept;
+  u32 MatchEmpty() const noexcept;
+  u32 MatchEmptyOrDeleted() const noexcept;
+
+ private:
+#if defined(__SSE2__) || defined(_M_X64)
+  __m128i bytes;
+#else
+  const i8* bytes;
+#endif
+};
+
+#if defined(__SSE2__) || defined(_M_X64)
+
+inline Group::Group(const i8* control) noexcept
+    : bytes(_mm_load_si128(reinterpret_cast<const __m128i*>(control)))
+{
+}
+
+inline u32 Group::Match(i8 tag) const noexcept
+{
+  return static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(tag))));
+}
+
+inline u32 Group::MatchEmpty() const noexcept
+{
+  return Match(emptyControl);
+}
+
+inline u32 Group::MatchEmptyOrDeleted() const noexcept
+{
+  // empty and deleted are the only values below -1
+  return static_cast<u32>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), bytes)));
+}
+
+#else
+
+inline Group::Group(const i8* control) noexcept
+    : bytes(control)
+{
+}
+
+inline u32 Group::Match(i8 tag) const noexcept
+{
+  u32 mask = 0;
+  for (u32 i = 0; i < FlatHashMapSettings::groupWidth; ++i)
+    mask |= static_cast<u32>(bytes[i] == tag) << i;
+  return mask;
+}
+
+inline u32 Group::MatchEmpty() const noexcept
+{
+  return Match(emptyControl);
+}
+
+inline u32 Group::MatchEmptyOrDeleted() const noexcept
+{
+  u32 mask = 0;
+  for (u32 i = 0; i < FlatHashMapSettings::groupWidth; ++i)
+    mask |= static_cast<u32>(bytes[i] < -1) << i;
+  return mask;
+}
+
+#endif
+
+/// Low 7 bits select the tag, the rest selects the first group
+inline i8 HashTag(u64 hash) noexcept
+{
+  return static_cast<i8>(hash & 0x7f);
+}
+
+} // namespace Internal
+
+template <typename Key, typename Value, typename Hasher, typename KeyEqual>
+FlatHashMap<Key, Value, Hasher, KeyEqual>::FlatHashMap(u32 capacity) noexcept
+{
+  Reserve(capacity);
+}
+
+template <typename Key, typename Value, typename Hasher, typename KeyEqual>
+void FlatHashMap<Key, Value, Hasher, KeyEqual>::Reserve(u32 count) noexcept
+{
+  keys.reserve(count);
+  values.reserve(count);
+  entrySlots.reserve(count);
+
+  constexpr u32 numerator = FlatHashMapSettings::maxLoadNumerator;
+  constexpr u32 denominator = FlatHashMapSettings::maxLoadDenominator;
+  u32 required = FlatHashMapSettings::groupWidth;
+  while (static_cast<u64>(required) * numerator / denominator < count)
+    required *= 2;
+  if (required > capacity)
+    Rehash(required);
+}
+
+template <typename Key, typename Value, typename Hasher, typename KeyEqual>
+void FlatHashMap<Key, Value, Hasher, KeyEqual>::Clear() noexcept
+{
+  std::fill(control.begin(), control.end(), Internal::emptyControl);
+  growthLeft = MaxLoad();
+  keys.clear();
+  values.clear();
+  entrySlots.clear();
+  freeEntries.clear();
+  size = 0;
+}
+
+template <typename Key, typename Value, typename Hasher, typename KeyEqual>
+std::pair<typename FlatHashMap<Key, Value, Hasher, KeyEqual>::Handle, bool>
+FlatHashMap<Key, Value, Hasher, KeyEqual>::Insert(const Key& key, const Value& value) noexcept
+{
+  return FindOrInsert(key, value);
+}
+
+template <typename Key, typename Value, typename Hasher, typename KeyEqual>
+typename FlatHashMap<Key, Value, Hasher, KeyEqual>::Handle
+FlatHashMap<Key, Value, Hasher, KeyEqual>::InsertOrAssign(const Key& key, const Value& value)
+    noexcept
+{
+  auto [handle, inserted] = FindOrInsert(key, value);
+  if (!inserted)
+    values[handle] = value;
+  return handle;
+}
+
+template <typename Key, typename Value, typename Hasher, typename KeyEqual>
+Value& FlatHashMap<Key, Value, Hasher, KeyEqual>::operator[](const Key& key) noexcept
+{
+  return values[FindOrInsert(key, Value()).first];
+}
+
+template <typename Key, typename Value, typename Hasher, typename KeyEqual>
+typename FlatHashMap<Key, Value, Hasher, KeyEqual>::Handle
+FlatHashMap<Key, Value, Hasher, KeyEqual>::Find(const Key& key) const noexcept
+{
+  if (size == 0)
+    return invalidHandle;
+  bool found;
+  u32 slot = FindSlot(key, hasher(key), found);
+  return found ? slots[slot] : invalidHandle;
+}
+
+template <typename Key, typename Value, typename Hasher, typename KeyEqual>
+bool FlatHashMap<Key, Value, Hasher, KeyEqual>::Contains(const Key& key) const noexcept
+{
+  return Find(key) != invalidHandle;
+}
+
+template <typename Key, typename Value, typename Hasher, typename KeyEqual>
+Value* FlatHashMap<Key, Value, Hasher, KeyEqual>::Get(const Key& key) noexcept
+{
+  Handle handle = Find(key);
+  return handle == invalidHandle ? nullptr : &values[handle];
+}
+
+template <typename Key, typename Value, typename Hasher, typename KeyEqual>
+const Value* FlatHashMap<Key, Value, Hasher, KeyEqual>::Get(const Key& key) const noexcept
+{
+  Handle handle = Find(key);
+  return handle == invalidHandle ? nullptr : &values[handle];
+}
+
+template <typename Key, typename Value, typename Hasher, typename KeyEqual>
+bool FlatHashMap<Key, Value, Hasher, KeyEqual>::Erase(const Key& key) noexcept
+{
+  Handle handle = Find(key);
+  if (handle == invalidHandle)
+    return false;
+  EraseAt(handle);
+  return true;
+}
+
+template <typename Key, typename Value, typename Hasher, typename KeyEqual>
+void FlatHashMap<Key, Value, Hasher, KeyEqual>::EraseAt(Handle handle) noexcept
+{
+  assert(IsValid(handle) && "Invalid handle");
+  if (!IsValid(handle))
+    return;
+
+  // probes stop at the first group with an empty slot, so a slot in such a group can become
+  // empty again without hiding keys stored further along any probe sequence
+  u32 slot = entrySlots[handle];
+  u32 group = slot / FlatHashMapSettings::groupWidth * FlatHashMapSettings::groupWidth;
+  if (Internal::Group(control.data() + group).MatchEmpty() != 0) {
+    control[slot] = Internal::emptyControl;
+    ++growthLeft;
+  } else {
+    control[slot] = Internal::deletedControl;
+  }
+
+  values[handle] = Value();
+  entrySlots[handle] = invalidSlot;
+  freeEntries.push_back(handle);
+  --size;
+}
+
+template <typename Key, typename Value, typename Hasher, typename KeyEqual>
+bool FlatHashMap<Key, Value, Hasher, KeyEqual>::IsValid(Handle handle) const noexcept
+{
+  return handle < entrySlots.size() && entrySlots[handle] != invalidSlot;
+}
+
+template <typename Key, typename Value, typename Hasher, typename KeyEqual>
+const Key& FlatHashMap<Key, Value, Hasher, KeyEqual>::KeyAt(Handle handle) const noexcept
+{
+  assert(IsValid(handle) && "Invalid handle");
+  return keys[handle];
+}
+
+template <typename Key, typename Value, typename Hasher, typename KeyEqual>
+Value& FlatHashMap<Key, Value, Hasher, KeyEqual>::ValueAt(Handle handle) noexcept
+{
+  assert(IsValid(handle) && "Invalid handle");
+  return values[handle];
+}
+
+template <typename Key, typename Value, typename Hasher, typename KeyEqual>
+const Value& FlatHashMap<Key, Value, Hasher, KeyEqual>::ValueAt(Handle handle) const noexcept
+{
+  assert(IsValid(handle) && "Invalid handle");
+  return values[handle];
+}
+
+template <typename Key, typename Value, typename Hasher, typename KeyEqual>
+template <typename Func>
+void FlatHashMap<Key, Value, Hasher, KeyEqual>::ForEach(Func&& func) noexcept
+{
+  for (std::size_t i = 0; i < entrySlots.size(); ++i) {
+    if (entrySlots[i] != invalidSlot)
+      func(static_cast<const Key&>(keys[i]), values[i]);
+  }
+}
+
+template <typename Key, typename Value, typename Hasher, typename KeyEqual>
+u32 FlatHashMap<Key, Value, Hasher, KeyEqual>::Size() const noexcept
+{
+  return size;
+}
+
+template <typename Key, typename Value, typename Hasher, typename KeyEqual>
+bool FlatHashMap<Key, Value, Hasher, KeyEqual>::Empty() const noexcept
+{
+  return size == 0;
+}
+
+template <typename Key, typename Value, typename Hasher, typename KeyEqual>
+u32 FlatHashMap<Key, Value, Hasher, KeyEqual>::Capacity() const noexcept
+{
+  return capacity;
+}
+
+template <typename Key, typename Value, typename Hasher, typename KeyEqual>
+u32 FlatHashMap<Key, Value, Hasher, KeyEqual>::FindSlot(const Key& key, u64 hash, bool& found)
+    const noexcept
+{
+  constexpr u32 width = FlatHashMapSettings::groupWidth;
+  u32 groupMask = capacity / width - 1;
+  u32 group = static_cast<u32>(hash >> 7) & groupMask;
+  i8 tag = Internal::HashTag(hash);
+  u32 freeSlot = invalidSlot;
+
+  for (u32 step = 1;; ++step) {
+    Internal::Group bytes(control.data() + group * width);
+    for (u32 mask = bytes.Match(tag); mask != 0; mask &= mask - 1) {
+      u32 slot = group * width + Internal::LowestBit(mask);
+      if (equal(keys[slots[slot]], key)) {
+        found = true;
+        return slot;
+      }
+    }
+
+    // the first deleted or empty slot on the way is where the key would be inserted
+    u32 available = bytes.MatchEmptyOrDeleted();
+    if (freeSlot == invalidSlot && available != 0)
+      freeSlot = group * width + Internal::LowestBit(available);
+    if (bytes.MatchEmpty() != 0 || step > groupMask) {
+      found = false;
+      return freeSlot;
+    }
+    group = (group + step) & groupMask;
+  }
+}
+
+template <typename Key, typename Value, typename Hasher, typename KeyEqual>
+u32 FlatHashMap<Key, Value, Hasher, KeyEqual>::MaxLoad() const noexcept
+{
+  constexpr u32 numerator = FlatHashMapSettings::maxLoadNumerator;
+  constexpr u32 denominator = FlatHashMapSettings::maxLoadDenominator;
+  return capacity / denominator * numerator;
+}
+
+template <typename Key, typename Value, typename Hasher, typename KeyEqual>
+void FlatHashMap<Key, Value, Hasher, KeyEqual>::Rehash(u32 newCapacity) noexcept
+{
+  constexpr u32 width = FlatHashMapSettings::groupWidth;
+  capacity = newCapacity;
+  control.assign(capacity, Internal::emptyControl);
+  slots.assign(capacity, 0);
+  growthLeft = MaxLoad();
+
+  // a fresh table holds no deleted slots and no equal keys, so the first empty slot is the spot
+  u32 groupMask = capacity / width - 1;
+  for (u32 entry = 0; entry < entrySlots.size(); ++entry) {
+    if (entrySlots[entry] == invalidSlot)
+      continue;
+    u64 hash = hasher(keys[entry]);
+    u32 group = static_cast<u32>(hash >> 7) & groupMask;
+    u32 empty = Internal::Group(control.data() + group * width).MatchEmpty();
+    for (u32 step = 1; empty == 0; ++step) {
+      group = (group + step) & groupMask;
+      empty = Internal::Group(control.data() + group * width).MatchEmpty();
+    }
+
+    u32 slot = group * width + Internal::LowestBit(empty);
+    control[slot] = Internal::HashTag(hash);
+    slots[slot] = entry;
+    entrySlots[entry] = slot;
+    --growthLeft;
+  }
+}
+
+template <typename Key, typename Value, typename Hasher, typename KeyEqual>
+typename FlatHashMap<Key, Value, Hasher, KeyEqual>::Handle
+FlatHashMap<Key, Value, Hasher, KeyEqual>::AllocateEntry(const Key& key, const Value& value)
+    noexcept
+{
+  if (!freeEntries.empty()) {
+    Handle handle = freeEntries.back();
+    freeEntries.pop_back();
+    keys[handle] = key;
+    values[handle] = value;
+    return handle;
+  }
+  keys.push_back(key);
+  values.push_back(value);
+  entrySlots.push_back(invalidSlot);
+  return static_cast<Handle>(keys.size()) - 1;
+}
+
+template <typename Key, typename Value, typename Hasher, typename KeyEqual>
+std::pair<typename FlatHashMap<Key, Value, Hasher, KeyEqual>::Handle, bool>
+FlatHashMap<Key, Value, Hasher, KeyEqual>::FindOrInsert(const Key& key, const Value& value)
+    noexcept
+{
+  if (capacity == 0)
+    Rehash(FlatHashMapSettings::groupWidth);
+
+  u64 hash = hasher(key);
+  bool found;
+  u32 slot = FindSlot(key, hash, found);
+  if (found)
+    return {slots[slot], false};
+
+  // reusing a deleted slot does not consume growth, filling an empty one does
+  if (slot == invalidSlot || (growthLeft == 0 && control[slot] == Internal::emptyControl)) {
+    // a table full of deleted slots is cleaned at the same size, otherwise it doubles
+    Rehash(size * 2 >= MaxLoad() ? capacity * 2 : capacity);
+    slot = FindSlot(key, hash, found);
+  }
+
+  if (control[slot] == Internal::emptyControl)
+    --growthLeft;
+  Handle handle = AllocateEntry(key, value);
+  control[slot] = Internal::HashTag(hash);
+  slots[slot] = handle;
+  entrySlots[handle] = slot;
+  ++size;
+  return {handle, true};
+}
+
+} // namespace Engine::Core::Container
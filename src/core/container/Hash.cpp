@@ -0,0 +1,10 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Hash.cpp
+ * @brief All implementation contains in header file Hash.h
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include "core/container/Hash.h"
@@ -0,0 +1,184 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Hash.h
+ * @brief Hash and equality functors for hash containers
+ *
+ * Hashes are 64 bit and well mixed in all bits, since FlatHashMap takes the group index from the
+ * high bits and a tag from the low bits. Vectors are hashed and compared exactly by components:
+ * the tolerant Vector3 operator== would make equal keys hash differently. Negative zero is hashed
+ * as zero to agree with the exact comparison. Every NaN is hashed as the same quiet NaN and
+ * compares equal to any other NaN, otherwise a NaN key would never find its own entry and every
+ * insertion of it would add a new one. Integer vectors serve as grid cell coordinates.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/math/Vector2.h"
+#include "core/math/Vector3.h"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace Engine::Core::Container
+{
+
+using Math::Vector2;
+using Math::Vector3;
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+/// Hash of integral, enum, floating point and pointer types
+template <typename T>
+struct Hash
+{
+  u64 operator()(const T& value) const noexcept;
+};
+
+template <typename T>
+struct Hash<Vector2<T>>
+{
+  u64 operator()(const Vector2<T>& v) const noexcept;
+};
+
+template <typename T>
+struct Hash<Vector3<T>>
+{
+  u64 operator()(const Vector3<T>& v) const noexcept;
+};
+
+/// Equality by operator== except for floating point, where NaN equals NaN, and for vectors,
+/// which are compared exactly by components the same way
+template <typename T>
+struct Equal
+{
+  bool operator()(const T& a, const T& b) const noexcept;
+};
+
+template <typename T>
+struct Equal<Vector2<T>>
+{
+  bool operator()(const Vector2<T>& a, const Vector2<T>& b) const noexcept;
+};
+
+template <typename T>
+struct Equal<Vector3<T>>
+{
+  bool operator()(const Vector3<T>& a, const Vector3<T>& b) const noexcept;
+};
+
+/// Finalizer of MurmurHash3, every input bit affects every output bit
+constexpr u64 MixHash(u64 value) noexcept;
+constexpr u64 CombineHash(u64 seed, u64 value) noexcept;
+/// Same key for both directions of the edge between vertices a and b
+constexpr u64 EdgeKey(u32 a, u32 b) noexcept;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+constexpr u64 MixHash(u64 value) noexcept
+{
+  value ^= value >> 33;
+  value *= 0xff51afd7ed558ccdull;
+  value ^= value >> 33;
+  value *= 0xc4ceb9fe1a85ec53ull;
+  value ^= value >> 33;
+  return value;
+}
+
+constexpr u64 CombineHash(u64 seed, u64 value) noexcept
+{
+  return MixHash(seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2)));
+}
+
+constexpr u64 EdgeKey(u32 a, u32 b) noexcept
+{
+  return a < b ? (u64(a) << 32) | b : (u64(b) << 32) | a;
+}
+
+namespace Internal
+{
+
+/// Bits of a scalar widened to 64 bits
+template <typename T>
+u64 ScalarBits(T value) noexcept
+{
+  static_assert(
+      std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>,
+      "Hash requires a scalar type or a specialization"
+  );
+  if constexpr (std::is_floating_point_v<T>) {
+    // +0 and -0 are equal, so they must hash equally, and so are all NaNs
+    if (value == static_cast<T>(0))
+      value = static_cast<T>(0);
+    if (value != value)
+      value = std::numeric_limits<T>::quiet_NaN();
+    if constexpr (sizeof(T) == sizeof(u32)) {
+      u32 bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      return bits;
+    } else {
+      u64 bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      return bits;
+    }
+  } else if constexpr (std::is_pointer_v<T>) {
+    return static_cast<u64>(reinterpret_cast<std::uintptr_t>(value));
+  } else {
+    return static_cast<u64>(value);
+  }
+}
+
+/// operator== except that a floating point NaN equals any NaN
+template <typename T>
+bool SameScalar(const T& a, const T& b) noexcept
+{
+  if constexpr (std::is_floating_point_v<T>)
+    return a == b || (a != a && b != b);
+  else
+    return a == b;
+}
+
+} // namespace Internal
+
+template <typename T>
+u64 Hash<T>::operator()(const T& value) const noexcept
+{
+  return MixHash(Internal::ScalarBits(value));
+}
+
+template <typename T>
+u64 Hash<Vector2<T>>::operator()(const Vector2<T>& v) const noexcept
+{
+  return CombineHash(MixHash(Internal::ScalarBits(v.x)), Internal::ScalarBits(v.y));
+}
+
+template <typename T>
+u64 Hash<Vector3<T>>::operator()(const Vector3<T>& v) const noexcept
+{
+  u64 hash = CombineHash(MixHash(Internal::ScalarBits(v.x)), Internal::ScalarBits(v.y));
+  return CombineHash(hash, Internal::ScalarBits(v.z));
+}
+
+template <typename T>
+bool Equal<T>::operator()(const T& a, const T& b) const noexcept
+{
+  return Internal::SameScalar(a, b);
+}
+
+template <typename T>
+bool Equal<Vector2<T>>::operator()(const Vector2<T>& a, const Vector2<T>& b) const noexcept
+{
+  return Internal::SameScalar(a.x, b.x) && Internal::SameScalar(a.y, b.y);
+}
+
+template <typename T>
+bool Equal<Vector3<T>>::operator()(const Vector3<T>& a, const Vector3<T>& b) const noexcept
+{
+  return Internal::SameScalar(a.x, b.x) && Internal::SameScalar(a.y, b.y) &&
+         Internal::SameScalar(a.z, b.z);
+}
+
+} // namespace Engine::Core::Container
@@ -0,0 +1,76 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file CommandBuffer.cpp
+ * @brief Implementation of command playback
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include "core/ecs/CommandBuffer.h"
+
+namespace Engine::Core::Ecs
+{
+
+void CommandBuffer::Destroy(Entity entity) noexcept
+{
+  commands.push_back(Command{CommandType::Destroy, 0, entity, 0});
+}
+
+void CommandBuffer::Playback(World& world) noexcept
+{
+  std::vector<Entity> entities;
+  entities.reserve(created);
+  auto resolve = [&entities](Entity entity) {
+    return entity.generation == pendingGeneration ? entities[entity.index] : entity;
+  };
+
+  for (const Command& command : commands) {
+    if (command.type == CommandType::Create) {
+      entities.push_back(world.Create());
+      continue;
+    }
+
+    // another buffer or an earlier command may have destroyed the entity since recording
+    Entity entity = resolve(command.entity);
+    if (!world.IsAlive(entity))
+      continue;
+    switch (command.type) {
+      case CommandType::Destroy:
+        world.Destroy(entity);
+        break;
+      case CommandType::Add:
+        world.AddComponent(entity, command.component, &payload[command.offset]);
+        break;
+      case CommandType::Remove:
+        world.RemoveComponent(entity, command.component);
+        break;
+      case CommandType::Create:
+        break;
+    }
+  }
+  Clear();
+}
+
+void CommandBuffer::Clear() noexcept
+{
+  commands.clear();
+  payload.clear();
+  created = 0;
+}
+
+bool CommandBuffer::Empty() const noexcept
+{
+  return commands.empty();
+}
+
+void CommandBuffer::AddComponent(Entity entity, ComponentId id, const void* data, u32 size)
+    noexcept
+{
+  u32 offset = static_cast<u32>(payload.size());
+  payload.resize(offset + size);
+  std::memcpy(payload.data() + offset, data, size);
+  commands.push_back(Command{CommandType::Add, id, entity, offset});
+}
+
+} // namespace Engine::Core::Ecs
@@ -0,0 +1,102 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file CommandBuffer.h
+ * @brief Deferred structural changes of a World
+ *
+ * Systems iterating chunks must not create or destroy entities or change their component sets,
+ * because that moves rows under the iteration. They record such changes here and the buffer is
+ * played back once iteration is over. Every system owns its buffer, so recording needs no locks.
+ * Several buffers may refer to the same entity, so commands on an entity which is no longer alive
+ * at playback, destroyed by an earlier buffer or an earlier command, are dropped.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/ecs/Component.h"
+#include "core/ecs/Entity.h"
+#include "core/ecs/World.h"
+
+#include <cstring>
+#include <vector>
+
+namespace Engine::Core::Ecs
+{
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+class CommandBuffer
+{
+ public:
+  /**
+   * @brief Records creation of an entity with components
+   * @return placeholder which other commands of this buffer may use, it is replaced by the
+   * created entity on playback and must not be used with World directly
+   */
+  template <typename... C>
+  Entity Create(const C&... components) noexcept;
+  void Destroy(Entity entity) noexcept;
+  template <typename C>
+  void Add(Entity entity, const C& component) noexcept;
+  template <typename C>
+  void Remove(Entity entity) noexcept;
+
+  /// Applies commands in recording order and clears the buffer, skipping Destroy, Add and
+  /// Remove of entities which are not alive anymore
+  void Playback(World& world) noexcept;
+  void Clear() noexcept;
+  bool Empty() const noexcept;
+
+ private:
+  /// Generation marking placeholders, index is the ordinal of the Create command
+  static constexpr u32 pendingGeneration = ~u32(0);
+
+  enum class CommandType : u8
+  {
+    Create,
+    Destroy,
+    Add,
+    Remove
+  };
+
+  struct Command
+  {
+    CommandType type;
+    ComponentId component;
+    Entity entity;
+    /// Offset of component data in payload
+    u32 offset;
+  };
+
+  void AddComponent(Entity entity, ComponentId id, const void* data, u32 size) noexcept;
+
+  std::vector<Command> commands;
+  std::vector<u8> payload;
+  u32 created = 0;
+};
+
+/* --------------------------------------- Implementation -------------------------------------- */
+template <typename... C>
+Entity CommandBuffer::Create(const C&... components) noexcept
+{
+  Entity entity{created++, pendingGeneration};
+  commands.push_back(Command{CommandType::Create, 0, entity, 0});
+  (AddComponent(entity, ComponentTypeId<C>(), &components, sizeof(C)), ...);
+  return entity;
+}
+
+template <typename C>
+void CommandBuffer::Add(Entity entity, const C& component) noexcept
+{
+  AddComponent(entity, ComponentTypeId<C>(), &component, sizeof(C));
+}
+
+template <typename C>
+void CommandBuffer::Remove(Entity entity) noexcept
+{
+  commands.push_back(Command{CommandType::Remove, ComponentTypeId<C>(), entity, 0});
+}
+
+} // namespace Engine::Core::Ecs
@@ -0,0 +1,55 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Component.cpp
+ * @brief Implementation of component type registry
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include "core/ecs/Component.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+
+namespace Engine::Core::Ecs
+{
+
+namespace
+{
+
+std::atomic<ComponentId> nextId{0};
+// written once before the id is published by the static initialization in ComponentTypeId
+ComponentInfo infos[ComponentSettings::maxComponents];
+
+} // namespace
+
+namespace Internal
+{
+
+ComponentId RegisterComponent(u32 size, u32 alignment) noexcept
+{
+  ComponentId id = nextId.fetch_add(1, std::memory_order_relaxed);
+  if (id >= ComponentSettings::maxComponents) {
+    // a shared id would let types of different layout overwrite each other in chunk memory
+    std::fprintf(
+        stderr, "Too many component types, ComponentMask holds %u\n",
+        ComponentSettings::maxComponents
+    );
+    std::abort();
+  }
+  infos[id] = ComponentInfo{size, alignment};
+  return id;
+}
+
+} // namespace Internal
+
+const ComponentInfo& GetComponentInfo(ComponentId id) noexcept
+{
+  assert(id < nextId.load(std::memory_order_relaxed) && "Unregistered component");
+  return infos[id];
+}
+
+} // namespace Engine::Core::Ecs
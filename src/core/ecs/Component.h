@@ -0,0 +1,97 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Component.h
+ * @brief Runtime identifiers of component types
+ *
+ * Every component type gets a small sequential id on first use, so sets of components are plain
+ * bit masks. Components are stored in raw chunk memory and moved with memcpy, hence they must be
+ * trivially copyable.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+
+#include <type_traits>
+
+namespace Engine::Core::Ecs
+{
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+struct ComponentSettings
+{
+  /// Number of bits in ComponentMask
+  static constexpr u32 maxComponents = 64;
+};
+
+using ComponentId = u32;
+using ComponentMask = u64;
+
+struct ComponentInfo
+{
+  u32 size;
+  u32 alignment;
+};
+
+/// Id of component type C, const and volatile qualifiers are ignored
+template <typename C>
+ComponentId ComponentTypeId() noexcept;
+
+/// Size and alignment of a component type registered by ComponentTypeId
+const ComponentInfo& GetComponentInfo(ComponentId id) noexcept;
+
+template <typename... C>
+ComponentMask ComponentMaskOf() noexcept;
+
+/// Mask of components accessed by const references in C
+template <typename... C>
+ComponentMask ReadMaskOf() noexcept;
+
+/// Mask of components accessed by mutable references in C
+template <typename... C>
+ComponentMask WriteMaskOf() noexcept;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+namespace Internal
+{
+
+ComponentId RegisterComponent(u32 size, u32 alignment) noexcept;
+
+template <typename C>
+ComponentId TypeId() noexcept
+{
+  static_assert(std::is_trivially_copyable_v<C>, "Components must be trivially copyable");
+  static const ComponentId id = Internal::RegisterComponent(sizeof(C), alignof(C));
+  return id;
+}
+
+} // namespace Internal
+
+template <typename C>
+ComponentId ComponentTypeId() noexcept
+{
+  return Internal::TypeId<std::remove_cv_t<C>>();
+}
+
+template <typename... C>
+ComponentMask ComponentMaskOf() noexcept
+{
+  return ((ComponentMask(1) << ComponentTypeId<C>()) | ... | ComponentMask(0));
+}
+
+template <typename... C>
+ComponentMask ReadMaskOf() noexcept
+{
+  return ((std::is_const_v<C> ? ComponentMaskOf<C>() : ComponentMask(0)) | ... | ComponentMask(0));
+}
+
+template <typename... C>
+ComponentMask WriteMaskOf() noexcept
+{
+  return ((std::is_const_v<C> ? ComponentMask(0) : ComponentMaskOf<C>()) | ... | ComponentMask(0));
+}
+
+} // namespace Engine::Core::Ecs
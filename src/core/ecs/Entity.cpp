@@ -0,0 +1,10 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Entity.cpp
+ * @brief All implementation contains in header file Entity.h
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include "core/ecs/Entity.h"
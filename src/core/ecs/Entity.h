@@ -0,0 +1,51 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Entity.h
+ * @brief Entity handle of the entity component system
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+
+namespace Engine::Core::Ecs
+{
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+/**
+ * @brief Index of an entity record with the generation it was created in
+ *
+ * The generation is bumped when an entity is destroyed, so handles kept after that are detected
+ * as dead even when the index is reused.
+ */
+struct Entity
+{
+  u32 index;
+  u32 generation;
+
+  static constexpr Entity Invalid() noexcept;
+
+  constexpr bool operator==(const Entity& e) const noexcept;
+  constexpr bool operator!=(const Entity& e) const noexcept;
+};
+
+/* --------------------------------------- Implementation -------------------------------------- */
+constexpr Entity Entity::Invalid() noexcept
+{
+  return Entity{~u32(0), 0};
+}
+
+constexpr bool Entity::operator==(const Entity& e) const noexcept
+{
+  return index == e.index && generation == e.generation;
+}
+
+constexpr bool Entity::operator!=(const Entity& e) const noexcept
+{
+  return !(*this == e);
+}
+
+} // namespace Engine::Core::Ecs
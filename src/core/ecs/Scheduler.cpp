@@ -0,0 +1,76 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Scheduler.cpp
+ * @brief Implementation of system staging and execution
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include "core/ecs/Scheduler.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace Engine::Core::Ecs
+{
+
+void Scheduler::Run(World& world) noexcept
+{
+  Run(world, nullptr);
+}
+
+void Scheduler::Run(World& world, Parallel::ThreadPool& pool) noexcept
+{
+  Run(world, &pool);
+}
+
+u32 Scheduler::StageCount() const noexcept
+{
+  return static_cast<u32>(stages.size());
+}
+
+u32 Scheduler::StageOf(u32 index) const noexcept
+{
+  assert(index < stageOf.size() && "Invalid system index");
+  return stageOf[index];
+}
+
+void Scheduler::AddSystem(System&& system) noexcept
+{
+  u32 stage = 0;
+  for (std::size_t i = 0; i < systems.size(); ++i) {
+    const System& other = systems[i];
+    bool conflict = (system.writes & (other.reads | other.writes)) != 0 ||
+                    (system.reads & other.writes) != 0;
+    if (conflict)
+      stage = std::max(stage, stageOf[i] + 1);
+  }
+
+  if (stage == stages.size())
+    stages.emplace_back();
+  stages[stage].push_back(static_cast<u32>(systems.size()));
+  stageOf.push_back(stage);
+  systems.push_back(std::move(system));
+}
+
+void Scheduler::Run(World& world, Parallel::ThreadPool* pool) noexcept
+{
+  for (const std::vector<u32>& stage : stages) {
+    auto run = [this, &world, &stage](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i) {
+        System& system = systems[stage[i]];
+        system.run(world, system.commands);
+      }
+    };
+    if (pool && stage.size() > 1)
+      pool->ParallelFor(stage.size(), 1, run);
+    else
+      run(0, stage.size());
+
+    for (u32 index : stage)
+      systems[index].commands.Playback(world);
+  }
+}
+
+} // namespace Engine::Core::Ecs
@@ -0,0 +1,74 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Scheduler.h
+ * @brief Ordered systems run in parallel stages derived from their component accesses
+ *
+ * A system declares the components it reads (const types) and writes (mutable types). Systems
+ * conflict when one writes a component the other reads or writes. Every system is placed in the
+ * stage after the last earlier system it conflicts with, so systems of one stage run concurrently
+ * while the result matches running all systems one by one in the order they were added. Command
+ * buffers of a stage are played back in system order after the stage.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/ecs/CommandBuffer.h"
+#include "core/ecs/Component.h"
+#include "core/ecs/World.h"
+#include "core/parallel/ThreadPool.h"
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace Engine::Core::Ecs
+{
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+class Scheduler
+{
+ public:
+  /**
+   * @brief Appends system func(World&, CommandBuffer&)
+   * @tparam C components accessed by the system, const for read only access
+   */
+  template <typename... C, typename Func>
+  void Add(Func&& func) noexcept;
+
+  void Run(World& world) noexcept;
+  void Run(World& world, Parallel::ThreadPool& pool) noexcept;
+
+  u32 StageCount() const noexcept;
+  /// Stage of the index-th added system
+  u32 StageOf(u32 index) const noexcept;
+
+ private:
+  struct System
+  {
+    ComponentMask reads;
+    ComponentMask writes;
+    std::function<void(World&, CommandBuffer&)> run;
+    CommandBuffer commands;
+  };
+
+  void AddSystem(System&& system) noexcept;
+  void Run(World& world, Parallel::ThreadPool* pool) noexcept;
+
+  std::vector<System> systems;
+  std::vector<u32> stageOf;
+  /// Systems of every stage in the order they were added
+  std::vector<std::vector<u32>> stages;
+};
+
+/* --------------------------------------- Implementation -------------------------------------- */
+template <typename... C, typename Func>
+void Scheduler::Add(Func&& func) noexcept
+{
+  AddSystem(System{ReadMaskOf<C...>(), WriteMaskOf<C...>(), std::forward<Func>(func), {}});
+}
+
+} // namespace Engine::Core::Ecs
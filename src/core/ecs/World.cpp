@@ -0,0 +1,260 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file World.cpp
+ * @brief Implementation of archetype and chunk management
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include "core/ecs/World.h"
+
+#include "core/memory/AlignedAllocator.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Engine::Core::Ecs
+{
+
+namespace
+{
+
+using ChunkAllocator = Memory::AlignedAllocator<u8>;
+
+u32 AlignUp(u32 value, u32 alignment) noexcept
+{
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+/// Column offsets for capacity rows, returns total bytes used
+u32 Layout(const std::vector<ComponentId>& components, u32 capacity, std::vector<u32>& offsets)
+    noexcept
+{
+  u32 offset = capacity * static_cast<u32>(sizeof(Entity));
+  offsets.clear();
+  for (ComponentId id : components) {
+    const ComponentInfo& info = GetComponentInfo(id);
+    offset = AlignUp(offset, info.alignment);
+    offsets.push_back(offset);
+    offset += capacity * info.size;
+  }
+  return offset;
+}
+
+} // namespace
+
+World::World() noexcept
+    : count(0)
+{
+  FindArchetype(0);
+}
+
+World::~World() noexcept
+{
+  ChunkAllocator allocator;
+  for (Internal::Archetype& archetype : archetypes) {
+    for (Internal::Chunk& chunk : archetype.chunks)
+      allocator.deallocate(chunk.data, WorldSettings::chunkSize);
+  }
+  for (u8* data : freeChunks)
+    allocator.deallocate(data, WorldSettings::chunkSize);
+}
+
+Entity World::Create() noexcept
+{
+  Entity entity = NewEntity();
+  AllocateRow(entity, 0);
+  return entity;
+}
+
+void World::Destroy(Entity entity) noexcept
+{
+  assert(IsAlive(entity) && "Dead entity");
+  if (!IsAlive(entity))
+    return;
+
+  Record& record = records[entity.index];
+  FreeRow(record);
+  record.archetype = invalidIndex;
+  ++record.generation;
+  freeRecords.push_back(entity.index);
+  --count;
+}
+
+bool World::IsAlive(Entity entity) const noexcept
+{
+  return entity.index < records.size() && records[entity.index].generation == entity.generation &&
+         records[entity.index].archetype != invalidIndex;
+}
+
+u32 World::Size() const noexcept
+{
+  return count;
+}
+
+void World::AddComponent(Entity entity, ComponentId id, const void* data) noexcept
+{
+  assert(IsAlive(entity) && "Dead entity");
+  if (!IsAlive(entity))
+    return;
+
+  ComponentMask mask = archetypes[records[entity.index].archetype].mask;
+  ComponentMask bit = ComponentMask(1) << id;
+  if ((mask & bit) == 0)
+    MoveEntity(entity, mask | bit);
+  std::memcpy(ComponentData(records[entity.index], id), data, GetComponentInfo(id).size);
+}
+
+void World::RemoveComponent(Entity entity, ComponentId id) noexcept
+{
+  assert(IsAlive(entity) && "Dead entity");
+  if (!IsAlive(entity))
+    return;
+
+  ComponentMask mask = archetypes[records[entity.index].archetype].mask;
+  ComponentMask bit = ComponentMask(1) << id;
+  if ((mask & bit) != 0)
+    MoveEntity(entity, mask & ~bit);
+}
+
+u32 World::ArchetypeCount() const noexcept
+{
+  return static_cast<u32>(archetypes.size());
+}
+
+u32 World::FindArchetype(ComponentMask mask) noexcept
+{
+  auto found = archetypeByMask.find(mask);
+  if (found != archetypeByMask.end())
+    return found->second;
+
+  Internal::Archetype archetype;
+  archetype.mask = mask;
+  archetype.count = 0;
+  std::fill(std::begin(archetype.columns), std::end(archetype.columns), archetype.noColumn);
+
+  u32 rowSize = sizeof(Entity);
+  for (ComponentId id = 0; id < ComponentSettings::maxComponents; ++id) {
+    if ((mask & (ComponentMask(1) << id)) == 0)
+      continue;
+    archetype.columns[id] = static_cast<u8>(archetype.components.size());
+    archetype.components.push_back(id);
+    rowSize += GetComponentInfo(id).size;
+  }
+
+  // padding between columns may not fit the estimate, shrink until the layout does
+  u32 capacity = static_cast<u32>(WorldSettings::chunkSize) / rowSize;
+  while (capacity > 1 && Layout(archetype.components, capacity, archetype.offsets) >
+                             WorldSettings::chunkSize)
+    --capacity;
+  assert(capacity > 0 && "Components do not fit in a chunk");
+  archetype.capacity = std::max<u32>(capacity, 1);
+  Layout(archetype.components, archetype.capacity, archetype.offsets);
+
+  u32 index = static_cast<u32>(archetypes.size());
+  archetypes.push_back(std::move(archetype));
+  archetypeByMask.emplace(mask, index);
+  return index;
+}
+
+void World::AllocateRow(Entity entity, u32 archetypeIndex) noexcept
+{
+  Internal::Archetype& archetype = archetypes[archetypeIndex];
+  if (archetype.chunks.empty() || archetype.chunks.back().count == archetype.capacity) {
+    u8* data;
+    if (!freeChunks.empty()) {
+      data = freeChunks.back();
+      freeChunks.pop_back();
+    } else {
+      data = ChunkAllocator().allocate(WorldSettings::chunkSize);
+    }
+    archetype.chunks.push_back(Internal::Chunk{data, 0});
+  }
+
+  Internal::Chunk& chunk = archetype.chunks.back();
+  u32 row = chunk.count++;
+  ++archetype.count;
+  reinterpret_cast<Entity*>(chunk.data)[row] = entity;
+
+  Record& record = records[entity.index];
+  record.archetype = archetypeIndex;
+  record.chunk = static_cast<u32>(archetype.chunks.size()) - 1;
+  record.row = row;
+}
+
+void World::FreeRow(const Record& record) noexcept
+{
+  Internal::Archetype& archetype = archetypes[record.archetype];
+  Internal::Chunk& last = archetype.chunks.back();
+  Internal::Chunk& chunk = archetype.chunks[record.chunk];
+  u32 lastRow = last.count - 1;
+
+  if (&chunk != &last || record.row != lastRow) {
+    Entity* lastEntities = reinterpret_cast<Entity*>(last.data);
+    Entity moved = lastEntities[lastRow];
+    reinterpret_cast<Entity*>(chunk.data)[record.row] = moved;
+    for (std::size_t column = 0; column < archetype.components.size(); ++column) {
+      u32 size = GetComponentInfo(archetype.components[column]).size;
+      u32 offset = archetype.offsets[column];
+      std::memcpy(
+          chunk.data + offset + record.row * size, last.data + offset + lastRow * size, size
+      );
+    }
+    Record& movedRecord = records[moved.index];
+    movedRecord.chunk = record.chunk;
+    movedRecord.row = record.row;
+  }
+
+  --last.count;
+  --archetype.count;
+  if (last.count == 0) {
+    freeChunks.push_back(last.data);
+    archetype.chunks.pop_back();
+  }
+}
+
+void World::MoveEntity(Entity entity, ComponentMask mask) noexcept
+{
+  Record source = records[entity.index];
+  u32 target = FindArchetype(mask);
+  AllocateRow(entity, target);
+  const Record& destination = records[entity.index];
+
+  // FindArchetype may have grown the archetype array, so references are taken after it
+  const Internal::Archetype& from = archetypes[source.archetype];
+  ComponentMask shared = from.mask & mask;
+  for (ComponentId id : from.components) {
+    if ((shared & (ComponentMask(1) << id)) != 0)
+      std::memcpy(
+          ComponentData(destination, id), ComponentData(source, id), GetComponentInfo(id).size
+      );
+  }
+
+  // the record already points to the new row, so FreeRow only relocates some other entity
+  FreeRow(source);
+}
+
+void* World::ComponentData(const Record& record, ComponentId id) const noexcept
+{
+  const Internal::Archetype& archetype = archetypes[record.archetype];
+  u8 column = archetype.columns[id];
+  assert(column != Internal::Archetype::noColumn && "Component is not in the archetype");
+  const Internal::Chunk& chunk = archetype.chunks[record.chunk];
+  u32 size = GetComponentInfo(id).size;
+  return chunk.data + archetype.offsets[column] + record.row * size;
+}
+
+Entity World::NewEntity() noexcept
+{
+  ++count;
+  if (!freeRecords.empty()) {
+    u32 index = freeRecords.back();
+    freeRecords.pop_back();
+    return Entity{index, records[index].generation};
+  }
+  records.push_back(Record{0, invalidIndex, 0, 0});
+  return Entity{static_cast<u32>(records.size()) - 1, 0};
+}
+
+} // namespace Engine::Core::Ecs
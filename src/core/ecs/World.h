@@ -0,0 +1,312 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file World.h
+ * @brief Archetype based entity storage with chunked SoA component columns
+ *
+ * Entities with the same set of components share an archetype. An archetype stores its entities in
+ * fixed size chunks, and a chunk keeps every component in its own contiguous column, so a query
+ * walks plain arrays chunk by chunk. Chunks stay densely packed: removing an entity moves the last
+ * entity of the archetype into its row. Adding or removing a component moves the entity into the
+ * archetype of the new set. Structural changes invalidate component pointers and must not happen
+ * during iteration; systems record them into a CommandBuffer instead.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/ecs/Component.h"
+#include "core/ecs/Entity.h"
+#include "core/parallel/ThreadPool.h"
+
+#include <bitset>
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine::Core::Ecs
+{
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+struct WorldSettings
+{
+  /// Bytes of one chunk including the entity column
+  static constexpr std::size_t chunkSize = 16 * 1024;
+};
+
+namespace Internal
+{
+
+struct Chunk
+{
+  u8* data;
+  u32 count;
+};
+
+struct Archetype
+{
+  static constexpr u8 noColumn = 0xff;
+
+  ComponentMask mask;
+  /// Rows of one chunk
+  u32 capacity;
+  /// Entities in all chunks, all chunks but the last are full
+  u32 count;
+  std::vector<ComponentId> components;
+  /// Byte offset of every component column in a chunk, parallel to components
+  std::vector<u32> offsets;
+  /// Index in components for every component id or noColumn
+  u8 columns[ComponentSettings::maxComponents];
+  std::vector<Chunk> chunks;
+};
+
+} // namespace Internal
+
+/**
+ * @brief Entities and components of one chunk handed to query callbacks
+ */
+class ChunkView
+{
+ public:
+  ChunkView(const Internal::Archetype& archetype, const Internal::Chunk& chunk) noexcept;
+
+  u32 Size() const noexcept;
+  const Entity* Entities() const noexcept;
+  /// Column of component C, C must be part of the query
+  template <typename C>
+  C* Column() const noexcept;
+
+ private:
+  const Internal::Archetype* archetype;
+  u8* data;
+  u32 count;
+};
+
+class World
+{
+ public:
+  World() noexcept;
+  ~World() noexcept;
+
+  World(const World&) = delete;
+  World& operator=(const World&) = delete;
+
+  Entity Create() noexcept;
+  template <typename... C>
+  Entity Create(const C&... components) noexcept;
+  void Destroy(Entity entity) noexcept;
+  bool IsAlive(Entity entity) const noexcept;
+  /// Number of alive entities
+  u32 Size() const noexcept;
+
+  /// Adds component or overwrites the existing one
+  template <typename C>
+  void Add(Entity entity, const C& component) noexcept;
+  template <typename C>
+  void Remove(Entity entity) noexcept;
+  template <typename C>
+  bool Has(Entity entity) const noexcept;
+  /// Component of entity or nullptr when it has none, valid until the next structural change
+  template <typename C>
+  C* Get(Entity entity) noexcept;
+
+  /// Type erased forms used by command buffers
+  void AddComponent(Entity entity, ComponentId id, const void* data) noexcept;
+  void RemoveComponent(Entity entity, ComponentId id) noexcept;
+
+  /// Calls func(ChunkView&) for every nonempty chunk holding all components C
+  template <typename... C, typename Func>
+  void ForEachChunk(Func&& func) noexcept;
+  /// Distributes chunks between threads, func must be safe to call concurrently
+  template <typename... C, typename Func>
+  void ForEachChunk(Func&& func, Parallel::ThreadPool& pool) noexcept;
+
+  /// Calls func(C&...) for every entity holding all components C
+  template <typename... C, typename Func>
+  void ForEach(Func&& func) noexcept;
+  template <typename... C, typename Func>
+  void ForEach(Func&& func, Parallel::ThreadPool& pool) noexcept;
+
+  /// Number of archetypes created so far including the empty one
+  u32 ArchetypeCount() const noexcept;
+
+ private:
+  static constexpr u32 invalidIndex = ~u32(0);
+
+  struct Record
+  {
+    u32 generation;
+    u32 archetype;
+    u32 chunk;
+    u32 row;
+  };
+
+  u32 FindArchetype(ComponentMask mask) noexcept;
+  /// Places entity into a new row of archetype and updates its record
+  void AllocateRow(Entity entity, u32 archetype) noexcept;
+  /// Fills the row of record with the last entity of its archetype
+  void FreeRow(const Record& record) noexcept;
+  /// Moves entity into the archetype of mask keeping its shared components
+  void MoveEntity(Entity entity, ComponentMask mask) noexcept;
+  void* ComponentData(const Record& record, ComponentId id) const noexcept;
+  Entity NewEntity() noexcept;
+
+  template <typename Func>
+  void ForEachMatchingChunk(ComponentMask mask, Func&& func) noexcept;
+
+  std::vector<Internal::Archetype> archetypes;
+  std::unordered_map<ComponentMask, u32> archetypeByMask;
+  std::vector<Record> records;
+  std::vector<u32> freeRecords;
+  std::vector<u8*> freeChunks;
+  u32 count;
+};
+
+/* --------------------------------------- Implementation -------------------------------------- */
+namespace Internal
+{
+
+template <typename Func, typename... P>
+void ForEachRow(u32 count, Func& func, P*... columns) noexcept
+{
+  for (u32 i = 0; i < count; ++i)
+    func(columns[i]...);
+}
+
+} // namespace Internal
+
+inline ChunkView::ChunkView(
+    const Internal::Archetype& archetype,
+    const Internal::Chunk& chunk
+) noexcept
+    : archetype(&archetype),
+      data(chunk.data),
+      count(chunk.count)
+{
+}
+
+inline u32 ChunkView::Size() const noexcept
+{
+  return count;
+}
+
+inline const Entity* ChunkView::Entities() const noexcept
+{
+  return reinterpret_cast<const Entity*>(data);
+}
+
+template <typename C>
+C* ChunkView::Column() const noexcept
+{
+  u8 column = archetype->columns[ComponentTypeId<C>()];
+  assert(column != Internal::Archetype::noColumn && "Component is not in the chunk");
+  return std::launder(reinterpret_cast<C*>(data + archetype->offsets[column]));
+}
+
+template <typename... C>
+Entity World::Create(const C&... components) noexcept
+{
+  ComponentMask mask = ComponentMaskOf<C...>();
+  assert(std::bitset<64>(mask).count() == sizeof...(C) && "Repeated component");
+
+  Entity entity = NewEntity();
+  AllocateRow(entity, FindArchetype(mask));
+  const Record& record = records[entity.index];
+  (new (ComponentData(record, ComponentTypeId<C>())) C(components), ...);
+  return entity;
+}
+
+template <typename C>
+void World::Add(Entity entity, const C& component) noexcept
+{
+  AddComponent(entity, ComponentTypeId<C>(), &component);
+}
+
+template <typename C>
+void World::Remove(Entity entity) noexcept
+{
+  RemoveComponent(entity, ComponentTypeId<C>());
+}
+
+template <typename C>
+bool World::Has(Entity entity) const noexcept
+{
+  if (!IsAlive(entity))
+    return false;
+  return (archetypes[records[entity.index].archetype].mask & ComponentMaskOf<C>()) != 0;
+}
+
+template <typename C>
+C* World::Get(Entity entity) noexcept
+{
+  if (!Has<C>(entity))
+    return nullptr;
+  return std::launder(static_cast<C*>(ComponentData(records[entity.index], ComponentTypeId<C>())));
+}
+
+template <typename Func>
+void World::ForEachMatchingChunk(ComponentMask mask, Func&& func) noexcept
+{
+  for (const Internal::Archetype& archetype : archetypes) {
+    if ((archetype.mask & mask) != mask)
+      continue;
+    for (const Internal::Chunk& chunk : archetype.chunks) {
+      if (chunk.count != 0)
+        func(archetype, chunk);
+    }
+  }
+}
+
+template <typename... C, typename Func>
+void World::ForEachChunk(Func&& func) noexcept
+{
+  ForEachMatchingChunk(
+      ComponentMaskOf<C...>(),
+      [&func](const Internal::Archetype& archetype, const Internal::Chunk& chunk) {
+        ChunkView view(archetype, chunk);
+        func(view);
+      }
+  );
+}
+
+template <typename... C, typename Func>
+void World::ForEachChunk(Func&& func, Parallel::ThreadPool& pool) noexcept
+{
+  std::vector<ChunkView> views;
+  ForEachMatchingChunk(
+      ComponentMaskOf<C...>(),
+      [&views](const Internal::Archetype& archetype, const Internal::Chunk& chunk) {
+        views.emplace_back(archetype, chunk);
+      }
+  );
+  pool.ParallelFor(views.size(), 1, [&views, &func](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i)
+      func(views[i]);
+  });
+}
+
+template <typename... C, typename Func>
+void World::ForEach(Func&& func) noexcept
+{
+  ForEachChunk<C...>([&func](const ChunkView& view) {
+    Internal::ForEachRow(view.Size(), func, view.template Column<C>()...);
+  });
+}
+
+template <typename... C, typename Func>
+void World::ForEach(Func&& func, Parallel::ThreadPool& pool) noexcept
+{
+  ForEachChunk<C...>(
+      [&func](const ChunkView& view) {
+        Internal::ForEachRow(view.Size(), func, view.template Column<C>()...);
+      },
+      pool
+  );
+}
+
+} // namespace Engine::Core::Ecs
@@ -0,0 +1,10 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file DistanceField.cpp
+ * @brief All implementation contains in header file DistanceField.h
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include "core/geometry/DistanceField.h"
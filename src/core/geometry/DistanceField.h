@@ -0,0 +1,827 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file DistanceField.h
+ * @brief Signed distance field of a triangle mesh sampled on a grid of bricks
+ *
+ * DistanceField samples the signed distance to a closed mesh, negative inside, at the corners of
+ * a regular grid of voxels. Distance and gradient queries interpolate the eight samples of the
+ * voxel around the point, so a clearance check costs a few loads instead of a search over the
+ * triangles.
+ *
+ * The grid is split into bricks of brickSize^3 voxels. Every brick stores its own
+ * (brickSize + 1)^3 samples, samples on the faces between bricks are duplicated, so the eight
+ * samples of a voxel lie in one small contiguous block. A dense field keeps every brick. A sparse
+ * field clamps distances to a narrow band around the surface and keeps a single value for the
+ * bricks entirely outside the band, which are most of them for a fine grid.
+ *
+ * Build finds the closest triangle of every sample by jump flooding (Rong and Tan, "Jump
+ * Flooding in GPU with Applications to Voronoi Diagram and Distance Transform"). Samples within a
+ * voxel of a triangle are seeded with exact distances, then passes with halving steps let every
+ * sample adopt the closest triangle known to the 26 samples one step away, and a last pass with
+ * step one repairs most of the remaining errors. A pass only reads the result of the previous
+ * one, so the parallel form runs grid slices concurrently and matches the serial result. The
+ * sign comes from the angle weighted pseudo normal of the closest feature (Baerentzen and Aanaes,
+ * "Signed Distance Computation Using the Angle Weighted Pseudonormal"), which is exact for a
+ * closed, welded and consistently oriented mesh. The grid is built densely either way, a sparse
+ * field only saves memory and cache once built.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/container/FlatHashMap.h"
+#include "core/container/Hash.h"
+#include "core/geometry/Mesh.h"
+#include "core/math/AABB.h"
+#include "core/math/Vector3.h"
+#include "core/parallel/ThreadPool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace Engine::Core::Geometry
+{
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+struct DistanceFieldSettings
+{
+  /// Voxels along every edge of a brick
+  static constexpr u32 brickSize = 8;
+  /// Default number of queries per parallel task
+  static constexpr std::size_t grain = 1024;
+};
+
+template <typename T>
+struct DistanceFieldOptions
+{
+  /// Edge length of a voxel, the spacing of the samples
+  T voxelSize = 1;
+  /// Space around the bounds of the mesh covered by the field
+  T padding = 0;
+  /// Zero builds a dense field, otherwise distances are clamped to [-narrowBand, narrowBand] and
+  /// bricks entirely outside the band keep a single value
+  T narrowBand = 0;
+};
+
+template <typename T>
+class DistanceField
+{
+ public:
+  static constexpr u32 brickSize = DistanceFieldSettings::brickSize;
+
+  DistanceField() noexcept = default;
+
+  /**
+   * @brief Samples the signed distance to mesh, previous content is dropped
+   *
+   * The mesh is expected closed, welded and wound counterclockwise seen from outside. Triangles
+   * of zero area are ignored.
+   * @return false when mesh has no triangle of positive area, the field is empty then
+   */
+  bool Build(const Mesh<T>& mesh, const DistanceFieldOptions<T>& options) noexcept;
+  bool Build(
+      const Mesh<T>& mesh,
+      const DistanceFieldOptions<T>& options,
+      Parallel::ThreadPool& pool
+  ) noexcept;
+  void Clear() noexcept;
+
+  bool Empty() const noexcept;
+  bool IsSparse() const noexcept;
+  /// Box covered by the samples, the padded mesh bounds grown to whole bricks
+  const Math::AABB<T>& Bounds() const noexcept;
+  T VoxelSize() const noexcept;
+  std::size_t BrickCount() const noexcept;
+  /// Bricks holding samples, all of them for a dense field
+  std::size_t StoredBrickCount() const noexcept;
+
+  /**
+   * @brief Trilinear interpolation of the sampled distance
+   *
+   * A point outside Bounds() gets the value at the closest point of the box plus the distance to
+   * that point. A NaN coordinate gives NaN.
+   */
+  T Sample(const Math::Vector3<T>& point) const noexcept;
+  /// Gradient of Sample, close to the unit vector pointing away from the surface
+  Math::Vector3<T> Gradient(const Math::Vector3<T>& point) const noexcept;
+
+  /**
+   * @brief Batch form writing out[i] = Sample(points[i])
+   *
+   * A convenience loop over the scalar query. The eight samples of a point are loaded from its
+   * own brick, so the cost is in those loads and lane-wise arithmetic would not shorten it. The
+   * parallel form splits the points over the pool.
+   */
+  void Sample(const Math::Vector3<T>* points, T* out, std::size_t count) const noexcept;
+  void Sample(
+      const Math::Vector3<T>* points,
+      T* out,
+      std::size_t count,
+      Parallel::ThreadPool& pool,
+      std::size_t grain = DistanceFieldSettings::grain
+  ) const noexcept;
+  /// Batch form writing out[i] = Gradient(points[i]), a convenience loop as the batch Sample
+  void Gradient(
+      const Math::Vector3<T>* points,
+      Math::Vector3<T>* out,
+      std::size_t count
+  ) const noexcept;
+  void Gradient(
+      const Math::Vector3<T>* points,
+      Math::Vector3<T>* out,
+      std::size_t count,
+      Parallel::ThreadPool& pool,
+      std::size_t grain = DistanceFieldSettings::grain
+  ) const noexcept;
+
+ private:
+  static constexpr u32 brickSamples = (brickSize + 1) * (brickSize + 1) * (brickSize + 1);
+  static constexpr u32 none = ~u32(0);
+
+  /// Voxel around a point of the box
+  struct Cell
+  {
+    /// First of the eight samples, null inside a brick stored as one value
+    const T* samples;
+    T value;
+    T fx;
+    T fy;
+    T fz;
+  };
+
+  Math::Vector3<T> ClosestInBounds(const Math::Vector3<T>& point) const noexcept;
+  Cell Locate(const Math::Vector3<T>& point) const noexcept;
+  void SampleRange(const Math::Vector3<T>* points, T* out, std::size_t count) const noexcept;
+  void GradientRange(
+      const Math::Vector3<T>* points,
+      Math::Vector3<T>* out,
+      std::size_t count
+  ) const noexcept;
+
+  /// parallelFor(count, func) calls func(begin, end) over ranges covering [0, count)
+  template <typename For>
+  bool BuildField(
+      const Mesh<T>& mesh,
+      const DistanceFieldOptions<T>& options,
+      For&& parallelFor
+  ) noexcept;
+
+  Math::AABB<T> bounds;
+  T voxelSize = 0;
+  T narrowBand = 0;
+  u32 bricksX = 0;
+  u32 bricksY = 0;
+  u32 bricksZ = 0;
+  /// Slot of every brick in samples, none for a brick stored as one value
+  std::vector<u32> brickSlots;
+  /// Value of every brick without samples
+  std::vector<T> brickValues;
+  /// brickSamples samples per slot, x varies fastest
+  std::vector<T> samples;
+};
+
+/* ------------------------------------------- Usings ------------------------------------------ */
+using DistanceFieldf = DistanceField<f32>;
+using DistanceFieldd = DistanceField<f64>;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+namespace Internal
+{
+
+/// Part of a triangle holding its closest point, edges are numbered by their first corner
+enum class TriangleFeature : u8
+{
+  Vertex0,
+  Vertex1,
+  Vertex2,
+  Edge01,
+  Edge12,
+  Edge20,
+  Face
+};
+
+/// Closest point of triangle abc to p, from "Real-Time Collision Detection" by Christer Ericson
+template <typename T>
+Math::Vector3<T> ClosestPointOnTriangle(
+    const Math::Vector3<T>& p,
+    const Math::Vector3<T>& a,
+    const Math::Vector3<T>& b,
+    const Math::Vector3<T>& c,
+    TriangleFeature& feature
+) noexcept
+{
+  Math::Vector3<T> ab = b - a;
+  Math::Vector3<T> ac = c - a;
+  Math::Vector3<T> ap = p - a;
+  T d1 = ab.Dot(ap);
+  T d2 = ac.Dot(ap);
+  if (d1 <= 0 && d2 <= 0) {
+    feature = TriangleFeature::Vertex0;
+    return a;
+  }
+  Math::Vector3<T> bp = p - b;
+  T d3 = ab.Dot(bp);
+  T d4 = ac.Dot(bp);
+  if (d3 >= 0 && d4 <= d3) {
+    feature = TriangleFeature::Vertex1;
+    return b;
+  }
+  T vc = d1 * d4 - d3 * d2;
+  if (vc <= 0 && d1 >= 0 && d3 <= 0) {
+    feature = TriangleFeature::Edge01;
+    return a + ab * (d1 / (d1 - d3));
+  }
+  Math::Vector3<T> cp = p - c;
+  T d5 = ab.Dot(cp);
+  T d6 = ac.Dot(cp);
+  if (d6 >= 0 && d5 <= d6) {
+    feature = TriangleFeature::Vertex2;
+    return c;
+  }
+  T vb = d5 * d2 - d1 * d6;
+  if (vb <= 0 && d2 >= 0 && d6 <= 0) {
+    feature = TriangleFeature::Edge20;
+    return a + ac * (d2 / (d2 - d6));
+  }
+  T va = d3 * d6 - d5 * d4;
+  if (va <= 0 && d4 - d3 >= 0 && d5 - d6 >= 0) {
+    feature = TriangleFeature::Edge12;
+    return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+  }
+  T scale = 1 / (va + vb + vc);
+  feature = TriangleFeature::Face;
+  return a + ab * (vb * scale) + ac * (vc * scale);
+}
+
+/// Triangles of positive area with the pseudo normals of their features
+template <typename T>
+struct DistanceTriangles
+{
+  static constexpr u32 featureCount = 7;
+
+  /// Three corners per triangle
+  std::vector<Math::Vector3<T>> corners;
+  /// featureCount normals per triangle, indexed by TriangleFeature
+  std::vector<Math::Vector3<T>> pseudoNormals;
+
+  /// @return false when mesh has no triangle of positive area
+  bool Build(const Mesh<T>& mesh) noexcept;
+  std::size_t Size() const noexcept;
+  T DistanceSquared(u32 triangle, const Math::Vector3<T>& p) const noexcept;
+  T SignedDistance(u32 triangle, const Math::Vector3<T>& p) const noexcept;
+};
+
+template <typename T>
+bool DistanceTriangles<T>::Build(const Mesh<T>& mesh) noexcept
+{
+  using Math::Vector3;
+  std::size_t vertexCount = mesh.VertexCount();
+  std::size_t triangleCount = mesh.TriangleCount();
+  std::vector<u32> kept;
+  std::vector<Vector3<T>> faceNormals;
+  std::vector<Vector3<T>> vertexNormals(vertexCount);
+  Container::FlatHashMap<u64, Vector3<T>> edgeNormals(static_cast<u32>(3 * triangleCount));
+  corners.clear();
+  for (std::size_t t = 0; t < triangleCount; ++t) {
+    const u32* triangle = mesh.indices.data() + 3 * t;
+    if (triangle[0] >= vertexCount || triangle[1] >= vertexCount || triangle[2] >= vertexCount)
+      continue;
+    Vector3<T> p[3];
+    for (u32 c = 0; c < 3; ++c)
+      p[c] = mesh.positions.Get(triangle[c]);
+    Vector3<T> normal = (p[1] - p[0]).Cross(p[2] - p[0]);
+    T length = normal.Length();
+    if (!(length > 0))
+      continue;
+    normal /= length;
+    kept.insert(kept.end(), triangle, triangle + 3);
+    corners.insert(corners.end(), p, p + 3);
+    faceNormals.push_back(normal);
+    for (u32 c = 0; c < 3; ++c) {
+      Vector3<T> next = p[(c + 1) % 3] - p[c];
+      Vector3<T> previous = p[(c + 2) % 3] - p[c];
+      vertexNormals[triangle[c]] += normal * next.AngleTo(previous);
+      edgeNormals[Container::EdgeKey(triangle[c], triangle[(c + 1) % 3])] += normal;
+    }
+  }
+
+  std::size_t count = faceNormals.size();
+  pseudoNormals.resize(featureCount * count);
+  for (std::size_t t = 0; t < count; ++t) {
+    const u32* triangle = kept.data() + 3 * t;
+    Vector3<T>* normals = pseudoNormals.data() + featureCount * t;
+    for (u32 c = 0; c < 3; ++c) {
+      normals[c] = vertexNormals[triangle[c]];
+      normals[3 + c] = *edgeNormals.Get(Container::EdgeKey(triangle[c], triangle[(c + 1) % 3]));
+    }
+    normals[6] = faceNormals[t];
+  }
+  return count > 0;
+}
+
+template <typename T>
+std::size_t DistanceTriangles<T>::Size() const noexcept
+{
+  return corners.size() / 3;
+}
+
+template <typename T>
+T DistanceTriangles<T>::DistanceSquared(u32 triangle, const Math::Vector3<T>& p) const noexcept
+{
+  const Math::Vector3<T>* c = corners.data() + 3 * std::size_t(triangle);
+  TriangleFeature feature;
+  return (p - ClosestPointOnTriangle(p, c[0], c[1], c[2], feature)).LengthSquared();
+}
+
+template <typename T>
+T DistanceTriangles<T>::SignedDistance(u32 triangle, const Math::Vector3<T>& p) const noexcept
+{
+  const Math::Vector3<T>* c = corners.data() + 3 * std::size_t(triangle);
+  TriangleFeature feature;
+  Math::Vector3<T> offset = p - ClosestPointOnTriangle(p, c[0], c[1], c[2], feature);
+  const Math::Vector3<T>& normal =
+      pseudoNormals[featureCount * std::size_t(triangle) + static_cast<u32>(feature)];
+  T distance = offset.Length();
+  return offset.Dot(normal) < 0 ? -distance : distance;
+}
+
+template <typename T>
+T Lerp(T a, T b, T t) noexcept
+{
+  return a + (b - a) * t;
+}
+
+} // namespace Internal
+
+template <typename T>
+bool DistanceField<T>::Build(const Mesh<T>& mesh, const DistanceFieldOptions<T>& options) noexcept
+{
+  return BuildField(mesh, options, [](std::size_t count, auto&& func) {
+    func(std::size_t(0), count);
+  });
+}
+
+template <typename T>
+bool DistanceField<T>::Build(
+    const Mesh<T>& mesh,
+    const DistanceFieldOptions<T>& options,
+    Parallel::ThreadPool& pool
+) noexcept
+{
+  // slices and bricks are heavy, one per task balances best
+  return BuildField(mesh, options, [&](std::size_t count, auto&& func) {
+    pool.ParallelFor(count, 1, func);
+  });
+}
+
+template <typename T>
+void DistanceField<T>::Clear() noexcept
+{
+  bounds = Math::AABB<T>();
+  voxelSize = 0;
+  narrowBand = 0;
+  bricksX = 0;
+  bricksY = 0;
+  bricksZ = 0;
+  brickSlots.clear();
+  brickValues.clear();
+  samples.clear();
+}
+
+template <typename T>
+bool DistanceField<T>::Empty() const noexcept
+{
+  return brickSlots.empty();
+}
+
+template <typename T>
+bool DistanceField<T>::IsSparse() const noexcept
+{
+  return narrowBand > 0;
+}
+
+template <typename T>
+const Math::AABB<T>& DistanceField<T>::Bounds() const noexcept
+{
+  return bounds;
+}
+
+template <typename T>
+T DistanceField<T>::VoxelSize() const noexcept
+{
+  return voxelSize;
+}
+
+template <typename T>
+std::size_t DistanceField<T>::BrickCount() const noexcept
+{
+  return brickSlots.size();
+}
+
+template <typename T>
+std::size_t DistanceField<T>::StoredBrickCount() const noexcept
+{
+  return samples.size() / brickSamples;
+}
+
+template <typename T>
+T DistanceField<T>::Sample(const Math::Vector3<T>& point) const noexcept
+{
+  assert(!Empty() && "Sampling an empty distance field");
+  if (Empty())
+    return std::numeric_limits<T>::max();
+  Math::Vector3<T> inside = ClosestInBounds(point);
+  Cell cell = Locate(inside);
+  T outside = point.DistanceTo(inside);
+  if (!cell.samples)
+    return cell.value + outside;
+
+  constexpr u32 row = brickSize + 1;
+  constexpr u32 slice = row * row;
+  const T* s = cell.samples;
+  T c00 = Internal::Lerp(s[0], s[1], cell.fx);
+  T c10 = Internal::Lerp(s[row], s[row + 1], cell.fx);
+  T c01 = Internal::Lerp(s[slice], s[slice + 1], cell.fx);
+  T c11 = Internal::Lerp(s[slice + row], s[slice + row + 1], cell.fx);
+  T c0 = Internal::Lerp(c00, c10, cell.fy);
+  T c1 = Internal::Lerp(c01, c11, cell.fy);
+  return Internal::Lerp(c0, c1, cell.fz) + outside;
+}
+
+template <typename T>
+Math::Vector3<T> DistanceField<T>::Gradient(const Math::Vector3<T>& point) const noexcept
+{
+  assert(!Empty() && "Sampling an empty distance field");
+  if (Empty())
+    return Math::Vector3<T>();
+  Math::Vector3<T> inside = ClosestInBounds(point);
+  Cell cell = Locate(inside);
+  Math::Vector3<T> gradient;
+  if (cell.samples) {
+    constexpr u32 row = brickSize + 1;
+    constexpr u32 slice = row * row;
+    const T* s = cell.samples;
+    T c00 = Internal::Lerp(s[0], s[1], cell.fx);
+    T c10 = Internal::Lerp(s[row], s[row + 1], cell.fx);
+    T c01 = Internal::Lerp(s[slice], s[slice + 1], cell.fx);
+    T c11 = Internal::Lerp(s[slice + row], s[slice + row + 1], cell.fx);
+    T dx0 = Internal::Lerp(s[1] - s[0], s[row + 1] - s[row], cell.fy);
+    T dx1 = Internal::Lerp(
+        s[slice + 1] - s[slice], s[slice + row + 1] - s[slice + row], cell.fy
+    );
+    gradient.x = Internal::Lerp(dx0, dx1, cell.fz) / voxelSize;
+    gradient.y = Internal::Lerp(c10 - c00, c11 - c01, cell.fz) / voxelSize;
+    gradient.z = (Internal::Lerp(c01, c11, cell.fy) - Internal::Lerp(c00, c10, cell.fy)) /
+                 voxelSize;
+  }
+
+  // outside the box the distance to it grows along the axes the point was clamped on
+  Math::Vector3<T> offset = point - inside;
+  T outside = offset.Length();
+  if (outside > 0) {
+    if (offset.x != 0)
+      gradient.x = offset.x / outside;
+    if (offset.y != 0)
+      gradient.y = offset.y / outside;
+    if (offset.z != 0)
+      gradient.z = offset.z / outside;
+  }
+  return gradient;
+}
+
+template <typename T>
+void DistanceField<T>::Sample(
+    const Math::Vector3<T>* points,
+    T* out,
+    std::size_t count
+) const noexcept
+{
+  SampleRange(points, out, count);
+}
+
+template <typename T>
+void DistanceField<T>::Sample(
+    const Math::Vector3<T>* points,
+    T* out,
+    std::size_t count,
+    Parallel::ThreadPool& pool,
+    std::size_t grain
+) const noexcept
+{
+  pool.ParallelFor(count, grain, [&](std::size_t begin, std::size_t end) {
+    SampleRange(points + begin, out + begin, end - begin);
+  });
+}
+
+template <typename T>
+void DistanceField<T>::Gradient(
+    const Math::Vector3<T>* points,
+    Math::Vector3<T>* out,
+    std::size_t count
+) const noexcept
+{
+  GradientRange(points, out, count);
+}
+
+template <typename T>
+void DistanceField<T>::Gradient(
+    const Math::Vector3<T>* points,
+    Math::Vector3<T>* out,
+    std::size_t count,
+    Parallel::ThreadPool& pool,
+    std::size_t grain
+) const noexcept
+{
+  pool.ParallelFor(count, grain, [&](std::size_t begin, std::size_t end) {
+    GradientRange(points + begin, out + begin, end - begin);
+  });
+}
+
+template <typename T>
+Math::Vector3<T> DistanceField<T>::ClosestInBounds(const Math::Vector3<T>& point) const noexcept
+{
+  return Math::Vector3<T>(
+      std::clamp(point.x, bounds.min.x, bounds.max.x),
+      std::clamp(point.y, bounds.min.y, bounds.max.y),
+      std::clamp(point.z, bounds.min.z, bounds.max.z)
+  );
+}
+
+template <typename T>
+typename DistanceField<T>::Cell DistanceField<T>::Locate(
+    const Math::Vector3<T>& point
+) const noexcept
+{
+  T local[3] = {
+      (point.x - bounds.min.x) / voxelSize,
+      (point.y - bounds.min.y) / voxelSize,
+      (point.z - bounds.min.z) / voxelSize,
+  };
+  u32 cells[3] = {bricksX * brickSize, bricksY * brickSize, bricksZ * brickSize};
+  u32 brick[3];
+  u32 voxel[3];
+  T fraction[3];
+  for (u32 axis = 0; axis < 3; ++axis) {
+    // written so that NaN maps to 0, a NaN reaching the cast to u32 would be undefined
+    T coordinate = local[axis] > 0 ? std::min(local[axis], static_cast<T>(cells[axis])) : 0;
+    u32 index = std::min(static_cast<u32>(coordinate), cells[axis] - 1);
+    fraction[axis] = coordinate - static_cast<T>(index);
+    brick[axis] = index / brickSize;
+    voxel[axis] = index % brickSize;
+  }
+
+  std::size_t b = (std::size_t(brick[2]) * bricksY + brick[1]) * bricksX + brick[0];
+  Cell cell{nullptr, brickValues[b], fraction[0], fraction[1], fraction[2]};
+  if (brickSlots[b] != none) {
+    constexpr u32 row = brickSize + 1;
+    cell.samples = samples.data() + std::size_t(brickSlots[b]) * brickSamples +
+                   (voxel[2] * row + voxel[1]) * row + voxel[0];
+  }
+  return cell;
+}
+
+template <typename T>
+void DistanceField<T>::SampleRange(
+    const Math::Vector3<T>* points,
+    T* out,
+    std::size_t count
+) const noexcept
+{
+  for (std::size_t i = 0; i < count; ++i)
+    out[i] = Sample(points[i]);
+}
+
+template <typename T>
+void DistanceField<T>::GradientRange(
+    const Math::Vector3<T>* points,
+    Math::Vector3<T>* out,
+    std::size_t count
+) const noexcept
+{
+  for (std::size_t i = 0; i < count; ++i)
+    out[i] = Gradient(points[i]);
+}
+
+template <typename T>
+template <typename For>
+bool DistanceField<T>::BuildField(
+    const Mesh<T>& mesh,
+    const DistanceFieldOptions<T>& options,
+    For&& parallelFor
+) noexcept
+{
+  using Math::Vector3;
+  Clear();
+  bool valid = options.voxelSize > 0 && options.padding >= 0 && options.narrowBand >= 0;
+  assert(valid && "Distance field needs a positive voxel size");
+  if (!valid)
+    return false;
+  Internal::DistanceTriangles<T> triangles;
+  if (!triangles.Build(mesh))
+    return false;
+
+  Math::AABB<T> box = Math::AABB<T>::Empty();
+  for (const Vector3<T>& corner : triangles.corners)
+    box.Merge(corner);
+  box = box.Expanded(options.padding);
+  T brickExtent = options.voxelSize * static_cast<T>(brickSize);
+  auto bricksAlong = [&](T size) {
+    return std::max(static_cast<u32>(std::ceil(size / brickExtent)), 1u);
+  };
+  Vector3<T> size = box.Size();
+  u32 nx = bricksAlong(size.x);
+  u32 ny = bricksAlong(size.y);
+  u32 nz = bricksAlong(size.z);
+  // samples along every axis
+  std::size_t sx = std::size_t(nx) * brickSize + 1;
+  std::size_t sy = std::size_t(ny) * brickSize + 1;
+  std::size_t sz = std::size_t(nz) * brickSize + 1;
+  std::size_t sampleCount = sx * sy * sz;
+  T voxel = options.voxelSize;
+  Vector3<T> origin = box.min;
+  auto position = [&](std::size_t x, std::size_t y, std::size_t z) {
+    return Vector3<T>(
+        origin.x + static_cast<T>(x) * voxel,
+        origin.y + static_cast<T>(y) * voxel,
+        origin.z + static_cast<T>(z) * voxel
+    );
+  };
+  // samples from the one at or below low to the one above high, clamped to the grid
+  auto sampleRange = [&](T low, T high, T start, std::size_t count, std::size_t& first,
+                         std::size_t& last) {
+    auto below = static_cast<i64>(std::floor((low - start) / voxel));
+    auto above = static_cast<i64>(std::floor((high - start) / voxel)) + 1;
+    first = static_cast<std::size_t>(std::clamp<i64>(below, 0, static_cast<i64>(count) - 1));
+    last = static_cast<std::size_t>(std::clamp<i64>(above, 0, static_cast<i64>(count) - 1));
+  };
+
+  // triangles listed at every slice within a voxel of them, seeding runs per slice
+  std::size_t triangleCount = triangles.Size();
+  std::vector<Math::AABB<T>> triangleBounds(triangleCount);
+  std::vector<u32> sliceOffsets(sz + 1, 0);
+  for (std::size_t t = 0; t < triangleCount; ++t) {
+    const Vector3<T>* c = triangles.corners.data() + 3 * t;
+    triangleBounds[t] = Math::AABB<T>(c[0], c[0]).Merge(c[1]).Merge(c[2]).Expanded(voxel);
+    std::size_t first;
+    std::size_t last;
+    sampleRange(triangleBounds[t].min.z, triangleBounds[t].max.z, origin.z, sz, first, last);
+    for (std::size_t z = first; z <= last; ++z)
+      ++sliceOffsets[z + 1];
+  }
+  for (std::size_t z = 0; z < sz; ++z)
+    sliceOffsets[z + 1] += sliceOffsets[z];
+  std::vector<u32> sliceTriangles(sliceOffsets[sz]);
+  std::vector<u32> cursor(sliceOffsets.begin(), sliceOffsets.end() - 1);
+  for (std::size_t t = 0; t < triangleCount; ++t) {
+    std::size_t first;
+    std::size_t last;
+    sampleRange(triangleBounds[t].min.z, triangleBounds[t].max.z, origin.z, sz, first, last);
+    for (std::size_t z = first; z <= last; ++z)
+      sliceTriangles[cursor[z]++] = static_cast<u32>(t);
+  }
+
+  std::vector<u32> closest(sampleCount, none);
+  std::vector<T> distances(sampleCount, std::numeric_limits<T>::max());
+  parallelFor(sz, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t z = begin; z < end; ++z) {
+      for (u32 k = sliceOffsets[z]; k < sliceOffsets[z + 1]; ++k) {
+        u32 t = sliceTriangles[k];
+        const Math::AABB<T>& b = triangleBounds[t];
+        std::size_t x0;
+        std::size_t x1;
+        std::size_t y0;
+        std::size_t y1;
+        sampleRange(b.min.x, b.max.x, origin.x, sx, x0, x1);
+        sampleRange(b.min.y, b.max.y, origin.y, sy, y0, y1);
+        for (std::size_t y = y0; y <= y1; ++y) {
+          for (std::size_t x = x0; x <= x1; ++x) {
+            std::size_t i = (z * sy + y) * sx + x;
+            T d = triangles.DistanceSquared(t, position(x, y, z));
+            if (d < distances[i]) {
+              distances[i] = d;
+              closest[i] = t;
+            }
+          }
+        }
+      }
+    }
+  });
+
+  // jump flooding from the largest power of two step below the grid size down to one, then one
+  // more pass with step one
+  std::size_t largest = std::max({sx, sy, sz});
+  std::size_t step = 1;
+  while (2 * step < largest)
+    step *= 2;
+  std::vector<u32> nextClosest(sampleCount);
+  std::vector<T> nextDistances(sampleCount);
+  bool repeated = false;
+  while (step > 0) {
+    auto s = static_cast<i64>(step);
+    parallelFor(sz, [&](std::size_t begin, std::size_t end) {
+      for (std::size_t z = begin; z < end; ++z) {
+        for (std::size_t y = 0; y < sy; ++y) {
+          for (std::size_t x = 0; x < sx; ++x) {
+            std::size_t i = (z * sy + y) * sx + x;
+            Vector3<T> p = position(x, y, z);
+            u32 best = closest[i];
+            T bestDistance = distances[i];
+            for (i64 dz = -s; dz <= s; dz += s) {
+              i64 nz = static_cast<i64>(z) + dz;
+              if (nz < 0 || nz >= static_cast<i64>(sz))
+                continue;
+              for (i64 dy = -s; dy <= s; dy += s) {
+                i64 ny = static_cast<i64>(y) + dy;
+                if (ny < 0 || ny >= static_cast<i64>(sy))
+                  continue;
+                for (i64 dx = -s; dx <= s; dx += s) {
+                  i64 nx = static_cast<i64>(x) + dx;
+                  if (nx < 0 || nx >= static_cast<i64>(sx))
+                    continue;
+                  u32 candidate = closest[(std::size_t(nz) * sy + std::size_t(ny)) * sx +
+                                          std::size_t(nx)];
+                  if (candidate == none || candidate == best)
+                    continue;
+                  T d = triangles.DistanceSquared(candidate, p);
+                  if (d < bestDistance) {
+                    best = candidate;
+                    bestDistance = d;
+                  }
+                }
+              }
+            }
+            nextClosest[i] = best;
+            nextDistances[i] = bestDistance;
+          }
+        }
+      }
+    });
+    closest.swap(nextClosest);
+    distances.swap(nextDistances);
+    if (step == 1 && !repeated)
+      repeated = true;
+    else
+      step /= 2;
+  }
+
+  bounds = Math::AABB<T>(origin, position(sx - 1, sy - 1, sz - 1));
+  voxelSize = voxel;
+  narrowBand = options.narrowBand;
+  bricksX = nx;
+  bricksY = ny;
+  bricksZ = nz;
+  std::size_t brickCount = std::size_t(nx) * ny * nz;
+  brickSlots.resize(brickCount);
+  brickValues.assign(brickCount, 0);
+  samples.resize(brickCount * brickSamples);
+  parallelFor(brickCount, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t b = begin; b < end; ++b) {
+      std::size_t bx = b % nx * brickSize;
+      std::size_t by = b / nx % ny * brickSize;
+      std::size_t bz = b / (std::size_t(nx) * ny) * brickSize;
+      T* out = samples.data() + b * brickSamples;
+      for (u32 z = 0; z <= brickSize; ++z) {
+        for (u32 y = 0; y <= brickSize; ++y) {
+          for (u32 x = 0; x <= brickSize; ++x) {
+            std::size_t i = ((bz + z) * sy + by + y) * sx + bx + x;
+            assert(closest[i] != none && "Jump flooding reaches every sample");
+            T d = triangles.SignedDistance(closest[i], position(bx + x, by + y, bz + z));
+            if (narrowBand > 0)
+              d = std::clamp(d, -narrowBand, narrowBand);
+            *out++ = d;
+          }
+        }
+      }
+      brickSlots[b] = static_cast<u32>(b);
+    }
+  });
+
+  if (narrowBand > 0) {
+    // bricks clamped to one value throughout keep that value only
+    u32 slot = 0;
+    for (std::size_t b = 0; b < brickCount; ++b) {
+      const T* block = samples.data() + b * brickSamples;
+      bool uniform = std::abs(block[0]) == narrowBand &&
+                     std::all_of(block, block + brickSamples, [&](T d) { return d == block[0]; });
+      if (uniform) {
+        brickSlots[b] = none;
+        brickValues[b] = block[0];
+        continue;
+      }
+      std::copy(block, block + brickSamples, samples.data() + std::size_t(slot) * brickSamples);
+      brickSlots[b] = slot++;
+    }
+    samples.resize(std::size_t(slot) * brickSamples);
+    samples.shrink_to_fit();
+  }
+  return true;
+}
+
+} // namespace Engine::Core::Geometry
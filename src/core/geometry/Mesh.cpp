@@ -0,0 +1,228 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Mesh.cpp
+ * @brief Implementation of non template part of Mesh class
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include "core/geometry/Mesh.h"
+
+namespace Engine::Core::Geometry
+{
+
+namespace
+{
+
+constexpr u32 none = ~u32(0);
+
+/// Constants of the vertex score in "Linear-Speed Vertex Cache Optimisation"
+constexpr f32 lastTriangleScore = 0.75f;
+constexpr f32 cacheDecayPower = 1.5f;
+constexpr f32 valenceBoostScale = 2.0f;
+constexpr f32 valenceBoostPower = 0.5f;
+constexpr u32 valenceTableSize = 32;
+
+struct ScoreTables
+{
+  f32 cache[MeshSettings::maxCacheSize];
+  f32 valence[valenceTableSize];
+};
+
+void InitScoreTables(ScoreTables& tables, u32 cacheSize) noexcept
+{
+  for (u32 position = 0; position < cacheSize; ++position) {
+    // the vertices of the last triangle score the same, whatever order they were added in
+    if (position < 3) {
+      tables.cache[position] = lastTriangleScore;
+    } else {
+      f32 scale = 1.0f - static_cast<f32>(position - 3) / static_cast<f32>(cacheSize - 3);
+      tables.cache[position] = std::pow(scale, cacheDecayPower);
+    }
+  }
+  tables.valence[0] = 0.0f;
+  for (u32 remaining = 1; remaining < valenceTableSize; ++remaining)
+    tables.valence[remaining] =
+        valenceBoostScale * std::pow(static_cast<f32>(remaining), -valenceBoostPower);
+}
+
+f32 VertexScore(const ScoreTables& tables, i32 cachePosition, u32 remaining) noexcept
+{
+  if (remaining == 0)
+    return -1.0f;
+  f32 score = cachePosition < 0 ? 0.0f : tables.cache[cachePosition];
+  if (remaining < valenceTableSize)
+    return score + tables.valence[remaining];
+  return score + valenceBoostScale * std::pow(static_cast<f32>(remaining), -valenceBoostPower);
+}
+
+bool ValidIndices(const u32* indices, std::size_t indexCount, std::size_t vertexCount) noexcept
+{
+  for (std::size_t i = 0; i < indexCount; ++i) {
+    if (indices[i] >= vertexCount)
+      return false;
+  }
+  return true;
+}
+
+} // namespace
+
+namespace Internal
+{
+
+void VertexTriangles(
+    const u32* indices,
+    std::size_t triangleCount,
+    std::size_t vertexCount,
+    std::vector<u32>& offsets,
+    std::vector<u32>& triangles
+) noexcept
+{
+  offsets.assign(vertexCount + 1, 0);
+  for (std::size_t i = 0; i < 3 * triangleCount; ++i) {
+    if (indices[i] < vertexCount)
+      ++offsets[indices[i] + 1];
+  }
+  for (std::size_t v = 0; v < vertexCount; ++v)
+    offsets[v + 1] += offsets[v];
+
+  triangles.resize(offsets[vertexCount]);
+  std::vector<u32> cursor(offsets.begin(), offsets.end() - 1);
+  for (std::size_t i = 0; i < 3 * triangleCount; ++i) {
+    if (indices[i] < vertexCount)
+      triangles[cursor[indices[i]]++] = static_cast<u32>(i / 3);
+  }
+}
+
+} // namespace Internal
+
+void OptimizeVertexCache(
+    u32* indices,
+    std::size_t indexCount,
+    std::size_t vertexCount,
+    u32 cacheSize
+) noexcept
+{
+  bool valid = indexCount % 3 == 0 && ValidIndices(indices, indexCount, vertexCount);
+  assert(valid && "Indices must form triangles of existing vertices");
+  if (!valid)
+    return;
+  cacheSize = std::clamp(cacheSize, 4u, MeshSettings::maxCacheSize);
+  std::size_t triangleCount = indexCount / 3;
+
+  std::vector<u32> offsets;
+  std::vector<u32> adjacency;
+  Internal::VertexTriangles(indices, triangleCount, vertexCount, offsets, adjacency);
+  // triangles not emitted yet are the first remaining[v] entries of the adjacency of v
+  std::vector<u32> remaining(vertexCount);
+  std::vector<i32> cachePosition(vertexCount, -1);
+  std::vector<f32> vertexScores(vertexCount);
+  ScoreTables tables;
+  InitScoreTables(tables, cacheSize);
+  for (std::size_t v = 0; v < vertexCount; ++v) {
+    remaining[v] = offsets[v + 1] - offsets[v];
+    vertexScores[v] = VertexScore(tables, -1, remaining[v]);
+  }
+
+  auto triangleScore = [&](u32 triangle) {
+    const u32* corners = indices + 3 * std::size_t(triangle);
+    return vertexScores[corners[0]] + vertexScores[corners[1]] + vertexScores[corners[2]];
+  };
+  u32 best = none;
+  f32 bestScore = -1.0f;
+  for (u32 triangle = 0; triangle < triangleCount; ++triangle) {
+    f32 score = triangleScore(triangle);
+    if (score > bestScore) {
+      best = triangle;
+      bestScore = score;
+    }
+  }
+
+  std::vector<u32> output(indexCount);
+  std::vector<u8> emitted(triangleCount, 0);
+  // most recently used first, three extra entries for the vertices pushed out by a triangle
+  u32 cache[MeshSettings::maxCacheSize + 3];
+  u32 newCache[MeshSettings::maxCacheSize + 3];
+  u32 cacheCount = 0;
+  std::size_t scan = 0;
+  for (std::size_t count = 0; count < triangleCount; ++count) {
+    if (best == none) {
+      // no cached vertex has triangles left, continue with any remaining triangle
+      while (emitted[scan])
+        ++scan;
+      best = static_cast<u32>(scan);
+    }
+
+    const u32* corners = indices + 3 * std::size_t(best);
+    std::copy(corners, corners + 3, output.data() + 3 * count);
+    emitted[best] = 1;
+    for (u32 c = 0; c < 3; ++c) {
+      u32* list = adjacency.data() + offsets[corners[c]];
+      u32& left = remaining[corners[c]];
+      for (u32 k = 0; k < left; ++k) {
+        if (list[k] == best) {
+          list[k] = list[--left];
+          break;
+        }
+      }
+    }
+
+    u32 newCount = 0;
+    for (u32 c = 0; c < 3; ++c) {
+      if (std::find(newCache, newCache + newCount, corners[c]) == newCache + newCount)
+        newCache[newCount++] = corners[c];
+    }
+    for (u32 k = 0; k < cacheCount; ++k) {
+      if (std::find(corners, corners + 3, cache[k]) == corners + 3)
+        newCache[newCount++] = cache[k];
+    }
+
+    for (u32 k = 0; k < newCount; ++k) {
+      u32 v = newCache[k];
+      cachePosition[v] = k < cacheSize ? static_cast<i32>(k) : -1;
+      vertexScores[v] = VertexScore(tables, cachePosition[v], remaining[v]);
+    }
+    // only triangles around the cache changed their score
+    best = none;
+    bestScore = -1.0f;
+    for (u32 k = 0; k < newCount; ++k) {
+      u32 v = newCache[k];
+      for (u32 j = 0; j < remaining[v]; ++j) {
+        u32 triangle = adjacency[offsets[v] + j];
+        f32 score = triangleScore(triangle);
+        if (score > bestScore) {
+          best = triangle;
+          bestScore = score;
+        }
+      }
+    }
+    cacheCount = std::min(newCount, cacheSize);
+    std::copy(newCache, newCache + cacheCount, cache);
+  }
+  std::copy(output.begin(), output.end(), indices);
+}
+
+f32 AverageCacheMissRatio(
+    const u32* indices,
+    std::size_t indexCount,
+    std::size_t vertexCount,
+    u32 cacheSize
+) noexcept
+{
+  if (indexCount < 3)
+    return 0.0f;
+  // a vertex is cached while fewer than cacheSize misses happened since it was loaded
+  std::vector<u32> loaded(vertexCount, 0);
+  u32 misses = 0;
+  for (std::size_t i = 0; i < indexCount; ++i) {
+    u32 v = indices[i];
+    if (v >= vertexCount)
+      continue;
+    if (loaded[v] == 0 || misses - loaded[v] >= cacheSize)
+      loaded[v] = ++misses;
+  }
+  return static_cast<f32>(misses) / static_cast<f32>(indexCount / 3);
+}
+
+} // namespace Engine::Core::Geometry
@@ -0,0 +1,414 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Mesh.h
+ * @brief Indexed triangle mesh with vertex welding, normal and tangent generation
+ *
+ * Mesh keeps positions, normals and tangents as structure of arrays and a triangle list index
+ * buffer. Optional attributes are either empty or hold one entry per vertex.
+ *
+ * Weld merges vertices whose positions and attributes agree within a tolerance. Positions are
+ * hashed into a grid with cells twice the tolerance, so a matching vertex lies in the cell of the
+ * vertex or in one of the seven neighbors on the near side along every axis, and welding takes
+ * linear time instead of comparing all vertex pairs.
+ *
+ * Normals and tangents are accumulated from per triangle vectors: the face normal is the
+ * unnormalized Cross product of two edges, hence weighted by triangle area. The accumulation is
+ * a gather over the triangles around each vertex, so the parallel forms run over vertex ranges
+ * without atomics and give the same result as the serial ones.
+ *
+ * OptimizeVertexCache reorders triangles for the post transform vertex cache with the algorithm
+ * of Tom Forsyth, "Linear-Speed Vertex Cache Optimisation": triangles are emitted greedily by a
+ * score which favours vertices recently used and vertices with few remaining triangles.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/container/FlatHashMap.h"
+#include "core/math/FloatComparator.h"
+#include "core/math/Vector2.h"
+#include "core/math/Vector3.h"
+#include "core/math/Vector3Array.h"
+#include "core/parallel/ThreadPool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace Engine::Core::Geometry
+{
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+struct MeshSettings
+{
+  /// Default welding tolerance relative to the mesh size
+  static constexpr f64 weldEpsilon = 1e-6;
+  /// Default number of vertices simulated in the post transform cache
+  static constexpr u32 cacheSize = 32;
+  static constexpr u32 maxCacheSize = 64;
+  /// Default number of triangles or vertices per parallel task
+  static constexpr std::size_t grain = 4096;
+};
+
+/**
+ * @brief Reorders the triangles of a triangle list for a vertex cache of cacheSize entries
+ *
+ * Vertex order inside a triangle is preserved, so is the winding.
+ */
+void OptimizeVertexCache(
+    u32* indices,
+    std::size_t indexCount,
+    std::size_t vertexCount,
+    u32 cacheSize = MeshSettings::cacheSize
+) noexcept;
+
+/// Average number of vertex transforms per triangle with a FIFO cache of cacheSize entries
+f32 AverageCacheMissRatio(
+    const u32* indices,
+    std::size_t indexCount,
+    std::size_t vertexCount,
+    u32 cacheSize = MeshSettings::cacheSize
+) noexcept;
+
+template <typename T>
+class Mesh
+{
+ public:
+  Math::Vector3Array<T> positions;
+  /// Empty or one unit normal per vertex
+  Math::Vector3Array<T> normals;
+  /// Empty or one texture coordinate per vertex
+  std::vector<Math::Vector2<T>> uvs;
+  /// Empty or one unit tangent per vertex, orthogonal to the normal
+  Math::Vector3Array<T> tangents;
+  /// Bitangent is tangentSigns[i] * Cross(normal, tangent)
+  std::vector<T> tangentSigns;
+  /// Triangle list, three indices per triangle
+  std::vector<u32> indices;
+
+  std::size_t VertexCount() const noexcept;
+  std::size_t TriangleCount() const noexcept;
+  void Clear() noexcept;
+
+  /**
+   * @brief Merges equal vertices and remaps the indices
+   *
+   * Two vertices are equal when every position component differs by at most comparator.epsilon
+   * times the largest coordinate magnitude of the mesh and, when present, normals and texture
+   * coordinates differ by at most comparator.epsilon per component. The position test is the
+   * FloatComparator test taken relative to the size of the mesh instead of the vertex, so
+   * vertices near the origin weld like all others. Vertices along texture seams stay separate.
+   * Tangents are dropped, they are recomputed after welding.
+   * @return number of vertices left
+   */
+  std::size_t Weld(
+      const Math::FloatComparator<T>& comparator =
+          Math::FloatComparator<T>(static_cast<T>(MeshSettings::weldEpsilon))
+  ) noexcept;
+
+  /// Area weighted smooth normals
+  void ComputeNormals() noexcept;
+  void ComputeNormals(
+      Parallel::ThreadPool& pool,
+      std::size_t grain = MeshSettings::grain
+  ) noexcept;
+
+  /// Tangents along increasing u, requires normals and texture coordinates
+  void ComputeTangents() noexcept;
+  void ComputeTangents(
+      Parallel::ThreadPool& pool,
+      std::size_t grain = MeshSettings::grain
+  ) noexcept;
+
+  void OptimizeVertexCache(u32 cacheSize = MeshSettings::cacheSize) noexcept;
+
+ private:
+  /// parallelFor(count, func) calls func(begin, end) over ranges covering [0, count)
+  template <typename For>
+  void AccumulateNormals(For&& parallelFor) noexcept;
+  template <typename For>
+  bool AccumulateTangents(For&& parallelFor) noexcept;
+};
+
+/* ------------------------------------------- Usings ------------------------------------------ */
+using Meshf = Mesh<f32>;
+using Meshd = Mesh<f64>;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+namespace Internal
+{
+
+/**
+ * @brief Lists the triangles around every vertex
+ *
+ * Triangles of vertex v are triangles[offsets[v]] up to triangles[offsets[v + 1]], a triangle
+ * with a repeated vertex is listed once per corner.
+ */
+void VertexTriangles(
+    const u32* indices,
+    std::size_t triangleCount,
+    std::size_t vertexCount,
+    std::vector<u32>& offsets,
+    std::vector<u32>& triangles
+) noexcept;
+
+/// Packs wrapped 21 bit grid coordinates, wrapping only adds candidates to compare
+inline u64 CellKey(i64 x, i64 y, i64 z) noexcept
+{
+  constexpr u64 mask = (u64(1) << 21) - 1;
+  return (u64(x) & mask) | ((u64(y) & mask) << 21) | ((u64(z) & mask) << 42);
+}
+
+template <typename T>
+bool Near(const Math::Vector3<T>& a, const Math::Vector3<T>& b, T tolerance) noexcept
+{
+  return std::abs(a.x - b.x) <= tolerance && std::abs(a.y - b.y) <= tolerance &&
+         std::abs(a.z - b.z) <= tolerance;
+}
+
+} // namespace Internal
+
+template <typename T>
+std::size_t Mesh<T>::VertexCount() const noexcept
+{
+  return positions.Size();
+}
+
+template <typename T>
+std::size_t Mesh<T>::TriangleCount() const noexcept
+{
+  return indices.size() / 3;
+}
+
+template <typename T>
+void Mesh<T>::Clear() noexcept
+{
+  positions.Clear();
+  normals.Clear();
+  uvs.clear();
+  tangents.Clear();
+  tangentSigns.clear();
+  indices.clear();
+}
+
+template <typename T>
+std::size_t Mesh<T>::Weld(const Math::FloatComparator<T>& comparator) noexcept
+{
+  using Math::Vector3;
+  std::size_t count = positions.Size();
+  bool hasNormals = normals.Size() == count;
+  bool hasUvs = uvs.size() == count;
+  tangents.Clear();
+  tangentSigns.clear();
+
+  T scale = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    scale = std::max({scale, std::abs(positions.x[i]), std::abs(positions.y[i]),
+                      std::abs(positions.z[i])});
+  }
+  T tolerance = comparator.epsilon * scale;
+  // exact welding still needs a nonzero cell
+  T cell = tolerance > 0 ? 2 * tolerance : std::max(scale, static_cast<T>(1));
+  T attributeTolerance = comparator.epsilon;
+  auto same = [&](std::size_t a, std::size_t b) {
+    if (!Internal::Near(positions.Get(a), positions.Get(b), tolerance))
+      return false;
+    if (hasNormals && !Internal::Near(normals.Get(a), normals.Get(b), attributeTolerance))
+      return false;
+    return !hasUvs || (std::abs(uvs[a].x - uvs[b].x) <= attributeTolerance &&
+                       std::abs(uvs[a].y - uvs[b].y) <= attributeTolerance);
+  };
+
+  constexpr u32 none = ~u32(0);
+  Container::FlatHashMap<u64, u32> cells(static_cast<u32>(std::min<std::size_t>(count, 1u << 30)));
+  // unique vertices of one cell are chained through next
+  std::vector<u32> next;
+  next.reserve(count);
+  std::vector<u32> remap(count);
+  std::size_t unique = 0;
+  for (std::size_t v = 0; v < count; ++v) {
+    Vector3<T> p = positions.Get(v);
+    T coordinates[3] = {p.x / cell, p.y / cell, p.z / cell};
+    i64 base[3];
+    i64 side[3];
+    for (u32 axis = 0; axis < 3; ++axis) {
+      T floor = std::floor(coordinates[axis]);
+      base[axis] = static_cast<i64>(floor);
+      side[axis] = coordinates[axis] - floor < static_cast<T>(0.5) ? -1 : 1;
+    }
+
+    u32 match = none;
+    for (u32 corner = 0; corner < 8 && match == none; ++corner) {
+      u64 key = Internal::CellKey(
+          base[0] + ((corner & 1) ? side[0] : 0), base[1] + ((corner & 2) ? side[1] : 0),
+          base[2] + ((corner & 4) ? side[2] : 0)
+      );
+      const u32* head = cells.Get(key);
+      for (u32 u = head ? *head : none; u != none; u = next[u]) {
+        if (same(u, v)) {
+          match = u;
+          break;
+        }
+      }
+    }
+
+    if (match == none) {
+      // compaction in place, unique <= v so only processed vertices are overwritten
+      match = static_cast<u32>(unique++);
+      positions.Set(match, p);
+      if (hasNormals)
+        normals.Set(match, normals.Get(v));
+      if (hasUvs)
+        uvs[match] = uvs[v];
+      u64 key = Internal::CellKey(base[0], base[1], base[2]);
+      u32* head = cells.Get(key);
+      next.push_back(head ? *head : none);
+      cells.InsertOrAssign(key, match);
+    }
+    remap[v] = match;
+  }
+
+  positions.Resize(unique);
+  if (hasNormals)
+    normals.Resize(unique);
+  if (hasUvs)
+    uvs.resize(unique);
+  for (u32& index : indices) {
+    assert(index < count && "Vertex index out of range");
+    index = index < count ? remap[index] : 0;
+  }
+  return unique;
+}
+
+template <typename T>
+void Mesh<T>::ComputeNormals() noexcept
+{
+  AccumulateNormals([](std::size_t count, auto&& func) { func(std::size_t(0), count); });
+}
+
+template <typename T>
+void Mesh<T>::ComputeNormals(Parallel::ThreadPool& pool, std::size_t grain) noexcept
+{
+  AccumulateNormals([&](std::size_t count, auto&& func) {
+    pool.ParallelFor(count, grain, func);
+  });
+}
+
+template <typename T>
+template <typename For>
+void Mesh<T>::AccumulateNormals(For&& parallelFor) noexcept
+{
+  using Math::Vector3;
+  std::size_t vertexCount = positions.Size();
+  std::size_t triangleCount = TriangleCount();
+  std::vector<Vector3<T>> faces(triangleCount);
+  parallelFor(triangleCount, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t t = begin; t < end; ++t) {
+      const u32* triangle = indices.data() + 3 * t;
+      Vector3<T> a = positions.Get(triangle[0]);
+      faces[t] = (positions.Get(triangle[1]) - a).Cross(positions.Get(triangle[2]) - a);
+    }
+  });
+
+  std::vector<u32> offsets;
+  std::vector<u32> triangles;
+  Internal::VertexTriangles(indices.data(), triangleCount, vertexCount, offsets, triangles);
+  normals.Resize(vertexCount);
+  parallelFor(vertexCount, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t v = begin; v < end; ++v) {
+      Vector3<T> sum = Vector3<T>::Zero();
+      for (u32 k = offsets[v]; k < offsets[v + 1]; ++k)
+        sum += faces[triangles[k]];
+      normals.Set(v, sum.Normalized());
+    }
+  });
+}
+
+template <typename T>
+void Mesh<T>::ComputeTangents() noexcept
+{
+  AccumulateTangents([](std::size_t count, auto&& func) { func(std::size_t(0), count); });
+}
+
+template <typename T>
+void Mesh<T>::ComputeTangents(Parallel::ThreadPool& pool, std::size_t grain) noexcept
+{
+  AccumulateTangents([&](std::size_t count, auto&& func) {
+    pool.ParallelFor(count, grain, func);
+  });
+}
+
+template <typename T>
+template <typename For>
+bool Mesh<T>::AccumulateTangents(For&& parallelFor) noexcept
+{
+  using Math::Vector3;
+  std::size_t vertexCount = positions.Size();
+  bool valid = normals.Size() == vertexCount && uvs.size() == vertexCount;
+  assert(valid && "Tangents require normals and texture coordinates");
+  if (!valid)
+    return false;
+
+  // per triangle directions of increasing u and v, scaled by the triangle area
+  std::size_t triangleCount = TriangleCount();
+  std::vector<Vector3<T>> faceTangents(triangleCount);
+  std::vector<Vector3<T>> faceBitangents(triangleCount);
+  parallelFor(triangleCount, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t t = begin; t < end; ++t) {
+      const u32* triangle = indices.data() + 3 * t;
+      Vector3<T> e1 = positions.Get(triangle[1]) - positions.Get(triangle[0]);
+      Vector3<T> e2 = positions.Get(triangle[2]) - positions.Get(triangle[0]);
+      Math::Vector2<T> d1 = uvs[triangle[1]] - uvs[triangle[0]];
+      Math::Vector2<T> d2 = uvs[triangle[2]] - uvs[triangle[0]];
+      T determinant = d1.Cross(d2);
+      if (determinant == 0) {
+        faceTangents[t] = Vector3<T>::Zero();
+        faceBitangents[t] = Vector3<T>::Zero();
+        continue;
+      }
+      T sign = determinant > 0 ? 1 : -1;
+      faceTangents[t] = (e1 * d2.y - e2 * d1.y) * sign;
+      faceBitangents[t] = (e2 * d1.x - e1 * d2.x) * sign;
+    }
+  });
+
+  std::vector<u32> offsets;
+  std::vector<u32> triangles;
+  Internal::VertexTriangles(indices.data(), triangleCount, vertexCount, offsets, triangles);
+  tangents.Resize(vertexCount);
+  tangentSigns.resize(vertexCount);
+  parallelFor(vertexCount, [&](std::size_t v, std::size_t end) {
+    for (; v < end; ++v) {
+      Vector3<T> tangent = Vector3<T>::Zero();
+      Vector3<T> bitangent = Vector3<T>::Zero();
+      for (u32 k = offsets[v]; k < offsets[v + 1]; ++k) {
+        tangent += faceTangents[triangles[k]];
+        bitangent += faceBitangents[triangles[k]];
+      }
+      // Gram-Schmidt against the normal, any perpendicular when the uv mapping degenerates
+      Vector3<T> normal = normals.Get(v);
+      tangent = (tangent - normal * normal.Dot(tangent)).Normalized();
+      if (tangent == Vector3<T>::Zero()) {
+        Vector3<T> axis =
+            std::abs(normal.x) < static_cast<T>(0.9) ? Vector3<T>::UnitX() : Vector3<T>::UnitY();
+        tangent = (axis - normal * normal.Dot(axis)).Normalized();
+      }
+      tangents.Set(v, tangent);
+      tangentSigns[v] = normal.Cross(tangent).Dot(bitangent) < 0 ? -1 : 1;
+    }
+  });
+  return true;
+}
+
+template <typename T>
+void Mesh<T>::OptimizeVertexCache(u32 cacheSize) noexcept
+{
+  Geometry::OptimizeVertexCache(indices.data(), indices.size(), positions.Size(), cacheSize);
+}
+
+} // namespace Engine::Core::Geometry
@@ -0,0 +1,704 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Simplify.h
+ * @brief Mesh simplification by quadric error metrics for level of detail generation
+ *
+ * Simplify removes triangles by half edge collapses: a vertex moves onto a neighbor and the two
+ * triangles on their edge vanish. Vertices never move to new positions, so the result is an
+ * index buffer into the vertex buffer of the source mesh and every level of detail shares it.
+ *
+ * The cost of moving a vertex is the quadric error of Garland and Heckbert, "Surface
+ * Simplification Using Quadric Error Metrics": every vertex accumulates the planes of its
+ * triangles weighted by area, and the error of a position is the mean squared distance to the
+ * planes of both collapsed vertices. When the mesh has normals or texture coordinates their
+ * squared difference is charged too, scaled by attributeWeight. Candidate collapses wait in a
+ * priority queue ordered by cost; entries of vertices whose neighborhood changed are skipped by
+ * version stamps and pushed again with updated costs. A collapse which would pinch the surface
+ * into a non-manifold edge or turn a triangle too far is rejected, and the queue is rebuilt from
+ * the remaining edges until a pass collapses nothing.
+ *
+ * Borders are the edges with a single triangle, which includes uv seams of a welded mesh because
+ * the two sides of a seam use different vertices. With lockBorder they never move, so seams stay
+ * closed; without it border vertices slide along border edges only and get constraint planes
+ * perpendicular to the border.
+ *
+ * The parallel form orders triangles along the Z-curve of their centroids and cuts the order into
+ * partitions of spatially coherent triangles. Vertices used by several partitions are locked
+ * while the partitions are simplified concurrently, each to its share of the target, and a final
+ * serial pass over the much smaller result removes the rest. Every vertex of the final pass
+ * starts with the planes of all source vertices collapsed onto it, so the error limit bounds the
+ * distance to the source mesh as in the serial form.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/container/FlatHashMap.h"
+#include "core/container/Hash.h"
+#include "core/geometry/Mesh.h"
+#include "core/math/AABB.h"
+#include "core/math/Morton.h"
+#include "core/math/Vector2.h"
+#include "core/math/Vector3.h"
+#include "core/parallel/ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace Engine::Core::Geometry
+{
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+struct SimplifySettings
+{
+  /// Weight of border constraint planes relative to the planes of triangles
+  static constexpr f64 borderWeight = 10.0;
+  /// Smallest cosine between the normals of a triangle before and after a collapse
+  static constexpr f64 minNormalCosine = 0.25;
+  /// Default number of triangles per partition of the parallel form
+  static constexpr std::size_t partitionTriangles = 16 * 1024;
+};
+
+template <typename T>
+struct SimplifyOptions
+{
+  /// Collapses stop once no more than targetTriangles are left
+  std::size_t targetTriangles = 0;
+  /// Collapses stop before one with a larger error, a distance in mesh units
+  T maxError = std::numeric_limits<T>::max();
+  /// Border vertices, uv seams included, keep their place
+  bool lockBorder = true;
+  /// Squared distance charged per squared difference of normals and texture coordinates
+  T attributeWeight = 1;
+};
+
+/**
+ * @brief Writes the triangle list of a simplified mesh, indexing the vertices of mesh
+ * @return largest error of the performed collapses
+ */
+template <typename T>
+T Simplify(
+    const Mesh<T>& mesh,
+    const SimplifyOptions<T>& options,
+    std::vector<u32>& indices
+) noexcept;
+
+template <typename T>
+T Simplify(
+    const Mesh<T>& mesh,
+    const SimplifyOptions<T>& options,
+    std::vector<u32>& indices,
+    Parallel::ThreadPool& pool,
+    std::size_t partitionTriangles = SimplifySettings::partitionTriangles
+) noexcept;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+namespace Internal
+{
+
+/// Sum of weighted squared distances to planes as p^T A p + 2 b^T p + c
+template <typename T>
+struct Quadric
+{
+  T a00 = 0;
+  T a01 = 0;
+  T a02 = 0;
+  T a11 = 0;
+  T a12 = 0;
+  T a22 = 0;
+  T b0 = 0;
+  T b1 = 0;
+  T b2 = 0;
+  T c = 0;
+  /// Sum of plane weights
+  T weight = 0;
+
+  /// Adds the plane normal . p + distance = 0, normal of unit length
+  void AddPlane(const Math::Vector3<T>& normal, T distance, T planeWeight) noexcept;
+  void Add(const Quadric<T>& q) noexcept;
+  /// Weighted mean squared distance of point to the planes
+  T Error(const Math::Vector3<T>& point) const noexcept;
+};
+
+/// Vertices and triangles of one simplification pass, vertex indices local to the pass
+template <typename T>
+struct CollapseMesh
+{
+  std::vector<Math::Vector3<T>> positions;
+  /// Empty or one per vertex
+  std::vector<Math::Vector3<T>> normals;
+  std::vector<Math::Vector2<T>> uvs;
+  /// Empty or one per vertex, locked vertices never move
+  std::vector<u8> locked;
+  std::vector<u32> indices;
+  /// Empty or one per vertex, Collapse adds the planes of indices when empty
+  std::vector<Quadric<T>> quadrics;
+  /// Written by Collapse, the vertex a removed vertex moved onto or none
+  std::vector<u32> collapsedTo;
+
+  /// Copies vertices[i] of mesh to vertex i, all vertices of mesh when vertices is null
+  void Gather(const Mesh<T>& mesh, const u32* vertices, std::size_t count) noexcept;
+};
+
+struct CollapseCandidate
+{
+  f64 cost;
+  u32 from;
+  u32 to;
+  u32 fromVersion;
+  u32 toVersion;
+};
+
+/**
+ * @brief Adds the area weighted planes of the triangles to the quadrics of their corners
+ *
+ * Unless borders are locked, the corners of border edges also get the border constraint planes.
+ */
+template <typename T>
+void AddPlanes(
+    const std::vector<Math::Vector3<T>>& positions,
+    const std::vector<u32>& indices,
+    const SimplifyOptions<T>& options,
+    std::vector<Quadric<T>>& quadrics
+) noexcept;
+
+/**
+ * @brief Collapses edges of mesh until target triangles are left or the error limit is reached
+ * @return largest squared error of the performed collapses
+ */
+template <typename T>
+T Collapse(CollapseMesh<T>& mesh, const SimplifyOptions<T>& options, std::size_t target) noexcept;
+
+inline bool IsDegenerate(const u32* corners) noexcept
+{
+  return corners[0] == corners[1] || corners[1] == corners[2] || corners[2] == corners[0];
+}
+
+/// Adds or removes the edges of a triangle from the per edge triangle counts
+inline void CountEdges(
+    Container::FlatHashMap<u64, u32>& edges,
+    const u32* corners,
+    bool add
+) noexcept
+{
+  for (u32 c = 0; c < 3; ++c) {
+    u32& count = edges[Container::EdgeKey(corners[c], corners[(c + 1) % 3])];
+    count = add ? count + 1 : count - 1;
+  }
+}
+
+template <typename T>
+void Quadric<T>::AddPlane(const Math::Vector3<T>& normal, T distance, T planeWeight) noexcept
+{
+  const Math::Vector3<T>& n = normal;
+  a00 += planeWeight * n.x * n.x;
+  a01 += planeWeight * n.x * n.y;
+  a02 += planeWeight * n.x * n.z;
+  a11 += planeWeight * n.y * n.y;
+  a12 += planeWeight * n.y * n.z;
+  a22 += planeWeight * n.z * n.z;
+  b0 += planeWeight * n.x * distance;
+  b1 += planeWeight * n.y * distance;
+  b2 += planeWeight * n.z * distance;
+  c += planeWeight * distance * distance;
+  weight += planeWeight;
+}
+
+template <typename T>
+void Quadric<T>::Add(const Quadric<T>& q) noexcept
+{
+  a00 += q.a00;
+  a01 += q.a01;
+  a02 += q.a02;
+  a11 += q.a11;
+  a12 += q.a12;
+  a22 += q.a22;
+  b0 += q.b0;
+  b1 += q.b1;
+  b2 += q.b2;
+  c += q.c;
+  weight += q.weight;
+}
+
+template <typename T>
+T Quadric<T>::Error(const Math::Vector3<T>& p) const noexcept
+{
+  if (!(weight > 0))
+    return 0;
+  T x = a00 * p.x + a01 * p.y + a02 * p.z + 2 * b0;
+  T y = a01 * p.x + a11 * p.y + a12 * p.z + 2 * b1;
+  T z = a02 * p.x + a12 * p.y + a22 * p.z + 2 * b2;
+  // rounding can make the sum of squares slightly negative
+  return std::max(p.x * x + p.y * y + p.z * z + c, static_cast<T>(0)) / weight;
+}
+
+template <typename T>
+void CollapseMesh<T>::Gather(const Mesh<T>& mesh, const u32* vertices, std::size_t count) noexcept
+{
+  bool hasNormals = mesh.normals.Size() == mesh.VertexCount();
+  bool hasUvs = mesh.uvs.size() == mesh.VertexCount();
+  positions.resize(count);
+  normals.resize(hasNormals ? count : 0);
+  uvs.resize(hasUvs ? count : 0);
+  for (std::size_t i = 0; i < count; ++i) {
+    std::size_t v = vertices ? vertices[i] : i;
+    positions[i] = mesh.positions.Get(v);
+    if (hasNormals)
+      normals[i] = mesh.normals.Get(v);
+    if (hasUvs)
+      uvs[i] = mesh.uvs[v];
+  }
+}
+
+template <typename T>
+void AddPlanes(
+    const std::vector<Math::Vector3<T>>& positions,
+    const std::vector<u32>& indices,
+    const SimplifyOptions<T>& options,
+    std::vector<Quadric<T>>& quadrics
+) noexcept
+{
+  using Math::Vector3;
+  std::size_t triangleCount = indices.size() / 3;
+  const std::vector<Vector3<T>>& p = positions;
+  Container::FlatHashMap<u64, u32> edges(static_cast<u32>(indices.size()));
+  for (std::size_t t = 0; t < triangleCount; ++t) {
+    if (!IsDegenerate(indices.data() + 3 * t))
+      CountEdges(edges, indices.data() + 3 * t, true);
+  }
+
+  for (std::size_t t = 0; t < triangleCount; ++t) {
+    const u32* corners = indices.data() + 3 * t;
+    if (IsDegenerate(corners))
+      continue;
+    Vector3<T> normal = (p[corners[1]] - p[corners[0]]).Cross(p[corners[2]] - p[corners[0]]);
+    // slivers carry next to no weight and have no reliable normal
+    T area = normal.Length() / 2;
+    if (!(2 * area > std::numeric_limits<T>::epsilon()))
+      continue;
+    normal /= 2 * area;
+    for (u32 c = 0; c < 3; ++c)
+      quadrics[corners[c]].AddPlane(normal, -normal.Dot(p[corners[0]]), area);
+    if (options.lockBorder)
+      continue;
+    // a plane through the border edge perpendicular to the triangle keeps the outline
+    for (u32 c = 0; c < 3; ++c) {
+      u32 a = corners[c];
+      u32 b = corners[(c + 1) % 3];
+      if (*edges.Get(Container::EdgeKey(a, b)) != 1)
+        continue;
+      Vector3<T> edge = p[b] - p[a];
+      Vector3<T> side = edge.Cross(normal).Normalized();
+      T weight = static_cast<T>(SimplifySettings::borderWeight) * edge.LengthSquared();
+      quadrics[a].AddPlane(side, -side.Dot(p[a]), weight);
+      quadrics[b].AddPlane(side, -side.Dot(p[a]), weight);
+    }
+  }
+}
+
+template <typename T>
+T Collapse(CollapseMesh<T>& mesh, const SimplifyOptions<T>& options, std::size_t target) noexcept
+{
+  using Math::Vector3;
+  constexpr u32 none = ~u32(0);
+  std::size_t vertexCount = mesh.positions.size();
+  std::size_t triangleCount = mesh.indices.size() / 3;
+  const std::vector<Vector3<T>>& p = mesh.positions;
+  u32* indices = mesh.indices.data();
+
+  // triangles per edge, kept current while collapsing, an edge with one triangle is a border
+  Container::FlatHashMap<u64, u32> edges(static_cast<u32>(mesh.indices.size()));
+  std::vector<u8> alive(triangleCount, 1);
+  std::size_t aliveCount = 0;
+  for (std::size_t t = 0; t < triangleCount; ++t) {
+    const u32* corners = indices + 3 * t;
+    if (IsDegenerate(corners)) {
+      alive[t] = 0;
+      continue;
+    }
+    ++aliveCount;
+    CountEdges(edges, corners, true);
+  }
+  auto edgeTriangles = [&](u32 a, u32 b) {
+    const u32* count = edges.Get(Container::EdgeKey(a, b));
+    return count ? *count : 0u;
+  };
+
+  if (mesh.quadrics.size() != vertexCount) {
+    mesh.quadrics.assign(vertexCount, Quadric<T>());
+    AddPlanes(mesh.positions, mesh.indices, options, mesh.quadrics);
+  }
+  std::vector<Quadric<T>>& quadrics = mesh.quadrics;
+  mesh.collapsedTo.assign(vertexCount, none);
+
+  // triangles around a vertex: a compressed range of the initial ones and a linked overflow
+  // list of the ones it gained by collapses, both dropping dead triangles as they are visited
+  struct Link
+  {
+    u32 triangle;
+    u32 next;
+  };
+  std::vector<u32> adjacencyBegin(vertexCount);
+  std::vector<u32> adjacencyEnd(vertexCount, 0);
+  std::vector<u32> adjacency(3 * aliveCount);
+  std::vector<u32> overflowHead(vertexCount, none);
+  std::vector<Link> overflow;
+  for (std::size_t t = 0; t < triangleCount; ++t) {
+    for (u32 c = 0; alive[t] && c < 3; ++c)
+      ++adjacencyEnd[indices[3 * t + c]];
+  }
+  for (std::size_t v = 0, offset = 0; v < vertexCount; ++v) {
+    adjacencyBegin[v] = static_cast<u32>(offset);
+    offset += adjacencyEnd[v];
+    adjacencyEnd[v] = adjacencyBegin[v];
+  }
+  for (std::size_t t = 0; t < triangleCount; ++t) {
+    for (u32 c = 0; alive[t] && c < 3; ++c)
+      adjacency[adjacencyEnd[indices[3 * t + c]]++] = static_cast<u32>(t);
+  }
+  auto forEachTriangle = [&](u32 v, auto&& func) {
+    u32 write = adjacencyBegin[v];
+    for (u32 read = adjacencyBegin[v]; read < adjacencyEnd[v]; ++read) {
+      u32 t = adjacency[read];
+      if (!alive[t])
+        continue;
+      adjacency[write++] = t;
+      func(t);
+    }
+    adjacencyEnd[v] = write;
+    for (u32* link = &overflowHead[v]; *link != none;) {
+      u32 t = overflow[*link].triangle;
+      if (!alive[t]) {
+        *link = overflow[*link].next;
+        continue;
+      }
+      func(t);
+      link = &overflow[*link].next;
+    }
+  };
+
+  std::vector<u8> border(vertexCount, 0);
+  std::vector<Vector3<T>> sourceNormals(triangleCount);
+  for (std::size_t t = 0; t < triangleCount; ++t) {
+    if (!alive[t])
+      continue;
+    const u32* corners = indices + 3 * t;
+    sourceNormals[t] = (p[corners[1]] - p[corners[0]]).Cross(p[corners[2]] - p[corners[0]]);
+    for (u32 c = 0; c < 3; ++c) {
+      if (edgeTriangles(corners[c], corners[(c + 1) % 3]) == 1) {
+        border[corners[c]] = 1;
+        border[corners[(c + 1) % 3]] = 1;
+      }
+    }
+  }
+
+  std::vector<u8> removed(vertexCount, 0);
+  std::vector<u32> versions(vertexCount, 0);
+  auto allowed = [&](u32 from, u32 to) {
+    if (removed[from] || removed[to] || (!mesh.locked.empty() && mesh.locked[from]))
+      return false;
+    if (!border[from])
+      return true;
+    return !options.lockBorder && border[to] && edgeTriangles(from, to) == 1;
+  };
+  auto cost = [&](u32 from, u32 to) {
+    Quadric<T> q = quadrics[from];
+    q.Add(quadrics[to]);
+    T error = q.Error(p[to]);
+    if (!mesh.normals.empty())
+      error += options.attributeWeight * (mesh.normals[from] - mesh.normals[to]).LengthSquared();
+    if (!mesh.uvs.empty())
+      error += options.attributeWeight * (mesh.uvs[from] - mesh.uvs[to]).LengthSquared();
+    return error;
+  };
+
+  std::vector<CollapseCandidate> heap;
+  auto greater = [](const CollapseCandidate& a, const CollapseCandidate& b) {
+    return a.cost > b.cost;
+  };
+  auto push = [&](u32 from, u32 to) {
+    if (!allowed(from, to))
+      return;
+    heap.push_back({static_cast<f64>(cost(from, to)), from, to, versions[from], versions[to]});
+    std::push_heap(heap.begin(), heap.end(), greater);
+  };
+
+  // sorted vertices sharing a remaining triangle with v
+  auto ring = [&](u32 v, std::vector<u32>& out) {
+    out.clear();
+    forEachTriangle(v, [&](u32 t) {
+      for (u32 c = 0; c < 3; ++c) {
+        if (indices[3 * std::size_t(t) + c] != v)
+          out.push_back(indices[3 * std::size_t(t) + c]);
+      }
+    });
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+  };
+  // the link condition: the only common neighbors are the opposite corners of the edge
+  // triangles, otherwise the collapse pinches the surface
+  std::vector<u32> fromRing;
+  std::vector<u32> toRing;
+  auto keepsManifold = [&](u32 from, u32 to) {
+    ring(from, fromRing);
+    ring(to, toRing);
+    std::size_t common = 0;
+    for (std::size_t i = 0, j = 0; i < fromRing.size() && j < toRing.size();) {
+      if (fromRing[i] < toRing[j]) {
+        ++i;
+      } else if (toRing[j] < fromRing[i]) {
+        ++j;
+      } else {
+        ++common;
+        ++i;
+        ++j;
+      }
+    }
+    return common == edgeTriangles(from, to);
+  };
+  // moving from onto to must not turn any remaining triangle too far or, summed over several
+  // collapses, around
+  const T minCosine = static_cast<T>(SimplifySettings::minNormalCosine);
+  auto keepsOrientation = [&](u32 from, u32 to) {
+    bool keeps = true;
+    forEachTriangle(from, [&](u32 t) {
+      const u32* corners = indices + 3 * std::size_t(t);
+      if (!keeps || corners[0] == to || corners[1] == to || corners[2] == to)
+        return;
+      Vector3<T> q[3];
+      for (u32 c = 0; c < 3; ++c)
+        q[c] = corners[c] == from ? p[to] : p[corners[c]];
+      Vector3<T> before = (p[corners[1]] - p[corners[0]]).Cross(p[corners[2]] - p[corners[0]]);
+      Vector3<T> after = (q[1] - q[0]).Cross(q[2] - q[0]);
+      keeps = after.Dot(before) > minCosine * after.Length() * before.Length() &&
+              after.Dot(sourceNormals[t]) > 0;
+    });
+    return keeps;
+  };
+
+  T maxCost = options.maxError < std::sqrt(std::numeric_limits<T>::max())
+                  ? options.maxError * options.maxError
+                  : std::numeric_limits<T>::max();
+  T worst = 0;
+  bool limited = false;
+  std::size_t collapsed = 1;
+  // rejected candidates may become valid once their neighborhood changed, so every pass
+  // starts over with the remaining edges until a pass collapses nothing
+  while (aliveCount > target && collapsed > 0 && !limited) {
+    collapsed = 0;
+    heap.clear();
+    for (std::size_t t = 0; t < triangleCount; ++t) {
+      if (!alive[t])
+        continue;
+      for (u32 c = 0; c < 3; ++c) {
+        u32 a = indices[3 * t + c];
+        u32 b = indices[3 * t + (c + 1) % 3];
+        push(a, b);
+        // the reverse half edge of a border belongs to no triangle
+        if (edgeTriangles(a, b) == 1)
+          push(b, a);
+      }
+    }
+
+    while (aliveCount > target && !heap.empty()) {
+      std::pop_heap(heap.begin(), heap.end(), greater);
+      CollapseCandidate candidate = heap.back();
+      heap.pop_back();
+      u32 from = candidate.from;
+      u32 to = candidate.to;
+      if (removed[from] || removed[to] || versions[from] != candidate.fromVersion ||
+          versions[to] != candidate.toVersion) {
+        continue;
+      }
+      if (candidate.cost > static_cast<f64>(maxCost)) {
+        limited = true;
+        break;
+      }
+      if (!keepsManifold(from, to) || !keepsOrientation(from, to))
+        continue;
+
+      forEachTriangle(from, [&](u32 t) {
+        u32* corners = indices + 3 * std::size_t(t);
+        CountEdges(edges, corners, false);
+        if (corners[0] == to || corners[1] == to || corners[2] == to) {
+          alive[t] = 0;
+          --aliveCount;
+          return;
+        }
+        *std::find(corners, corners + 3, from) = to;
+        CountEdges(edges, corners, true);
+        overflow.push_back({t, overflowHead[to]});
+        overflowHead[to] = static_cast<u32>(overflow.size() - 1);
+      });
+      quadrics[to].Add(quadrics[from]);
+      mesh.collapsedTo[from] = to;
+      removed[from] = 1;
+      ++versions[from];
+      ++versions[to];
+      ++collapsed;
+      worst = std::max(worst, static_cast<T>(candidate.cost));
+
+      ring(to, toRing);
+      for (u32 w : toRing) {
+        push(to, w);
+        push(w, to);
+      }
+    }
+  }
+
+  std::size_t kept = 0;
+  for (std::size_t t = 0; t < triangleCount; ++t) {
+    if (!alive[t])
+      continue;
+    std::copy(indices + 3 * t, indices + 3 * t + 3, indices + 3 * kept);
+    ++kept;
+  }
+  mesh.indices.resize(3 * kept);
+  return worst;
+}
+
+} // namespace Internal
+
+template <typename T>
+T Simplify(
+    const Mesh<T>& mesh,
+    const SimplifyOptions<T>& options,
+    std::vector<u32>& indices
+) noexcept
+{
+  Internal::CollapseMesh<T> pass;
+  pass.Gather(mesh, nullptr, mesh.VertexCount());
+  pass.indices = mesh.indices;
+  T error = Internal::Collapse(pass, options, options.targetTriangles);
+  indices = std::move(pass.indices);
+  return std::sqrt(error);
+}
+
+template <typename T>
+T Simplify(
+    const Mesh<T>& mesh,
+    const SimplifyOptions<T>& options,
+    std::vector<u32>& indices,
+    Parallel::ThreadPool& pool,
+    std::size_t partitionTriangles
+) noexcept
+{
+  using Math::Vector3;
+  constexpr u32 none = ~u32(0);
+  std::size_t triangleCount = mesh.TriangleCount();
+  std::size_t vertexCount = mesh.VertexCount();
+  partitionTriangles = std::max<std::size_t>(partitionTriangles, 1);
+  if (triangleCount <= partitionTriangles)
+    return Simplify(mesh, options, indices);
+
+  std::vector<Vector3<T>> centroids(triangleCount);
+  Math::AABB<T> bounds = Math::AABB<T>::Empty();
+  for (std::size_t t = 0; t < triangleCount; ++t) {
+    const u32* corners = mesh.indices.data() + 3 * t;
+    centroids[t] = (mesh.positions.Get(corners[0]) + mesh.positions.Get(corners[1]) +
+                    mesh.positions.Get(corners[2])) /
+                   static_cast<T>(3);
+    bounds.Merge(centroids[t]);
+  }
+  std::vector<u32> order;
+  Math::MortonOrder(centroids.data(), triangleCount, bounds, order, pool);
+
+  // vertices used by two partitions are locked while the partitions are simplified
+  std::size_t partitionCount = (triangleCount + partitionTriangles - 1) / partitionTriangles;
+  std::vector<u32> owners(vertexCount, none);
+  std::vector<u8> shared(vertexCount, 0);
+  for (std::size_t i = 0; i < triangleCount; ++i) {
+    u32 partition = static_cast<u32>(i / partitionTriangles);
+    for (u32 c = 0; c < 3; ++c) {
+      u32 v = mesh.indices[3 * std::size_t(order[i]) + c];
+      if (owners[v] == none)
+        owners[v] = partition;
+      else if (owners[v] != partition)
+        shared[v] = 1;
+    }
+  }
+
+  // planes of the source mesh, partitions start from them and the final pass sums them along
+  // the collapses of the partitions
+  Internal::CollapseMesh<T> pass;
+  pass.Gather(mesh, nullptr, vertexCount);
+  pass.quadrics.resize(vertexCount);
+  Internal::AddPlanes(pass.positions, mesh.indices, options, pass.quadrics);
+
+  // every removed vertex belongs to a single partition, so the writes never overlap
+  std::vector<u32> collapsedTo(vertexCount, none);
+  std::vector<std::vector<u32>> results(partitionCount);
+  std::vector<T> errors(partitionCount, 0);
+  pool.ParallelFor(partitionCount, 1, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t partition = begin; partition < end; ++partition) {
+      std::size_t first = partition * partitionTriangles;
+      std::size_t last = std::min(triangleCount, first + partitionTriangles);
+      std::vector<u32> vertices;
+      for (std::size_t i = first; i < last; ++i) {
+        const u32* corners = mesh.indices.data() + 3 * std::size_t(order[i]);
+        vertices.insert(vertices.end(), corners, corners + 3);
+      }
+      std::sort(vertices.begin(), vertices.end());
+      vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+
+      Internal::CollapseMesh<T> part;
+      part.Gather(mesh, vertices.data(), vertices.size());
+      part.locked.resize(vertices.size());
+      part.quadrics.resize(vertices.size());
+      for (std::size_t v = 0; v < vertices.size(); ++v) {
+        part.locked[v] = shared[vertices[v]];
+        part.quadrics[v] = pass.quadrics[vertices[v]];
+      }
+      for (std::size_t i = first; i < last; ++i) {
+        for (u32 c = 0; c < 3; ++c) {
+          u32 v = mesh.indices[3 * std::size_t(order[i]) + c];
+          auto local = std::lower_bound(vertices.begin(), vertices.end(), v) - vertices.begin();
+          part.indices.push_back(static_cast<u32>(local));
+        }
+      }
+
+      // the share of the target proportional to the partition size
+      std::size_t target = (options.targetTriangles * (last - first) + triangleCount - 1) /
+                           triangleCount;
+      errors[partition] = Internal::Collapse(part, options, target);
+      for (u32& index : part.indices)
+        index = vertices[index];
+      for (std::size_t v = 0; v < vertices.size(); ++v) {
+        if (part.collapsedTo[v] != none)
+          collapsedTo[vertices[v]] = vertices[part.collapsedTo[v]];
+      }
+      results[partition] = std::move(part.indices);
+    }
+  });
+
+  // a removed vertex is never a collapse target of the final chain, so its quadric is still
+  // the one of its source planes
+  for (std::size_t v = 0; v < vertexCount; ++v) {
+    if (collapsedTo[v] == none)
+      continue;
+    u32 root = collapsedTo[v];
+    while (collapsedTo[root] != none)
+      root = collapsedTo[root];
+    for (std::size_t w = v; collapsedTo[w] != root;) {
+      std::size_t next = collapsedTo[w];
+      collapsedTo[w] = root;
+      w = next;
+    }
+    pass.quadrics[root].Add(pass.quadrics[v]);
+  }
+  for (const std::vector<u32>& result : results)
+    pass.indices.insert(pass.indices.end(), result.begin(), result.end());
+  T error = Internal::Collapse(pass, options, options.targetTriangles);
+  for (T partitionError : errors)
+    error = std::max(error, partitionError);
+  indices = std::move(pass.indices);
+  return std::sqrt(error);
+}
+
+} // namespace Engine::Core::Geometry
@@ -0,0 +1,117 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file MappedFile.cpp
+ * @brief Implementation of MappedFile class
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include "core/io/MappedFile.h"
+
+#include <cstdio>
+
+#if defined(__unix__) || defined(__APPLE__)
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace Engine::Core::Io
+{
+
+MappedFile::MappedFile() noexcept
+    : data(nullptr),
+      size(0),
+      mapped(false),
+      opened(false)
+{
+}
+
+MappedFile::~MappedFile() noexcept
+{
+  Close();
+}
+
+bool MappedFile::Open(const char* path) noexcept
+{
+  Close();
+
+#if defined(__unix__) || defined(__APPLE__)
+  int descriptor = open(path, O_RDONLY);
+  if (descriptor < 0)
+    return false;
+
+  struct stat status;
+  if (fstat(descriptor, &status) != 0) {
+    close(descriptor);
+    return false;
+  }
+
+  // empty files can not be mapped, they are open with no data
+  if (status.st_size > 0) {
+    std::size_t length = static_cast<std::size_t>(status.st_size);
+    void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    if (address != MAP_FAILED) {
+      madvise(address, length, MADV_SEQUENTIAL);
+      data = static_cast<const char*>(address);
+      size = length;
+      mapped = true;
+    }
+  }
+  close(descriptor);
+  opened = mapped || status.st_size == 0;
+  return opened;
+#else
+  std::FILE* file = std::fopen(path, "rb");
+  if (!file)
+    return false;
+
+  char block[64 * 1024];
+  std::size_t read;
+  while ((read = std::fread(block, 1, sizeof(block), file)) > 0)
+    buffer.insert(buffer.end(), block, block + read);
+  bool failed = std::ferror(file) != 0;
+  std::fclose(file);
+  if (failed) {
+    buffer.clear();
+    return false;
+  }
+
+  data = buffer.data();
+  size = buffer.size();
+  opened = true;
+  return true;
+#endif
+}
+
+void MappedFile::Close() noexcept
+{
+#if defined(__unix__) || defined(__APPLE__)
+  if (mapped)
+    munmap(const_cast<char*>(data), size);
+#endif
+  buffer.clear();
+  data = nullptr;
+  size = 0;
+  mapped = false;
+  opened = false;
+}
+
+bool MappedFile::IsOpen() const noexcept
+{
+  return opened;
+}
+
+const char* MappedFile::Data() const noexcept
+{
+  return data;
+}
+
+std::size_t MappedFile::Size() const noexcept
+{
+  return size;
+}
+
+} // namespace Engine::Core::Io
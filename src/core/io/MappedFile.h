@@ -0,0 +1,51 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file MappedFile.h
+ * @brief Read-only view of a whole file mapped into memory
+ *
+ * On POSIX systems the file is mapped with mmap and the kernel is told that it will be read
+ * sequentially, so pages are read ahead while parsers consume earlier ones and no copy of the file
+ * is made. Elsewhere the file is read into a heap buffer once.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace Engine::Core::Io
+{
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+class MappedFile
+{
+ public:
+  MappedFile() noexcept;
+  ~MappedFile() noexcept;
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /// Maps file at path replacing a previously opened one, false when it can not be read
+  bool Open(const char* path) noexcept;
+  void Close() noexcept;
+
+  bool IsOpen() const noexcept;
+  const char* Data() const noexcept;
+  std::size_t Size() const noexcept;
+
+ private:
+  const char* data;
+  std::size_t size;
+  bool mapped;
+  bool opened;
+  /// Contents of files which are read instead of mapped
+  std::vector<char> buffer;
+};
+
+} // namespace Engine::Core::Io
@@ -0,0 +1,271 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file PointCloudLoader.cpp
+ * @brief Implementation of PLY header parsing and line splitting
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include "core/io/PointCloudLoader.h"
+
+#include <string_view>
+
+namespace Engine::Core::Io::Internal
+{
+
+namespace
+{
+
+constexpr std::string_view plyMagic = "ply";
+
+/// Reads the next line of the header, false at the end of data
+bool NextLine(
+    const char* data,
+    std::size_t size,
+    std::size_t& position,
+    std::string_view& line
+) noexcept
+{
+  if (position >= size)
+    return false;
+  const char* begin = data + position;
+  const char* end = static_cast<const char*>(std::memchr(begin, '\n', size - position));
+  if (!end)
+    end = data + size;
+  position = end - data + 1;
+  line = std::string_view(begin, end - begin);
+  if (!line.empty() && line.back() == '\r')
+    line.remove_suffix(1);
+  return true;
+}
+
+/// Splits the next space separated word off line
+std::string_view NextWord(std::string_view& line) noexcept
+{
+  std::size_t begin = line.find_first_not_of(" \t");
+  if (begin == std::string_view::npos) {
+    line = std::string_view();
+    return line;
+  }
+  std::size_t end = line.find_first_of(" \t", begin);
+  if (end == std::string_view::npos)
+    end = line.size();
+  std::string_view word = line.substr(begin, end - begin);
+  line.remove_prefix(end);
+  return word;
+}
+
+bool ParsePlyType(std::string_view name, PlyType& type) noexcept
+{
+  struct Alias
+  {
+    std::string_view name;
+    PlyType type;
+  };
+  static constexpr Alias aliases[] = {
+      {"char", PlyType::Int8},       {"int8", PlyType::Int8},        {"uchar", PlyType::UInt8},
+      {"uint8", PlyType::UInt8},     {"short", PlyType::Int16},      {"int16", PlyType::Int16},
+      {"ushort", PlyType::UInt16},   {"uint16", PlyType::UInt16},    {"int", PlyType::Int32},
+      {"int32", PlyType::Int32},     {"uint", PlyType::UInt32},      {"uint32", PlyType::UInt32},
+      {"float", PlyType::Float32},   {"float32", PlyType::Float32},  {"double", PlyType::Float64},
+      {"float64", PlyType::Float64},
+  };
+  for (const Alias& alias : aliases) {
+    if (alias.name == name) {
+      type = alias.type;
+      return true;
+    }
+  }
+  return false;
+}
+
+u32 PlyTypeSize(PlyType type) noexcept
+{
+  switch (type) {
+    case PlyType::Int8:
+    case PlyType::UInt8:
+      return 1;
+    case PlyType::Int16:
+    case PlyType::UInt16:
+      return 2;
+    case PlyType::Int32:
+    case PlyType::UInt32:
+    case PlyType::Float32:
+      return 4;
+    case PlyType::Float64:
+      return 8;
+  }
+  return 0;
+}
+
+template <typename T>
+T ReadSwapped(const char* data, bool swapBytes) noexcept
+{
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, data, sizeof(T));
+  if (swapBytes)
+    std::reverse(bytes, bytes + sizeof(T));
+  T value;
+  std::memcpy(&value, bytes, sizeof(T));
+  return value;
+}
+
+} // namespace
+
+bool IsPly(const char* data, std::size_t size) noexcept
+{
+  std::size_t position = 0;
+  std::string_view line;
+  return NextLine(data, size, position, line) && line == plyMagic;
+}
+
+PointCloudStatus ParsePlyHeader(const char* data, std::size_t size, PlyHeader& header) noexcept
+{
+  std::size_t position = 0;
+  std::string_view line;
+  if (!NextLine(data, size, position, line) || line != plyMagic)
+    return PointCloudStatus::UnsupportedFormat;
+
+  bool hasFormat = false;
+  bool hasVertex = false;
+  // properties are only collected while the first element is the vertex element
+  bool inVertex = false;
+  u32 property = 0;
+  bool found[3] = {false, false, false};
+  header.stride = 0;
+  header.vertexCount = 0;
+
+  while (NextLine(data, size, position, line)) {
+    std::string_view keyword = NextWord(line);
+    if (keyword == "end_header") {
+      if (!hasFormat || !hasVertex || !found[0] || !found[1] || !found[2])
+        return PointCloudStatus::Malformed;
+      header.bodyOffset = std::min(position, size);
+      return PointCloudStatus::Ok;
+    }
+
+    if (keyword == "format") {
+      std::string_view encoding = NextWord(line);
+      if (encoding == "ascii")
+        header.encoding = PlyEncoding::Ascii;
+      else if (encoding == "binary_little_endian")
+        header.encoding = PlyEncoding::BinaryLittleEndian;
+      else if (encoding == "binary_big_endian")
+        header.encoding = PlyEncoding::BinaryBigEndian;
+      else
+        return PointCloudStatus::UnsupportedFormat;
+      hasFormat = true;
+    } else if (keyword == "element") {
+      std::string_view name = NextWord(line);
+      std::string_view count = NextWord(line);
+      if (!hasVertex) {
+        // the vertex body is only located without skipping other elements when it comes first
+        if (name != "vertex")
+          return PointCloudStatus::UnsupportedFormat;
+        std::from_chars_result result =
+            std::from_chars(count.data(), count.data() + count.size(), header.vertexCount);
+        if (result.ec != std::errc() || result.ptr != count.data() + count.size())
+          return PointCloudStatus::Malformed;
+        hasVertex = true;
+        inVertex = true;
+      } else {
+        inVertex = false;
+      }
+    } else if (keyword == "property" && inVertex) {
+      std::string_view typeName = NextWord(line);
+      PlyType type;
+      if (typeName == "list")
+        return PointCloudStatus::UnsupportedFormat;
+      if (!ParsePlyType(typeName, type))
+        return PointCloudStatus::Malformed;
+
+      std::string_view name = NextWord(line);
+      int axis = name == "x" ? 0 : name == "y" ? 1 : name == "z" ? 2 : -1;
+      if (axis >= 0) {
+        header.columns[axis] = property;
+        header.offsets[axis] = header.stride;
+        header.types[axis] = type;
+        found[axis] = true;
+      }
+      header.stride += PlyTypeSize(type);
+      ++property;
+    } else if (keyword != "comment" && keyword != "obj_info" && keyword != "property") {
+      return PointCloudStatus::Malformed;
+    }
+  }
+  return PointCloudStatus::Malformed;
+}
+
+void SplitLines(
+    const char* data,
+    std::size_t size,
+    std::size_t chunkSize,
+    std::vector<std::size_t>& bounds
+) noexcept
+{
+  bounds.clear();
+  bounds.push_back(0);
+  std::size_t begin = 0;
+  while (size - begin > chunkSize) {
+    const char* start = data + begin + chunkSize;
+    const char* newline = static_cast<const char*>(std::memchr(start, '\n', data + size - start));
+    if (!newline)
+      break;
+    begin = newline - data + 1;
+    if (begin >= size)
+      break;
+    bounds.push_back(begin);
+  }
+  bounds.push_back(size);
+}
+
+std::size_t CountPointLines(const char* begin, const char* end) noexcept
+{
+  std::size_t count = 0;
+  const char* p = begin;
+  while (p < end) {
+    while (p < end && IsSeparator(*p))
+      ++p;
+    if (p < end && *p != '\n' && *p != '#')
+      ++count;
+    const char* newline = static_cast<const char*>(std::memchr(p, '\n', end - p));
+    if (!newline)
+      break;
+    p = newline + 1;
+  }
+  return count;
+}
+
+f64 ReadPlyScalar(const char* data, PlyType type, bool swapBytes) noexcept
+{
+  switch (type) {
+    case PlyType::Int8:
+      return ReadSwapped<i8>(data, swapBytes);
+    case PlyType::UInt8:
+      return ReadSwapped<u8>(data, swapBytes);
+    case PlyType::Int16:
+      return ReadSwapped<i16>(data, swapBytes);
+    case PlyType::UInt16:
+      return ReadSwapped<u16>(data, swapBytes);
+    case PlyType::Int32:
+      return ReadSwapped<i32>(data, swapBytes);
+    case PlyType::UInt32:
+      return ReadSwapped<u32>(data, swapBytes);
+    case PlyType::Float32:
+      return ReadSwapped<f32>(data, swapBytes);
+    case PlyType::Float64:
+      return ReadSwapped<f64>(data, swapBytes);
+  }
+  return 0.0;
+}
+
+bool HostIsLittleEndian() noexcept
+{
+  constexpr u16 probe = 1;
+  u8 first;
+  std::memcpy(&first, &probe, 1);
+  return first == 1;
+}
+
+} // namespace Engine::Core::Io::Internal
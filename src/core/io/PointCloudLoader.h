@@ -0,0 +1,446 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file PointCloudLoader.h
+ * @brief Parallel loading of XYZ and PLY point clouds into Vector3Array
+ *
+ * Files are mapped instead of streamed and parsed in place. Text bodies are cut into chunks at
+ * line starts; one pass counts the points of every chunk, a scan of the counts gives each chunk
+ * its first output index and a second pass parses all chunks independently with from_chars
+ * straight into the x, y and z arrays. Binary PLY vertices have a fixed stride, so they are
+ * converted by plain index ranges. Both passes run on a thread pool when one is given.
+ *
+ * XYZ files hold one point per line as the first three numbers separated by spaces, tabs, commas
+ * or semicolons; further columns, blank lines and lines starting with # are ignored. PLY files
+ * may be ASCII or binary of either byte order, the vertex element must come first and have no
+ * list properties, its x, y and z properties may be of any scalar type.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/io/MappedFile.h"
+#include "core/math/Vector3Array.h"
+#include "core/parallel/Scan.h"
+#include "core/parallel/ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace Engine::Core::Io
+{
+
+using Math::Vector3Array;
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+struct PointCloudLoaderSettings
+{
+  /// Bytes of text parsed as one task, binary bodies are split into the same number of bytes
+  static constexpr std::size_t grain = 4 * 1024 * 1024;
+};
+
+enum class PointCloudFormat
+{
+  /// PLY when the data starts with the PLY magic line, XYZ otherwise
+  Auto,
+  Xyz,
+  Ply
+};
+
+enum class PointCloudStatus
+{
+  Ok,
+  OpenFailed,
+  UnsupportedFormat,
+  Malformed
+};
+
+/// Parses a point cloud held in memory, points are replaced on success and cleared on failure
+template <typename T>
+PointCloudStatus ParsePointCloud(
+    const char* data,
+    std::size_t size,
+    Vector3Array<T>& points,
+    PointCloudFormat format = PointCloudFormat::Auto
+) noexcept;
+
+template <typename T>
+PointCloudStatus ParsePointCloud(
+    const char* data,
+    std::size_t size,
+    Vector3Array<T>& points,
+    Parallel::ThreadPool& pool,
+    PointCloudFormat format = PointCloudFormat::Auto,
+    std::size_t grain = PointCloudLoaderSettings::grain
+) noexcept;
+
+template <typename T>
+PointCloudStatus LoadPointCloud(
+    const char* path,
+    Vector3Array<T>& points,
+    PointCloudFormat format = PointCloudFormat::Auto
+) noexcept;
+
+template <typename T>
+PointCloudStatus LoadPointCloud(
+    const char* path,
+    Vector3Array<T>& points,
+    Parallel::ThreadPool& pool,
+    PointCloudFormat format = PointCloudFormat::Auto,
+    std::size_t grain = PointCloudLoaderSettings::grain
+) noexcept;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+namespace Internal
+{
+
+enum class PlyEncoding
+{
+  Ascii,
+  BinaryLittleEndian,
+  BinaryBigEndian
+};
+
+enum class PlyType : u8
+{
+  Int8,
+  UInt8,
+  Int16,
+  UInt16,
+  Int32,
+  UInt32,
+  Float32,
+  Float64
+};
+
+struct PlyHeader
+{
+  PlyEncoding encoding;
+  std::size_t vertexCount;
+  /// Bytes of one binary vertex
+  u32 stride;
+  /// Property index of x, y and z, which is the token index of ASCII vertex lines
+  u32 columns[3];
+  /// Byte offset of x, y and z in a binary vertex
+  u32 offsets[3];
+  PlyType types[3];
+  /// Offset of the first vertex from the start of the data
+  std::size_t bodyOffset;
+};
+
+bool IsPly(const char* data, std::size_t size) noexcept;
+PointCloudStatus ParsePlyHeader(const char* data, std::size_t size, PlyHeader& header) noexcept;
+/// Chunk boundaries at line starts, bounds holds chunk count + 1 offsets from 0 to size
+void SplitLines(
+    const char* data,
+    std::size_t size,
+    std::size_t chunkSize,
+    std::vector<std::size_t>& bounds
+) noexcept;
+/// Lines of [begin, end) holding a point, not blank and not a # comment
+std::size_t CountPointLines(const char* begin, const char* end) noexcept;
+/// Reads a binary PLY scalar converting it to double and host byte order
+f64 ReadPlyScalar(const char* data, PlyType type, bool swapBytes) noexcept;
+bool HostIsLittleEndian() noexcept;
+
+inline bool IsSeparator(char c) noexcept
+{
+  return c == ' ' || c == '\t' || c == ',' || c == ';' || c == '\r';
+}
+
+template <typename T>
+const char* ParseNumber(const char* p, const char* end, T& value) noexcept
+{
+  if (p != end && *p == '+')
+    ++p;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+  std::from_chars_result result = std::from_chars(p, end, value);
+  return result.ec == std::errc() ? result.ptr : nullptr;
+#else
+  // strtod needs a terminated string, numbers longer than the buffer are malformed anyway
+  char buffer[64];
+  std::size_t length = std::min<std::size_t>(end - p, sizeof(buffer) - 1);
+  std::memcpy(buffer, p, length);
+  buffer[length] = '\0';
+  char* next;
+  value = static_cast<T>(std::strtod(buffer, &next));
+  return next == buffer ? nullptr : p + (next - buffer);
+#endif
+}
+
+/**
+ * @brief Parses point lines of [begin, end) into x, y and z from index first
+ * @param columns token index of x, y and z in a line
+ * @param limit number of points to parse, the rest of the range is left alone
+ * @return false for a line without a number at a requested column
+ */
+template <typename T>
+bool ParsePointLines(
+    const char* begin,
+    const char* end,
+    const u32* columns,
+    std::size_t limit,
+    T* x,
+    T* y,
+    T* z
+) noexcept
+{
+  T* outputs[3] = {x, y, z};
+  u32 lastColumn = std::max({columns[0], columns[1], columns[2]});
+  std::size_t parsed = 0;
+  const char* p = begin;
+
+  while (p < end && parsed < limit) {
+    const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', end - p));
+    if (!lineEnd)
+      lineEnd = end;
+
+    while (p < lineEnd && IsSeparator(*p))
+      ++p;
+    if (p == lineEnd || *p == '#') {
+      p = lineEnd + 1;
+      continue;
+    }
+
+    u32 found = 0;
+    for (u32 column = 0; column <= lastColumn; ++column) {
+      while (p < lineEnd && IsSeparator(*p))
+        ++p;
+      if (p == lineEnd)
+        return false;
+
+      const char* tokenEnd = p;
+      while (tokenEnd < lineEnd && !IsSeparator(*tokenEnd))
+        ++tokenEnd;
+      for (u32 axis = 0; axis < 3; ++axis) {
+        if (columns[axis] != column)
+          continue;
+        T value;
+        if (ParseNumber(p, tokenEnd, value) != tokenEnd)
+          return false;
+        outputs[axis][parsed] = value;
+        ++found;
+      }
+      p = tokenEnd;
+    }
+    if (found != 3)
+      return false;
+
+    ++parsed;
+    p = lineEnd + 1;
+  }
+  return parsed == limit;
+}
+
+/**
+ * @brief Parses text of point lines
+ * @param maxPoints stop after this many points, PLY bodies continue with other elements
+ */
+template <typename T>
+PointCloudStatus ParseText(
+    const char* data,
+    std::size_t size,
+    const u32* columns,
+    std::size_t maxPoints,
+    Vector3Array<T>& points,
+    Parallel::ThreadPool* pool,
+    std::size_t grain
+) noexcept
+{
+  std::vector<std::size_t> bounds;
+  SplitLines(data, size, std::max<std::size_t>(grain, 1), bounds);
+  std::size_t chunks = bounds.size() - 1;
+  std::vector<std::size_t> counts(chunks);
+  auto run = [pool, chunks](auto&& func) {
+    if (pool)
+      pool->ParallelFor(chunks, 1, func);
+    else
+      func(0, chunks);
+  };
+
+  run([&](std::size_t first, std::size_t last) {
+    for (std::size_t chunk = first; chunk < last; ++chunk)
+      counts[chunk] = CountPointLines(data + bounds[chunk], data + bounds[chunk + 1]);
+  });
+
+  std::size_t total = Parallel::ExclusiveScan(counts.data(), counts.data(), chunks);
+  if (total < maxPoints && maxPoints != ~std::size_t(0))
+    return PointCloudStatus::Malformed;
+  std::size_t count = std::min(total, maxPoints);
+  points.Resize(count);
+
+  std::atomic<bool> malformed{false};
+  run([&](std::size_t first, std::size_t last) {
+    for (std::size_t chunk = first; chunk < last; ++chunk) {
+      std::size_t offset = counts[chunk];
+      if (offset >= count)
+        continue;
+      std::size_t limit = std::min(count - offset, chunk + 1 < chunks ? counts[chunk + 1] - offset
+                                                                      : count - offset);
+      bool parsed = ParsePointLines(
+          data + bounds[chunk], data + bounds[chunk + 1], columns, limit,
+          points.x.data() + offset, points.y.data() + offset, points.z.data() + offset
+      );
+      if (!parsed)
+        malformed.store(true, std::memory_order_relaxed);
+    }
+  });
+  return malformed.load() ? PointCloudStatus::Malformed : PointCloudStatus::Ok;
+}
+
+template <typename T>
+PointCloudStatus ParseBinaryPly(
+    const char* data,
+    std::size_t size,
+    const PlyHeader& header,
+    Vector3Array<T>& points,
+    Parallel::ThreadPool* pool,
+    std::size_t grain
+) noexcept
+{
+  std::size_t count = header.vertexCount;
+  if (count > (size - header.bodyOffset) / header.stride)
+    return PointCloudStatus::Malformed;
+
+  bool swapBytes = (header.encoding == PlyEncoding::BinaryLittleEndian) != HostIsLittleEndian();
+  const char* body = data + header.bodyOffset;
+  points.Resize(count);
+
+  auto convert = [&](std::size_t begin, std::size_t end) {
+    T* outputs[3] = {points.x.data(), points.y.data(), points.z.data()};
+    for (u32 axis = 0; axis < 3; ++axis) {
+      const char* source = body + header.offsets[axis];
+      PlyType type = header.types[axis];
+      // the common case of native floats is a strided copy
+      if (type == PlyType::Float32 && !swapBytes) {
+        for (std::size_t i = begin; i < end; ++i) {
+          f32 value;
+          std::memcpy(&value, source + i * header.stride, sizeof(value));
+          outputs[axis][i] = static_cast<T>(value);
+        }
+      } else {
+        for (std::size_t i = begin; i < end; ++i)
+          outputs[axis][i] =
+              static_cast<T>(ReadPlyScalar(source + i * header.stride, type, swapBytes));
+      }
+    }
+  };
+
+  std::size_t vertexGrain = std::max<std::size_t>(grain / header.stride, 1);
+  if (pool)
+    pool->ParallelFor(count, vertexGrain, convert);
+  else
+    convert(0, count);
+  return PointCloudStatus::Ok;
+}
+
+template <typename T>
+PointCloudStatus ParsePointCloud(
+    const char* data,
+    std::size_t size,
+    Vector3Array<T>& points,
+    PointCloudFormat format,
+    Parallel::ThreadPool* pool,
+    std::size_t grain
+) noexcept
+{
+  if (format == PointCloudFormat::Auto)
+    format = IsPly(data, size) ? PointCloudFormat::Ply : PointCloudFormat::Xyz;
+
+  PointCloudStatus status;
+  if (format == PointCloudFormat::Xyz) {
+    constexpr u32 columns[3] = {0, 1, 2};
+    status = ParseText(data, size, columns, ~std::size_t(0), points, pool, grain);
+  } else {
+    PlyHeader header;
+    status = ParsePlyHeader(data, size, header);
+    if (status == PointCloudStatus::Ok && header.encoding == PlyEncoding::Ascii) {
+      status = ParseText(
+          data + header.bodyOffset, size - header.bodyOffset, header.columns, header.vertexCount,
+          points, pool, grain
+      );
+    } else if (status == PointCloudStatus::Ok) {
+      status = ParseBinaryPly(data, size, header, points, pool, grain);
+    }
+  }
+
+  if (status != PointCloudStatus::Ok)
+    points.Clear();
+  return status;
+}
+
+template <typename T>
+PointCloudStatus LoadPointCloud(
+    const char* path,
+    Vector3Array<T>& points,
+    PointCloudFormat format,
+    Parallel::ThreadPool* pool,
+    std::size_t grain
+) noexcept
+{
+  MappedFile file;
+  if (!file.Open(path)) {
+    points.Clear();
+    return PointCloudStatus::OpenFailed;
+  }
+  return ParsePointCloud(file.Data(), file.Size(), points, format, pool, grain);
+}
+
+} // namespace Internal
+
+template <typename T>
+PointCloudStatus ParsePointCloud(
+    const char* data,
+    std::size_t size,
+    Vector3Array<T>& points,
+    PointCloudFormat format
+) noexcept
+{
+  return Internal::ParsePointCloud(
+      data, size, points, format, nullptr, PointCloudLoaderSettings::grain
+  );
+}
+
+template <typename T>
+PointCloudStatus ParsePointCloud(
+    const char* data,
+    std::size_t size,
+    Vector3Array<T>& points,
+    Parallel::ThreadPool& pool,
+    PointCloudFormat format,
+    std::size_t grain
+) noexcept
+{
+  return Internal::ParsePointCloud(data, size, points, format, &pool, grain);
+}
+
+template <typename T>
+PointCloudStatus LoadPointCloud(
+    const char* path,
+    Vector3Array<T>& points,
+    PointCloudFormat format
+) noexcept
+{
+  return Internal::LoadPointCloud(path, points, format, nullptr, PointCloudLoaderSettings::grain);
+}
+
+template <typename T>
+PointCloudStatus LoadPointCloud(
+    const char* path,
+    Vector3Array<T>& points,
+    Parallel::ThreadPool& pool,
+    PointCloudFormat format,
+    std::size_t grain
+) noexcept
+{
+  return Internal::LoadPointCloud(path, points, format, &pool, grain);
+}
+
+} // namespace Engine::Core::Io
@@ -0,0 +1,237 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file AABB.h
+ * @brief Implementation of AABB (axis aligned bounding box) class
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/math/Vector3.h"
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <string>
+
+namespace Engine::Core::Math
+{
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+template <typename T>
+class AABB
+{
+ public:
+  Vector3<T> min;
+  Vector3<T> max;
+
+  /// Inverted box which becomes valid after the first Merge
+  static constexpr AABB<T> Empty() noexcept;
+  static constexpr AABB<T> FromCenterExtents(
+      const Vector3<T>& center,
+      const Vector3<T>& halfExtents
+  ) noexcept;
+
+  constexpr AABB() noexcept;
+  constexpr AABB(const Vector3<T>& min, const Vector3<T>& max) noexcept;
+
+  constexpr bool operator==(const AABB<T>& b) const noexcept;
+  constexpr bool operator!=(const AABB<T>& b) const noexcept;
+
+  constexpr bool IsValid() const noexcept;
+  constexpr Vector3<T> Center() const noexcept;
+  constexpr Vector3<T> Extents() const noexcept;
+  constexpr Vector3<T> Size() const noexcept;
+  constexpr T SurfaceArea() const noexcept;
+  constexpr T Volume() const noexcept;
+
+  constexpr bool Contains(const Vector3<T>& point) const noexcept;
+  constexpr bool Contains(const AABB<T>& b) const noexcept;
+  constexpr bool Overlaps(const AABB<T>& b) const noexcept;
+  constexpr T DistanceSquaredTo(const Vector3<T>& point) const noexcept;
+
+  constexpr AABB<T> Merged(const Vector3<T>& point) const noexcept;
+  constexpr AABB<T> Merged(const AABB<T>& b) const noexcept;
+  constexpr AABB<T>& Merge(const Vector3<T>& point) noexcept;
+  constexpr AABB<T>& Merge(const AABB<T>& b) noexcept;
+  constexpr AABB<T> Expanded(T margin) const noexcept;
+
+  std::string ToString(int precision = 2) const noexcept;
+};
+
+/* --------------------------------- Friend methods declaration -------------------------------- */
+template <typename T>
+constexpr std::ostream& operator<<(std::ostream& os, const AABB<T>& b) noexcept;
+
+/* ------------------------------------------- Usings ------------------------------------------ */
+using AABBf = AABB<f32>;
+using AABBd = AABB<f64>;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+template <typename T>
+constexpr AABB<T> AABB<T>::Empty() noexcept
+{
+  constexpr T limit = std::numeric_limits<T>::max();
+  return AABB<T>(Vector3<T>(limit, limit, limit), Vector3<T>(-limit, -limit, -limit));
+}
+
+template <typename T>
+constexpr AABB<T> AABB<T>::FromCenterExtents(
+    const Vector3<T>& center,
+    const Vector3<T>& halfExtents
+) noexcept
+{
+  return AABB<T>(center - halfExtents, center + halfExtents);
+}
+
+template <typename T>
+constexpr AABB<T>::AABB() noexcept
+    : min(),
+      max()
+{
+}
+
+template <typename T>
+constexpr AABB<T>::AABB(const Vector3<T>& min, const Vector3<T>& max) noexcept
+    : min(min),
+      max(max)
+{
+}
+
+template <typename T>
+constexpr bool AABB<T>::operator==(const AABB<T>& b) const noexcept
+{
+  return min == b.min && max == b.max;
+}
+
+template <typename T>
+constexpr bool AABB<T>::operator!=(const AABB<T>& b) const noexcept
+{
+  return min != b.min || max != b.max;
+}
+
+template <typename T>
+constexpr bool AABB<T>::IsValid() const noexcept
+{
+  return min.x <= max.x && min.y <= max.y && min.z <= max.z;
+}
+
+template <typename T>
+constexpr Vector3<T> AABB<T>::Center() const noexcept
+{
+  return (min + max) * static_cast<T>(0.5);
+}
+
+template <typename T>
+constexpr Vector3<T> AABB<T>::Extents() const noexcept
+{
+  return (max - min) * static_cast<T>(0.5);
+}
+
+template <typename T>
+constexpr Vector3<T> AABB<T>::Size() const noexcept
+{
+  return max - min;
+}
+
+template <typename T>
+constexpr T AABB<T>::SurfaceArea() const noexcept
+{
+  Vector3<T> size = Size();
+  return static_cast<T>(2) * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+template <typename T>
+constexpr T AABB<T>::Volume() const noexcept
+{
+  Vector3<T> size = Size();
+  return size.x * size.y * size.z;
+}
+
+template <typename T>
+constexpr bool AABB<T>::Contains(const Vector3<T>& point) const noexcept
+{
+  return point.x >= min.x && point.x <= max.x && point.y >= min.y && point.y <= max.y &&
+         point.z >= min.z && point.z <= max.z;
+}
+
+template <typename T>
+constexpr bool AABB<T>::Contains(const AABB<T>& b) const noexcept
+{
+  return b.min.x >= min.x && b.max.x <= max.x && b.min.y >= min.y && b.max.y <= max.y &&
+         b.min.z >= min.z && b.max.z <= max.z;
+}
+
+template <typename T>
+constexpr bool AABB<T>::Overlaps(const AABB<T>& b) const noexcept
+{
+  return min.x <= b.max.x && b.min.x <= max.x && min.y <= b.max.y && b.min.y <= max.y &&
+         min.z <= b.max.z && b.min.z <= max.z;
+}
+
+template <typename T>
+constexpr T AABB<T>::DistanceSquaredTo(const Vector3<T>& point) const noexcept
+{
+  T dx = std::max(std::max(min.x - point.x, point.x - max.x), static_cast<T>(0));
+  T dy = std::max(std::max(min.y - point.y, point.y - max.y), static_cast<T>(0));
+  T dz = std::max(std::max(min.z - point.z, point.z - max.z), static_cast<T>(0));
+  return dx * dx + dy * dy + dz * dz;
+}
+
+template <typename T>
+constexpr AABB<T> AABB<T>::Merged(const Vector3<T>& point) const noexcept
+{
+  return AABB<T>(
+      Vector3<T>(std::min(min.x, point.x), std::min(min.y, point.y), std::min(min.z, point.z)),
+      Vector3<T>(std::max(max.x, point.x), std::max(max.y, point.y), std::max(max.z, point.z))
+  );
+}
+
+template <typename T>
+constexpr AABB<T> AABB<T>::Merged(const AABB<T>& b) const noexcept
+{
+  return AABB<T>(
+      Vector3<T>(std::min(min.x, b.min.x), std::min(min.y, b.min.y), std::min(min.z, b.min.z)),
+      Vector3<T>(std::max(max.x, b.max.x), std::max(max.y, b.max.y), std::max(max.z, b.max.z))
+  );
+}
+
+template <typename T>
+constexpr AABB<T>& AABB<T>::Merge(const Vector3<T>& point) noexcept
+{
+  *this = Merged(point);
+  return *this;
+}
+
+template <typename T>
+constexpr AABB<T>& AABB<T>::Merge(const AABB<T>& b) noexcept
+{
+  *this = Merged(b);
+  return *this;
+}
+
+template <typename T>
+constexpr AABB<T> AABB<T>::Expanded(T margin) const noexcept
+{
+  Vector3<T> offset(margin, margin, margin);
+  return AABB<T>(min - offset, max + offset);
+}
+
+template <typename T>
+std::string AABB<T>::ToString(int precision) const noexcept
+{
+  std::ostringstream oss;
+  oss << "(" << min.ToString(precision) << ", " << max.ToString(precision) << ")";
+  return oss.str();
+}
+
+template <typename T>
+constexpr std::ostream& operator<<(std::ostream& os, const AABB<T>& b) noexcept
+{
+  return os << b.ToString();
+}
+
+} // namespace Engine::Core::Math
@@ -0,0 +1,117 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file FastMath.cpp
+ * @brief Implementation of batch forms of fast math functions
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include "core/math/FastMath.h"
+
+#include <algorithm>
+
+namespace Engine::Core::Math
+{
+
+namespace
+{
+
+template <typename Kernel>
+void Map(const f32* x, f32* out, std::size_t count, Kernel&& kernel) noexcept
+{
+  ForEachLane(0, count, [&](auto lanes, std::size_t i) {
+    using V = decltype(lanes);
+    Store(kernel(Load<V>(x + i)), out + i);
+  });
+}
+
+/// Buffer of dot products and cross product lengths handed to FastAtan2 in blocks
+constexpr std::size_t angleBlock = 256;
+
+} // namespace
+
+void FastSin(const f32* x, f32* out, std::size_t count) noexcept
+{
+  Map(x, out, count, [](auto v) { return FastSin(v); });
+}
+
+void FastCos(const f32* x, f32* out, std::size_t count) noexcept
+{
+  Map(x, out, count, [](auto v) { return FastCos(v); });
+}
+
+void FastSinCos(const f32* x, f32* sin, f32* cos, std::size_t count) noexcept
+{
+  ForEachLane(0, count, [&](auto lanes, std::size_t i) {
+    using V = decltype(lanes);
+    V s;
+    V c;
+    FastSinCos(Load<V>(x + i), s, c);
+    Store(s, sin + i);
+    Store(c, cos + i);
+  });
+}
+
+void FastAtan2(const f32* y, const f32* x, f32* out, std::size_t count) noexcept
+{
+  ForEachLane(0, count, [&](auto lanes, std::size_t i) {
+    using V = decltype(lanes);
+    Store(FastAtan2(Load<V>(y + i), Load<V>(x + i)), out + i);
+  });
+}
+
+void FastAcos(const f32* x, f32* out, std::size_t count) noexcept
+{
+  Map(x, out, count, [](auto v) { return FastAcos(v); });
+}
+
+void FastExp(const f32* x, f32* out, std::size_t count) noexcept
+{
+  Map(x, out, count, [](auto v) { return FastExp(v); });
+}
+
+void FastLog(const f32* x, f32* out, std::size_t count) noexcept
+{
+  Map(x, out, count, [](auto v) { return FastLog(v); });
+}
+
+void AngleToMany(
+    const Vector2<f32>& from,
+    const Vector2<f32>* to,
+    f32* angles,
+    std::size_t count
+) noexcept
+{
+  f32 dots[angleBlock];
+  f32 crosses[angleBlock];
+  for (std::size_t begin = 0; begin < count; begin += angleBlock) {
+    std::size_t size = std::min(angleBlock, count - begin);
+    for (std::size_t i = 0; i < size; ++i) {
+      dots[i] = from.Dot(to[begin + i]);
+      crosses[i] = from.Cross(to[begin + i]);
+    }
+    FastAtan2(crosses, dots, angles + begin, size);
+  }
+}
+
+void AngleToMany(
+    const Vector3<f32>& from,
+    const Vector3<f32>* to,
+    f32* angles,
+    std::size_t count
+) noexcept
+{
+  f32 dots[angleBlock];
+  f32 crosses[angleBlock];
+  for (std::size_t begin = 0; begin < count; begin += angleBlock) {
+    std::size_t size = std::min(angleBlock, count - begin);
+    for (std::size_t i = 0; i < size; ++i) {
+      dots[i] = from.Dot(to[begin + i]);
+      crosses[i] = from.Cross(to[begin + i]).Length();
+    }
+    FastAtan2(crosses, dots, angles + begin, size);
+  }
+}
+
+} // namespace Engine::Core::Math
@@ -0,0 +1,207 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file FastMath.h
+ * @brief Polynomial approximations of sin, cos, atan2, acos, exp and log for f32 lanes
+ *
+ * Every function is one branch-free kernel templated on the lane type, so it runs on f32, Float4
+ * and Float8 with the same results up to fused multiply-add rounding. Arguments are reduced to a
+ * short interval with a few exact steps and the remainder is evaluated with a minimax polynomial
+ * in Horner form (Cephes and Abramowitz-Stegun coefficients). The batch forms run the widest
+ * lane type available over arrays and finish the tail with scalars; they replace libm calls in
+ * loops over many angles. The error bounds below are absolute unless noted and were measured
+ * against double precision libm over the stated ranges.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/math/SimdFloat.h"
+#include "core/math/Vector2.h"
+#include "core/math/Vector3.h"
+
+#include <cstddef>
+
+namespace Engine::Core::Math
+{
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+/// Max error 1e-7 for |x| <= 8192, accuracy degrades slowly for larger |x|, |x| < 6e6
+template <typename V>
+V FastSin(V x) noexcept;
+/// Max error 1e-7 for |x| <= 8192, accuracy degrades slowly for larger |x|, |x| < 6e6
+template <typename V>
+V FastCos(V x) noexcept;
+template <typename V>
+void FastSinCos(V x, V& sin, V& cos) noexcept;
+/// Max error 3e-7 radians, atan2(0, 0) is 0, infinite arguments are not supported
+template <typename V>
+V FastAtan2(V y, V x) noexcept;
+/// Max error 5e-7 radians for x in [-1, 1]
+template <typename V>
+V FastAcos(V x) noexcept;
+/// Max relative error 1.2e-7, x is clamped to [-87.3, 88.3] so results stay finite and normal
+template <typename V>
+V FastExp(V x) noexcept;
+/// Max error 5e-8 for |log(x)| < 1 and relative error 1e-7 elsewhere, x must be positive and
+/// normal, other arguments give unspecified results
+template <typename V>
+V FastLog(V x) noexcept;
+
+/// Batch forms computing out[i] = f(x[i]), out may alias x
+void FastSin(const f32* x, f32* out, std::size_t count) noexcept;
+void FastCos(const f32* x, f32* out, std::size_t count) noexcept;
+void FastSinCos(const f32* x, f32* sin, f32* cos, std::size_t count) noexcept;
+void FastAtan2(const f32* y, const f32* x, f32* out, std::size_t count) noexcept;
+void FastAcos(const f32* x, f32* out, std::size_t count) noexcept;
+void FastExp(const f32* x, f32* out, std::size_t count) noexcept;
+void FastLog(const f32* x, f32* out, std::size_t count) noexcept;
+
+/// Signed angles from.AngleTo(to[i]) in (-pi, pi], counterclockwise positive
+void AngleToMany(
+    const Vector2<f32>& from,
+    const Vector2<f32>* to,
+    f32* angles,
+    std::size_t count
+) noexcept;
+/// Unsigned angles from.AngleTo(to[i]) in [0, pi]
+void AngleToMany(
+    const Vector3<f32>& from,
+    const Vector3<f32>* to,
+    f32* angles,
+    std::size_t count
+) noexcept;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+namespace Internal
+{
+
+constexpr f32 pi = 3.14159265358979f;
+constexpr f32 halfPi = 1.57079632679490f;
+
+/// Evaluates coefficients[0] * x^(n-1) + ... + coefficients[n-1]
+template <typename V, std::size_t N>
+V Horner(V x, const f32 (&coefficients)[N]) noexcept
+{
+  V result(coefficients[0]);
+  for (std::size_t i = 1; i < N; ++i)
+    result = MulAdd(result, x, V(coefficients[i]));
+  return result;
+}
+
+} // namespace Internal
+
+template <typename V>
+void FastSinCos(V x, V& sin, V& cos) noexcept
+{
+  // x = q * pi / 2 + r with pi / 2 split into three parts whose products with q are exact
+  constexpr f32 twoOverPi = 0.636619772367581f;
+  V q = Round(x * V(twoOverPi));
+  V r = MulAdd(q, V(-1.5703125f), x);
+  r = MulAdd(q, V(-4.837512969970703125e-4f), r);
+  r = MulAdd(q, V(-7.54978995489188216e-8f), r);
+
+  // minimax polynomials on [-pi / 4, pi / 4]
+  constexpr f32 sinCoefficients[] = {-1.9515295891e-4f, 8.3321608736e-3f, -1.6666654611e-1f};
+  constexpr f32 cosCoefficients[] = {2.443315711809948e-5f, -1.388731625493765e-3f,
+                                     4.166664568298827e-2f};
+  V z = r * r;
+  V sinR = MulAdd(Internal::Horner(z, sinCoefficients) * z, r, r);
+  V cosR = MulAdd(z * z, Internal::Horner(z, cosCoefficients), MulAdd(z, V(-0.5f), V(1.0f)));
+
+  // quadrant k = q mod 4 in {-2, -1, 0, 1, 2}, -1 stands for 3 and -2 for 2
+  V k = q - V(4.0f) * Round(q * V(0.25f));
+  auto odd = Abs(k) == V(1.0f);
+  V s = Select(odd, cosR, sinR);
+  V c = Select(odd, sinR, cosR);
+  sin = Select((k < V(0.0f)) | (k > V(1.5f)), -s, s);
+  cos = Select((k > V(0.5f)) | (k < V(-1.5f)), -c, c);
+}
+
+template <typename V>
+V FastSin(V x) noexcept
+{
+  V sin;
+  V cos;
+  FastSinCos(x, sin, cos);
+  return sin;
+}
+
+template <typename V>
+V FastCos(V x) noexcept
+{
+  V sin;
+  V cos;
+  FastSinCos(x, sin, cos);
+  return cos;
+}
+
+template <typename V>
+V FastAtan2(V y, V x) noexcept
+{
+  // Abramowitz-Stegun 4.4.49, atan(a) for a in [0, 1]
+  constexpr f32 coefficients[] = {0.0028662257f,  -0.0161657367f, 0.0429096138f, -0.0752896400f,
+                                  0.1065626393f,  -0.1420889944f, 0.1999355085f, -0.3333314528f};
+  V ax = Abs(x);
+  V ay = Abs(y);
+  V high = Max(ax, ay);
+  V a = Select(high == V(0.0f), V(0.0f), Min(ax, ay) / high);
+  V z = a * a;
+  V r = MulAdd(Internal::Horner(z, coefficients) * z, a, a);
+
+  r = Select(ay > ax, V(Internal::halfPi) - r, r);
+  r = Select(x < V(0.0f), V(Internal::pi) - r, r);
+  return CopySign(r, y);
+}
+
+template <typename V>
+V FastAcos(V x) noexcept
+{
+  // Abramowitz-Stegun 4.4.46, acos(a) = sqrt(1 - a) * p(a) for a in [0, 1]
+  constexpr f32 coefficients[] = {-0.0012624911f, 0.0066700901f,  -0.0170881256f, 0.0308918810f,
+                                  -0.0501743046f, 0.0889789874f, -0.2145988016f, 1.5707963050f};
+  V a = Abs(x);
+  V r = Sqrt(Max(V(1.0f) - a, V(0.0f))) * Internal::Horner(a, coefficients);
+  return Select(x < V(0.0f), V(Internal::pi) - r, r);
+}
+
+template <typename V>
+V FastExp(V x) noexcept
+{
+  // x = n * ln(2) + r, the bounds keep 2^n normal
+  constexpr f32 log2e = 1.44269504088896f;
+  x = Min(Max(x, V(-87.3365f)), V(88.3762f));
+  V n = Round(x * V(log2e));
+  V r = MulAdd(n, V(-0.693359375f), x);
+  r = MulAdd(n, V(2.12194440e-4f), r);
+
+  constexpr f32 coefficients[] = {1.9875691500e-4f, 1.3981999507e-3f, 8.3334519073e-3f,
+                                  4.1665795894e-2f, 1.6666665459e-1f, 5.0000001201e-1f};
+  V e = MulAdd(Internal::Horner(r, coefficients), r * r, r + V(1.0f));
+  return e * Pow2(n);
+}
+
+template <typename V>
+V FastLog(V x) noexcept
+{
+  // x = m * 2^e with m in [sqrt(0.5), sqrt(2)), log(m) = log(1 + f)
+  constexpr f32 sqrtHalf = 0.707106781186547f;
+  V e;
+  V m = Frexp(x, e);
+  auto small = m < V(sqrtHalf);
+  e = Select(small, e - V(1.0f), e);
+  V f = Select(small, m + m - V(1.0f), m - V(1.0f));
+
+  constexpr f32 coefficients[] = {7.0376836292e-2f,  -1.1514610310e-1f, 1.1676998740e-1f,
+                                  -1.2420140846e-1f, 1.4249322787e-1f,  -1.6668057665e-1f,
+                                  2.0000714765e-1f,  -2.4999993993e-1f, 3.3333331174e-1f};
+  V z = f * f;
+  V y = Internal::Horner(f, coefficients) * f * z;
+  y = MulAdd(e, V(-2.12194440e-4f), y);
+  y = MulAdd(z, V(-0.5f), y);
+  return MulAdd(e, V(0.693359375f), f + y);
+}
+
+} // namespace Engine::Core::Math
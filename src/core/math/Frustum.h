@@ -0,0 +1,460 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Frustum.h
+ * @brief Implementation of Frustum class
+ *
+ * Frustum is a set of six planes with normals pointing inside the volume. Besides single object
+ * tests it provides batched culling kernels working on SoA bounds, which process objects in blocks
+ * of eight and write one visibility bit per object.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/math/Plane.h"
+#include "core/math/Vector3.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <sstream>
+#include <string>
+
+namespace Engine::Core::Math
+{
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+enum class Intersection : u8
+{
+  Outside,
+  Intersecting,
+  Inside
+};
+
+template <typename T>
+class Frustum
+{
+ public:
+  enum PlaneIndex : u8
+  {
+    Left,
+    Right,
+    Bottom,
+    Top,
+    Near,
+    Far,
+    PlaneCount
+  };
+
+  /// Number of objects processed by one iteration of the batched kernels
+  static constexpr std::size_t batchSize = 8;
+  /// Plane mask with all six planes enabled
+  static constexpr u8 allPlanes = (1u << PlaneCount) - 1;
+
+  Plane<T> planes[PlaneCount];
+
+  constexpr Frustum() noexcept;
+  constexpr explicit Frustum(const Plane<T> (&planes)[PlaneCount]) noexcept;
+
+  /**
+   * @brief Builds perspective frustum of camera looking along forward
+   * @param fovY vertical field of view in radians
+   */
+  static Frustum<T> FromPerspective(
+      const Vector3<T>& position,
+      const Vector3<T>& forward,
+      const Vector3<T>& up,
+      T fovY,
+      T aspect,
+      T near,
+      T far
+  ) noexcept;
+
+  static Frustum<T> FromOrthographic(
+      const Vector3<T>& position,
+      const Vector3<T>& forward,
+      const Vector3<T>& up,
+      T halfWidth,
+      T halfHeight,
+      T near,
+      T far
+  ) noexcept;
+
+  constexpr bool Contains(const Vector3<T>& point) const noexcept;
+  constexpr bool IntersectsSphere(const Vector3<T>& center, T radius) const noexcept;
+  constexpr bool IntersectsAABB(const Vector3<T>& min, const Vector3<T>& max) const noexcept;
+
+  /**
+   * @brief Sphere test which starts from the plane rejected the object last time
+   * @param lastFailedPlane per object cache, updated when the object is rejected
+   */
+  constexpr bool IntersectsSphere(
+      const Vector3<T>& center,
+      T radius,
+      u8& lastFailedPlane
+  ) const noexcept;
+
+  /**
+   * @brief Classifies AABB against planes enabled in planeMask
+   *
+   * Planes the box is completely inside of are removed from planeMask, so the mask can be passed
+   * down to children of a hierarchy which skip those planes.
+   */
+  constexpr Intersection ClassifyAABB(
+      const Vector3<T>& min,
+      const Vector3<T>& max,
+      u8& planeMask
+  ) const noexcept;
+
+  /**
+   * @brief Culls SoA array of spheres
+   * @param visibility output bitmask of (count + 7) / 8 bytes, bit i % 8 of byte i / 8 is set when
+   * object i is visible
+   * @param lastFailedPlane optional cache of (count + 7) / 8 bytes, one per block of eight
+   * objects; stores plane which rejected the whole block and is tested first on the next call
+   */
+  void CullSpheres(
+      const T* centerX,
+      const T* centerY,
+      const T* centerZ,
+      const T* radius,
+      std::size_t count,
+      u8* visibility,
+      u8* lastFailedPlane = nullptr
+  ) const noexcept;
+
+  /**
+   * @brief Culls SoA array of AABBs, output layout is the same as in CullSpheres
+   */
+  void CullAABBs(
+      const T* minX,
+      const T* minY,
+      const T* minZ,
+      const T* maxX,
+      const T* maxY,
+      const T* maxZ,
+      std::size_t count,
+      u8* visibility,
+      u8* lastFailedPlane = nullptr
+  ) const noexcept;
+
+  std::string ToString(int precision = 2) const noexcept;
+
+ private:
+  template <std::size_t N, typename BlockTest>
+  void CullBatched(
+      const T* const (&streams)[N],
+      std::size_t count,
+      u8* visibility,
+      u8* lastFailedPlane,
+      BlockTest test
+  ) const noexcept;
+
+  static u32 SphereBlockMask(const Plane<T>& plane, const T* const* block) noexcept;
+  static u32 AABBBlockMask(const Plane<T>& plane, const T* const* block) noexcept;
+};
+
+/* --------------------------------- Friend methods declaration -------------------------------- */
+template <typename T>
+constexpr std::ostream& operator<<(std::ostream& os, const Frustum<T>& f) noexcept;
+
+/* ------------------------------------------- Usings ------------------------------------------ */
+using Frustumf = Frustum<f32>;
+using Frustumd = Frustum<f64>;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+template <typename T>
+constexpr Frustum<T>::Frustum() noexcept
+    : planes()
+{
+}
+
+template <typename T>
+constexpr Frustum<T>::Frustum(const Plane<T> (&planes)[PlaneCount]) noexcept
+    : planes{planes[0], planes[1], planes[2], planes[3], planes[4], planes[5]}
+{
+}
+
+template <typename T>
+Frustum<T> Frustum<T>::FromPerspective(
+    const Vector3<T>& position,
+    const Vector3<T>& forward,
+    const Vector3<T>& up,
+    T fovY,
+    T aspect,
+    T near,
+    T far
+) noexcept
+{
+  assert(near > static_cast<T>(0) && far > near && "Invalid clip distances");
+
+  Vector3<T> f = forward.Normalized();
+  Vector3<T> r = f.Cross(up).Normalized();
+  Vector3<T> u = r.Cross(f);
+
+  T halfHeight = std::tan(fovY / static_cast<T>(2));
+  T halfWidth = halfHeight * aspect;
+
+  // side planes pass through camera position and contain one edge direction of the frustum
+  Vector3<T> leftEdge = f - r * halfWidth;
+  Vector3<T> rightEdge = f + r * halfWidth;
+  Vector3<T> bottomEdge = f - u * halfHeight;
+  Vector3<T> topEdge = f + u * halfHeight;
+
+  Frustum<T> frustum;
+  frustum.planes[Left] = Plane<T>(leftEdge.Cross(u).Normalized(), position);
+  frustum.planes[Right] = Plane<T>(u.Cross(rightEdge).Normalized(), position);
+  frustum.planes[Bottom] = Plane<T>(r.Cross(bottomEdge).Normalized(), position);
+  frustum.planes[Top] = Plane<T>(topEdge.Cross(r).Normalized(), position);
+  frustum.planes[Near] = Plane<T>(f, position + f * near);
+  frustum.planes[Far] = Plane<T>(-f, position + f * far);
+  return frustum;
+}
+
+template <typename T>
+Frustum<T> Frustum<T>::FromOrthographic(
+    const Vector3<T>& position,
+    const Vector3<T>& forward,
+    const Vector3<T>& up,
+    T halfWidth,
+    T halfHeight,
+    T near,
+    T far
+) noexcept
+{
+  assert(far > near && "Invalid clip distances");
+
+  Vector3<T> f = forward.Normalized();
+  Vector3<T> r = f.Cross(up).Normalized();
+  Vector3<T> u = r.Cross(f);
+
+  Frustum<T> frustum;
+  frustum.planes[Left] = Plane<T>(r, position - r * halfWidth);
+  frustum.planes[Right] = Plane<T>(-r, position + r * halfWidth);
+  frustum.planes[Bottom] = Plane<T>(u, position - u * halfHeight);
+  frustum.planes[Top] = Plane<T>(-u, position + u * halfHeight);
+  frustum.planes[Near] = Plane<T>(f, position + f * near);
+  frustum.planes[Far] = Plane<T>(-f, position + f * far);
+  return frustum;
+}
+
+template <typename T>
+constexpr bool Frustum<T>::Contains(const Vector3<T>& point) const noexcept
+{
+  for (const Plane<T>& plane : planes)
+    if (plane.SignedDistance(point) < static_cast<T>(0))
+      return false;
+  return true;
+}
+
+template <typename T>
+constexpr bool Frustum<T>::IntersectsSphere(const Vector3<T>& center, T radius) const noexcept
+{
+  for (const Plane<T>& plane : planes)
+    if (plane.SignedDistance(center) < -radius)
+      return false;
+  return true;
+}
+
+template <typename T>
+constexpr bool Frustum<T>::IntersectsAABB(const Vector3<T>& min, const Vector3<T>& max)
+    const noexcept
+{
+  for (const Plane<T>& plane : planes) {
+    Vector3<T> positive(
+        plane.normal.x >= static_cast<T>(0) ? max.x : min.x,
+        plane.normal.y >= static_cast<T>(0) ? max.y : min.y,
+        plane.normal.z >= static_cast<T>(0) ? max.z : min.z
+    );
+    if (plane.SignedDistance(positive) < static_cast<T>(0))
+      return false;
+  }
+  return true;
+}
+
+template <typename T>
+constexpr bool Frustum<T>::IntersectsSphere(
+    const Vector3<T>& center,
+    T radius,
+    u8& lastFailedPlane
+) const noexcept
+{
+  u8 start = lastFailedPlane < PlaneCount ? lastFailedPlane : 0;
+  for (u8 i = 0; i < PlaneCount; ++i) {
+    u8 index = start + i < PlaneCount ? start + i : start + i - PlaneCount;
+    if (planes[index].SignedDistance(center) < -radius) {
+      lastFailedPlane = index;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+constexpr Intersection Frustum<T>::ClassifyAABB(
+    const Vector3<T>& min,
+    const Vector3<T>& max,
+    u8& planeMask
+) const noexcept
+{
+  for (u8 i = 0; i < PlaneCount; ++i) {
+    if (!(planeMask & (1u << i)))
+      continue;
+
+    const Plane<T>& plane = planes[i];
+    Vector3<T> positive = min;
+    Vector3<T> negative = max;
+    if (plane.normal.x >= static_cast<T>(0)) {
+      positive.x = max.x;
+      negative.x = min.x;
+    }
+    if (plane.normal.y >= static_cast<T>(0)) {
+      positive.y = max.y;
+      negative.y = min.y;
+    }
+    if (plane.normal.z >= static_cast<T>(0)) {
+      positive.z = max.z;
+      negative.z = min.z;
+    }
+
+    if (plane.SignedDistance(positive) < static_cast<T>(0))
+      return Intersection::Outside;
+    if (plane.SignedDistance(negative) >= static_cast<T>(0))
+      planeMask &= static_cast<u8>(~(1u << i));
+  }
+  return planeMask == 0 ? Intersection::Inside : Intersection::Intersecting;
+}
+
+template <typename T>
+void Frustum<T>::CullSpheres(
+    const T* centerX,
+    const T* centerY,
+    const T* centerZ,
+    const T* radius,
+    std::size_t count,
+    u8* visibility,
+    u8* lastFailedPlane
+) const noexcept
+{
+  const T* const streams[] = {centerX, centerY, centerZ, radius};
+  CullBatched(streams, count, visibility, lastFailedPlane, &Frustum<T>::SphereBlockMask);
+}
+
+template <typename T>
+void Frustum<T>::CullAABBs(
+    const T* minX,
+    const T* minY,
+    const T* minZ,
+    const T* maxX,
+    const T* maxY,
+    const T* maxZ,
+    std::size_t count,
+    u8* visibility,
+    u8* lastFailedPlane
+) const noexcept
+{
+  const T* const streams[] = {minX, minY, minZ, maxX, maxY, maxZ};
+  CullBatched(streams, count, visibility, lastFailedPlane, &Frustum<T>::AABBBlockMask);
+}
+
+template <typename T>
+template <std::size_t N, typename BlockTest>
+void Frustum<T>::CullBatched(
+    const T* const (&streams)[N],
+    std::size_t count,
+    u8* visibility,
+    u8* lastFailedPlane,
+    BlockTest test
+) const noexcept
+{
+  T padded[N][batchSize] = {};
+  const T* block[N];
+
+  const std::size_t blocks = (count + batchSize - 1) / batchSize;
+  for (std::size_t b = 0; b < blocks; ++b) {
+    const std::size_t base = b * batchSize;
+    const std::size_t lanes = count - base < batchSize ? count - base : batchSize;
+
+    // the last partial block is copied into zero padded storage, so kernels are always 8 wide
+    if (lanes == batchSize) {
+      for (std::size_t s = 0; s < N; ++s)
+        block[s] = streams[s] + base;
+    } else {
+      for (std::size_t s = 0; s < N; ++s) {
+        for (std::size_t lane = 0; lane < lanes; ++lane)
+          padded[s][lane] = streams[s][base + lane];
+        block[s] = padded[s];
+      }
+    }
+
+    u32 visible = (1u << lanes) - 1;
+    u8 start = lastFailedPlane && lastFailedPlane[b] < PlaneCount ? lastFailedPlane[b] : 0;
+    for (u8 i = 0; i < PlaneCount && visible != 0; ++i) {
+      u8 index = start + i < PlaneCount ? start + i : start + i - PlaneCount;
+      visible &= test(planes[index], block);
+      if (visible == 0 && lastFailedPlane)
+        lastFailedPlane[b] = index;
+    }
+    visibility[b] = static_cast<u8>(visible);
+  }
+}
+
+template <typename T>
+u32 Frustum<T>::SphereBlockMask(const Plane<T>& plane, const T* const* block) noexcept
+{
+  const T* cx = block[0];
+  const T* cy = block[1];
+  const T* cz = block[2];
+  const T* r = block[3];
+
+  T distance[batchSize];
+  for (std::size_t lane = 0; lane < batchSize; ++lane)
+    distance[lane] = plane.normal.x * cx[lane] + plane.normal.y * cy[lane] +
+                     plane.normal.z * cz[lane] + plane.d + r[lane];
+
+  u32 mask = 0;
+  for (std::size_t lane = 0; lane < batchSize; ++lane)
+    mask |= static_cast<u32>(distance[lane] >= static_cast<T>(0)) << lane;
+  return mask;
+}
+
+template <typename T>
+u32 Frustum<T>::AABBBlockMask(const Plane<T>& plane, const T* const* block) noexcept
+{
+  // positive vertex selection depends only on the plane, so it is uniform across the block
+  const T* px = plane.normal.x >= static_cast<T>(0) ? block[3] : block[0];
+  const T* py = plane.normal.y >= static_cast<T>(0) ? block[4] : block[1];
+  const T* pz = plane.normal.z >= static_cast<T>(0) ? block[5] : block[2];
+
+  T distance[batchSize];
+  for (std::size_t lane = 0; lane < batchSize; ++lane)
+    distance[lane] = plane.normal.x * px[lane] + plane.normal.y * py[lane] +
+                     plane.normal.z * pz[lane] + plane.d;
+
+  u32 mask = 0;
+  for (std::size_t lane = 0; lane < batchSize; ++lane)
+    mask |= static_cast<u32>(distance[lane] >= static_cast<T>(0)) << lane;
+  return mask;
+}
+
+template <typename T>
+std::string Frustum<T>::ToString(int precision) const noexcept
+{
+  std::ostringstream oss;
+  oss << "(";
+  for (u8 i = 0; i < PlaneCount; ++i)
+    oss << (i ? ", " : "") << planes[i].ToString(precision);
+  oss << ")";
+  return oss.str();
+}
+
+template <typename T>
+constexpr std::ostream& operator<<(std::ostream& os, const Frustum<T>& f) noexcept
+{
+  return os << f.ToString();
+}
+
+} // namespace Engine::Core::Math
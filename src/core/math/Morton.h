@@ -0,0 +1,336 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Morton.h
+ * @brief Morton (Z-order) codes of 3D points and spatial sorting along the Z-curve
+ *
+ * A 64 bit code interleaves 21 bits of every quantized coordinate, x in the lowest bit. With BMI2
+ * bits are deposited by a single pdep instruction per axis, otherwise by the shift and mask magic
+ * number sequence. Sorting points by their codes puts points which are close in space close in
+ * memory, which makes later neighbor queries and hierarchy builds cache friendly.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/math/AABB.h"
+#include "core/math/Vector3.h"
+#include "core/math/Vector3Array.h"
+#include "core/parallel/RadixSort.h"
+#include "core/parallel/ThreadPool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#if defined(__BMI2__)
+  #include <immintrin.h>
+#endif
+
+namespace Engine::Core::Math
+{
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+struct MortonSettings
+{
+  /// Bits per coordinate
+  static constexpr u32 bits = 21;
+  static constexpr u32 maxCoordinate = (1u << bits) - 1;
+  /// Default number of points in one chunk of the parallel forms
+  static constexpr std::size_t grain = 16 * 1024;
+};
+
+/// Spreads lower 21 bits of value so that there are two zero bits between every two bits
+u64 MortonSpread(u32 value) noexcept;
+/// Inverse of MortonSpread, bits between every third bit are ignored
+u32 MortonCompact(u64 value) noexcept;
+
+u64 MortonEncode(u32 x, u32 y, u32 z) noexcept;
+void MortonDecode(u64 code, u32& x, u32& y, u32& z) noexcept;
+
+/// Quantizes point to the 2^21 grid over bounds, points outside of bounds are clamped and NaN
+/// coordinates go to cell 0
+template <typename T>
+u64 MortonEncode(const Vector3<T>& point, const AABB<T>& bounds) noexcept;
+/// Returns center of the grid cell of code, the cells at the max side are cut by bounds
+template <typename T>
+Vector3<T> MortonDecode(u64 code, const AABB<T>& bounds) noexcept;
+
+/**
+ * @brief Computes permutation which orders points along the Z-curve
+ * @param order resized to count, order[i] is the index of the point which goes to position i
+ */
+template <typename T>
+void MortonOrder(
+    const Vector3<T>* points,
+    std::size_t count,
+    const AABB<T>& bounds,
+    std::vector<u32>& order
+) noexcept;
+
+template <typename T>
+void MortonOrder(
+    const Vector3<T>* points,
+    std::size_t count,
+    const AABB<T>& bounds,
+    std::vector<u32>& order,
+    Parallel::ThreadPool& pool,
+    std::size_t grain = MortonSettings::grain
+) noexcept;
+
+/// Reorders data in place so that data[i] becomes old data[order[i]]
+template <typename U>
+void Permute(const std::vector<u32>& order, U* data) noexcept;
+
+/**
+ * @brief Sorts points along the Z-curve
+ * @param order receives the applied permutation, pass it to Permute to reorder payloads
+ */
+template <typename T>
+void MortonSort(
+    Vector3<T>* points,
+    std::size_t count,
+    const AABB<T>& bounds,
+    std::vector<u32>& order
+) noexcept;
+
+template <typename T>
+void MortonSort(Vector3Array<T>& points, const AABB<T>& bounds, std::vector<u32>& order) noexcept;
+
+template <typename T>
+void MortonSort(
+    Vector3Array<T>& points,
+    const AABB<T>& bounds,
+    std::vector<u32>& order,
+    Parallel::ThreadPool& pool,
+    std::size_t grain = MortonSettings::grain
+) noexcept;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+inline u64 MortonSpread(u32 value) noexcept
+{
+#if defined(__BMI2__)
+  return _pdep_u64(value, 0x1249249249249249ull);
+#else
+  u64 x = value & MortonSettings::maxCoordinate;
+  x = (x | x << 32) & 0x001f00000000ffffull;
+  x = (x | x << 16) & 0x001f0000ff0000ffull;
+  x = (x | x << 8) & 0x100f00f00f00f00full;
+  x = (x | x << 4) & 0x10c30c30c30c30c3ull;
+  x = (x | x << 2) & 0x1249249249249249ull;
+  return x;
+#endif
+}
+
+inline u32 MortonCompact(u64 value) noexcept
+{
+#if defined(__BMI2__)
+  return static_cast<u32>(_pext_u64(value, 0x1249249249249249ull));
+#else
+  u64 x = value & 0x1249249249249249ull;
+  x = (x ^ (x >> 2)) & 0x10c30c30c30c30c3ull;
+  x = (x ^ (x >> 4)) & 0x100f00f00f00f00full;
+  x = (x ^ (x >> 8)) & 0x001f0000ff0000ffull;
+  x = (x ^ (x >> 16)) & 0x001f00000000ffffull;
+  x = (x ^ (x >> 32)) & MortonSettings::maxCoordinate;
+  return static_cast<u32>(x);
+#endif
+}
+
+inline u64 MortonEncode(u32 x, u32 y, u32 z) noexcept
+{
+  return MortonSpread(x) | (MortonSpread(y) << 1) | (MortonSpread(z) << 2);
+}
+
+inline void MortonDecode(u64 code, u32& x, u32& y, u32& z) noexcept
+{
+  x = MortonCompact(code);
+  y = MortonCompact(code >> 1);
+  z = MortonCompact(code >> 2);
+}
+
+namespace Internal
+{
+
+template <typename T>
+class MortonQuantizer
+{
+ public:
+  explicit MortonQuantizer(const AABB<T>& bounds) noexcept
+      : min(bounds.min),
+        scale(Scale(bounds.min.x, bounds.max.x), Scale(bounds.min.y, bounds.max.y),
+              Scale(bounds.min.z, bounds.max.z))
+  {
+  }
+
+  u64 Encode(const Vector3<T>& point) const noexcept
+  {
+    return MortonEncode(
+        Quantize(point.x, min.x, scale.x), Quantize(point.y, min.y, scale.y),
+        Quantize(point.z, min.z, scale.z)
+    );
+  }
+
+ private:
+  static T Scale(T min, T max) noexcept
+  {
+    T extent = max - min;
+    return extent > static_cast<T>(0) ? static_cast<T>(MortonSettings::maxCoordinate) / extent
+                                      : static_cast<T>(0);
+  }
+
+  static u32 Quantize(T value, T min, T scale) noexcept
+  {
+    // written so that NaN maps to 0, a NaN reaching the cast to u32 would be undefined
+    T cell = (value - min) * scale;
+    T last = static_cast<T>(MortonSettings::maxCoordinate);
+    return cell > static_cast<T>(0) ? static_cast<u32>(std::min(cell, last)) : 0;
+  }
+
+  Vector3<T> min;
+  Vector3<T> scale;
+};
+
+template <typename T>
+Vector3<T> PointAt(const Vector3<T>* points, std::size_t index) noexcept
+{
+  return points[index];
+}
+
+template <typename T>
+Vector3<T> PointAt(const Vector3Array<T>& points, std::size_t index) noexcept
+{
+  return Vector3<T>(points.x[index], points.y[index], points.z[index]);
+}
+
+/// Sorts codes of points, pool may be null
+template <typename T, typename Points>
+void MortonOrder(
+    const Points& points,
+    std::size_t count,
+    const AABB<T>& bounds,
+    std::vector<u32>& order,
+    Parallel::ThreadPool* pool,
+    std::size_t grain
+) noexcept
+{
+  std::vector<u64> codes(count);
+  std::vector<u64> codeScratch(count);
+  std::vector<u32> orderScratch(count);
+  order.resize(count);
+
+  MortonQuantizer<T> quantizer(bounds);
+  auto encode = [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      codes[i] = quantizer.Encode(PointAt(points, i));
+      order[i] = static_cast<u32>(i);
+    }
+  };
+
+  if (pool) {
+    pool->ParallelFor(count, grain, encode);
+    Parallel::RadixSort(
+        codes.data(), order.data(), count, codeScratch.data(), orderScratch.data(), *pool
+    );
+  } else {
+    encode(0, count);
+    Parallel::RadixSort(
+        codes.data(), order.data(), count, codeScratch.data(), orderScratch.data()
+    );
+  }
+}
+
+} // namespace Internal
+
+template <typename T>
+u64 MortonEncode(const Vector3<T>& point, const AABB<T>& bounds) noexcept
+{
+  return Internal::MortonQuantizer<T>(bounds).Encode(point);
+}
+
+template <typename T>
+Vector3<T> MortonDecode(u64 code, const AABB<T>& bounds) noexcept
+{
+  u32 x, y, z;
+  MortonDecode(code, x, y, z);
+  Vector3<T> cell = bounds.Size() / static_cast<T>(MortonSettings::maxCoordinate);
+  T half = static_cast<T>(0.5);
+  // the last cell holds only points on the max side, its center lies outside
+  return Vector3<T>(
+      std::min(bounds.min.x + (static_cast<T>(x) + half) * cell.x, bounds.max.x),
+      std::min(bounds.min.y + (static_cast<T>(y) + half) * cell.y, bounds.max.y),
+      std::min(bounds.min.z + (static_cast<T>(z) + half) * cell.z, bounds.max.z)
+  );
+}
+
+template <typename T>
+void MortonOrder(
+    const Vector3<T>* points,
+    std::size_t count,
+    const AABB<T>& bounds,
+    std::vector<u32>& order
+) noexcept
+{
+  Internal::MortonOrder(points, count, bounds, order, nullptr, 0);
+}
+
+template <typename T>
+void MortonOrder(
+    const Vector3<T>* points,
+    std::size_t count,
+    const AABB<T>& bounds,
+    std::vector<u32>& order,
+    Parallel::ThreadPool& pool,
+    std::size_t grain
+) noexcept
+{
+  Internal::MortonOrder(points, count, bounds, order, &pool, grain);
+}
+
+template <typename U>
+void Permute(const std::vector<u32>& order, U* data) noexcept
+{
+  std::vector<U> source(data, data + order.size());
+  for (std::size_t i = 0; i < order.size(); ++i)
+    data[i] = source[order[i]];
+}
+
+template <typename T>
+void MortonSort(
+    Vector3<T>* points,
+    std::size_t count,
+    const AABB<T>& bounds,
+    std::vector<u32>& order
+) noexcept
+{
+  MortonOrder(points, count, bounds, order);
+  Permute(order, points);
+}
+
+template <typename T>
+void MortonSort(Vector3Array<T>& points, const AABB<T>& bounds, std::vector<u32>& order) noexcept
+{
+  Internal::MortonOrder(points, points.Size(), bounds, order, nullptr, 0);
+  Permute(order, points.x.data());
+  Permute(order, points.y.data());
+  Permute(order, points.z.data());
+}
+
+template <typename T>
+void MortonSort(
+    Vector3Array<T>& points,
+    const AABB<T>& bounds,
+    std::vector<u32>& order,
+    Parallel::ThreadPool& pool,
+    std::size_t grain
+) noexcept
+{
+  Internal::MortonOrder(points, points.Size(), bounds, order, &pool, grain);
+  Permute(order, points.x.data());
+  Permute(order, points.y.data());
+  Permute(order, points.z.data());
+}
+
+} // namespace Engine::Core::Math
@@ -0,0 +1,170 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Plane.h
+ * @brief Implementation of Plane class
+ *
+ * Plane is stored as normal and distance, so that for every point p on the plane
+ * Dot(normal, p) + d == 0. Points with positive signed distance lie in front of the plane.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/math/FloatComparator.h"
+#include "core/math/Vector3.h"
+
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+
+namespace Engine::Core::Math
+{
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+template <typename T>
+class Plane
+{
+  static constexpr T epsilon = std::numeric_limits<T>::epsilon();
+
+ public:
+  Vector3<T> normal;
+  T d;
+
+  constexpr Plane() noexcept;
+  constexpr Plane(const Vector3<T>& normal, T d) noexcept;
+  constexpr Plane(const Vector3<T>& normal, const Vector3<T>& point) noexcept;
+
+  static constexpr Plane<T> FromPoints(
+      const Vector3<T>& a,
+      const Vector3<T>& b,
+      const Vector3<T>& c
+  ) noexcept;
+
+  constexpr bool operator==(const Plane<T>& p) const noexcept;
+  constexpr bool operator!=(const Plane<T>& p) const noexcept;
+
+  constexpr T SignedDistance(const Vector3<T>& point) const noexcept;
+  constexpr T DistanceTo(const Vector3<T>& point) const noexcept;
+  constexpr Vector3<T> ClosestPoint(const Vector3<T>& point) const noexcept;
+  constexpr Plane<T> Normalized() const noexcept;
+  constexpr Plane<T>& Normalize() noexcept;
+  constexpr Plane<T> Flipped() const noexcept;
+
+  std::string ToString(int precision = 2) const noexcept;
+};
+
+/* --------------------------------- Friend methods declaration -------------------------------- */
+template <typename T>
+constexpr std::ostream& operator<<(std::ostream& os, const Plane<T>& p) noexcept;
+
+/* ------------------------------------------- Usings ------------------------------------------ */
+using Planef = Plane<f32>;
+using Planed = Plane<f64>;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+template <typename T>
+constexpr Plane<T>::Plane() noexcept
+    : normal(Vector3<T>::UnitY()),
+      d(static_cast<T>(0))
+{
+}
+
+template <typename T>
+constexpr Plane<T>::Plane(const Vector3<T>& normal, T d) noexcept
+    : normal(normal),
+      d(d)
+{
+}
+
+template <typename T>
+constexpr Plane<T>::Plane(const Vector3<T>& normal, const Vector3<T>& point) noexcept
+    : normal(normal),
+      d(-normal.Dot(point))
+{
+}
+
+template <typename T>
+constexpr Plane<T> Plane<T>::FromPoints(
+    const Vector3<T>& a,
+    const Vector3<T>& b,
+    const Vector3<T>& c
+) noexcept
+{
+  Vector3<T> n = (b - a).Cross(c - a).Normalized();
+  return Plane<T>(n, a);
+}
+
+template <typename T>
+constexpr bool Plane<T>::operator==(const Plane<T>& p) const noexcept
+{
+  constexpr FloatComparator<T> comparator(5 * std::numeric_limits<T>::epsilon());
+  return normal == p.normal && comparator.Compare(d, p.d);
+}
+
+template <typename T>
+constexpr bool Plane<T>::operator!=(const Plane<T>& p) const noexcept
+{
+  return !(*this == p);
+}
+
+template <typename T>
+constexpr T Plane<T>::SignedDistance(const Vector3<T>& point) const noexcept
+{
+  return normal.Dot(point) + d;
+}
+
+template <typename T>
+constexpr T Plane<T>::DistanceTo(const Vector3<T>& point) const noexcept
+{
+  return std::abs(SignedDistance(point));
+}
+
+template <typename T>
+constexpr Vector3<T> Plane<T>::ClosestPoint(const Vector3<T>& point) const noexcept
+{
+  return point - normal * SignedDistance(point);
+}
+
+template <typename T>
+constexpr Plane<T> Plane<T>::Normalized() const noexcept
+{
+  T length = normal.Length();
+  if (length > epsilon)
+    return Plane<T>(normal / length, d / length);
+  return Plane<T>(Vector3<T>(), static_cast<T>(0));
+}
+
+template <typename T>
+constexpr Plane<T>& Plane<T>::Normalize() noexcept
+{
+  *this = Normalized();
+  return *this;
+}
+
+template <typename T>
+constexpr Plane<T> Plane<T>::Flipped() const noexcept
+{
+  return Plane<T>(-normal, -d);
+}
+
+template <typename T>
+std::string Plane<T>::ToString(int precision) const noexcept
+{
+  std::ostringstream oss;
+  oss << std::fixed << std::setprecision(precision);
+  oss << "(" << normal.ToString(precision) << ", " << d << ")";
+  return oss.str();
+}
+
+template <typename T>
+constexpr std::ostream& operator<<(std::ostream& os, const Plane<T>& p) noexcept
+{
+  return os << p.ToString();
+}
+
+} // namespace Engine::Core::Math
@@ -0,0 +1,385 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Polygon2.h
+ * @brief Planar polygon kernels: area, point-in-polygon, convex hull, segment intersection and
+ * clipping
+ *
+ * Polygons are arrays of vertices with an implicit closing edge and either orientation unless
+ * noted. Point-in-polygon uses the nonzero winding rule, so self-intersecting outlines and holes
+ * given as oppositely wound loops work. The batch form classifies many points against one
+ * polygon: points are taken in blocks whose coordinates are copied into contiguous arrays, and
+ * every edge updates the winding numbers of the whole block with branch-free arithmetic the
+ * compiler vectorizes. Edges outside the vertical range of a block are skipped, so spatially
+ * sorted queries against large polygons touch few edges. The convex hull is Andrew's monotone
+ * chain and clipping is Sutherland-Hodgman against a convex clip polygon.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/math/Vector2.h"
+#include "core/parallel/ThreadPool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace Engine::Core::Math
+{
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+struct Polygon2Settings
+{
+  /// Default number of query points in one chunk of the parallel forms
+  static constexpr std::size_t grain = 4096;
+  /// Query points whose winding numbers are updated together by every edge
+  static constexpr std::size_t block = 64;
+};
+
+/// Shoelace area, positive for counterclockwise polygons
+template <typename T>
+T SignedArea(const Vector2<T>* polygon, std::size_t count) noexcept;
+
+/// Number of counterclockwise turns of the polygon around point, points on the boundary may be
+/// counted as inside or outside
+template <typename T>
+i32 WindingNumber(const Vector2<T>* polygon, std::size_t count, const Vector2<T>& point) noexcept;
+
+/// Nonzero winding rule
+template <typename T>
+bool PointInPolygon(
+    const Vector2<T>* polygon,
+    std::size_t count,
+    const Vector2<T>& point
+) noexcept;
+
+/// Batch form writing inside[i] = PointInPolygon(polygon, count, points[i]) as 1 or 0
+template <typename T>
+void PointsInPolygon(
+    const Vector2<T>* polygon,
+    std::size_t count,
+    const Vector2<T>* points,
+    std::size_t pointCount,
+    u8* inside
+) noexcept;
+
+template <typename T>
+void PointsInPolygon(
+    const Vector2<T>* polygon,
+    std::size_t count,
+    const Vector2<T>* points,
+    std::size_t pointCount,
+    u8* inside,
+    Parallel::ThreadPool& pool,
+    std::size_t grain = Polygon2Settings::grain
+) noexcept;
+
+/**
+ * @brief Convex hull of a point set by Andrew's monotone chain
+ * @param hull cleared and filled with indices of the hull vertices in counterclockwise order
+ * starting at the lowest x (then lowest y), collinear and duplicate points are dropped
+ */
+template <typename T>
+void ConvexHull(const Vector2<T>* points, std::size_t count, std::vector<u32>& hull) noexcept;
+
+/**
+ * @brief Intersection of the closed segments [a0, a1] and [b0, b1]
+ * @param point the intersection point, for collinear overlapping segments the point of the
+ * overlap closest to a0
+ * @return false if the segments do not intersect, point is left unchanged
+ */
+template <typename T>
+bool SegmentIntersection(
+    const Vector2<T>& a0,
+    const Vector2<T>& a1,
+    const Vector2<T>& b0,
+    const Vector2<T>& b1,
+    Vector2<T>& point
+) noexcept;
+
+/**
+ * @brief Part of polygon inside the convex polygon clip (Sutherland-Hodgman)
+ * @param out cleared and filled with the clipped polygon in the orientation of polygon, empty if
+ * they do not overlap, a concave polygon may give degenerate edges where it leaves and reenters
+ */
+template <typename T>
+void ClipPolygon(
+    const Vector2<T>* polygon,
+    std::size_t count,
+    const Vector2<T>* clip,
+    std::size_t clipCount,
+    std::vector<Vector2<T>>& out
+) noexcept;
+
+/// Exact comparison, Vector2::operator== allows a relative tolerance
+template <typename T>
+bool SamePoint(const Vector2<T>& a, const Vector2<T>& b) noexcept;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+namespace Internal
+{
+
+/// Winding numbers of points [begin, end) in blocks of Polygon2Settings::block
+template <typename T>
+void PointsInPolygonRange(
+    const Vector2<T>* polygon,
+    std::size_t count,
+    const Vector2<T>* points,
+    std::size_t begin,
+    std::size_t end,
+    u8* inside
+) noexcept
+{
+  constexpr std::size_t block = Polygon2Settings::block;
+  T xs[block];
+  T ys[block];
+  i32 windings[block];
+
+  for (std::size_t first = begin; first < end; first += block) {
+    std::size_t size = std::min(block, end - first);
+    T minY = points[first].y;
+    T maxY = points[first].y;
+    for (std::size_t j = 0; j < size; ++j) {
+      xs[j] = points[first + j].x;
+      ys[j] = points[first + j].y;
+      windings[j] = 0;
+      minY = std::min(minY, ys[j]);
+      maxY = std::max(maxY, ys[j]);
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+      const Vector2<T>& a = polygon[i];
+      const Vector2<T>& b = polygon[i + 1 == count ? 0 : i + 1];
+      // an edge crosses the ray from a point only if a.y <= y < b.y or b.y <= y < a.y
+      if (maxY < std::min(a.y, b.y) || minY >= std::max(a.y, b.y))
+        continue;
+
+      T ex = b.x - a.x;
+      T ey = b.y - a.y;
+      for (std::size_t j = 0; j < size; ++j) {
+        T side = ex * (ys[j] - a.y) - ey * (xs[j] - a.x);
+        i32 up = (a.y <= ys[j]) & (b.y > ys[j]) & (side > T(0));
+        i32 down = (b.y <= ys[j]) & (a.y > ys[j]) & (side < T(0));
+        windings[j] += up - down;
+      }
+    }
+
+    for (std::size_t j = 0; j < size; ++j)
+      inside[first + j] = windings[j] != 0 ? 1 : 0;
+  }
+}
+
+} // namespace Internal
+
+template <typename T>
+bool SamePoint(const Vector2<T>& a, const Vector2<T>& b) noexcept
+{
+  return a.x == b.x && a.y == b.y;
+}
+
+template <typename T>
+T SignedArea(const Vector2<T>* polygon, std::size_t count) noexcept
+{
+  if (count < 3)
+    return T(0);
+
+  // fan from the first vertex keeps the cross products small for polygons far from the origin
+  T area = T(0);
+  for (std::size_t i = 1; i + 1 < count; ++i)
+    area += (polygon[i] - polygon[0]).Cross(polygon[i + 1] - polygon[0]);
+  return area * T(0.5);
+}
+
+template <typename T>
+i32 WindingNumber(const Vector2<T>* polygon, std::size_t count, const Vector2<T>& point) noexcept
+{
+  i32 winding = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    const Vector2<T>& a = polygon[i];
+    const Vector2<T>& b = polygon[i + 1 == count ? 0 : i + 1];
+    T side = (b - a).Cross(point - a);
+    if (a.y <= point.y) {
+      if (b.y > point.y && side > T(0))
+        ++winding;
+    } else if (b.y <= point.y && side < T(0)) {
+      --winding;
+    }
+  }
+  return winding;
+}
+
+template <typename T>
+bool PointInPolygon(
+    const Vector2<T>* polygon,
+    std::size_t count,
+    const Vector2<T>& point
+) noexcept
+{
+  return WindingNumber(polygon, count, point) != 0;
+}
+
+template <typename T>
+void PointsInPolygon(
+    const Vector2<T>* polygon,
+    std::size_t count,
+    const Vector2<T>* points,
+    std::size_t pointCount,
+    u8* inside
+) noexcept
+{
+  Internal::PointsInPolygonRange(polygon, count, points, 0, pointCount, inside);
+}
+
+template <typename T>
+void PointsInPolygon(
+    const Vector2<T>* polygon,
+    std::size_t count,
+    const Vector2<T>* points,
+    std::size_t pointCount,
+    u8* inside,
+    Parallel::ThreadPool& pool,
+    std::size_t grain
+) noexcept
+{
+  pool.ParallelFor(pointCount, grain, [&](std::size_t begin, std::size_t end) {
+    Internal::PointsInPolygonRange(polygon, count, points, begin, end, inside);
+  });
+}
+
+template <typename T>
+void ConvexHull(const Vector2<T>* points, std::size_t count, std::vector<u32>& hull) noexcept
+{
+  hull.clear();
+  std::vector<u32> order(count);
+  for (std::size_t i = 0; i < count; ++i)
+    order[i] = static_cast<u32>(i);
+  std::sort(order.begin(), order.end(), [points](u32 a, u32 b) {
+    return points[a].x < points[b].x || (points[a].x == points[b].x && points[a].y < points[b].y);
+  });
+  order.erase(std::unique(order.begin(), order.end(),
+                          [points](u32 a, u32 b) {
+                            return SamePoint(points[a], points[b]);
+                          }),
+              order.end());
+  if (order.size() < 3) {
+    hull = order;
+    return;
+  }
+
+  // lower chain left to right, then upper chain right to left, both turning counterclockwise
+  auto turnsLeft = [&](u32 next) {
+    const Vector2<T>& a = points[hull[hull.size() - 2]];
+    const Vector2<T>& b = points[hull.back()];
+    return (b - a).Cross(points[next] - a) > T(0);
+  };
+  hull.reserve(order.size() + 1);
+  for (u32 index : order) {
+    while (hull.size() >= 2 && !turnsLeft(index))
+      hull.pop_back();
+    hull.push_back(index);
+  }
+  std::size_t lower = hull.size() + 1;
+  for (std::size_t i = order.size() - 1; i-- > 0;) {
+    while (hull.size() >= lower && !turnsLeft(order[i]))
+      hull.pop_back();
+    hull.push_back(order[i]);
+  }
+  hull.pop_back();
+}
+
+template <typename T>
+bool SegmentIntersection(
+    const Vector2<T>& a0,
+    const Vector2<T>& a1,
+    const Vector2<T>& b0,
+    const Vector2<T>& b1,
+    Vector2<T>& point
+) noexcept
+{
+  Vector2<T> r = a1 - a0;
+  Vector2<T> s = b1 - b0;
+  Vector2<T> offset = b0 - a0;
+  T denominator = r.Cross(s);
+
+  if (denominator != T(0)) {
+    // a0 + t * r = b0 + u * s with t and u in [0, 1], compared without dividing
+    T t = offset.Cross(s);
+    T u = offset.Cross(r);
+    if (denominator < T(0)) {
+      denominator = -denominator;
+      t = -t;
+      u = -u;
+    }
+    if (t < T(0) || t > denominator || u < T(0) || u > denominator)
+      return false;
+    point = a0 + r * (t / denominator);
+    return true;
+  }
+
+  if (offset.Cross(r) != T(0) || offset.Cross(s) != T(0))
+    return false;
+
+  // collinear, project b onto a and intersect the parameter intervals
+  T length = r.LengthSquared();
+  if (length == T(0)) {
+    T sLength = s.LengthSquared();
+    T u = sLength == T(0) ? T(0) : (a0 - b0).Dot(s) / sLength;
+    if (u < T(0) || u > T(1) || (sLength == T(0) && !SamePoint(a0, b0)))
+      return false;
+    point = a0;
+    return true;
+  }
+  T t0 = offset.Dot(r) / length;
+  T t1 = t0 + s.Dot(r) / length;
+  T low = std::max(std::min(t0, t1), T(0));
+  T high = std::min(std::max(t0, t1), T(1));
+  if (low > high)
+    return false;
+  point = a0 + r * low;
+  return true;
+}
+
+template <typename T>
+void ClipPolygon(
+    const Vector2<T>* polygon,
+    std::size_t count,
+    const Vector2<T>* clip,
+    std::size_t clipCount,
+    std::vector<Vector2<T>>& out
+) noexcept
+{
+  assert((clipCount >= 3 || clipCount == 0) && "Clip polygon needs at least three vertices");
+  out.assign(polygon, polygon + count);
+  if (clipCount < 3)
+    return;
+
+  T sign = SignedArea(clip, clipCount) < T(0) ? T(-1) : T(1);
+  std::vector<Vector2<T>> input;
+  for (std::size_t c = 0; c < clipCount && !out.empty(); ++c) {
+    const Vector2<T>& c0 = clip[c];
+    Vector2<T> edge = clip[c + 1 == clipCount ? 0 : c + 1] - c0;
+    if (edge.x == T(0) && edge.y == T(0))
+      continue;
+
+    input.swap(out);
+    out.clear();
+    T previous = edge.Cross(input.back() - c0) * sign;
+    for (std::size_t i = 0; i < input.size(); ++i) {
+      // signed distances scaled by the edge length, points on the edge are inside
+      T current = edge.Cross(input[i] - c0) * sign;
+      if ((previous > T(0) && current < T(0)) || (previous < T(0) && current > T(0))) {
+        const Vector2<T>& p0 = input[i == 0 ? input.size() - 1 : i - 1];
+        out.push_back(p0.Lerp(input[i], previous / (previous - current)));
+      }
+      if (current >= T(0))
+        out.push_back(input[i]);
+      previous = current;
+    }
+  }
+}
+
+} // namespace Engine::Core::Math
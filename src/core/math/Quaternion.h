@@ -0,0 +1,321 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Quaternion.h
+ * @brief Implementation of Quaternion class
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/math/FloatComparator.h"
+#include "core/math/Vector3.h"
+
+#include <cassert>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+
+namespace Engine::Core::Math
+{
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+/**
+ * @brief Quaternion x * i + y * j + z * k + w, unit quaternions represent rotations
+ *
+ * Product a * b is the rotation b followed by a.
+ */
+template <typename T>
+class Quaternion
+{
+  static constexpr T epsilon = std::numeric_limits<T>::epsilon();
+
+ public:
+  T x;
+  T y;
+  T z;
+  T w;
+
+  static constexpr Quaternion<T> Identity() noexcept;
+  /// Rotation by angle in radians counterclockwise around axis, axis must be normalized
+  static Quaternion<T> FromAxisAngle(const Vector3<T>& axis, T angle) noexcept;
+  /// Shortest rotation turning direction from into direction to, both must be normalized
+  static Quaternion<T> FromTo(const Vector3<T>& from, const Vector3<T>& to) noexcept;
+
+  constexpr Quaternion() noexcept;
+  constexpr Quaternion(T x, T y, T z, T w) noexcept;
+  constexpr Quaternion(const Vector3<T>& vector, T w) noexcept;
+
+  constexpr Quaternion<T> operator+(const Quaternion<T>& q) const noexcept;
+  constexpr Quaternion<T> operator-(const Quaternion<T>& q) const noexcept;
+  constexpr Quaternion<T> operator*(const Quaternion<T>& q) const noexcept;
+  constexpr Quaternion<T> operator*(T scalar) const noexcept;
+  constexpr Quaternion<T> operator-() const noexcept;
+  /// Rotates vector, quaternion must be normalized
+  constexpr Vector3<T> operator*(const Vector3<T>& v) const noexcept;
+
+  constexpr Quaternion<T>& operator*=(const Quaternion<T>& q) noexcept;
+
+  constexpr bool operator==(const Quaternion<T>& q) const noexcept;
+  constexpr bool operator!=(const Quaternion<T>& q) const noexcept;
+
+  constexpr Vector3<T> Vector() const noexcept;
+  constexpr T Length() const noexcept;
+  constexpr T LengthSquared() const noexcept;
+  constexpr T Dot(const Quaternion<T>& q) const noexcept;
+  constexpr Quaternion<T> Normalized() const noexcept;
+  constexpr Quaternion<T>& Normalize() noexcept;
+  constexpr Quaternion<T> Conjugated() const noexcept;
+  constexpr Quaternion<T> Inversed() const noexcept;
+  /// True when both quaternions represent the same rotation, q and -q included
+  constexpr bool SameRotation(const Quaternion<T>& q) const noexcept;
+
+  /// Normalized linear interpolation along the shorter arc
+  static constexpr Quaternion<T> Nlerp(const Quaternion<T>& q1, const Quaternion<T>& q2, T t)
+      noexcept;
+  /// Spherical linear interpolation along the shorter arc
+  static Quaternion<T> Slerp(const Quaternion<T>& q1, const Quaternion<T>& q2, T t) noexcept;
+
+  std::string ToString(int precision = 2) const noexcept;
+};
+
+/* --------------------------------- Friend methods declaration -------------------------------- */
+template <typename T>
+constexpr std::ostream& operator<<(std::ostream& os, const Quaternion<T>& q) noexcept;
+
+/* ------------------------------------------- Usings ------------------------------------------ */
+using Quaternionf = Quaternion<f32>;
+using Quaterniond = Quaternion<f64>;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+template <typename T>
+constexpr Quaternion<T> Quaternion<T>::Identity() noexcept
+{
+  return Quaternion<T>(static_cast<T>(0), static_cast<T>(0), static_cast<T>(0), static_cast<T>(1));
+}
+
+template <typename T>
+Quaternion<T> Quaternion<T>::FromAxisAngle(const Vector3<T>& axis, T angle) noexcept
+{
+  T half = angle * static_cast<T>(0.5);
+  return Quaternion<T>(axis * std::sin(half), std::cos(half));
+}
+
+template <typename T>
+Quaternion<T> Quaternion<T>::FromTo(const Vector3<T>& from, const Vector3<T>& to) noexcept
+{
+  T cosine = from.Dot(to);
+  if (cosine < static_cast<T>(-1) + static_cast<T>(1e-6)) {
+    // opposite directions, rotate by pi around any perpendicular axis
+    Vector3<T> axis = Vector3<T>::UnitX().Cross(from);
+    if (axis.LengthSquared() < static_cast<T>(1e-6))
+      axis = Vector3<T>::UnitY().Cross(from);
+    return Quaternion<T>(axis.Normalized(), static_cast<T>(0));
+  }
+  return Quaternion<T>(from.Cross(to), static_cast<T>(1) + cosine).Normalized();
+}
+
+template <typename T>
+constexpr Quaternion<T>::Quaternion() noexcept
+    : x(static_cast<T>(0)),
+      y(static_cast<T>(0)),
+      z(static_cast<T>(0)),
+      w(static_cast<T>(1))
+{
+}
+
+template <typename T>
+constexpr Quaternion<T>::Quaternion(T x, T y, T z, T w) noexcept
+    : x(x),
+      y(y),
+      z(z),
+      w(w)
+{
+}
+
+template <typename T>
+constexpr Quaternion<T>::Quaternion(const Vector3<T>& vector, T w) noexcept
+    : x(vector.x),
+      y(vector.y),
+      z(vector.z),
+      w(w)
+{
+}
+
+template <typename T>
+constexpr Quaternion<T> Quaternion<T>::operator+(const Quaternion<T>& q) const noexcept
+{
+  return Quaternion<T>(x + q.x, y + q.y, z + q.z, w + q.w);
+}
+
+template <typename T>
+constexpr Quaternion<T> Quaternion<T>::operator-(const Quaternion<T>& q) const noexcept
+{
+  return Quaternion<T>(x - q.x, y - q.y, z - q.z, w - q.w);
+}
+
+template <typename T>
+constexpr Quaternion<T> Quaternion<T>::operator*(const Quaternion<T>& q) const noexcept
+{
+  return Quaternion<T>(
+      w * q.x + x * q.w + y * q.z - z * q.y,
+      w * q.y - x * q.z + y * q.w + z * q.x,
+      w * q.z + x * q.y - y * q.x + z * q.w,
+      w * q.w - x * q.x - y * q.y - z * q.z
+  );
+}
+
+template <typename T>
+constexpr Quaternion<T> Quaternion<T>::operator*(T scalar) const noexcept
+{
+  return Quaternion<T>(x * scalar, y * scalar, z * scalar, w * scalar);
+}
+
+template <typename T>
+constexpr Quaternion<T> Quaternion<T>::operator-() const noexcept
+{
+  return Quaternion<T>(-x, -y, -z, -w);
+}
+
+template <typename T>
+constexpr Vector3<T> Quaternion<T>::operator*(const Vector3<T>& v) const noexcept
+{
+  // v' = v + 2w (u x v) + 2 u x (u x v)
+  Vector3<T> u(x, y, z);
+  Vector3<T> t = u.Cross(v) * static_cast<T>(2);
+  return v + t * w + u.Cross(t);
+}
+
+template <typename T>
+constexpr Quaternion<T>& Quaternion<T>::operator*=(const Quaternion<T>& q) noexcept
+{
+  *this = *this * q;
+  return *this;
+}
+
+template <typename T>
+constexpr bool Quaternion<T>::operator==(const Quaternion<T>& q) const noexcept
+{
+  constexpr FloatComparator<T> comparator(5 * std::numeric_limits<T>::epsilon());
+  return comparator.Compare(x, q.x) && comparator.Compare(y, q.y) && comparator.Compare(z, q.z) &&
+         comparator.Compare(w, q.w);
+}
+
+template <typename T>
+constexpr bool Quaternion<T>::operator!=(const Quaternion<T>& q) const noexcept
+{
+  return !(*this == q);
+}
+
+template <typename T>
+constexpr Vector3<T> Quaternion<T>::Vector() const noexcept
+{
+  return Vector3<T>(x, y, z);
+}
+
+template <typename T>
+constexpr T Quaternion<T>::Length() const noexcept
+{
+  return std::sqrt(LengthSquared());
+}
+
+template <typename T>
+constexpr T Quaternion<T>::LengthSquared() const noexcept
+{
+  return x * x + y * y + z * z + w * w;
+}
+
+template <typename T>
+constexpr T Quaternion<T>::Dot(const Quaternion<T>& q) const noexcept
+{
+  return x * q.x + y * q.y + z * q.z + w * q.w;
+}
+
+template <typename T>
+constexpr Quaternion<T> Quaternion<T>::Normalized() const noexcept
+{
+  T length = Length();
+  return length > epsilon ? *this * (static_cast<T>(1) / length) : Identity();
+}
+
+template <typename T>
+constexpr Quaternion<T>& Quaternion<T>::Normalize() noexcept
+{
+  *this = Normalized();
+  return *this;
+}
+
+template <typename T>
+constexpr Quaternion<T> Quaternion<T>::Conjugated() const noexcept
+{
+  return Quaternion<T>(-x, -y, -z, w);
+}
+
+template <typename T>
+constexpr Quaternion<T> Quaternion<T>::Inversed() const noexcept
+{
+  T lengthSquared = LengthSquared();
+  assert(lengthSquared > epsilon && "Inverse of zero quaternion");
+  if (lengthSquared > epsilon)
+    return Conjugated() * (static_cast<T>(1) / lengthSquared);
+  return Identity();
+}
+
+template <typename T>
+constexpr bool Quaternion<T>::SameRotation(const Quaternion<T>& q) const noexcept
+{
+  return *this == q || *this == -q;
+}
+
+template <typename T>
+constexpr Quaternion<T> Quaternion<T>::Nlerp(
+    const Quaternion<T>& q1,
+    const Quaternion<T>& q2,
+    T t
+) noexcept
+{
+  Quaternion<T> end = q1.Dot(q2) < static_cast<T>(0) ? -q2 : q2;
+  return (q1 + (end - q1) * t).Normalized();
+}
+
+template <typename T>
+Quaternion<T> Quaternion<T>::Slerp(const Quaternion<T>& q1, const Quaternion<T>& q2, T t) noexcept
+{
+  T cosine = q1.Dot(q2);
+  Quaternion<T> end = q2;
+  if (cosine < static_cast<T>(0)) {
+    cosine = -cosine;
+    end = -q2;
+  }
+
+  // nearly parallel quaternions, sin(angle) is too small to divide by
+  if (cosine > static_cast<T>(1) - static_cast<T>(1e-4))
+    return Nlerp(q1, end, t);
+
+  T angle = std::acos(cosine);
+  T sine = std::sin(angle);
+  T a = std::sin((static_cast<T>(1) - t) * angle) / sine;
+  T b = std::sin(t * angle) / sine;
+  return q1 * a + end * b;
+}
+
+template <typename T>
+std::string Quaternion<T>::ToString(int precision) const noexcept
+{
+  std::ostringstream oss;
+  oss << std::fixed << std::setprecision(precision);
+  oss << "(" << x << ", " << y << ", " << z << ", " << w << ")";
+  return oss.str();
+}
+
+template <typename T>
+constexpr std::ostream& operator<<(std::ostream& os, const Quaternion<T>& q) noexcept
+{
+  return os << q.ToString();
+}
+
+} // namespace Engine::Core::Math
@@ -0,0 +1,822 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file SimdFloat.h
+ * @brief 4 and 8 wide float vectors for branch-free kernels written once for every width
+ *
+ * Float4 maps to an SSE2 register and Float8 to an AVX2 register when the target has them;
+ * otherwise Float4 is a plain array and Float8 a pair of Float4. The free functions below are
+ * also defined for f32, so a kernel templated on the lane type compiles for scalars, Float4 and
+ * Float8 alike. Comparisons return masks of the same type with all bits of a lane set where
+ * the comparison holds; for f32 they return bool. Masks are consumed by Select. ForEachLane runs
+ * such a kernel over arrays in the widest lanes of the target and finishes the tail with scalars.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64)
+  #include <emmintrin.h>
+#endif
+#if defined(__AVX2__) || defined(__FMA__)
+  #include <immintrin.h>
+#endif
+
+namespace Engine::Core::Math
+{
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+class Float4
+{
+ public:
+  static constexpr u32 width = 4;
+
+  Float4() noexcept = default;
+  explicit Float4(f32 value) noexcept;
+
+  static Float4 Load(const f32* data) noexcept;
+  void Store(f32* data) const noexcept;
+
+#if defined(__SSE2__) || defined(_M_X64)
+  explicit Float4(__m128 value) noexcept;
+  __m128 value;
+#else
+  f32 value[width];
+#endif
+};
+
+class Float8
+{
+ public:
+  static constexpr u32 width = 8;
+
+  Float8() noexcept = default;
+  explicit Float8(f32 value) noexcept;
+
+  static Float8 Load(const f32* data) noexcept;
+  void Store(f32* data) const noexcept;
+
+#if defined(__AVX2__)
+  explicit Float8(__m256 value) noexcept;
+  __m256 value;
+#else
+  Float8(const Float4& low, const Float4& high) noexcept;
+  Float4 low;
+  Float4 high;
+#endif
+};
+
+/* ------------------------------------ Operations on lanes ------------------------------------ */
+/// a * b + c, fused where the target has FMA
+f32 MulAdd(f32 a, f32 b, f32 c) noexcept;
+f32 Select(bool mask, f32 a, f32 b) noexcept;
+f32 Abs(f32 x) noexcept;
+/// Magnitude of magnitude with the sign of sign
+f32 CopySign(f32 magnitude, f32 sign) noexcept;
+f32 Min(f32 a, f32 b) noexcept;
+f32 Max(f32 a, f32 b) noexcept;
+f32 Sqrt(f32 x) noexcept;
+/// Rounds half to even, |x| must be below 2^22
+f32 Round(f32 x) noexcept;
+/// 2^n for integral n in [-126, 127]
+f32 Pow2(f32 n) noexcept;
+/// Splits positive normal x into mantissa in [0.5, 1) returned and integral exponent
+f32 Frexp(f32 x, f32& exponent) noexcept;
+
+Float4 operator+(const Float4& a, const Float4& b) noexcept;
+Float4 operator-(const Float4& a, const Float4& b) noexcept;
+Float4 operator*(const Float4& a, const Float4& b) noexcept;
+Float4 operator/(const Float4& a, const Float4& b) noexcept;
+Float4 operator-(const Float4& a) noexcept;
+Float4 operator<(const Float4& a, const Float4& b) noexcept;
+Float4 operator>(const Float4& a, const Float4& b) noexcept;
+Float4 operator==(const Float4& a, const Float4& b) noexcept;
+/// Union and intersection of masks
+Float4 operator|(const Float4& a, const Float4& b) noexcept;
+Float4 operator&(const Float4& a, const Float4& b) noexcept;
+Float4 MulAdd(const Float4& a, const Float4& b, const Float4& c) noexcept;
+Float4 Select(const Float4& mask, const Float4& a, const Float4& b) noexcept;
+Float4 Abs(const Float4& x) noexcept;
+Float4 CopySign(const Float4& magnitude, const Float4& sign) noexcept;
+Float4 Min(const Float4& a, const Float4& b) noexcept;
+Float4 Max(const Float4& a, const Float4& b) noexcept;
+Float4 Sqrt(const Float4& x) noexcept;
+Float4 Round(const Float4& x) noexcept;
+Float4 Pow2(const Float4& n) noexcept;
+Float4 Frexp(const Float4& x, Float4& exponent) noexcept;
+
+Float8 operator+(const Float8& a, const Float8& b) noexcept;
+Float8 operator-(const Float8& a, const Float8& b) noexcept;
+Float8 operator*(const Float8& a, const Float8& b) noexcept;
+Float8 operator/(const Float8& a, const Float8& b) noexcept;
+Float8 operator-(const Float8& a) noexcept;
+Float8 operator<(const Float8& a, const Float8& b) noexcept;
+Float8 operator>(const Float8& a, const Float8& b) noexcept;
+Float8 operator==(const Float8& a, const Float8& b) noexcept;
+Float8 operator|(const Float8& a, const Float8& b) noexcept;
+Float8 operator&(const Float8& a, const Float8& b) noexcept;
+Float8 MulAdd(const Float8& a, const Float8& b, const Float8& c) noexcept;
+Float8 Select(const Float8& mask, const Float8& a, const Float8& b) noexcept;
+Float8 Abs(const Float8& x) noexcept;
+Float8 CopySign(const Float8& magnitude, const Float8& sign) noexcept;
+Float8 Min(const Float8& a, const Float8& b) noexcept;
+Float8 Max(const Float8& a, const Float8& b) noexcept;
+Float8 Sqrt(const Float8& x) noexcept;
+Float8 Round(const Float8& x) noexcept;
+Float8 Pow2(const Float8& n) noexcept;
+Float8 Frexp(const Float8& x, Float8& exponent) noexcept;
+
+/* --------------------------------------- Lane iteration -------------------------------------- */
+/// Widest lane type of the target
+#if defined(__AVX2__)
+using WidestFloat = Float8;
+#else
+using WidestFloat = Float4;
+#endif
+
+/// Number of lanes of V, 1 for f32
+template <typename V>
+constexpr u32 laneWidth = V::width;
+template <>
+constexpr u32 laneWidth<f32> = 1;
+
+/// Calls func(WidestFloat(), i) on full lanes of [begin, end) and func(f32(), i) on the tail
+template <typename Func>
+void ForEachLane(std::size_t begin, std::size_t end, Func&& func) noexcept;
+
+/// Loads laneWidth<V> floats from data, V being f32, Float4 or Float8
+template <typename V>
+V Load(const f32* data) noexcept;
+template <typename V>
+void Store(const V& value, f32* data) noexcept;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+namespace Internal
+{
+
+inline u32 FloatBits(f32 x) noexcept
+{
+  u32 bits;
+  std::memcpy(&bits, &x, sizeof(bits));
+  return bits;
+}
+
+inline f32 BitsFloat(u32 bits) noexcept
+{
+  f32 x;
+  std::memcpy(&x, &bits, sizeof(x));
+  return x;
+}
+
+/// Adding and subtracting 1.5 * 2^23 drops the fraction of |x| < 2^22 in round to nearest mode
+constexpr f32 roundMagic = 12582912.0f;
+constexpr u32 mantissaMask = 0x007fffffu;
+/// Exponent bits of 0.5
+constexpr u32 halfExponent = 0x3f000000u;
+
+} // namespace Internal
+
+inline f32 MulAdd(f32 a, f32 b, f32 c) noexcept
+{
+#if defined(__FMA__)
+  return std::fma(a, b, c);
+#else
+  return a * b + c;
+#endif
+}
+
+inline f32 Select(bool mask, f32 a, f32 b) noexcept
+{
+  return mask ? a : b;
+}
+
+inline f32 Abs(f32 x) noexcept
+{
+  return std::abs(x);
+}
+
+inline f32 CopySign(f32 magnitude, f32 sign) noexcept
+{
+  return std::copysign(magnitude, sign);
+}
+
+inline f32 Min(f32 a, f32 b) noexcept
+{
+  return a < b ? a : b;
+}
+
+inline f32 Max(f32 a, f32 b) noexcept
+{
+  return a > b ? a : b;
+}
+
+inline f32 Sqrt(f32 x) noexcept
+{
+  return std::sqrt(x);
+}
+
+inline f32 Round(f32 x) noexcept
+{
+  return (x + Internal::roundMagic) - Internal::roundMagic;
+}
+
+inline f32 Pow2(f32 n) noexcept
+{
+  return Internal::BitsFloat(static_cast<u32>(static_cast<i32>(n) + 127) << 23);
+}
+
+inline f32 Frexp(f32 x, f32& exponent) noexcept
+{
+  u32 bits = Internal::FloatBits(x);
+  exponent = static_cast<f32>(static_cast<i32>(bits >> 23) - 126);
+  return Internal::BitsFloat((bits & Internal::mantissaMask) | Internal::halfExponent);
+}
+
+#if defined(__SSE2__) || defined(_M_X64)
+
+inline Float4::Float4(f32 value) noexcept
+    : value(_mm_set1_ps(value))
+{
+}
+
+inline Float4::Float4(__m128 value) noexcept
+    : value(value)
+{
+}
+
+inline Float4 Float4::Load(const f32* data) noexcept
+{
+  return Float4(_mm_loadu_ps(data));
+}
+
+inline void Float4::Store(f32* data) const noexcept
+{
+  _mm_storeu_ps(data, value);
+}
+
+inline Float4 operator+(const Float4& a, const Float4& b) noexcept
+{
+  return Float4(_mm_add_ps(a.value, b.value));
+}
+
+inline Float4 operator-(const Float4& a, const Float4& b) noexcept
+{
+  return Float4(_mm_sub_ps(a.value, b.value));
+}
+
+inline Float4 operator*(const Float4& a, const Float4& b) noexcept
+{
+  return Float4(_mm_mul_ps(a.value, b.value));
+}
+
+inline Float4 operator/(const Float4& a, const Float4& b) noexcept
+{
+  return Float4(_mm_div_ps(a.value, b.value));
+}
+
+inline Float4 operator-(const Float4& a) noexcept
+{
+  return Float4(_mm_xor_ps(a.value, _mm_set1_ps(-0.0f)));
+}
+
+inline Float4 operator<(const Float4& a, const Float4& b) noexcept
+{
+  return Float4(_mm_cmplt_ps(a.value, b.value));
+}
+
+inline Float4 operator>(const Float4& a, const Float4& b) noexcept
+{
+  return Float4(_mm_cmpgt_ps(a.value, b.value));
+}
+
+inline Float4 operator==(const Float4& a, const Float4& b) noexcept
+{
+  return Float4(_mm_cmpeq_ps(a.value, b.value));
+}
+
+inline Float4 operator|(const Float4& a, const Float4& b) noexcept
+{
+  return Float4(_mm_or_ps(a.value, b.value));
+}
+
+inline Float4 operator&(const Float4& a, const Float4& b) noexcept
+{
+  return Float4(_mm_and_ps(a.value, b.value));
+}
+
+inline Float4 MulAdd(const Float4& a, const Float4& b, const Float4& c) noexcept
+{
+  #if defined(__FMA__)
+  return Float4(_mm_fmadd_ps(a.value, b.value, c.value));
+  #else
+  return Float4(_mm_add_ps(_mm_mul_ps(a.value, b.value), c.value));
+  #endif
+}
+
+inline Float4 Select(const Float4& mask, const Float4& a, const Float4& b) noexcept
+{
+  return Float4(_mm_or_ps(_mm_and_ps(mask.value, a.value), _mm_andnot_ps(mask.value, b.value)));
+}
+
+inline Float4 Abs(const Float4& x) noexcept
+{
+  return Float4(_mm_andnot_ps(_mm_set1_ps(-0.0f), x.value));
+}
+
+inline Float4 CopySign(const Float4& magnitude, const Float4& sign) noexcept
+{
+  __m128 mask = _mm_set1_ps(-0.0f);
+  return Float4(
+      _mm_or_ps(_mm_andnot_ps(mask, magnitude.value), _mm_and_ps(mask, sign.value))
+  );
+}
+
+inline Float4 Min(const Float4& a, const Float4& b) noexcept
+{
+  return Float4(_mm_min_ps(a.value, b.value));
+}
+
+inline Float4 Max(const Float4& a, const Float4& b) noexcept
+{
+  return Float4(_mm_max_ps(a.value, b.value));
+}
+
+inline Float4 Sqrt(const Float4& x) noexcept
+{
+  return Float4(_mm_sqrt_ps(x.value));
+}
+
+inline Float4 Round(const Float4& x) noexcept
+{
+  __m128 magic = _mm_set1_ps(Internal::roundMagic);
+  return Float4(_mm_sub_ps(_mm_add_ps(x.value, magic), magic));
+}
+
+inline Float4 Pow2(const Float4& n) noexcept
+{
+  __m128i exponent = _mm_add_epi32(_mm_cvtps_epi32(n.value), _mm_set1_epi32(127));
+  return Float4(_mm_castsi128_ps(_mm_slli_epi32(exponent, 23)));
+}
+
+inline Float4 Frexp(const Float4& x, Float4& exponent) noexcept
+{
+  __m128i bits = _mm_castps_si128(x.value);
+  exponent = Float4(_mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(126))));
+  __m128i mantissa = _mm_and_si128(bits, _mm_set1_epi32(static_cast<i32>(Internal::mantissaMask)));
+  mantissa = _mm_or_si128(mantissa, _mm_set1_epi32(static_cast<i32>(Internal::halfExponent)));
+  return Float4(_mm_castsi128_ps(mantissa));
+}
+
+#else
+
+inline Float4::Float4(f32 value) noexcept
+{
+  for (f32& lane : this->value)
+    lane = value;
+}
+
+inline Float4 Float4::Load(const f32* data) noexcept
+{
+  Float4 result;
+  std::memcpy(result.value, data, sizeof(result.value));
+  return result;
+}
+
+inline void Float4::Store(f32* data) const noexcept
+{
+  std::memcpy(data, value, sizeof(value));
+}
+
+namespace Internal
+{
+
+template <typename Func>
+Float4 Lanes(Func&& func) noexcept
+{
+  Float4 result;
+  for (u32 i = 0; i < Float4::width; ++i)
+    result.value[i] = func(i);
+  return result;
+}
+
+inline f32 Mask(bool condition) noexcept
+{
+  return BitsFloat(condition ? ~0u : 0u);
+}
+
+inline bool IsSet(f32 mask) noexcept
+{
+  return FloatBits(mask) != 0;
+}
+
+} // namespace Internal
+
+inline Float4 operator+(const Float4& a, const Float4& b) noexcept
+{
+  return Internal::Lanes([&](u32 i) { return a.value[i] + b.value[i]; });
+}
+
+inline Float4 operator-(const Float4& a, const Float4& b) noexcept
+{
+  return Internal::Lanes([&](u32 i) { return a.value[i] - b.value[i]; });
+}
+
+inline Float4 operator*(const Float4& a, const Float4& b) noexcept
+{
+  return Internal::Lanes([&](u32 i) { return a.value[i] * b.value[i]; });
+}
+
+inline Float4 operator/(const Float4& a, const Float4& b) noexcept
+{
+  return Internal::Lanes([&](u32 i) { return a.value[i] / b.value[i]; });
+}
+
+inline Float4 operator-(const Float4& a) noexcept
+{
+  return Internal::Lanes([&](u32 i) { return -a.value[i]; });
+}
+
+inline Float4 operator<(const Float4& a, const Float4& b) noexcept
+{
+  return Internal::Lanes([&](u32 i) { return Internal::Mask(a.value[i] < b.value[i]); });
+}
+
+inline Float4 operator>(const Float4& a, const Float4& b) noexcept
+{
+  return Internal::Lanes([&](u32 i) { return Internal::Mask(a.value[i] > b.value[i]); });
+}
+
+inline Float4 operator==(const Float4& a, const Float4& b) noexcept
+{
+  return Internal::Lanes([&](u32 i) { return Internal::Mask(a.value[i] == b.value[i]); });
+}
+
+inline Float4 operator|(const Float4& a, const Float4& b) noexcept
+{
+  return Internal::Lanes([&](u32 i) {
+    return Internal::BitsFloat(Internal::FloatBits(a.value[i]) | Internal::FloatBits(b.value[i]));
+  });
+}
+
+inline Float4 operator&(const Float4& a, const Float4& b) noexcept
+{
+  return Internal::Lanes([&](u32 i) {
+    return Internal::BitsFloat(Internal::FloatBits(a.value[i]) & Internal::FloatBits(b.value[i]));
+  });
+}
+
+inline Float4 MulAdd(const Float4& a, const Float4& b, const Float4& c) noexcept
+{
+  return Internal::Lanes([&](u32 i) { return MulAdd(a.value[i], b.value[i], c.value[i]); });
+}
+
+inline Float4 Select(const Float4& mask, const Float4& a, const Float4& b) noexcept
+{
+  return Internal::Lanes([&](u32 i) {
+    return Internal::IsSet(mask.value[i]) ? a.value[i] : b.value[i];
+  });
+}
+
+inline Float4 Abs(const Float4& x) noexcept
+{
+  return Internal::Lanes([&](u32 i) { return Abs(x.value[i]); });
+}
+
+inline Float4 CopySign(const Float4& magnitude, const Float4& sign) noexcept
+{
+  return Internal::Lanes([&](u32 i) { return CopySign(magnitude.value[i], sign.value[i]); });
+}
+
+inline Float4 Min(const Float4& a, const Float4& b) noexcept
+{
+  return Internal::Lanes([&](u32 i) { return Min(a.value[i], b.value[i]); });
+}
+
+inline Float4 Max(const Float4& a, const Float4& b) noexcept
+{
+  return Internal::Lanes([&](u32 i) { return Max(a.value[i], b.value[i]); });
+}
+
+inline Float4 Sqrt(const Float4& x) noexcept
+{
+  return Internal::Lanes([&](u32 i) { return Sqrt(x.value[i]); });
+}
+
+inline Float4 Round(const Float4& x) noexcept
+{
+  return Internal::Lanes([&](u32 i) { return Round(x.value[i]); });
+}
+
+inline Float4 Pow2(const Float4& n) noexcept
+{
+  return Internal::Lanes([&](u32 i) { return Pow2(n.value[i]); });
+}
+
+inline Float4 Frexp(const Float4& x, Float4& exponent) noexcept
+{
+  return Internal::Lanes([&](u32 i) { return Frexp(x.value[i], exponent.value[i]); });
+}
+
+#endif
+
+#if defined(__AVX2__)
+
+inline Float8::Float8(f32 value) noexcept
+    : value(_mm256_set1_ps(value))
+{
+}
+
+inline Float8::Float8(__m256 value) noexcept
+    : value(value)
+{
+}
+
+inline Float8 Float8::Load(const f32* data) noexcept
+{
+  return Float8(_mm256_loadu_ps(data));
+}
+
+inline void Float8::Store(f32* data) const noexcept
+{
+  _mm256_storeu_ps(data, value);
+}
+
+inline Float8 operator+(const Float8& a, const Float8& b) noexcept
+{
+  return Float8(_mm256_add_ps(a.value, b.value));
+}
+
+inline Float8 operator-(const Float8& a, const Float8& b) noexcept
+{
+  return Float8(_mm256_sub_ps(a.value, b.value));
+}
+
+inline Float8 operator*(const Float8& a, const Float8& b) noexcept
+{
+  return Float8(_mm256_mul_ps(a.value, b.value));
+}
+
+inline Float8 operator/(const Float8& a, const Float8& b) noexcept
+{
+  return Float8(_mm256_div_ps(a.value, b.value));
+}
+
+inline Float8 operator-(const Float8& a) noexcept
+{
+  return Float8(_mm256_xor_ps(a.value, _mm256_set1_ps(-0.0f)));
+}
+
+inline Float8 operator<(const Float8& a, const Float8& b) noexcept
+{
+  return Float8(_mm256_cmp_ps(a.value, b.value, _CMP_LT_OQ));
+}
+
+inline Float8 operator>(const Float8& a, const Float8& b) noexcept
+{
+  return Float8(_mm256_cmp_ps(a.value, b.value, _CMP_GT_OQ));
+}
+
+inline Float8 operator==(const Float8& a, const Float8& b) noexcept
+{
+  return Float8(_mm256_cmp_ps(a.value, b.value, _CMP_EQ_OQ));
+}
+
+inline Float8 operator|(const Float8& a, const Float8& b) noexcept
+{
+  return Float8(_mm256_or_ps(a.value, b.value));
+}
+
+inline Float8 operator&(const Float8& a, const Float8& b) noexcept
+{
+  return Float8(_mm256_and_ps(a.value, b.value));
+}
+
+inline Float8 MulAdd(const Float8& a, const Float8& b, const Float8& c) noexcept
+{
+  #if defined(__FMA__)
+  return Float8(_mm256_fmadd_ps(a.value, b.value, c.value));
+  #else
+  return Float8(_mm256_add_ps(_mm256_mul_ps(a.value, b.value), c.value));
+  #endif
+}
+
+inline Float8 Select(const Float8& mask, const Float8& a, const Float8& b) noexcept
+{
+  return Float8(_mm256_blendv_ps(b.value, a.value, mask.value));
+}
+
+inline Float8 Abs(const Float8& x) noexcept
+{
+  return Float8(_mm256_andnot_ps(_mm256_set1_ps(-0.0f), x.value));
+}
+
+inline Float8 CopySign(const Float8& magnitude, const Float8& sign) noexcept
+{
+  __m256 mask = _mm256_set1_ps(-0.0f);
+  return Float8(
+      _mm256_or_ps(_mm256_andnot_ps(mask, magnitude.value), _mm256_and_ps(mask, sign.value))
+  );
+}
+
+inline Float8 Min(const Float8& a, const Float8& b) noexcept
+{
+  return Float8(_mm256_min_ps(a.value, b.value));
+}
+
+inline Float8 Max(const Float8& a, const Float8& b) noexcept
+{
+  return Float8(_mm256_max_ps(a.value, b.value));
+}
+
+inline Float8 Sqrt(const Float8& x) noexcept
+{
+  return Float8(_mm256_sqrt_ps(x.value));
+}
+
+inline Float8 Round(const Float8& x) noexcept
+{
+  return Float8(_mm256_round_ps(x.value, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+}
+
+inline Float8 Pow2(const Float8& n) noexcept
+{
+  __m256i exponent = _mm256_add_epi32(_mm256_cvtps_epi32(n.value), _mm256_set1_epi32(127));
+  return Float8(_mm256_castsi256_ps(_mm256_slli_epi32(exponent, 23)));
+}
+
+inline Float8 Frexp(const Float8& x, Float8& exponent) noexcept
+{
+  __m256i bits = _mm256_castps_si256(x.value);
+  __m256i biased = _mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(126));
+  exponent = Float8(_mm256_cvtepi32_ps(biased));
+  __m256i mantissa =
+      _mm256_and_si256(bits, _mm256_set1_epi32(static_cast<i32>(Internal::mantissaMask)));
+  __m256i half = _mm256_set1_epi32(static_cast<i32>(Internal::halfExponent));
+  mantissa = _mm256_or_si256(mantissa, half);
+  return Float8(_mm256_castsi256_ps(mantissa));
+}
+
+#else
+
+inline Float8::Float8(f32 value) noexcept
+    : low(value),
+      high(value)
+{
+}
+
+inline Float8::Float8(const Float4& low, const Float4& high) noexcept
+    : low(low),
+      high(high)
+{
+}
+
+inline Float8 Float8::Load(const f32* data) noexcept
+{
+  return Float8(Float4::Load(data), Float4::Load(data + Float4::width));
+}
+
+inline void Float8::Store(f32* data) const noexcept
+{
+  low.Store(data);
+  high.Store(data + Float4::width);
+}
+
+inline Float8 operator+(const Float8& a, const Float8& b) noexcept
+{
+  return Float8(a.low + b.low, a.high + b.high);
+}
+
+inline Float8 operator-(const Float8& a, const Float8& b) noexcept
+{
+  return Float8(a.low - b.low, a.high - b.high);
+}
+
+inline Float8 operator*(const Float8& a, const Float8& b) noexcept
+{
+  return Float8(a.low * b.low, a.high * b.high);
+}
+
+inline Float8 operator/(const Float8& a, const Float8& b) noexcept
+{
+  return Float8(a.low / b.low, a.high / b.high);
+}
+
+inline Float8 operator-(const Float8& a) noexcept
+{
+  return Float8(-a.low, -a.high);
+}
+
+inline Float8 operator<(const Float8& a, const Float8& b) noexcept
+{
+  return Float8(a.low < b.low, a.high < b.high);
+}
+
+inline Float8 operator>(const Float8& a, const Float8& b) noexcept
+{
+  return Float8(a.low > b.low, a.high > b.high);
+}
+
+inline Float8 operator==(const Float8& a, const Float8& b) noexcept
+{
+  return Float8(a.low == b.low, a.high == b.high);
+}
+
+inline Float8 operator|(const Float8& a, const Float8& b) noexcept
+{
+  return Float8(a.low | b.low, a.high | b.high);
+}
+
+inline Float8 operator&(const Float8& a, const Float8& b) noexcept
+{
+  return Float8(a.low & b.low, a.high & b.high);
+}
+
+inline Float8 MulAdd(const Float8& a, const Float8& b, const Float8& c) noexcept
+{
+  return Float8(MulAdd(a.low, b.low, c.low), MulAdd(a.high, b.high, c.high));
+}
+
+inline Float8 Select(const Float8& mask, const Float8& a, const Float8& b) noexcept
+{
+  return Float8(Select(mask.low, a.low, b.low), Select(mask.high, a.high, b.high));
+}
+
+inline Float8 Abs(const Float8& x) noexcept
+{
+  return Float8(Abs(x.low), Abs(x.high));
+}
+
+inline Float8 CopySign(const Float8& magnitude, const Float8& sign) noexcept
+{
+  return Float8(CopySign(magnitude.low, sign.low), CopySign(magnitude.high, sign.high));
+}
+
+inline Float8 Min(const Float8& a, const Float8& b) noexcept
+{
+  return Float8(Min(a.low, b.low), Min(a.high, b.high));
+}
+
+inline Float8 Max(const Float8& a, const Float8& b) noexcept
+{
+  return Float8(Max(a.low, b.low), Max(a.high, b.high));
+}
+
+inline Float8 Sqrt(const Float8& x) noexcept
+{
+  return Float8(Sqrt(x.low), Sqrt(x.high));
+}
+
+inline Float8 Round(const Float8& x) noexcept
+{
+  return Float8(Round(x.low), Round(x.high));
+}
+
+inline Float8 Pow2(const Float8& n) noexcept
+{
+  return Float8(Pow2(n.low), Pow2(n.high));
+}
+
+inline Float8 Frexp(const Float8& x, Float8& exponent) noexcept
+{
+  return Float8(Frexp(x.low, exponent.low), Frexp(x.high, exponent.high));
+}
+
+#endif
+
+template <typename Func>
+void ForEachLane(std::size_t begin, std::size_t end, Func&& func) noexcept
+{
+  std::size_t i = begin;
+  for (; i + WidestFloat::width <= end; i += WidestFloat::width)
+    func(WidestFloat(), i);
+  for (; i < end; ++i)
+    func(f32(), i);
+}
+
+template <typename V>
+V Load(const f32* data) noexcept
+{
+  if constexpr (std::is_same_v<V, f32>)
+    return *data;
+  else
+    return V::Load(data);
+}
+
+template <typename V>
+void Store(const V& value, f32* data) noexcept
+{
+  if constexpr (std::is_same_v<V, f32>)
+    *data = value;
+  else
+    value.Store(data);
+}
+
+} // namespace Engine::Core::Math
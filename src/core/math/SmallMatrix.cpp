@@ -0,0 +1,10 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file SmallMatrix.cpp
+ * @brief All implementation contains in header file SmallMatrix.h
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include "core/math/SmallMatrix.h"
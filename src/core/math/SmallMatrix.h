@@ -0,0 +1,170 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file SmallMatrix.h
+ * @brief Eigen decomposition and linear solves of small dense symmetric matrices
+ *
+ * Fitting problems such as best-fit rotations, normal estimation and least squares updates end in
+ * 3x3 to 6x6 symmetric systems. These are solved in double precision on plain arrays, with cyclic
+ * Jacobi rotations for eigenpairs and Cholesky factorization for positive definite systems.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+namespace Engine::Core::Math
+{
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+struct SmallMatrixSettings
+{
+  /// Jacobi sweeps over all off-diagonal elements, convergence is quadratic and takes a few
+  static constexpr u32 maxSweeps = 32;
+};
+
+/**
+ * @brief Eigenvalues and eigenvectors of a symmetric matrix, only the upper triangle is read
+ * @param values eigenvalues in ascending order
+ * @param vectors column i is the unit eigenvector of values[i]
+ */
+template <std::size_t N>
+void SymmetricEigen(const f64 (&matrix)[N][N], f64 (&values)[N], f64 (&vectors)[N][N]) noexcept;
+
+/**
+ * @brief Solves matrix * solution = rhs for a symmetric positive definite matrix
+ * @return false if matrix is not positive definite within rounding, solution is left unchanged
+ */
+template <std::size_t N>
+bool SolveSymmetric(const f64 (&matrix)[N][N], const f64 (&rhs)[N], f64 (&solution)[N]) noexcept;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+template <std::size_t N>
+void SymmetricEigen(const f64 (&matrix)[N][N], f64 (&values)[N], f64 (&vectors)[N][N]) noexcept
+{
+  f64 a[N][N];
+  for (std::size_t i = 0; i < N; ++i) {
+    for (std::size_t j = 0; j < N; ++j) {
+      a[i][j] = i <= j ? matrix[i][j] : matrix[j][i];
+      vectors[i][j] = i == j ? 1.0 : 0.0;
+    }
+  }
+
+  for (u32 sweep = 0; sweep < SmallMatrixSettings::maxSweeps; ++sweep) {
+    f64 diagonal = 0.0;
+    f64 offDiagonal = 0.0;
+    for (std::size_t p = 0; p < N; ++p) {
+      diagonal += a[p][p] * a[p][p];
+      for (std::size_t q = p + 1; q < N; ++q)
+        offDiagonal += a[p][q] * a[p][q];
+    }
+    constexpr f64 epsilon = std::numeric_limits<f64>::epsilon();
+    if (offDiagonal <= epsilon * epsilon * diagonal || offDiagonal == 0.0)
+      break;
+
+    for (std::size_t p = 0; p < N; ++p) {
+      for (std::size_t q = p + 1; q < N; ++q) {
+        if (a[p][q] == 0.0)
+          continue;
+
+        // rotation J with tan = t zeroes a[p][q] in J^T * A * J
+        f64 theta = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+        f64 t = 1.0 / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+        if (theta < 0.0)
+          t = -t;
+        f64 c = 1.0 / std::sqrt(t * t + 1.0);
+        f64 s = t * c;
+
+        for (std::size_t k = 0; k < N; ++k) {
+          f64 kp = a[k][p];
+          f64 kq = a[k][q];
+          a[k][p] = c * kp - s * kq;
+          a[k][q] = s * kp + c * kq;
+        }
+        for (std::size_t k = 0; k < N; ++k) {
+          f64 pk = a[p][k];
+          f64 qk = a[q][k];
+          a[p][k] = c * pk - s * qk;
+          a[q][k] = s * pk + c * qk;
+        }
+        for (std::size_t k = 0; k < N; ++k) {
+          f64 kp = vectors[k][p];
+          f64 kq = vectors[k][q];
+          vectors[k][p] = c * kp - s * kq;
+          vectors[k][q] = s * kp + c * kq;
+        }
+        a[p][q] = 0.0;
+        a[q][p] = 0.0;
+      }
+    }
+  }
+
+  for (std::size_t i = 0; i < N; ++i)
+    values[i] = a[i][i];
+
+  // selection sort keeps eigenvector columns paired with their values
+  for (std::size_t i = 0; i < N; ++i) {
+    std::size_t smallest = i;
+    for (std::size_t j = i + 1; j < N; ++j) {
+      if (values[j] < values[smallest])
+        smallest = j;
+    }
+    if (smallest == i)
+      continue;
+    std::swap(values[i], values[smallest]);
+    for (std::size_t k = 0; k < N; ++k)
+      std::swap(vectors[k][i], vectors[k][smallest]);
+  }
+}
+
+template <std::size_t N>
+bool SolveSymmetric(const f64 (&matrix)[N][N], const f64 (&rhs)[N], f64 (&solution)[N]) noexcept
+{
+  f64 maxDiagonal = 0.0;
+  for (std::size_t i = 0; i < N; ++i)
+    maxDiagonal = std::max(maxDiagonal, std::abs(matrix[i][i]));
+  f64 tolerance = maxDiagonal * N * std::numeric_limits<f64>::epsilon();
+
+  // lower factor L with matrix = L * L^T
+  f64 lower[N][N] = {};
+  for (std::size_t j = 0; j < N; ++j) {
+    f64 pivot = matrix[j][j];
+    for (std::size_t k = 0; k < j; ++k)
+      pivot -= lower[j][k] * lower[j][k];
+    if (!(pivot > tolerance))
+      return false;
+    lower[j][j] = std::sqrt(pivot);
+
+    for (std::size_t i = j + 1; i < N; ++i) {
+      f64 value = matrix[j][i];
+      for (std::size_t k = 0; k < j; ++k)
+        value -= lower[i][k] * lower[j][k];
+      lower[i][j] = value / lower[j][j];
+    }
+  }
+
+  f64 y[N];
+  for (std::size_t i = 0; i < N; ++i) {
+    f64 value = rhs[i];
+    for (std::size_t k = 0; k < i; ++k)
+      value -= lower[i][k] * y[k];
+    y[i] = value / lower[i][i];
+  }
+  for (std::size_t i = N; i-- > 0;) {
+    f64 value = y[i];
+    for (std::size_t k = i + 1; k < N; ++k)
+      value -= lower[k][i] * solution[k];
+    solution[i] = value / lower[i][i];
+  }
+  return true;
+}
+
+} // namespace Engine::Core::Math
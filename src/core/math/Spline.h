@@ -0,0 +1,487 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Spline.h
+ * @brief Piecewise cubic Bezier, Catmull-Rom and uniform B-spline curves over Vector2 and Vector3
+ *
+ * A spline is a chain of cubic segments, segment i covering the global parameter range [i, i + 1].
+ * All three kinds are converted once to power basis coefficients a u^3 + b u^2 + c u + d by their
+ * basis matrices, so evaluation is three multiply-adds per component whatever the kind. The batch
+ * form evaluates runs of parameters falling into one segment in a loop over constant
+ * coefficients, which the compiler vectorizes across parameters. De Casteljau evaluation of
+ * Bezier curves of any degree is provided for control polygons which are not split into cubics.
+ *
+ * Arc length parameterization uses a table of cumulative lengths at evenly spaced parameters
+ * integrated with Gauss-Legendre quadrature. A distance is mapped to a parameter by binary search
+ * and linear interpolation in that table. Tessellation subdivides every segment until the curve
+ * at the quarter points of a piece lies within a tolerance of its chord.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/math/Vector2.h"
+#include "core/math/Vector3.h"
+#include "core/parallel/ThreadPool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace Engine::Core::Math
+{
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+struct SplineSettings
+{
+  /// Default number of arc length table intervals per segment
+  static constexpr u32 samplesPerSegment = 16;
+  /// Pieces of a segment are halved at most this many times by tessellation
+  static constexpr u32 maxSubdivisions = 12;
+  /// Highest number of control points accepted by DeCasteljau
+  static constexpr std::size_t maxControlPoints = 32;
+  /// Default number of parameters in one chunk of the parallel forms
+  static constexpr std::size_t grain = 4096;
+};
+
+enum class SplineType : u8
+{
+  /// Segments of four control points sharing end points, 3n + 1 points give n segments
+  Bezier,
+  /// Passes through every point, n points give n - 1 segments
+  CatmullRom,
+  /// Uniform cubic B-spline approximating the points, n points give n - 3 segments
+  BSpline
+};
+
+/// Bezier curve of degree count - 1 at t in [0, 1]
+template <typename V, typename T>
+V DeCasteljau(const V* controls, std::size_t count, T t) noexcept;
+
+/// V is Vector2<T> or Vector3<T>
+template <typename V>
+class Spline
+{
+ public:
+  using Scalar = decltype(V::x);
+
+  Spline() noexcept = default;
+
+  /// Builds the segments of points, previous content and arc length table are dropped
+  void Build(SplineType type, const V* points, std::size_t count) noexcept;
+  void Clear() noexcept;
+
+  std::size_t SegmentCount() const noexcept;
+  bool Empty() const noexcept;
+
+  /// Point at global parameter t clamped to [0, SegmentCount()]
+  V Evaluate(Scalar t) const noexcept;
+  /// First derivative with respect to the global parameter
+  V Derivative(Scalar t) const noexcept;
+  /// Batch form writing out[i] = Evaluate(parameters[i])
+  void Evaluate(const Scalar* parameters, V* out, std::size_t count) const noexcept;
+  void Evaluate(
+      const Scalar* parameters,
+      V* out,
+      std::size_t count,
+      Parallel::ThreadPool& pool,
+      std::size_t grain = SplineSettings::grain
+  ) const noexcept;
+
+  /// Fills the arc length table, needed by Length and the distance based functions
+  void BuildArcLengthTable(u32 samples = SplineSettings::samplesPerSegment) noexcept;
+  Scalar Length() const noexcept;
+  /// Global parameter at arc length distance clamped to [0, Length()]
+  Scalar ParameterAtDistance(Scalar distance) const noexcept;
+  V EvaluateAtDistance(Scalar distance) const noexcept;
+  /// Writes count points evenly spaced by arc length from start to end, count >= 2
+  void EvaluateEvenly(V* out, std::size_t count) const noexcept;
+
+  /**
+   * @brief Polyline within tolerance of the curve
+   * @param out cleared and filled with the start point and the end point of every piece
+   */
+  void Tessellate(Scalar tolerance, std::vector<V>& out) const noexcept;
+
+ private:
+  struct Segment
+  {
+    V a;
+    V b;
+    V c;
+    V d;
+  };
+
+  /// Segment of t and the local parameter in [0, 1]
+  std::size_t Locate(Scalar t, Scalar& u) const noexcept;
+  void EvaluateRange(const Scalar* parameters, V* out, std::size_t count) const noexcept;
+  /// Length of segment over [u0, u1]
+  Scalar SegmentLength(const Segment& segment, Scalar u0, Scalar u1) const noexcept;
+
+  static V Horner(const Segment& segment, Scalar u) noexcept;
+  static V HornerDerivative(const Segment& segment, Scalar u) noexcept;
+
+  std::vector<Segment> segments;
+  u32 samplesPerSegment = 0;
+  /// Cumulative length at global parameters k / samplesPerSegment
+  std::vector<Scalar> arcLengths;
+};
+
+/* ------------------------------------------- Usings ------------------------------------------ */
+using Spline2f = Spline<Vector2f>;
+using Spline2d = Spline<Vector2d>;
+using Spline3f = Spline<Vector3f>;
+using Spline3d = Spline<Vector3d>;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+namespace Internal
+{
+
+/// Rows give the weights of the four points in the u^3, u^2, u and 1 coefficients, times scale
+struct SplineBasis
+{
+  f64 weights[4][4];
+  f64 scale;
+};
+
+constexpr SplineBasis bezierBasis = {
+    {{-1.0, 3.0, -3.0, 1.0}, {3.0, -6.0, 3.0, 0.0}, {-3.0, 3.0, 0.0, 0.0}, {1.0, 0.0, 0.0, 0.0}},
+    1.0};
+constexpr SplineBasis catmullRomBasis = {
+    {{-1.0, 3.0, -3.0, 1.0}, {2.0, -5.0, 4.0, -1.0}, {-1.0, 0.0, 1.0, 0.0}, {0.0, 2.0, 0.0, 0.0}},
+    0.5};
+constexpr SplineBasis bSplineBasis = {
+    {{-1.0, 3.0, -3.0, 1.0}, {3.0, -6.0, 3.0, 0.0}, {-3.0, 0.0, 3.0, 0.0}, {1.0, 4.0, 1.0, 0.0}},
+    1.0 / 6.0};
+
+template <typename V>
+V Combine(const SplineBasis& basis, u32 row, const V* points[4]) noexcept
+{
+  using T = decltype(V::x);
+  V result = *points[0] * static_cast<T>(basis.weights[row][0] * basis.scale);
+  for (u32 j = 1; j < 4; ++j)
+    result += *points[j] * static_cast<T>(basis.weights[row][j] * basis.scale);
+  return result;
+}
+
+/// Squared distance from point to the segment [a, b]
+template <typename V>
+decltype(V::x) DistanceToChordSquared(const V& point, const V& a, const V& b) noexcept
+{
+  using T = decltype(V::x);
+  V chord = b - a;
+  T length = chord.LengthSquared();
+  T s = length > T(0) ? std::clamp((point - a).Dot(chord) / length, T(0), T(1)) : T(0);
+  return (a + chord * s - point).LengthSquared();
+}
+
+} // namespace Internal
+
+template <typename V, typename T>
+V DeCasteljau(const V* controls, std::size_t count, T t) noexcept
+{
+  assert(count >= 1 && count <= SplineSettings::maxControlPoints && "Unsupported Bezier degree");
+  count = std::min(count, SplineSettings::maxControlPoints);
+  if (count == 0)
+    return V();
+
+  V points[SplineSettings::maxControlPoints];
+  std::copy(controls, controls + count, points);
+  for (std::size_t level = count - 1; level > 0; --level) {
+    for (std::size_t i = 0; i < level; ++i)
+      points[i] = points[i].Lerp(points[i + 1], t);
+  }
+  return points[0];
+}
+
+template <typename V>
+void Spline<V>::Build(SplineType type, const V* points, std::size_t count) noexcept
+{
+  Clear();
+  const V* window[4];
+  if (type == SplineType::Bezier) {
+    assert((count == 0 || (count >= 4 && count % 3 == 1)) && "Bezier needs 3n + 1 points");
+    for (std::size_t first = 0; first + 3 < count; first += 3) {
+      for (u32 j = 0; j < 4; ++j)
+        window[j] = &points[first + j];
+      segments.push_back({Internal::Combine(Internal::bezierBasis, 0, window),
+                          Internal::Combine(Internal::bezierBasis, 1, window),
+                          Internal::Combine(Internal::bezierBasis, 2, window),
+                          Internal::Combine(Internal::bezierBasis, 3, window)});
+    }
+    return;
+  }
+
+  const Internal::SplineBasis& basis =
+      type == SplineType::CatmullRom ? Internal::catmullRomBasis : Internal::bSplineBasis;
+  // Catmull-Rom repeats the end points so the curve reaches them
+  std::size_t segmentCount = 0;
+  if (type == SplineType::CatmullRom && count >= 2)
+    segmentCount = count - 1;
+  else if (type == SplineType::BSpline && count >= 4)
+    segmentCount = count - 3;
+  assert((count == 0 || segmentCount > 0) && "Too few points for the spline type");
+
+  for (std::size_t i = 0; i < segmentCount; ++i) {
+    for (u32 j = 0; j < 4; ++j) {
+      std::size_t index = i + j;
+      if (type == SplineType::CatmullRom)
+        index = std::clamp<std::size_t>(i + j, 1, count) - 1;
+      window[j] = &points[index];
+    }
+    segments.push_back({Internal::Combine(basis, 0, window), Internal::Combine(basis, 1, window),
+                        Internal::Combine(basis, 2, window), Internal::Combine(basis, 3, window)});
+  }
+}
+
+template <typename V>
+void Spline<V>::Clear() noexcept
+{
+  segments.clear();
+  samplesPerSegment = 0;
+  arcLengths.clear();
+}
+
+template <typename V>
+std::size_t Spline<V>::SegmentCount() const noexcept
+{
+  return segments.size();
+}
+
+template <typename V>
+bool Spline<V>::Empty() const noexcept
+{
+  return segments.empty();
+}
+
+template <typename V>
+V Spline<V>::Evaluate(Scalar t) const noexcept
+{
+  assert(!segments.empty() && "Evaluating an empty spline");
+  if (segments.empty())
+    return V();
+  Scalar u;
+  std::size_t segment = Locate(t, u);
+  return Horner(segments[segment], u);
+}
+
+template <typename V>
+V Spline<V>::Derivative(Scalar t) const noexcept
+{
+  assert(!segments.empty() && "Evaluating an empty spline");
+  if (segments.empty())
+    return V();
+  Scalar u;
+  std::size_t segment = Locate(t, u);
+  return HornerDerivative(segments[segment], u);
+}
+
+template <typename V>
+void Spline<V>::Evaluate(const Scalar* parameters, V* out, std::size_t count) const noexcept
+{
+  EvaluateRange(parameters, out, count);
+}
+
+template <typename V>
+void Spline<V>::Evaluate(
+    const Scalar* parameters,
+    V* out,
+    std::size_t count,
+    Parallel::ThreadPool& pool,
+    std::size_t grain
+) const noexcept
+{
+  pool.ParallelFor(count, grain, [&](std::size_t begin, std::size_t end) {
+    EvaluateRange(parameters + begin, out + begin, end - begin);
+  });
+}
+
+template <typename V>
+void Spline<V>::BuildArcLengthTable(u32 samples) noexcept
+{
+  samplesPerSegment = std::max<u32>(samples, 1);
+  arcLengths.resize(segments.size() * samplesPerSegment + 1);
+  arcLengths[0] = Scalar(0);
+  Scalar step = Scalar(1) / static_cast<Scalar>(samplesPerSegment);
+  std::size_t k = 1;
+  for (const Segment& segment : segments) {
+    for (u32 s = 0; s < samplesPerSegment; ++s, ++k) {
+      Scalar u0 = static_cast<Scalar>(s) * step;
+      arcLengths[k] = arcLengths[k - 1] + SegmentLength(segment, u0, u0 + step);
+    }
+  }
+}
+
+template <typename V>
+typename Spline<V>::Scalar Spline<V>::Length() const noexcept
+{
+  assert(!arcLengths.empty() && "BuildArcLengthTable has to be called first");
+  return arcLengths.empty() ? Scalar(0) : arcLengths.back();
+}
+
+template <typename V>
+typename Spline<V>::Scalar Spline<V>::ParameterAtDistance(Scalar distance) const noexcept
+{
+  assert(!arcLengths.empty() && "BuildArcLengthTable has to be called first");
+  if (arcLengths.size() < 2)
+    return Scalar(0);
+  if (!(distance > Scalar(0)))
+    return Scalar(0);
+  if (distance >= arcLengths.back())
+    return static_cast<Scalar>(segments.size());
+
+  // arcLengths[k] <= distance < arcLengths[k + 1]
+  std::size_t k = static_cast<std::size_t>(
+      std::upper_bound(arcLengths.begin(), arcLengths.end(), distance) - arcLengths.begin() - 1);
+  Scalar interval = arcLengths[k + 1] - arcLengths[k];
+  Scalar fraction = interval > Scalar(0) ? (distance - arcLengths[k]) / interval : Scalar(0);
+  return (static_cast<Scalar>(k) + fraction) / static_cast<Scalar>(samplesPerSegment);
+}
+
+template <typename V>
+V Spline<V>::EvaluateAtDistance(Scalar distance) const noexcept
+{
+  return Evaluate(ParameterAtDistance(distance));
+}
+
+template <typename V>
+void Spline<V>::EvaluateEvenly(V* out, std::size_t count) const noexcept
+{
+  assert(count >= 2 && "Start and end need two points");
+  if (count == 0)
+    return;
+
+  // distances grow, so the table search continues from the previous interval
+  Scalar length = Length();
+  Scalar spacing = count > 1 ? length / static_cast<Scalar>(count - 1) : Scalar(0);
+  std::size_t k = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    Scalar distance = std::min(static_cast<Scalar>(i) * spacing, length);
+    while (k + 2 < arcLengths.size() && arcLengths[k + 1] <= distance)
+      ++k;
+    Scalar interval = arcLengths[k + 1] - arcLengths[k];
+    Scalar fraction = interval > Scalar(0) ? (distance - arcLengths[k]) / interval : Scalar(0);
+    out[i] = Evaluate((static_cast<Scalar>(k) + std::min(fraction, Scalar(1))) /
+                      static_cast<Scalar>(samplesPerSegment));
+  }
+}
+
+template <typename V>
+void Spline<V>::Tessellate(Scalar tolerance, std::vector<V>& out) const noexcept
+{
+  out.clear();
+  if (segments.empty())
+    return;
+
+  struct Piece
+  {
+    Scalar u0;
+    Scalar u1;
+    u32 depth;
+  };
+  Scalar toleranceSquared = tolerance * tolerance;
+  Piece stack[SplineSettings::maxSubdivisions + 1];
+
+  out.push_back(Horner(segments[0], Scalar(0)));
+  for (const Segment& segment : segments) {
+    // depth first with the left half on top, so end points come out in order
+    u32 size = 0;
+    stack[size++] = {Scalar(0), Scalar(1), 0};
+    while (size > 0) {
+      Piece piece = stack[--size];
+      V p0 = Horner(segment, piece.u0);
+      V p1 = Horner(segment, piece.u1);
+      bool curved = false;
+      for (u32 q = 1; q <= 3 && !curved; ++q) {
+        Scalar u = piece.u0 + (piece.u1 - piece.u0) * static_cast<Scalar>(q) * Scalar(0.25);
+        curved = Internal::DistanceToChordSquared(Horner(segment, u), p0, p1) > toleranceSquared;
+      }
+      if (!curved || piece.depth == SplineSettings::maxSubdivisions) {
+        out.push_back(p1);
+        continue;
+      }
+      Scalar middle = (piece.u0 + piece.u1) * Scalar(0.5);
+      stack[size++] = {middle, piece.u1, piece.depth + 1};
+      stack[size++] = {piece.u0, middle, piece.depth + 1};
+    }
+  }
+}
+
+template <typename V>
+std::size_t Spline<V>::Locate(Scalar t, Scalar& u) const noexcept
+{
+  Scalar last = static_cast<Scalar>(segments.size() - 1);
+  Scalar index = std::floor(std::clamp(t, Scalar(0), last));
+  u = std::clamp(t - index, Scalar(0), Scalar(1));
+  return static_cast<std::size_t>(index);
+}
+
+template <typename V>
+void Spline<V>::EvaluateRange(const Scalar* parameters, V* out, std::size_t count) const noexcept
+{
+  assert((count == 0 || !segments.empty()) && "Evaluating an empty spline");
+  if (segments.empty())
+    return;
+
+  std::size_t i = 0;
+  while (i < count) {
+    Scalar u;
+    std::size_t index = Locate(parameters[i], u);
+    Scalar low = static_cast<Scalar>(index);
+    Scalar high = low + Scalar(1);
+    bool first = index == 0;
+    bool last = index + 1 == segments.size();
+
+    // the run continues while parameters stay inside the segment, the outer ones clamp
+    std::size_t end = i + 1;
+    while (end < count && (first || parameters[end] >= low) && (last || parameters[end] < high))
+      ++end;
+
+    const Segment& segment = segments[index];
+    for (std::size_t j = i; j < end; ++j) {
+      Scalar local = std::clamp(parameters[j] - low, Scalar(0), Scalar(1));
+      out[j] = Horner(segment, local);
+    }
+    i = end;
+  }
+}
+
+template <typename V>
+typename Spline<V>::Scalar Spline<V>::SegmentLength(
+    const Segment& segment,
+    Scalar u0,
+    Scalar u1
+) const noexcept
+{
+  // five point Gauss-Legendre on [u0, u1]
+  constexpr f64 nodes[] = {0.0, -0.538469310105683, 0.538469310105683, -0.906179845938664,
+                           0.906179845938664};
+  constexpr f64 weights[] = {0.568888888888889, 0.478628670499366, 0.478628670499366,
+                             0.236926885056189, 0.236926885056189};
+  Scalar half = (u1 - u0) * Scalar(0.5);
+  Scalar middle = (u0 + u1) * Scalar(0.5);
+  Scalar length = Scalar(0);
+  for (u32 i = 0; i < 5; ++i) {
+    Scalar u = middle + half * static_cast<Scalar>(nodes[i]);
+    length += static_cast<Scalar>(weights[i]) * HornerDerivative(segment, u).Length();
+  }
+  return length * half;
+}
+
+template <typename V>
+V Spline<V>::Horner(const Segment& segment, Scalar u) noexcept
+{
+  return ((segment.a * u + segment.b) * u + segment.c) * u + segment.d;
+}
+
+template <typename V>
+V Spline<V>::HornerDerivative(const Segment& segment, Scalar u) noexcept
+{
+  return (segment.a * (Scalar(3) * u) + segment.b * Scalar(2)) * u + segment.c;
+}
+
+} // namespace Engine::Core::Math
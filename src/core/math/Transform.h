@@ -0,0 +1,142 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Transform.h
+ * @brief Implementation of Transform class: translation, rotation and scale
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/math/Quaternion.h"
+#include "core/math/Vector3.h"
+
+#include <sstream>
+#include <string>
+
+namespace Engine::Core::Math
+{
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+/**
+ * @brief Maps a point p to position + rotation * (scale * p)
+ *
+ * Product a * b applies b first and then a, so world = parentWorld * local. Scale is composed per
+ * axis, which is exact for uniform scales and drops the shear a rotated non-uniform scale would
+ * produce.
+ */
+template <typename T>
+class Transform
+{
+ public:
+  Vector3<T> position;
+  Quaternion<T> rotation;
+  Vector3<T> scale;
+
+  static constexpr Transform<T> Identity() noexcept;
+
+  constexpr Transform() noexcept;
+  constexpr Transform(
+      const Vector3<T>& position,
+      const Quaternion<T>& rotation = Quaternion<T>::Identity(),
+      const Vector3<T>& scale = Vector3<T>::One()
+  ) noexcept;
+
+  constexpr Transform<T> operator*(const Transform<T>& child) const noexcept;
+
+  constexpr bool operator==(const Transform<T>& t) const noexcept;
+  constexpr bool operator!=(const Transform<T>& t) const noexcept;
+
+  constexpr Vector3<T> TransformPoint(const Vector3<T>& point) const noexcept;
+  /// Transforms a direction, translation is ignored
+  constexpr Vector3<T> TransformVector(const Vector3<T>& vector) const noexcept;
+
+  std::string ToString(int precision = 2) const noexcept;
+};
+
+/* --------------------------------- Friend methods declaration -------------------------------- */
+template <typename T>
+constexpr std::ostream& operator<<(std::ostream& os, const Transform<T>& t) noexcept;
+
+/* ------------------------------------------- Usings ------------------------------------------ */
+using Transformf = Transform<f32>;
+using Transformd = Transform<f64>;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+template <typename T>
+constexpr Transform<T> Transform<T>::Identity() noexcept
+{
+  return Transform<T>();
+}
+
+template <typename T>
+constexpr Transform<T>::Transform() noexcept
+    : position(Vector3<T>::Zero()),
+      rotation(Quaternion<T>::Identity()),
+      scale(Vector3<T>::One())
+{
+}
+
+template <typename T>
+constexpr Transform<T>::Transform(
+    const Vector3<T>& position,
+    const Quaternion<T>& rotation,
+    const Vector3<T>& scale
+) noexcept
+    : position(position),
+      rotation(rotation),
+      scale(scale)
+{
+}
+
+template <typename T>
+constexpr Transform<T> Transform<T>::operator*(const Transform<T>& child) const noexcept
+{
+  return Transform<T>(
+      TransformPoint(child.position), rotation * child.rotation,
+      Vector3<T>(scale.x * child.scale.x, scale.y * child.scale.y, scale.z * child.scale.z)
+  );
+}
+
+template <typename T>
+constexpr bool Transform<T>::operator==(const Transform<T>& t) const noexcept
+{
+  return position == t.position && rotation == t.rotation && scale == t.scale;
+}
+
+template <typename T>
+constexpr bool Transform<T>::operator!=(const Transform<T>& t) const noexcept
+{
+  return !(*this == t);
+}
+
+template <typename T>
+constexpr Vector3<T> Transform<T>::TransformPoint(const Vector3<T>& point) const noexcept
+{
+  return position + TransformVector(point);
+}
+
+template <typename T>
+constexpr Vector3<T> Transform<T>::TransformVector(const Vector3<T>& vector) const noexcept
+{
+  return rotation * Vector3<T>(scale.x * vector.x, scale.y * vector.y, scale.z * vector.z);
+}
+
+template <typename T>
+std::string Transform<T>::ToString(int precision) const noexcept
+{
+  std::ostringstream oss;
+  oss << "(" << position.ToString(precision) << ", " << rotation.ToString(precision) << ", "
+      << scale.ToString(precision) << ")";
+  return oss.str();
+}
+
+template <typename T>
+constexpr std::ostream& operator<<(std::ostream& os, const Transform<T>& t) noexcept
+{
+  return os << t.ToString();
+}
+
+} // namespace Engine::Core::Math
@@ -15,6 +15,7 @@
 #include "core/math/FloatComparator.h"
 
 #include <cassert>
+#include <cmath>
 #include <iomanip>
 #include <limits>
 #include <sstream>
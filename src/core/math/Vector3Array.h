@@ -0,0 +1,178 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Vector3Array.h
+ * @brief Implementation of Vector3Array class
+ *
+ * Vector3Array stores vectors as three separate component arrays (structure of arrays), so batch
+ * kernels load full SIMD registers of one component instead of shuffling interleaved x, y, z.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/math/Vector3.h"
+#include "core/memory/AlignedAllocator.h"
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace Engine::Core::Math
+{
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+template <typename T>
+class Vector3Array
+{
+ public:
+  using Storage = std::vector<T, Memory::AlignedAllocator<T>>;
+
+  Storage x;
+  Storage y;
+  Storage z;
+
+  Vector3Array() noexcept;
+  explicit Vector3Array(std::size_t count, const Vector3<T>& value = Vector3<T>()) noexcept;
+  Vector3Array(const Vector3<T>* vectors, std::size_t count) noexcept;
+
+  std::size_t Size() const noexcept;
+  bool Empty() const noexcept;
+  void Resize(std::size_t count, const Vector3<T>& value = Vector3<T>()) noexcept;
+  void Reserve(std::size_t count) noexcept;
+  void Clear() noexcept;
+
+  void PushBack(const Vector3<T>& v) noexcept;
+  void PopBack() noexcept;
+  /// Removes element by moving the last element into its place
+  void RemoveSwap(std::size_t index) noexcept;
+
+  Vector3<T> Get(std::size_t index) const noexcept;
+  void Set(std::size_t index, const Vector3<T>& v) noexcept;
+
+  void ToAoS(Vector3<T>* out) const noexcept;
+};
+
+/* ------------------------------------------- Usings ------------------------------------------ */
+using Vector3Arrayf = Vector3Array<f32>;
+using Vector3Arrayd = Vector3Array<f64>;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+template <typename T>
+Vector3Array<T>::Vector3Array() noexcept
+    : x(),
+      y(),
+      z()
+{
+}
+
+template <typename T>
+Vector3Array<T>::Vector3Array(std::size_t count, const Vector3<T>& value) noexcept
+    : x(count, value.x),
+      y(count, value.y),
+      z(count, value.z)
+{
+}
+
+template <typename T>
+Vector3Array<T>::Vector3Array(const Vector3<T>* vectors, std::size_t count) noexcept
+    : x(count),
+      y(count),
+      z(count)
+{
+  for (std::size_t i = 0; i < count; ++i) {
+    x[i] = vectors[i].x;
+    y[i] = vectors[i].y;
+    z[i] = vectors[i].z;
+  }
+}
+
+template <typename T>
+std::size_t Vector3Array<T>::Size() const noexcept
+{
+  return x.size();
+}
+
+template <typename T>
+bool Vector3Array<T>::Empty() const noexcept
+{
+  return x.empty();
+}
+
+template <typename T>
+void Vector3Array<T>::Resize(std::size_t count, const Vector3<T>& value) noexcept
+{
+  x.resize(count, value.x);
+  y.resize(count, value.y);
+  z.resize(count, value.z);
+}
+
+template <typename T>
+void Vector3Array<T>::Reserve(std::size_t count) noexcept
+{
+  x.reserve(count);
+  y.reserve(count);
+  z.reserve(count);
+}
+
+template <typename T>
+void Vector3Array<T>::Clear() noexcept
+{
+  x.clear();
+  y.clear();
+  z.clear();
+}
+
+template <typename T>
+void Vector3Array<T>::PushBack(const Vector3<T>& v) noexcept
+{
+  x.push_back(v.x);
+  y.push_back(v.y);
+  z.push_back(v.z);
+}
+
+template <typename T>
+void Vector3Array<T>::PopBack() noexcept
+{
+  assert(!Empty() && "PopBack on empty array");
+  x.pop_back();
+  y.pop_back();
+  z.pop_back();
+}
+
+template <typename T>
+void Vector3Array<T>::RemoveSwap(std::size_t index) noexcept
+{
+  assert(index < Size() && "Index out of range");
+  x[index] = x.back();
+  y[index] = y.back();
+  z[index] = z.back();
+  PopBack();
+}
+
+template <typename T>
+Vector3<T> Vector3Array<T>::Get(std::size_t index) const noexcept
+{
+  assert(index < Size() && "Index out of range");
+  return Vector3<T>(x[index], y[index], z[index]);
+}
+
+template <typename T>
+void Vector3Array<T>::Set(std::size_t index, const Vector3<T>& v) noexcept
+{
+  assert(index < Size() && "Index out of range");
+  x[index] = v.x;
+  y[index] = v.y;
+  z[index] = v.z;
+}
+
+template <typename T>
+void Vector3Array<T>::ToAoS(Vector3<T>* out) const noexcept
+{
+  for (std::size_t i = 0; i < Size(); ++i)
+    out[i] = Vector3<T>(x[i], y[i], z[i]);
+}
+
+} // namespace Engine::Core::Math
@@ -0,0 +1,10 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file AlignedAllocator.cpp
+ * @brief All implementation contains in header file AlignedAllocator.h
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include "core/memory/AlignedAllocator.h"
@@ -0,0 +1,10 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file NavMesh.cpp
+ * @brief All implementation contains in header file NavMesh.h
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include "core/navigation/NavMesh.h"
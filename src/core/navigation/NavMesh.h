@@ -0,0 +1,649 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file NavMesh.h
+ * @brief Navigation mesh of convex polygons with A* corridors, funnel string pulling and a cache
+ *
+ * The mesh is built once from counterclockwise convex polygons over a shared vertex array. Edges
+ * used by two polygons become portals linking them, and a uniform grid of polygon bounds finds
+ * the polygon under a point. The mesh is immutable afterwards and may be shared by any number of
+ * threads.
+ *
+ * Searches run through NavMeshQuery, one per thread. A query owns all scratch memory sized to the
+ * mesh at construction: per polygon costs and parents tagged with a search generation, so nothing
+ * is cleared between searches, a binary heap open list with room for every portal, and the
+ * corridor and portal buffers. A* runs over polygon centroids only, so the corridor depends on
+ * the start and goal polygons alone and is kept in a direct mapped cache keyed by that pair. The
+ * corridor is turned into a path with the simple stupid funnel algorithm. Once the output path
+ * has grown to its largest size no search allocates.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/container/FlatHashMap.h"
+#include "core/container/Hash.h"
+#include "core/math/Polygon2.h"
+#include "core/math/Vector2.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace Engine::Core::Navigation
+{
+
+using Math::Vector2;
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+struct NavMeshSettings
+{
+  /// Default number of corridors a query caches, rounded up to a power of two
+  static constexpr u32 cacheSize = 256;
+  /// Longer corridors are searched every time instead of being cached
+  static constexpr u32 maxCachedCorridor = 64;
+};
+
+enum class NavPathStatus : u8
+{
+  Found,
+  StartOffMesh,
+  GoalOffMesh,
+  Unreachable
+};
+
+template <typename T>
+class NavMesh
+{
+ public:
+  static constexpr u32 invalidPolygon = ~u32(0);
+
+  NavMesh() noexcept = default;
+
+  /**
+   * @brief Builds the mesh, previous content is dropped
+   * @param indices vertex indices of all polygons one after another
+   * @param polygonSizes vertex count of every polygon
+   * @return false and an empty mesh if a polygon has fewer than three vertices, is not convex
+   * and counterclockwise, refers to a missing vertex or an edge is shared by more than two
+   * polygons
+   */
+  bool Build(
+      const Vector2<T>* input,
+      std::size_t vertexCount,
+      const u32* indices,
+      const u32* polygonSizes,
+      std::size_t polygonCount
+  ) noexcept;
+  void Clear() noexcept;
+
+  u32 PolygonCount() const noexcept;
+  u32 VertexCount() const noexcept;
+  const Vector2<T>& Vertex(u32 vertex) const noexcept;
+  const Vector2<T>& Centroid(u32 polygon) const noexcept;
+  /// Edge i of a polygon runs from its vertex i to vertex i + 1
+  u32 EdgeCount(u32 polygon) const noexcept;
+  u32 PolygonVertex(u32 polygon, u32 index) const noexcept;
+  /// Polygon across edge or invalidPolygon for a boundary edge
+  u32 Neighbor(u32 polygon, u32 edge) const noexcept;
+  /// Number of edges shared by two polygons, counted once per side
+  u32 PortalCount() const noexcept;
+
+  /// True for points inside or on the boundary of polygon
+  bool Contains(u32 polygon, const Vector2<T>& point) const noexcept;
+  /// Some polygon containing point or invalidPolygon
+  u32 FindPolygon(const Vector2<T>& point) const noexcept;
+
+ private:
+  /// Grid cell along one axis clamped to [0, cells)
+  u32 CellCoordinate(T value, T origin, u32 cells) const noexcept;
+
+  std::vector<Vector2<T>> vertices;
+  /// Polygon p has corners corners[polygonStarts[p]] to corners[polygonStarts[p + 1] - 1]
+  std::vector<u32> polygonStarts;
+  std::vector<u32> corners;
+  /// Polygon across the edge starting at every corner
+  std::vector<u32> neighbors;
+  std::vector<Vector2<T>> centroids;
+  u32 portalCount = 0;
+
+  Vector2<T> gridOrigin;
+  T inverseCellSize = T(0);
+  u32 gridWidth = 0;
+  u32 gridHeight = 0;
+  /// Polygons overlapping cell c are cellPolygons[cellStarts[c]] to [cellStarts[c + 1] - 1]
+  std::vector<u32> cellStarts;
+  std::vector<u32> cellPolygons;
+};
+
+template <typename T>
+class NavMeshQuery
+{
+ public:
+  /// The query keeps a reference to mesh, which must not be rebuilt while the query is in use
+  explicit NavMeshQuery(
+      const NavMesh<T>& mesh,
+      u32 cacheSize = NavMeshSettings::cacheSize
+  ) noexcept;
+
+  /**
+   * @brief Shortest path through the corridor of polygons from start to goal
+   * @param path cleared and filled with start, the corners the path bends around and goal, its
+   * capacity is reused
+   */
+  NavPathStatus FindPath(
+      const Vector2<T>& start,
+      const Vector2<T>& goal,
+      std::vector<Vector2<T>>& path
+  ) noexcept;
+
+  /**
+   * @brief Polygons from startPolygon to goalPolygon with the least sum of centroid distances
+   * @return the corridor, valid until the next search, empty when goalPolygon is unreachable
+   */
+  const std::vector<u32>& FindCorridor(u32 startPolygon, u32 goalPolygon) noexcept;
+
+  void ClearCache() noexcept;
+  u64 CacheHits() const noexcept;
+  u64 CacheMisses() const noexcept;
+
+ private:
+  struct OpenEntry
+  {
+    T cost;
+    u32 polygon;
+  };
+
+  struct CacheEntry
+  {
+    u64 key;
+    u32 length;
+  };
+
+  static constexpr u64 emptyKey = ~u64(0);
+
+  void Search(u32 startPolygon, u32 goalPolygon) noexcept;
+  /// Funnel algorithm over the portals of the current corridor
+  void PullString(
+      const Vector2<T>& start,
+      const Vector2<T>& goal,
+      std::vector<Vector2<T>>& path
+  ) noexcept;
+
+  const NavMesh<T>* mesh;
+
+  /// Search state of a polygon is valid when its stamp equals generation
+  std::vector<u32> visited;
+  std::vector<u32> closed;
+  std::vector<T> costs;
+  std::vector<u32> parents;
+  std::vector<OpenEntry> open;
+  u32 generation = 0;
+
+  std::vector<u32> corridor;
+  /// Left and right end of every portal seen when walking along the corridor
+  std::vector<Vector2<T>> lefts;
+  std::vector<Vector2<T>> rights;
+
+  std::vector<CacheEntry> cacheEntries;
+  std::vector<u32> cacheCorridors;
+  u64 cacheHits = 0;
+  u64 cacheMisses = 0;
+};
+
+/* ------------------------------------------- Usings ------------------------------------------ */
+using NavMeshf = NavMesh<f32>;
+using NavMeshd = NavMesh<f64>;
+using NavMeshQueryf = NavMeshQuery<f32>;
+using NavMeshQueryd = NavMeshQuery<f64>;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+namespace Internal
+{
+
+/// Twice the signed area of triangle abc, positive when c is left of the line from a to b
+template <typename T>
+T Side(const Vector2<T>& a, const Vector2<T>& b, const Vector2<T>& c) noexcept
+{
+  return (b - a).Cross(c - a);
+}
+
+} // namespace Internal
+
+template <typename T>
+bool NavMesh<T>::Build(
+    const Vector2<T>* input,
+    std::size_t vertexCount,
+    const u32* indices,
+    const u32* polygonSizes,
+    std::size_t polygonCount
+) noexcept
+{
+  Clear();
+  vertices.assign(input, input + vertexCount);
+  polygonStarts.resize(polygonCount + 1);
+  polygonStarts[0] = 0;
+  for (std::size_t p = 0; p < polygonCount; ++p)
+    polygonStarts[p + 1] = polygonStarts[p] + polygonSizes[p];
+  corners.assign(indices, indices + polygonStarts[polygonCount]);
+  neighbors.assign(corners.size(), invalidPolygon);
+  centroids.resize(polygonCount);
+
+  // first corner of every edge seen once, a second polygon on the edge links both
+  Container::FlatHashMap<u64, u32> edges(static_cast<u32>(corners.size()));
+  bool valid = true;
+  for (u32 p = 0; p < polygonCount && valid; ++p) {
+    u32 first = polygonStarts[p];
+    u32 size = polygonStarts[p + 1] - first;
+    valid = size >= 3;
+    Vector2<T> sum = Vector2<T>::Zero();
+    for (u32 i = 0; i < size && valid; ++i) {
+      u32 a = corners[first + i];
+      u32 b = corners[first + (i + 1) % size];
+      u32 c = corners[first + (i + 2) % size];
+      valid = a < vertexCount && b < vertexCount && c < vertexCount && a != b &&
+              Internal::Side(vertices[a], vertices[b], vertices[c]) >= T(0);
+      if (!valid)
+        break;
+      sum += vertices[a];
+
+      auto [handle, inserted] = edges.Insert(Container::EdgeKey(a, b), first + i);
+      if (inserted)
+        continue;
+      u32 other = edges.ValueAt(handle);
+      valid = other != invalidPolygon;
+      if (!valid)
+        break;
+      u32 otherPolygon = static_cast<u32>(
+          std::upper_bound(polygonStarts.begin(), polygonStarts.end(), other) -
+          polygonStarts.begin() - 1);
+      neighbors[first + i] = otherPolygon;
+      neighbors[other] = p;
+      edges.ValueAt(handle) = invalidPolygon;
+      portalCount += 2;
+    }
+    if (valid)
+      centroids[p] = sum / static_cast<T>(size);
+  }
+  if (!valid) {
+    Clear();
+    return false;
+  }
+  if (polygonCount == 0)
+    return true;
+
+  Vector2<T> low = vertices[corners[0]];
+  Vector2<T> high = low;
+  for (u32 corner : corners) {
+    low = Vector2<T>(std::min(low.x, vertices[corner].x), std::min(low.y, vertices[corner].y));
+    high = Vector2<T>(std::max(high.x, vertices[corner].x), std::max(high.y, vertices[corner].y));
+  }
+
+  // about one polygon per cell for evenly sized polygons
+  T cellSize = std::max(high.x - low.x, high.y - low.y) /
+               std::ceil(std::sqrt(static_cast<T>(polygonCount)));
+  if (!(cellSize > T(0)))
+    cellSize = T(1);
+  gridOrigin = low;
+  inverseCellSize = T(1) / cellSize;
+  gridWidth = static_cast<u32>((high.x - low.x) * inverseCellSize) + 1;
+  gridHeight = static_cast<u32>((high.y - low.y) * inverseCellSize) + 1;
+
+  cellStarts.assign(static_cast<std::size_t>(gridWidth) * gridHeight + 1, 0);
+  auto forEachCell = [&](u32 p, auto&& func) {
+    Vector2<T> polygonLow = vertices[corners[polygonStarts[p]]];
+    Vector2<T> polygonHigh = polygonLow;
+    for (u32 i = polygonStarts[p]; i < polygonStarts[p + 1]; ++i) {
+      const Vector2<T>& v = vertices[corners[i]];
+      polygonLow = Vector2<T>(std::min(polygonLow.x, v.x), std::min(polygonLow.y, v.y));
+      polygonHigh = Vector2<T>(std::max(polygonHigh.x, v.x), std::max(polygonHigh.y, v.y));
+    }
+    u32 x0 = CellCoordinate(polygonLow.x, gridOrigin.x, gridWidth);
+    u32 x1 = CellCoordinate(polygonHigh.x, gridOrigin.x, gridWidth);
+    u32 y0 = CellCoordinate(polygonLow.y, gridOrigin.y, gridHeight);
+    u32 y1 = CellCoordinate(polygonHigh.y, gridOrigin.y, gridHeight);
+    for (u32 y = y0; y <= y1; ++y) {
+      for (u32 x = x0; x <= x1; ++x)
+        func(y * gridWidth + x);
+    }
+  };
+  for (u32 p = 0; p < polygonCount; ++p)
+    forEachCell(p, [&](u32 cell) { ++cellStarts[cell + 1]; });
+  for (std::size_t c = 1; c < cellStarts.size(); ++c)
+    cellStarts[c] += cellStarts[c - 1];
+  cellPolygons.resize(cellStarts.back());
+  std::vector<u32> fill(cellStarts.begin(), cellStarts.end() - 1);
+  for (u32 p = 0; p < polygonCount; ++p)
+    forEachCell(p, [&](u32 cell) { cellPolygons[fill[cell]++] = p; });
+  return true;
+}
+
+template <typename T>
+void NavMesh<T>::Clear() noexcept
+{
+  vertices.clear();
+  polygonStarts.clear();
+  corners.clear();
+  neighbors.clear();
+  centroids.clear();
+  portalCount = 0;
+  gridWidth = 0;
+  gridHeight = 0;
+  cellStarts.clear();
+  cellPolygons.clear();
+}
+
+template <typename T>
+u32 NavMesh<T>::PolygonCount() const noexcept
+{
+  return static_cast<u32>(centroids.size());
+}
+
+template <typename T>
+u32 NavMesh<T>::VertexCount() const noexcept
+{
+  return static_cast<u32>(vertices.size());
+}
+
+template <typename T>
+const Vector2<T>& NavMesh<T>::Vertex(u32 vertex) const noexcept
+{
+  return vertices[vertex];
+}
+
+template <typename T>
+const Vector2<T>& NavMesh<T>::Centroid(u32 polygon) const noexcept
+{
+  return centroids[polygon];
+}
+
+template <typename T>
+u32 NavMesh<T>::EdgeCount(u32 polygon) const noexcept
+{
+  return polygonStarts[polygon + 1] - polygonStarts[polygon];
+}
+
+template <typename T>
+u32 NavMesh<T>::PolygonVertex(u32 polygon, u32 index) const noexcept
+{
+  return corners[polygonStarts[polygon] + index];
+}
+
+template <typename T>
+u32 NavMesh<T>::Neighbor(u32 polygon, u32 edge) const noexcept
+{
+  return neighbors[polygonStarts[polygon] + edge];
+}
+
+template <typename T>
+u32 NavMesh<T>::PortalCount() const noexcept
+{
+  return portalCount;
+}
+
+template <typename T>
+bool NavMesh<T>::Contains(u32 polygon, const Vector2<T>& point) const noexcept
+{
+  u32 first = polygonStarts[polygon];
+  u32 size = polygonStarts[polygon + 1] - first;
+  for (u32 i = 0; i < size; ++i) {
+    const Vector2<T>& a = vertices[corners[first + i]];
+    const Vector2<T>& b = vertices[corners[first + (i + 1 == size ? 0 : i + 1)]];
+    if (Internal::Side(a, b, point) < T(0))
+      return false;
+  }
+  return true;
+}
+
+template <typename T>
+u32 NavMesh<T>::FindPolygon(const Vector2<T>& point) const noexcept
+{
+  if (gridWidth == 0)
+    return invalidPolygon;
+  T x = (point.x - gridOrigin.x) * inverseCellSize;
+  T y = (point.y - gridOrigin.y) * inverseCellSize;
+  if (!(x >= T(0) && y >= T(0) && x < static_cast<T>(gridWidth) &&
+        y < static_cast<T>(gridHeight)))
+    return invalidPolygon;
+
+  u32 cell = static_cast<u32>(y) * gridWidth + static_cast<u32>(x);
+  for (u32 i = cellStarts[cell]; i < cellStarts[cell + 1]; ++i) {
+    if (Contains(cellPolygons[i], point))
+      return cellPolygons[i];
+  }
+  return invalidPolygon;
+}
+
+template <typename T>
+u32 NavMesh<T>::CellCoordinate(T value, T origin, u32 cells) const noexcept
+{
+  T cell = (value - origin) * inverseCellSize;
+  return static_cast<u32>(std::clamp(cell, T(0), static_cast<T>(cells - 1)));
+}
+
+template <typename T>
+NavMeshQuery<T>::NavMeshQuery(const NavMesh<T>& mesh, u32 cacheSize) noexcept
+  : mesh(&mesh)
+{
+  u32 polygonCount = mesh.PolygonCount();
+  visited.assign(polygonCount, 0);
+  closed.assign(polygonCount, 0);
+  costs.resize(polygonCount);
+  parents.resize(polygonCount);
+  // every polygon is pushed once when found and once per improvement through a portal
+  open.reserve(static_cast<std::size_t>(mesh.PortalCount()) + 1);
+  corridor.reserve(polygonCount);
+  lefts.reserve(static_cast<std::size_t>(polygonCount) + 1);
+  rights.reserve(static_cast<std::size_t>(polygonCount) + 1);
+
+  u32 entries = 1;
+  while (entries < cacheSize)
+    entries *= 2;
+  cacheEntries.assign(cacheSize == 0 ? 0 : entries, CacheEntry{emptyKey, 0});
+  cacheCorridors.resize(cacheEntries.size() * NavMeshSettings::maxCachedCorridor);
+}
+
+template <typename T>
+NavPathStatus NavMeshQuery<T>::FindPath(
+    const Vector2<T>& start,
+    const Vector2<T>& goal,
+    std::vector<Vector2<T>>& path
+) noexcept
+{
+  path.clear();
+  u32 startPolygon = mesh->FindPolygon(start);
+  if (startPolygon == NavMesh<T>::invalidPolygon)
+    return NavPathStatus::StartOffMesh;
+  u32 goalPolygon = mesh->FindPolygon(goal);
+  if (goalPolygon == NavMesh<T>::invalidPolygon)
+    return NavPathStatus::GoalOffMesh;
+
+  if (FindCorridor(startPolygon, goalPolygon).empty())
+    return NavPathStatus::Unreachable;
+  PullString(start, goal, path);
+  return NavPathStatus::Found;
+}
+
+template <typename T>
+const std::vector<u32>& NavMeshQuery<T>::FindCorridor(u32 startPolygon, u32 goalPolygon) noexcept
+{
+  u64 key = (static_cast<u64>(startPolygon) << 32) | goalPolygon;
+  CacheEntry* entry = nullptr;
+  if (!cacheEntries.empty()) {
+    std::size_t slot = Container::MixHash(key) & (cacheEntries.size() - 1);
+    entry = &cacheEntries[slot];
+    const u32* cached = cacheCorridors.data() + slot * NavMeshSettings::maxCachedCorridor;
+    if (entry->key == key) {
+      ++cacheHits;
+      corridor.assign(cached, cached + entry->length);
+      return corridor;
+    }
+  }
+
+  ++cacheMisses;
+  Search(startPolygon, goalPolygon);
+  if (entry && corridor.size() <= NavMeshSettings::maxCachedCorridor) {
+    std::size_t slot = static_cast<std::size_t>(entry - cacheEntries.data());
+    std::copy(corridor.begin(), corridor.end(),
+              cacheCorridors.begin() + slot * NavMeshSettings::maxCachedCorridor);
+    *entry = CacheEntry{key, static_cast<u32>(corridor.size())};
+  }
+  return corridor;
+}
+
+template <typename T>
+void NavMeshQuery<T>::ClearCache() noexcept
+{
+  std::fill(cacheEntries.begin(), cacheEntries.end(), CacheEntry{emptyKey, 0});
+  cacheHits = 0;
+  cacheMisses = 0;
+}
+
+template <typename T>
+u64 NavMeshQuery<T>::CacheHits() const noexcept
+{
+  return cacheHits;
+}
+
+template <typename T>
+u64 NavMeshQuery<T>::CacheMisses() const noexcept
+{
+  return cacheMisses;
+}
+
+template <typename T>
+void NavMeshQuery<T>::Search(u32 startPolygon, u32 goalPolygon) noexcept
+{
+  corridor.clear();
+  if (++generation == 0) {
+    std::fill(visited.begin(), visited.end(), 0);
+    std::fill(closed.begin(), closed.end(), 0);
+    generation = 1;
+  }
+
+  auto greater = [](const OpenEntry& a, const OpenEntry& b) { return a.cost > b.cost; };
+  const Vector2<T>& target = mesh->Centroid(goalPolygon);
+  open.clear();
+  visited[startPolygon] = generation;
+  costs[startPolygon] = T(0);
+  parents[startPolygon] = NavMesh<T>::invalidPolygon;
+  open.push_back({mesh->Centroid(startPolygon).DistanceTo(target), startPolygon});
+
+  bool found = false;
+  while (!open.empty()) {
+    std::pop_heap(open.begin(), open.end(), greater);
+    u32 current = open.back().polygon;
+    open.pop_back();
+    // entries left behind by a later improvement of the same polygon
+    if (closed[current] == generation)
+      continue;
+    closed[current] = generation;
+    if (current == goalPolygon) {
+      found = true;
+      break;
+    }
+
+    const Vector2<T>& from = mesh->Centroid(current);
+    for (u32 edge = 0; edge < mesh->EdgeCount(current); ++edge) {
+      u32 next = mesh->Neighbor(current, edge);
+      if (next == NavMesh<T>::invalidPolygon || closed[next] == generation)
+        continue;
+      T cost = costs[current] + from.DistanceTo(mesh->Centroid(next));
+      if (visited[next] == generation && costs[next] <= cost)
+        continue;
+      visited[next] = generation;
+      costs[next] = cost;
+      parents[next] = current;
+      open.push_back({cost + mesh->Centroid(next).DistanceTo(target), next});
+      std::push_heap(open.begin(), open.end(), greater);
+    }
+  }
+  if (!found)
+    return;
+
+  for (u32 p = goalPolygon; p != NavMesh<T>::invalidPolygon; p = parents[p])
+    corridor.push_back(p);
+  std::reverse(corridor.begin(), corridor.end());
+}
+
+template <typename T>
+void NavMeshQuery<T>::PullString(
+    const Vector2<T>& start,
+    const Vector2<T>& goal,
+    std::vector<Vector2<T>>& path
+) noexcept
+{
+  // portals as seen when leaving every polygon, the start and goal are degenerate portals
+  lefts.clear();
+  rights.clear();
+  lefts.push_back(start);
+  rights.push_back(start);
+  for (std::size_t i = 0; i + 1 < corridor.size(); ++i) {
+    u32 polygon = corridor[i];
+    u32 edgeCount = mesh->EdgeCount(polygon);
+    for (u32 edge = 0; edge < edgeCount; ++edge) {
+      if (mesh->Neighbor(polygon, edge) != corridor[i + 1])
+        continue;
+      rights.push_back(mesh->Vertex(mesh->PolygonVertex(polygon, edge)));
+      lefts.push_back(mesh->Vertex(mesh->PolygonVertex(polygon, (edge + 1) % edgeCount)));
+      break;
+    }
+  }
+  lefts.push_back(goal);
+  rights.push_back(goal);
+
+  path.push_back(start);
+  Vector2<T> apex = start;
+  Vector2<T> left = start;
+  Vector2<T> right = start;
+  std::size_t apexIndex = 0;
+  std::size_t leftIndex = 0;
+  std::size_t rightIndex = 0;
+  for (std::size_t i = 1; i < lefts.size(); ++i) {
+    // tighten the right side unless it crosses the left one, which then becomes a corner
+    if (Internal::Side(apex, right, rights[i]) >= T(0)) {
+      if (Math::SamePoint(apex, right) || Internal::Side(apex, left, rights[i]) < T(0)) {
+        right = rights[i];
+        rightIndex = i;
+      } else {
+        // a corner shared by consecutive portals is reached again after the restart
+        if (!Math::SamePoint(path.back(), left))
+          path.push_back(left);
+        apex = left;
+        apexIndex = leftIndex;
+        left = apex;
+        right = apex;
+        leftIndex = apexIndex;
+        rightIndex = apexIndex;
+        i = apexIndex;
+        continue;
+      }
+    }
+
+    if (Internal::Side(apex, left, lefts[i]) <= T(0)) {
+      if (Math::SamePoint(apex, left) || Internal::Side(apex, right, lefts[i]) > T(0)) {
+        left = lefts[i];
+        leftIndex = i;
+      } else {
+        if (!Math::SamePoint(path.back(), right))
+          path.push_back(right);
+        apex = right;
+        apexIndex = rightIndex;
+        left = apex;
+        right = apex;
+        leftIndex = apexIndex;
+        rightIndex = apexIndex;
+        i = apexIndex;
+        continue;
+      }
+    }
+  }
+
+  if (!Math::SamePoint(path.back(), goal))
+    path.push_back(goal);
+}
+
+} // namespace Engine::Core::Navigation
@@ -0,0 +1,10 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file BatchSlab.cpp
+ * @brief All implementation contains in header file BatchSlab.h
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include "core/parallel/BatchSlab.h"
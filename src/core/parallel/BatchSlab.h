@@ -0,0 +1,143 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file BatchSlab.h
+ * @brief Preallocated slab of fixed capacity batches passed between threads without copies
+ *
+ * A producer acquires a free batch, fills it in place and pushes the small Batch descriptor
+ * through a queue; the consumer processes the elements where they are and releases the batch
+ * back to the slab. Batches start on cache line boundaries, so neighbouring batches filled by
+ * different threads do not share lines. Free batches are kept in an MpmcQueue, so acquiring and
+ * releasing work from any thread without locks.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/memory/AlignedAllocator.h"
+#include "core/parallel/MpmcQueue.h"
+
+#include <cassert>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+namespace Engine::Core::Parallel
+{
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+/**
+ * @brief View of a batch, data points into the slab
+ */
+template <typename T>
+struct Batch
+{
+  T* data;
+  /// Filled elements, set by the producer
+  u32 size;
+  u32 capacity;
+  /// Index of the batch in its slab
+  u32 index;
+
+  T* begin() const noexcept;
+  T* end() const noexcept;
+  T& operator[](u32 i) const noexcept;
+};
+
+template <typename T>
+class BatchSlab
+{
+ public:
+  BatchSlab(u32 batchCount, u32 batchCapacity) noexcept;
+
+  BatchSlab(const BatchSlab&) = delete;
+  BatchSlab& operator=(const BatchSlab&) = delete;
+
+  /// Takes a free batch with size 0, false when all batches are in use
+  bool TryAcquire(Batch<T>& batch) noexcept;
+  /// Returns a batch acquired from this slab
+  void Release(const Batch<T>& batch) noexcept;
+
+  u32 BatchCount() const noexcept;
+  u32 BatchCapacity() const noexcept;
+
+ private:
+  std::vector<T, Memory::AlignedAllocator<T>> storage;
+  /// Elements between batch starts, batch capacity rounded up to whole cache lines
+  std::size_t stride;
+  u32 batchCount;
+  u32 batchCapacity;
+  MpmcQueue<u32> freeBatches;
+};
+
+/* --------------------------------------- Implementation -------------------------------------- */
+template <typename T>
+T* Batch<T>::begin() const noexcept
+{
+  return data;
+}
+
+template <typename T>
+T* Batch<T>::end() const noexcept
+{
+  return data + size;
+}
+
+template <typename T>
+T& Batch<T>::operator[](u32 i) const noexcept
+{
+  assert(i < capacity && "Index out of batch");
+  return data[i];
+}
+
+template <typename T>
+BatchSlab<T>::BatchSlab(u32 batchCount, u32 batchCapacity) noexcept
+    : batchCount(batchCount),
+      batchCapacity(batchCapacity),
+      freeBatches(batchCount)
+{
+  // smallest element count spanning whole cache lines, 16 for 12 byte Vector3f
+  std::size_t step = Memory::cacheLineSize / std::gcd(Memory::cacheLineSize, sizeof(T));
+  stride = (batchCapacity + step - 1) / step * step;
+  storage.resize(stride * batchCount);
+
+  for (u32 i = 0; i < batchCount; ++i)
+    freeBatches.TryPush(i);
+}
+
+template <typename T>
+bool BatchSlab<T>::TryAcquire(Batch<T>& batch) noexcept
+{
+  u32 index;
+  if (!freeBatches.TryPop(index))
+    return false;
+  batch = Batch<T>{storage.data() + index * stride, 0, batchCapacity, index};
+  return true;
+}
+
+template <typename T>
+void BatchSlab<T>::Release(const Batch<T>& batch) noexcept
+{
+  assert(batch.index < batchCount && batch.data == storage.data() + batch.index * stride &&
+         "Batch of another slab");
+  // the queue holds every batch, so a release always finds a free cell
+  bool pushed = freeBatches.TryPush(batch.index);
+  assert(pushed && "Batch released twice");
+  (void)pushed;
+}
+
+template <typename T>
+u32 BatchSlab<T>::BatchCount() const noexcept
+{
+  return batchCount;
+}
+
+template <typename T>
+u32 BatchSlab<T>::BatchCapacity() const noexcept
+{
+  return batchCapacity;
+}
+
+} // namespace Engine::Core::Parallel
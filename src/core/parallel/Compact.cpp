@@ -0,0 +1,122 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Compact.cpp
+ * @brief Implementation of bitmask compaction
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include "core/parallel/Compact.h"
+
+#include <cstring>
+
+#if defined(_MSC_VER)
+  #include <intrin.h>
+#endif
+
+namespace Engine::Core::Parallel
+{
+
+namespace
+{
+
+constexpr std::size_t wordBits = 64;
+
+/// Bits [first, first + 64) of the mask, bits at or past count are cleared
+u64 LoadWord(const u8* bits, std::size_t first, std::size_t count) noexcept
+{
+  std::size_t bytes = std::min<std::size_t>(8, (count - first + 7) / 8);
+  u64 word = 0;
+  // byte i / 8 holds bit i % 8, so on little endian targets bit i of the word is element i
+  std::memcpy(&word, bits + first / 8, bytes);
+  if (count - first < wordBits)
+    word &= (u64(1) << (count - first)) - 1;
+  return word;
+}
+
+u32 CountBits(u64 word) noexcept
+{
+#if defined(_MSC_VER)
+  return static_cast<u32>(__popcnt64(word));
+#else
+  return static_cast<u32>(__builtin_popcountll(word));
+#endif
+}
+
+u32 LowestBit(u64 word) noexcept
+{
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward64(&index, word);
+  return static_cast<u32>(index);
+#else
+  return static_cast<u32>(__builtin_ctzll(word));
+#endif
+}
+
+std::size_t CompactWords(
+    const u8* bits,
+    std::size_t begin,
+    std::size_t end,
+    std::size_t count,
+    u32* indices
+) noexcept
+{
+  std::size_t written = 0;
+  for (std::size_t first = begin; first < end; first += wordBits) {
+    for (u64 word = LoadWord(bits, first, count); word != 0; word &= word - 1)
+      indices[written++] = static_cast<u32>(first + LowestBit(word));
+  }
+  return written;
+}
+
+} // namespace
+
+std::size_t CompactBits(const u8* bits, std::size_t count, u32* indices) noexcept
+{
+  return CompactWords(bits, 0, count, count, indices);
+}
+
+std::size_t CompactBits(
+    const u8* bits,
+    std::size_t count,
+    u32* indices,
+    ThreadPool& pool,
+    std::size_t grain
+) noexcept
+{
+  std::size_t blocks = count / std::max<std::size_t>(grain, wordBits);
+  blocks = std::min<std::size_t>(blocks, pool.WorkerCount() + 1);
+  if (blocks < 2)
+    return CompactBits(bits, count, indices);
+
+  // blocks start at word boundaries
+  std::size_t words = (count + wordBits - 1) / wordBits;
+  std::size_t blockSize = (words + blocks - 1) / blocks * wordBits;
+  std::vector<std::size_t> offsets(blocks);
+
+  pool.ParallelFor(blocks, 1, [&](std::size_t first, std::size_t last) {
+    for (std::size_t block = first; block < last; ++block) {
+      std::size_t begin = std::min(count, block * blockSize);
+      std::size_t end = std::min(count, begin + blockSize);
+      std::size_t found = 0;
+      for (std::size_t word = begin; word < end; word += wordBits)
+        found += CountBits(LoadWord(bits, word, count));
+      offsets[block] = found;
+    }
+  });
+
+  std::size_t total = ExclusiveScan(offsets.data(), offsets.data(), blocks);
+
+  pool.ParallelFor(blocks, 1, [&](std::size_t first, std::size_t last) {
+    for (std::size_t block = first; block < last; ++block) {
+      std::size_t begin = std::min(count, block * blockSize);
+      std::size_t end = std::min(count, begin + blockSize);
+      CompactWords(bits, begin, end, count, indices + offsets[block]);
+    }
+  });
+  return total;
+}
+
+} // namespace Engine::Core::Parallel
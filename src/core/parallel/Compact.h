@@ -0,0 +1,141 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Compact.h
+ * @brief Stream compaction: order preserving filtering of arrays by a mask
+ *
+ * The serial loops are branchless, every element is stored and the output position advances only
+ * for selected ones. Bitmask compaction walks 64 mask bits at a time and visits set bits only,
+ * which suits sparse visibility masks produced by batched culling. The parallel forms count
+ * selected elements per block, scan the counts and compact all blocks independently.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/parallel/Scan.h"
+#include "core/parallel/ThreadPool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace Engine::Core::Parallel
+{
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+struct CompactSettings
+{
+  /// Inputs smaller than this are compacted on the calling thread by the parallel forms
+  static constexpr std::size_t grain = 64 * 1024;
+};
+
+/**
+ * @brief Copies input[i] with nonzero mask[i] to output keeping their order
+ * @param output buffer of count elements, must not overlap input
+ * @return number of copied elements
+ */
+template <typename T>
+std::size_t Compact(const T* input, const u8* mask, std::size_t count, T* output) noexcept;
+
+template <typename T>
+std::size_t Compact(
+    const T* input,
+    const u8* mask,
+    std::size_t count,
+    T* output,
+    ThreadPool& pool,
+    std::size_t grain = CompactSettings::grain
+) noexcept;
+
+/**
+ * @brief Writes indices of set bits in ascending order
+ * @param bits bitmask of (count + 7) / 8 bytes, bit i % 8 of byte i / 8 selects element i; the
+ * layout written by Frustum culling
+ * @param indices buffer of count elements
+ * @return number of written indices
+ */
+std::size_t CompactBits(const u8* bits, std::size_t count, u32* indices) noexcept;
+
+std::size_t CompactBits(
+    const u8* bits,
+    std::size_t count,
+    u32* indices,
+    ThreadPool& pool,
+    std::size_t grain = CompactSettings::grain
+) noexcept;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+namespace Internal
+{
+
+/// Stops after the selected-th element, so it never stores past its part of a shared output
+template <typename T>
+void CompactRange(const T* input, const u8* mask, T* output, std::size_t selected) noexcept
+{
+  std::size_t written = 0;
+  for (std::size_t i = 0; written < selected; ++i) {
+    output[written] = input[i];
+    written += mask[i] != 0;
+  }
+}
+
+} // namespace Internal
+
+template <typename T>
+std::size_t Compact(const T* input, const u8* mask, std::size_t count, T* output) noexcept
+{
+  std::size_t written = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    output[written] = input[i];
+    written += mask[i] != 0;
+  }
+  return written;
+}
+
+template <typename T>
+std::size_t Compact(
+    const T* input,
+    const u8* mask,
+    std::size_t count,
+    T* output,
+    ThreadPool& pool,
+    std::size_t grain
+) noexcept
+{
+  std::size_t blocks = count / std::max<std::size_t>(grain, 1);
+  blocks = std::min<std::size_t>(blocks, pool.WorkerCount() + 1);
+  if (blocks < 2)
+    return Compact(input, mask, count, output);
+
+  std::size_t blockSize = (count + blocks - 1) / blocks;
+  std::vector<std::size_t> selected(blocks);
+  std::vector<std::size_t> offsets(blocks);
+
+  pool.ParallelFor(blocks, 1, [&](std::size_t first, std::size_t last) {
+    for (std::size_t block = first; block < last; ++block) {
+      std::size_t begin = std::min(count, block * blockSize);
+      std::size_t end = std::min(count, begin + blockSize);
+      std::size_t found = 0;
+      for (std::size_t i = begin; i < end; ++i)
+        found += mask[i] != 0;
+      selected[block] = found;
+    }
+  });
+
+  std::size_t total = ExclusiveScan(selected.data(), offsets.data(), blocks);
+
+  pool.ParallelFor(blocks, 1, [&](std::size_t first, std::size_t last) {
+    for (std::size_t block = first; block < last; ++block) {
+      std::size_t begin = block * blockSize;
+      Internal::CompactRange(
+          input + begin, mask + begin, output + offsets[block], selected[block]
+      );
+    }
+  });
+  return total;
+}
+
+} // namespace Engine::Core::Parallel
@@ -0,0 +1,10 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file MpmcQueue.cpp
+ * @brief All implementation contains in header file MpmcQueue.h
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include "core/parallel/MpmcQueue.h"
@@ -0,0 +1,131 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file MpmcQueue.h
+ * @brief Bounded lock-free queue for any number of producers and consumers
+ *
+ * Dmitry Vyukov's array queue: every cell carries a sequence number telling whether it is ready
+ * for the producer or the consumer of a given lap. A thread claims a position with one compare and
+ * swap on the shared enqueue or dequeue index and then hands the cell over by publishing the next
+ * sequence number, so producers and consumers never touch the same index.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/memory/AlignedAllocator.h"
+#include "core/parallel/SpscQueue.h"
+
+#include <atomic>
+#include <memory>
+
+namespace Engine::Core::Parallel
+{
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+template <typename T>
+class MpmcQueue
+{
+ public:
+  /// Capacity is rounded up to a power of two, at most 2^31
+  explicit MpmcQueue(u32 capacity) noexcept;
+
+  MpmcQueue(const MpmcQueue&) = delete;
+  MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+  /// False when the queue is full
+  bool TryPush(const T& value) noexcept;
+  /// False when the queue is empty
+  bool TryPop(T& value) noexcept;
+
+  u32 Capacity() const noexcept;
+
+ private:
+  struct Cell
+  {
+    std::atomic<u32> sequence;
+    T value;
+  };
+
+  std::unique_ptr<Cell[]> cells;
+  u32 mask;
+
+  alignas(Memory::cacheLineSize) std::atomic<u32> enqueuePosition;
+  alignas(Memory::cacheLineSize) std::atomic<u32> dequeuePosition;
+};
+
+/* --------------------------------------- Implementation -------------------------------------- */
+template <typename T>
+MpmcQueue<T>::MpmcQueue(u32 capacity) noexcept
+    : mask(Internal::RoundUpToPowerOfTwo(capacity > 1 ? capacity : 2) - 1),
+      enqueuePosition(0),
+      dequeuePosition(0)
+{
+  cells = std::make_unique<Cell[]>(mask + 1);
+  for (u32 i = 0; i <= mask; ++i)
+    cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+template <typename T>
+bool MpmcQueue<T>::TryPush(const T& value) noexcept
+{
+  Cell* cell;
+  u32 position = enqueuePosition.load(std::memory_order_relaxed);
+  for (;;) {
+    cell = &cells[position & mask];
+    u32 sequence = cell->sequence.load(std::memory_order_acquire);
+    i32 difference = static_cast<i32>(sequence - position);
+    if (difference == 0) {
+      if (enqueuePosition.compare_exchange_weak(
+              position, position + 1, std::memory_order_relaxed
+          ))
+        break;
+    } else if (difference < 0) {
+      // the cell still holds the value of the previous lap
+      return false;
+    } else {
+      position = enqueuePosition.load(std::memory_order_relaxed);
+    }
+  }
+
+  cell->value = value;
+  cell->sequence.store(position + 1, std::memory_order_release);
+  return true;
+}
+
+template <typename T>
+bool MpmcQueue<T>::TryPop(T& value) noexcept
+{
+  Cell* cell;
+  u32 position = dequeuePosition.load(std::memory_order_relaxed);
+  for (;;) {
+    cell = &cells[position & mask];
+    u32 sequence = cell->sequence.load(std::memory_order_acquire);
+    i32 difference = static_cast<i32>(sequence - (position + 1));
+    if (difference == 0) {
+      if (dequeuePosition.compare_exchange_weak(
+              position, position + 1, std::memory_order_relaxed
+          ))
+        break;
+    } else if (difference < 0) {
+      // the producer of this lap has not published the cell yet
+      return false;
+    } else {
+      position = dequeuePosition.load(std::memory_order_relaxed);
+    }
+  }
+
+  value = cell->value;
+  cell->sequence.store(position + mask + 1, std::memory_order_release);
+  return true;
+}
+
+template <typename T>
+u32 MpmcQueue<T>::Capacity() const noexcept
+{
+  return mask + 1;
+}
+
+} // namespace Engine::Core::Parallel
@@ -0,0 +1,61 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file QueryScheduler.cpp
+ * @brief Implementation of non template part of QueryScheduler class
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include "core/parallel/QueryScheduler.h"
+
+namespace Engine::Core::Parallel
+{
+
+std::size_t QueryScheduler::Tick(Clock::duration budget, std::size_t grain) noexcept
+{
+  return Tick(budget, nullptr, grain);
+}
+
+std::size_t QueryScheduler::Tick(
+    Clock::duration budget,
+    ThreadPool& pool,
+    std::size_t grain
+) noexcept
+{
+  return Tick(budget, &pool, grain);
+}
+
+std::size_t QueryScheduler::PendingCount() const noexcept
+{
+  std::size_t count = 0;
+  for (const Channel& entry : channels)
+    count += entry.pendingCount(entry.channel);
+  return count;
+}
+
+std::size_t QueryScheduler::Tick(
+    Clock::duration budget,
+    ThreadPool* pool,
+    std::size_t grain
+) noexcept
+{
+  Clock::time_point deadline = Clock::now() + budget;
+  std::size_t answered = 0;
+  bool mustProgress = true;
+  std::size_t count = channels.size();
+  for (std::size_t i = 0; i < count; ++i) {
+    const Channel& entry = channels[(firstChannel + i) % count];
+    if (entry.pendingCount(entry.channel) == 0)
+      continue;
+    if (!mustProgress && Clock::now() >= deadline)
+      break;
+    answered += entry.run(entry.channel, pool, deadline, mustProgress, grain);
+    mustProgress = false;
+  }
+  if (count != 0)
+    firstChannel = (firstChannel + 1) % count;
+  return answered;
+}
+
+} // namespace Engine::Core::Parallel
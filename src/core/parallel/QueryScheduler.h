@@ -0,0 +1,314 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file QueryScheduler.h
+ * @brief Batched agent queries run across worker threads under a per-frame time budget
+ *
+ * Every kind of query (path requests, raycasts, neighbor lookups) gets its own QueryChannel with
+ * one function answering a request. Submitting a request returns a handle and the answer is taken
+ * through that handle once it is ready. Requests live in slots recycled through a free list and
+ * handles carry a slot generation, so a stale handle is detected instead of reading another
+ * request's result.
+ *
+ * QueryScheduler::Tick runs the pending requests of all channels channel by channel, each channel
+ * as one parallel loop over its queue in chunks of grain requests. A chunk that starts after the
+ * deadline is skipped and its requests stay queued in submission order for the next tick, so a
+ * burst of requests is spread over frames and the budget is exceeded by at most one chunk per
+ * thread. The channel served first rotates between ticks and the first chunk of a tick always
+ * runs, hence every channel makes progress even under a tiny budget. Submission, taking results
+ * and ticking must happen on one thread, only the query functions run on workers.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/parallel/ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace Engine::Core::Parallel
+{
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+struct QuerySchedulerSettings
+{
+  /// Default number of requests in one chunk, the deadline is checked between chunks
+  static constexpr std::size_t grain = 8;
+};
+
+enum class QueryStatus : u8
+{
+  Pending,
+  Ready,
+  /// The handle was never issued, its result was taken or the request was cancelled
+  Invalid
+};
+
+struct QueryHandle
+{
+  u32 slot = ~u32(0);
+  u32 generation = 0;
+};
+
+class QueryScheduler;
+
+template <typename Request, typename Result>
+class QueryChannel
+{
+ public:
+  /// Answers one request, called concurrently for different requests
+  using Function = std::function<void(const Request&, Result&)>;
+
+  explicit QueryChannel(Function function) noexcept;
+
+  QueryHandle Submit(const Request& request) noexcept;
+  QueryStatus Status(QueryHandle handle) const noexcept;
+  /**
+   * @brief Moves the result of a ready request to result and releases the handle
+   * @return false if the request is pending or the handle is invalid
+   */
+  bool Take(QueryHandle handle, Result& result) noexcept;
+  /// Drops a pending request or the unclaimed result of a ready one
+  bool Cancel(QueryHandle handle) noexcept;
+
+  u32 PendingCount() const noexcept;
+
+ private:
+  friend class QueryScheduler;
+
+  enum class SlotState : u8
+  {
+    Free,
+    Pending,
+    Ready,
+    /// Cancelled while queued, freed when the queue is next compacted
+    Cancelled
+  };
+
+  bool IsCurrent(QueryHandle handle) const noexcept;
+  void Release(u32 slot) noexcept;
+  /// Answers queued requests until the deadline, returns the number answered
+  std::size_t Run(
+      ThreadPool* pool,
+      std::chrono::steady_clock::time_point deadline,
+      bool mustProgress,
+      std::size_t grain
+  ) noexcept;
+
+  Function function;
+  std::vector<Request> requests;
+  std::vector<Result> results;
+  std::vector<SlotState> states;
+  std::vector<u32> generations;
+  std::vector<u32> freeSlots;
+  /// Slots of queued requests in submission order, may contain cancelled slots
+  std::vector<u32> queue;
+  u32 pendingCount = 0;
+};
+
+class QueryScheduler
+{
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /// Adds a channel served by Tick, channel must outlive the scheduler
+  template <typename Request, typename Result>
+  void Add(QueryChannel<Request, Result>& channel) noexcept;
+
+  /**
+   * @brief Answers queued requests of all channels until budget has elapsed
+   * @return number of requests answered
+   */
+  std::size_t Tick(
+      Clock::duration budget,
+      std::size_t grain = QuerySchedulerSettings::grain
+  ) noexcept;
+
+  std::size_t Tick(
+      Clock::duration budget,
+      ThreadPool& pool,
+      std::size_t grain = QuerySchedulerSettings::grain
+  ) noexcept;
+
+  /// Requests queued in all channels
+  std::size_t PendingCount() const noexcept;
+
+ private:
+  struct Channel
+  {
+    void* channel;
+    std::size_t (*run)(
+        void* channel,
+        ThreadPool* pool,
+        Clock::time_point deadline,
+        bool mustProgress,
+        std::size_t grain
+    );
+    u32 (*pendingCount)(const void* channel);
+  };
+
+  std::size_t Tick(Clock::duration budget, ThreadPool* pool, std::size_t grain) noexcept;
+
+  std::vector<Channel> channels;
+  /// Channel served first by the next tick
+  std::size_t firstChannel = 0;
+};
+
+/* --------------------------------------- Implementation -------------------------------------- */
+template <typename Request, typename Result>
+QueryChannel<Request, Result>::QueryChannel(Function function) noexcept
+    : function(std::move(function))
+{
+}
+
+template <typename Request, typename Result>
+QueryHandle QueryChannel<Request, Result>::Submit(const Request& request) noexcept
+{
+  u32 slot;
+  if (freeSlots.empty()) {
+    slot = static_cast<u32>(states.size());
+    requests.push_back(request);
+    results.emplace_back();
+    states.push_back(SlotState::Pending);
+    generations.push_back(0);
+  } else {
+    slot = freeSlots.back();
+    freeSlots.pop_back();
+    requests[slot] = request;
+    states[slot] = SlotState::Pending;
+  }
+  queue.push_back(slot);
+  ++pendingCount;
+  return {slot, generations[slot]};
+}
+
+template <typename Request, typename Result>
+QueryStatus QueryChannel<Request, Result>::Status(QueryHandle handle) const noexcept
+{
+  if (!IsCurrent(handle))
+    return QueryStatus::Invalid;
+  return states[handle.slot] == SlotState::Ready ? QueryStatus::Ready : QueryStatus::Pending;
+}
+
+template <typename Request, typename Result>
+bool QueryChannel<Request, Result>::Take(QueryHandle handle, Result& result) noexcept
+{
+  if (!IsCurrent(handle) || states[handle.slot] != SlotState::Ready)
+    return false;
+  result = std::move(results[handle.slot]);
+  Release(handle.slot);
+  return true;
+}
+
+template <typename Request, typename Result>
+bool QueryChannel<Request, Result>::Cancel(QueryHandle handle) noexcept
+{
+  if (!IsCurrent(handle))
+    return false;
+  if (states[handle.slot] == SlotState::Ready) {
+    Release(handle.slot);
+    return true;
+  }
+  // the slot is still referenced by the queue
+  states[handle.slot] = SlotState::Cancelled;
+  ++generations[handle.slot];
+  --pendingCount;
+  return true;
+}
+
+template <typename Request, typename Result>
+u32 QueryChannel<Request, Result>::PendingCount() const noexcept
+{
+  return pendingCount;
+}
+
+template <typename Request, typename Result>
+bool QueryChannel<Request, Result>::IsCurrent(QueryHandle handle) const noexcept
+{
+  return handle.slot < states.size() && generations[handle.slot] == handle.generation &&
+         (states[handle.slot] == SlotState::Pending || states[handle.slot] == SlotState::Ready);
+}
+
+template <typename Request, typename Result>
+void QueryChannel<Request, Result>::Release(u32 slot) noexcept
+{
+  states[slot] = SlotState::Free;
+  ++generations[slot];
+  results[slot] = Result();
+  freeSlots.push_back(slot);
+}
+
+template <typename Request, typename Result>
+std::size_t QueryChannel<Request, Result>::Run(
+    ThreadPool* pool,
+    std::chrono::steady_clock::time_point deadline,
+    bool mustProgress,
+    std::size_t grain
+) noexcept
+{
+  grain = std::max<std::size_t>(grain, 1);
+  auto run = [&](std::size_t begin, std::size_t end) {
+    if (!(mustProgress && begin == 0) && std::chrono::steady_clock::now() >= deadline)
+      return;
+    for (std::size_t i = begin; i < end; ++i) {
+      u32 slot = queue[i];
+      if (states[slot] != SlotState::Pending)
+        continue;
+      function(requests[slot], results[slot]);
+      states[slot] = SlotState::Ready;
+    }
+  };
+  if (pool) {
+    pool->ParallelFor(queue.size(), grain, run);
+  } else {
+    for (std::size_t begin = 0; begin < queue.size(); begin += grain) {
+      if (begin != 0 && std::chrono::steady_clock::now() >= deadline)
+        break;
+      run(begin, std::min(queue.size(), begin + grain));
+    }
+  }
+
+  // keep unanswered requests in submission order
+  std::size_t answered = 0;
+  std::size_t kept = 0;
+  for (u32 slot : queue) {
+    if (states[slot] == SlotState::Pending) {
+      queue[kept++] = slot;
+      continue;
+    }
+    if (states[slot] == SlotState::Ready) {
+      ++answered;
+    } else {
+      states[slot] = SlotState::Free;
+      freeSlots.push_back(slot);
+    }
+  }
+  queue.resize(kept);
+  pendingCount -= static_cast<u32>(answered);
+  return answered;
+}
+
+template <typename Request, typename Result>
+void QueryScheduler::Add(QueryChannel<Request, Result>& channel) noexcept
+{
+  using Target = QueryChannel<Request, Result>;
+  Channel entry;
+  entry.channel = &channel;
+  entry.run = [](void* target, ThreadPool* pool, Clock::time_point deadline, bool mustProgress,
+                 std::size_t grain) {
+    return static_cast<Target*>(target)->Run(pool, deadline, mustProgress, grain);
+  };
+  entry.pendingCount = [](const void* target) {
+    return static_cast<const Target*>(target)->PendingCount();
+  };
+  channels.push_back(entry);
+}
+
+} // namespace Engine::Core::Parallel
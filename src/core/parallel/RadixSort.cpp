@@ -0,0 +1,10 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file RadixSort.cpp
+ * @brief All implementation contains in header file RadixSort.h
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include "core/parallel/RadixSort.h"
@@ -0,0 +1,293 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file RadixSort.h
+ * @brief Stable LSD radix sort of unsigned integer keys with optional attached values
+ *
+ * Keys are sorted by 8 bit digits, ping-ponging between the input arrays and the scratch arrays.
+ * Histograms of all digits are gathered by one read of the keys, and a digit which is the same for
+ * every key is skipped, so keys using only low bits (indices, quantized depths) cost fewer passes.
+ * The parallel form splits the input into one block per thread; every block counts its digits,
+ * block offsets are laid out digit by digit and every block scatters its elements independently,
+ * which keeps the sort stable.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/parallel/ThreadPool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace Engine::Core::Parallel
+{
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+struct RadixSortSettings
+{
+  static constexpr u32 digitBits = 8;
+  static constexpr u32 buckets = 1u << digitBits;
+  /// Inputs smaller than this are sorted on the calling thread by the parallel form
+  static constexpr std::size_t grain = 64 * 1024;
+};
+
+/**
+ * @brief Sorts keys in ascending order and moves values along with them
+ * @param keyScratch, valueScratch buffers of count elements used as temporary storage
+ */
+template <typename Key, typename Value>
+void RadixSort(
+    Key* keys,
+    Value* values,
+    std::size_t count,
+    Key* keyScratch,
+    Value* valueScratch
+) noexcept;
+
+template <typename Key, typename Value>
+void RadixSort(
+    Key* keys,
+    Value* values,
+    std::size_t count,
+    Key* keyScratch,
+    Value* valueScratch,
+    ThreadPool& pool,
+    std::size_t grain = RadixSortSettings::grain
+) noexcept;
+
+/// Sorts keys without values
+template <typename Key>
+void RadixSort(Key* keys, std::size_t count, Key* keyScratch) noexcept;
+
+template <typename Key>
+void RadixSort(
+    Key* keys,
+    std::size_t count,
+    Key* keyScratch,
+    ThreadPool& pool,
+    std::size_t grain = RadixSortSettings::grain
+) noexcept;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+namespace Internal
+{
+
+template <typename Key>
+std::size_t Digit(Key key, u32 shift) noexcept
+{
+  return static_cast<std::size_t>((key >> shift) & (RadixSortSettings::buckets - 1));
+}
+
+/// Adds counts of every digit of keys [begin, end) to histograms[pass * buckets + digit]
+template <typename Key>
+void CountDigits(
+    const Key* keys,
+    std::size_t begin,
+    std::size_t end,
+    std::size_t* histograms
+) noexcept
+{
+  constexpr u32 passes = sizeof(Key) * 8 / RadixSortSettings::digitBits;
+  for (std::size_t i = begin; i < end; ++i) {
+    Key key = keys[i];
+    for (u32 pass = 0; pass < passes; ++pass) {
+      u32 shift = pass * RadixSortSettings::digitBits;
+      ++histograms[pass * RadixSortSettings::buckets + Digit(key, shift)];
+    }
+  }
+}
+
+/// A pass is trivial when one bucket holds all keys
+inline bool TrivialPass(const std::size_t* histogram, std::size_t count) noexcept
+{
+  const std::size_t* end = histogram + RadixSortSettings::buckets;
+  return std::find(histogram, end, count) != end;
+}
+
+/// Value is void for key only sorts
+template <typename Key, typename Value>
+void ScatterDigit(
+    const Key* keys,
+    const Value* values,
+    std::size_t begin,
+    std::size_t end,
+    u32 shift,
+    std::size_t* offsets,
+    Key* keysOut,
+    Value* valuesOut
+) noexcept
+{
+  for (std::size_t i = begin; i < end; ++i) {
+    std::size_t slot = offsets[Digit(keys[i], shift)]++;
+    keysOut[slot] = keys[i];
+    if constexpr (!std::is_void_v<Value>)
+      valuesOut[slot] = values[i];
+  }
+}
+
+/// Sorts on the calling thread when pool is null
+template <typename Key, typename Value>
+void RadixSort(
+    Key* keys,
+    Value* values,
+    std::size_t count,
+    Key* keyScratch,
+    Value* valueScratch,
+    ThreadPool* pool,
+    std::size_t grain
+) noexcept
+{
+  static_assert(std::is_unsigned_v<Key>, "RadixSort requires unsigned integer keys");
+  constexpr u32 passes = sizeof(Key) * 8 / RadixSortSettings::digitBits;
+  constexpr std::size_t buckets = RadixSortSettings::buckets;
+
+  std::size_t blocks = 1;
+  if (pool) {
+    blocks = count / std::max<std::size_t>(grain, 1);
+    blocks = std::clamp<std::size_t>(blocks, 1, pool->WorkerCount() + 1);
+  }
+  std::size_t blockSize = (count + blocks - 1) / blocks;
+  auto blockRange = [count, blockSize](std::size_t block, std::size_t& begin, std::size_t& end) {
+    begin = std::min(count, block * blockSize);
+    end = std::min(count, begin + blockSize);
+  };
+
+  // block ranges hold different keys after every pass, so per block counts are redone for every
+  // pass and these totals only decide which passes are skipped
+  std::vector<std::size_t> totals(passes * buckets, 0);
+  std::vector<std::size_t> offsets(blocks * buckets);
+  if (blocks == 1) {
+    CountDigits(keys, 0, count, totals.data());
+  } else {
+    std::vector<std::size_t> partial(blocks * passes * buckets, 0);
+    pool->ParallelFor(blocks, 1, [&](std::size_t first, std::size_t last) {
+      for (std::size_t block = first; block < last; ++block) {
+        std::size_t begin, end;
+        blockRange(block, begin, end);
+        CountDigits(keys, begin, end, partial.data() + block * passes * buckets);
+      }
+    });
+    for (std::size_t block = 0; block < blocks; ++block) {
+      for (std::size_t i = 0; i < passes * buckets; ++i)
+        totals[i] += partial[block * passes * buckets + i];
+    }
+  }
+
+  Key* keysIn = keys;
+  Value* valuesIn = values;
+  Key* keysOut = keyScratch;
+  Value* valuesOut = valueScratch;
+
+  for (u32 pass = 0; pass < passes; ++pass) {
+    const std::size_t* total = totals.data() + pass * buckets;
+    if (TrivialPass(total, count))
+      continue;
+
+    u32 shift = pass * RadixSortSettings::digitBits;
+    auto scatter = [&](std::size_t first, std::size_t last) {
+      for (std::size_t block = first; block < last; ++block) {
+        std::size_t begin, end;
+        blockRange(block, begin, end);
+        ScatterDigit(
+            keysIn, valuesIn, begin, end, shift, offsets.data() + block * buckets, keysOut,
+            valuesOut
+        );
+      }
+    };
+
+    if (blocks == 1) {
+      std::size_t sum = 0;
+      for (std::size_t digit = 0; digit < buckets; ++digit) {
+        offsets[digit] = sum;
+        sum += total[digit];
+      }
+      scatter(0, 1);
+    } else {
+      pool->ParallelFor(blocks, 1, [&](std::size_t first, std::size_t last) {
+        for (std::size_t block = first; block < last; ++block) {
+          std::size_t* histogram = offsets.data() + block * buckets;
+          std::fill(histogram, histogram + buckets, 0);
+          std::size_t begin, end;
+          blockRange(block, begin, end);
+          for (std::size_t i = begin; i < end; ++i)
+            ++histogram[Digit(keysIn[i], shift)];
+        }
+      });
+
+      // digit major order: all blocks of digit 0, then all blocks of digit 1 and so on
+      std::size_t sum = 0;
+      for (std::size_t digit = 0; digit < buckets; ++digit) {
+        for (std::size_t block = 0; block < blocks; ++block) {
+          std::size_t& offset = offsets[block * buckets + digit];
+          std::size_t bucket = offset;
+          offset = sum;
+          sum += bucket;
+        }
+      }
+      pool->ParallelFor(blocks, 1, scatter);
+    }
+
+    std::swap(keysIn, keysOut);
+    std::swap(valuesIn, valuesOut);
+  }
+
+  // an odd number of performed passes leaves the result in scratch
+  if (keysIn != keys) {
+    std::copy(keysIn, keysIn + count, keys);
+    if constexpr (!std::is_void_v<Value>)
+      std::copy(valuesIn, valuesIn + count, values);
+  }
+}
+
+} // namespace Internal
+
+template <typename Key, typename Value>
+void RadixSort(
+    Key* keys,
+    Value* values,
+    std::size_t count,
+    Key* keyScratch,
+    Value* valueScratch
+) noexcept
+{
+  Internal::RadixSort(keys, values, count, keyScratch, valueScratch, nullptr, 0);
+}
+
+template <typename Key, typename Value>
+void RadixSort(
+    Key* keys,
+    Value* values,
+    std::size_t count,
+    Key* keyScratch,
+    Value* valueScratch,
+    ThreadPool& pool,
+    std::size_t grain
+) noexcept
+{
+  Internal::RadixSort(keys, values, count, keyScratch, valueScratch, &pool, grain);
+}
+
+template <typename Key>
+void RadixSort(Key* keys, std::size_t count, Key* keyScratch) noexcept
+{
+  Internal::RadixSort<Key, void>(keys, nullptr, count, keyScratch, nullptr, nullptr, 0);
+}
+
+template <typename Key>
+void RadixSort(
+    Key* keys,
+    std::size_t count,
+    Key* keyScratch,
+    ThreadPool& pool,
+    std::size_t grain
+) noexcept
+{
+  Internal::RadixSort<Key, void>(keys, nullptr, count, keyScratch, nullptr, &pool, grain);
+}
+
+} // namespace Engine::Core::Parallel
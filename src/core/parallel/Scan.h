@@ -0,0 +1,171 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Scan.h
+ * @brief Exclusive and inclusive prefix sums
+ *
+ * The parallel forms use two passes over one block per thread: blocks are reduced in parallel,
+ * the few block sums are scanned on the calling thread, and then every block is scanned from its
+ * offset. Input and output may be the same array.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/parallel/ThreadPool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace Engine::Core::Parallel
+{
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+struct ScanSettings
+{
+  /// Inputs smaller than this are scanned on the calling thread by the parallel forms
+  static constexpr std::size_t grain = 64 * 1024;
+};
+
+/**
+ * @brief output[i] = initial + input[0] + ... + input[i - 1]
+ * @return initial plus sum of all elements
+ */
+template <typename T>
+T ExclusiveScan(
+    const T* input,
+    T* output,
+    std::size_t count,
+    T initial = static_cast<T>(0)
+) noexcept;
+
+template <typename T>
+T ExclusiveScan(
+    const T* input,
+    T* output,
+    std::size_t count,
+    ThreadPool& pool,
+    T initial = static_cast<T>(0),
+    std::size_t grain = ScanSettings::grain
+) noexcept;
+
+/**
+ * @brief output[i] = input[0] + ... + input[i]
+ * @return sum of all elements
+ */
+template <typename T>
+T InclusiveScan(const T* input, T* output, std::size_t count) noexcept;
+
+template <typename T>
+T InclusiveScan(
+    const T* input,
+    T* output,
+    std::size_t count,
+    ThreadPool& pool,
+    std::size_t grain = ScanSettings::grain
+) noexcept;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+namespace Internal
+{
+
+template <typename T, bool Inclusive>
+T ScanRange(const T* input, T* output, std::size_t count, T sum) noexcept
+{
+  for (std::size_t i = 0; i < count; ++i) {
+    T value = input[i];
+    if constexpr (Inclusive) {
+      sum += value;
+      output[i] = sum;
+    } else {
+      output[i] = sum;
+      sum += value;
+    }
+  }
+  return sum;
+}
+
+template <typename T, bool Inclusive>
+T Scan(
+    const T* input,
+    T* output,
+    std::size_t count,
+    T initial,
+    ThreadPool& pool,
+    std::size_t grain
+) noexcept
+{
+  std::size_t blocks = count / std::max<std::size_t>(grain, 1);
+  blocks = std::min<std::size_t>(blocks, pool.WorkerCount() + 1);
+  if (blocks < 2)
+    return ScanRange<T, Inclusive>(input, output, count, initial);
+
+  std::size_t blockSize = (count + blocks - 1) / blocks;
+  std::vector<T> sums(blocks);
+
+  pool.ParallelFor(blocks, 1, [&](std::size_t first, std::size_t last) {
+    for (std::size_t block = first; block < last; ++block) {
+      std::size_t begin = std::min(count, block * blockSize);
+      std::size_t end = std::min(count, begin + blockSize);
+      T sum = static_cast<T>(0);
+      for (std::size_t i = begin; i < end; ++i)
+        sum += input[i];
+      sums[block] = sum;
+    }
+  });
+
+  T total = ScanRange<T, false>(sums.data(), sums.data(), blocks, initial);
+
+  pool.ParallelFor(blocks, 1, [&](std::size_t first, std::size_t last) {
+    for (std::size_t block = first; block < last; ++block) {
+      std::size_t begin = std::min(count, block * blockSize);
+      std::size_t end = std::min(count, begin + blockSize);
+      ScanRange<T, Inclusive>(input + begin, output + begin, end - begin, sums[block]);
+    }
+  });
+  return total;
+}
+
+} // namespace Internal
+
+template <typename T>
+T ExclusiveScan(const T* input, T* output, std::size_t count, T initial) noexcept
+{
+  return Internal::ScanRange<T, false>(input, output, count, initial);
+}
+
+template <typename T>
+T ExclusiveScan(
+    const T* input,
+    T* output,
+    std::size_t count,
+    ThreadPool& pool,
+    T initial,
+    std::size_t grain
+) noexcept
+{
+  return Internal::Scan<T, false>(input, output, count, initial, pool, grain);
+}
+
+template <typename T>
+T InclusiveScan(const T* input, T* output, std::size_t count) noexcept
+{
+  return Internal::ScanRange<T, true>(input, output, count, static_cast<T>(0));
+}
+
+template <typename T>
+T InclusiveScan(
+    const T* input,
+    T* output,
+    std::size_t count,
+    ThreadPool& pool,
+    std::size_t grain
+) noexcept
+{
+  return Internal::Scan<T, true>(input, output, count, static_cast<T>(0), pool, grain);
+}
+
+} // namespace Engine::Core::Parallel
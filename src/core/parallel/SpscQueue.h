@@ -0,0 +1,131 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file SpscQueue.h
+ * @brief Bounded lock-free queue for one producer thread and one consumer thread
+ *
+ * The producer owns the tail index and the consumer owns the head index; both live on their own
+ * cache lines so the threads do not invalidate each other's lines on every operation. Each side
+ * also keeps a private copy of the other side's index and reloads the shared one only when the
+ * copy says the queue is full or empty, which keeps cross-core traffic to one load per wrap.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/memory/AlignedAllocator.h"
+
+#include <atomic>
+#include <cassert>
+#include <vector>
+
+namespace Engine::Core::Parallel
+{
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+template <typename T>
+class SpscQueue
+{
+ public:
+  /// Capacity is rounded up to a power of two, at most 2^31
+  explicit SpscQueue(u32 capacity) noexcept;
+
+  SpscQueue(const SpscQueue&) = delete;
+  SpscQueue& operator=(const SpscQueue&) = delete;
+
+  /// Producer side, false when the queue is full
+  bool TryPush(const T& value) noexcept;
+  /// Consumer side, false when the queue is empty
+  bool TryPop(T& value) noexcept;
+
+  u32 Capacity() const noexcept;
+  /// Exact only when neither side is running concurrently
+  u32 SizeApprox() const noexcept;
+
+ private:
+  std::vector<T> buffer;
+  u32 mask;
+
+  /// Indices run freely and wrap around, slot is index & mask
+  alignas(Memory::cacheLineSize) std::atomic<u32> head;
+  u32 cachedTail;
+
+  alignas(Memory::cacheLineSize) std::atomic<u32> tail;
+  u32 cachedHead;
+};
+
+/* --------------------------------------- Implementation -------------------------------------- */
+namespace Internal
+{
+
+/// Largest power of two a u32 holds, doubling past it would overflow
+constexpr u32 maxPowerOfTwo = 1u << 31;
+
+/// Values above maxPowerOfTwo are clamped to it
+inline u32 RoundUpToPowerOfTwo(u32 value) noexcept
+{
+  assert(value <= maxPowerOfTwo && "Capacity above 2^31");
+  if (value > maxPowerOfTwo)
+    value = maxPowerOfTwo;
+  u32 result = 1;
+  while (result < value)
+    result <<= 1;
+  return result;
+}
+
+} // namespace Internal
+
+template <typename T>
+SpscQueue<T>::SpscQueue(u32 capacity) noexcept
+    : buffer(Internal::RoundUpToPowerOfTwo(capacity > 0 ? capacity : 1)),
+      mask(static_cast<u32>(buffer.size()) - 1),
+      head(0),
+      cachedTail(0),
+      tail(0),
+      cachedHead(0)
+{
+}
+
+template <typename T>
+bool SpscQueue<T>::TryPush(const T& value) noexcept
+{
+  u32 position = tail.load(std::memory_order_relaxed);
+  if (position - cachedHead > mask) {
+    cachedHead = head.load(std::memory_order_acquire);
+    if (position - cachedHead > mask)
+      return false;
+  }
+  buffer[position & mask] = value;
+  tail.store(position + 1, std::memory_order_release);
+  return true;
+}
+
+template <typename T>
+bool SpscQueue<T>::TryPop(T& value) noexcept
+{
+  u32 position = head.load(std::memory_order_relaxed);
+  if (position == cachedTail) {
+    cachedTail = tail.load(std::memory_order_acquire);
+    if (position == cachedTail)
+      return false;
+  }
+  value = buffer[position & mask];
+  head.store(position + 1, std::memory_order_release);
+  return true;
+}
+
+template <typename T>
+u32 SpscQueue<T>::Capacity() const noexcept
+{
+  return mask + 1;
+}
+
+template <typename T>
+u32 SpscQueue<T>::SizeApprox() const noexcept
+{
+  return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+}
+
+} // namespace Engine::Core::Parallel
@@ -0,0 +1,121 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file ThreadPool.cpp
+ * @brief Implementation of non template part of ThreadPool class
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include "core/parallel/ThreadPool.h"
+
+namespace Engine::Core::Parallel
+{
+
+namespace
+{
+
+/// Set on worker threads and on a thread which is dispatching a loop
+thread_local bool insideLoop = false;
+
+} // namespace
+
+u32 ThreadPool::DefaultWorkerCount() noexcept
+{
+  u32 hardware = std::thread::hardware_concurrency();
+  return hardware > 1 ? hardware - 1 : 0;
+}
+
+ThreadPool::ThreadPool(u32 workerCount) noexcept
+    : workers(),
+      job(nullptr),
+      generation(0),
+      activeWorkers(0),
+      stop(false)
+{
+  workers.reserve(workerCount);
+  for (u32 i = 0; i < workerCount; ++i)
+    workers.emplace_back(&ThreadPool::WorkerLoop, this);
+}
+
+ThreadPool::~ThreadPool() noexcept
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = true;
+  }
+  wake.notify_all();
+  for (std::thread& worker : workers)
+    worker.join();
+}
+
+u32 ThreadPool::WorkerCount() const noexcept
+{
+  return static_cast<u32>(workers.size());
+}
+
+void ThreadPool::Dispatch(Job& loop) noexcept
+{
+  // small loops, nested loops and pools without workers run on the calling thread
+  if (workers.empty() || insideLoop || loop.count <= loop.grain) {
+    RunChunks(loop);
+    return;
+  }
+
+  std::lock_guard<std::mutex> dispatchLock(dispatchMutex);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    job = &loop;
+    ++generation;
+  }
+  wake.notify_all();
+
+  insideLoop = true;
+  RunChunks(loop);
+  insideLoop = false;
+
+  // the job lives on this stack frame, so wait until no worker references it
+  std::unique_lock<std::mutex> lock(mutex);
+  finished.wait(lock, [this] { return activeWorkers == 0; });
+  job = nullptr;
+}
+
+void ThreadPool::WorkerLoop() noexcept
+{
+  insideLoop = true;
+  u64 seen = 0;
+
+  for (;;) {
+    Job* current = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      wake.wait(lock, [this, seen] { return stop || (job && generation != seen); });
+      if (stop)
+        return;
+      seen = generation;
+      current = job;
+      ++activeWorkers;
+    }
+
+    RunChunks(*current);
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      --activeWorkers;
+    }
+    finished.notify_one();
+  }
+}
+
+void ThreadPool::RunChunks(Job& loop) noexcept
+{
+  for (;;) {
+    std::size_t begin = loop.next.fetch_add(loop.grain, std::memory_order_relaxed);
+    if (begin >= loop.count)
+      return;
+    std::size_t end = begin + loop.grain < loop.count ? begin + loop.grain : loop.count;
+    loop.invoke(loop.context, begin, end);
+  }
+}
+
+} // namespace Engine::Core::Parallel
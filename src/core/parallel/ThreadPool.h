@@ -0,0 +1,98 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file ThreadPool.h
+ * @brief Fixed set of worker threads executing data parallel loops
+ *
+ * ParallelFor splits an index range into chunks which are taken by workers and by the calling
+ * thread through one atomic counter. Only one loop runs at a time; a ParallelFor issued from
+ * inside a running loop is executed inline, so nested loops do not deadlock.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Engine::Core::Parallel
+{
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+class ThreadPool
+{
+ public:
+  /// Hardware threads minus the calling thread, which takes part in every loop
+  static u32 DefaultWorkerCount() noexcept;
+
+  explicit ThreadPool(u32 workerCount = DefaultWorkerCount()) noexcept;
+  ~ThreadPool() noexcept;
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  u32 WorkerCount() const noexcept;
+
+  /**
+   * @brief Calls func(begin, end) for consecutive chunks covering [0, count) and waits for them
+   * @param grain maximal chunk size
+   */
+  template <typename Func>
+  void ParallelFor(std::size_t count, std::size_t grain, Func&& func) noexcept;
+
+ private:
+  struct Job
+  {
+    void (*invoke)(void* context, std::size_t begin, std::size_t end);
+    void* context;
+    std::size_t count;
+    std::size_t grain;
+    std::atomic<std::size_t> next;
+  };
+
+  void Dispatch(Job& job) noexcept;
+  void WorkerLoop() noexcept;
+  static void RunChunks(Job& job) noexcept;
+
+  std::vector<std::thread> workers;
+  std::mutex dispatchMutex;
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable finished;
+  Job* job;
+  u64 generation;
+  u32 activeWorkers;
+  bool stop;
+};
+
+/* --------------------------------------- Implementation -------------------------------------- */
+template <typename Func>
+void ThreadPool::ParallelFor(std::size_t count, std::size_t grain, Func&& func) noexcept
+{
+  if (count == 0)
+    return;
+  if (grain == 0)
+    grain = 1;
+
+  using Callable = std::remove_reference_t<Func>;
+  Job loop;
+  loop.invoke = [](void* context, std::size_t begin, std::size_t end) {
+    (*static_cast<Callable*>(context))(begin, end);
+  };
+  loop.context = const_cast<void*>(static_cast<const void*>(&func));
+  loop.count = count;
+  loop.grain = grain;
+  loop.next.store(0, std::memory_order_relaxed);
+
+  Dispatch(loop);
+}
+
+} // namespace Engine::Core::Parallel
@@ -0,0 +1,317 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Epa.h
+ * @brief Expanding Polytope Algorithm for penetration depth of intersecting convex shapes
+ *
+ * EPA starts from the terminating simplex of GjkDistance/GjkIntersect and expands it inside the
+ * Minkowski difference until the face closest to origin lies on its boundary. The polytope lives
+ * in fixed size arrays, so a query never allocates.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/math/Vector3.h"
+#include "core/physics/Gjk.h"
+
+#include <cmath>
+#include <initializer_list>
+#include <limits>
+
+namespace Engine::Core::Physics
+{
+
+using Math::Vector3;
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+template <typename T>
+struct EpaResult
+{
+  /// False if the polytope could not be built, e.g. shapes are not intersecting
+  bool valid;
+  /// Contact normal pointing from shape A to shape B
+  Vector3<T> normal;
+  /// Distance B has to be moved along normal to separate shapes
+  T depth;
+  /// Deepest point of shape A inside B
+  Vector3<T> pointA;
+  /// Deepest point of shape B inside A
+  Vector3<T> pointB;
+  u32 iterations;
+};
+
+template <typename T>
+struct EpaSettings
+{
+  static constexpr u32 maxIterations = 64;
+  static constexpr u32 maxVertices = 4 + maxIterations;
+  static constexpr u32 maxFaces = 2 * maxVertices;
+  static constexpr u32 maxHorizonEdges = maxVertices;
+  /// Relative tolerance of support distance used as termination criterion
+  static constexpr T tolerance = static_cast<T>(1000) * std::numeric_limits<T>::epsilon();
+};
+
+/**
+ * @brief Computes penetration depth and contact points of intersecting shapes
+ * @param simplex simplex returned by GJK query which reported intersection
+ */
+template <typename T, typename ShapeA, typename ShapeB>
+EpaResult<T> EpaPenetration(
+    const ShapeA& a,
+    const ShapeB& b,
+    const GjkSimplex<T>& simplex
+) noexcept;
+
+/* ------------------------------------------- Usings ------------------------------------------ */
+using EpaResultf = EpaResult<f32>;
+using EpaResultd = EpaResult<f64>;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+namespace Internal
+{
+
+template <typename T>
+struct EpaFace
+{
+  u32 indices[3];
+  Vector3<T> normal;
+  T distance;
+};
+
+template <typename T>
+struct EpaPolytope
+{
+  SimplexVertex<T> vertices[EpaSettings<T>::maxVertices];
+  EpaFace<T> faces[EpaSettings<T>::maxFaces];
+  u32 vertexCount = 0;
+  u32 faceCount = 0;
+
+  bool AddFace(u32 i0, u32 i1, u32 i2) noexcept
+  {
+    if (faceCount == EpaSettings<T>::maxFaces)
+      return false;
+
+    const Vector3<T>& a = vertices[i0].w;
+    Vector3<T> normal = (vertices[i1].w - a).Cross(vertices[i2].w - a);
+    T length = normal.Length();
+    if (length <= std::numeric_limits<T>::min())
+      return true;
+
+    EpaFace<T>& face = faces[faceCount++];
+    face.indices[0] = i0;
+    face.indices[1] = i1;
+    face.indices[2] = i2;
+    face.normal = normal / length;
+    face.distance = face.normal.Dot(a);
+    return true;
+  }
+};
+
+/**
+ * @brief Grows GJK simplex to a tetrahedron, needed when GJK stopped on a touching contact
+ */
+template <typename T, typename ShapeA, typename ShapeB>
+bool EpaBuildTetrahedron(
+    const ShapeA& a,
+    const ShapeB& b,
+    const GjkSimplex<T>& simplex,
+    EpaPolytope<T>& polytope
+) noexcept
+{
+  constexpr T tolerance = EpaSettings<T>::tolerance;
+
+  for (u32 i = 0; i < simplex.count && i < 4; ++i)
+    polytope.vertices[i] = simplex.vertices[i];
+  polytope.vertexCount = simplex.count < 4 ? simplex.count : 4;
+
+  if (polytope.vertexCount == 0) {
+    polytope.vertices[0] = MinkowskiSupport(a, b, Vector3<T>::UnitX());
+    polytope.vertexCount = 1;
+  }
+
+  if (polytope.vertexCount == 1) {
+    const Vector3<T> axes[6] = {Vector3<T>::UnitX(),  Vector3<T>::UnitY(),
+                                Vector3<T>::UnitZ(),  -Vector3<T>::UnitX(),
+                                -Vector3<T>::UnitY(), -Vector3<T>::UnitZ()};
+    for (const Vector3<T>& axis : axes) {
+      SimplexVertex<T> vertex = MinkowskiSupport(a, b, axis);
+      if ((vertex.w - polytope.vertices[0].w).LengthSquared() > tolerance) {
+        polytope.vertices[polytope.vertexCount++] = vertex;
+        break;
+      }
+    }
+    if (polytope.vertexCount < 2)
+      return false;
+  }
+
+  if (polytope.vertexCount == 2) {
+    Vector3<T> line = polytope.vertices[1].w - polytope.vertices[0].w;
+    Vector3<T> axis = std::abs(line.x) < std::abs(line.y) ? Vector3<T>::UnitX()
+                                                          : Vector3<T>::UnitY();
+    axis = std::abs(line.z) < std::abs(line.Dot(axis)) ? Vector3<T>::UnitZ() : axis;
+    Vector3<T> side = line.Cross(axis).Normalized();
+    Vector3<T> up = line.Cross(side).Normalized();
+    const Vector3<T> directions[4] = {side, up, -side, -up};
+    for (const Vector3<T>& direction : directions) {
+      SimplexVertex<T> vertex = MinkowskiSupport(a, b, direction);
+      Vector3<T> offset = (vertex.w - polytope.vertices[0].w).Cross(line);
+      if (offset.LengthSquared() > tolerance * line.LengthSquared()) {
+        polytope.vertices[polytope.vertexCount++] = vertex;
+        break;
+      }
+    }
+    if (polytope.vertexCount < 3)
+      return false;
+  }
+
+  if (polytope.vertexCount == 3) {
+    const Vector3<T>& origin = polytope.vertices[0].w;
+    Vector3<T> normal = (polytope.vertices[1].w - origin).Cross(polytope.vertices[2].w - origin);
+    for (const Vector3<T>& direction : {normal, -normal}) {
+      SimplexVertex<T> vertex = MinkowskiSupport(a, b, direction);
+      if (std::abs(normal.Dot(vertex.w - origin)) > tolerance * normal.Length()) {
+        polytope.vertices[polytope.vertexCount++] = vertex;
+        break;
+      }
+    }
+    if (polytope.vertexCount < 4)
+      return false;
+  }
+
+  // orient every face so its normal points away from the opposite vertex
+  constexpr u32 faces[4][4] = {{0, 1, 2, 3}, {0, 3, 1, 2}, {0, 2, 3, 1}, {1, 3, 2, 0}};
+  for (const auto& face : faces) {
+    const Vector3<T>& origin = polytope.vertices[face[0]].w;
+    Vector3<T> normal =
+        (polytope.vertices[face[1]].w - origin).Cross(polytope.vertices[face[2]].w - origin);
+    if (normal.Dot(polytope.vertices[face[3]].w - origin) > static_cast<T>(0))
+      polytope.AddFace(face[0], face[2], face[1]);
+    else
+      polytope.AddFace(face[0], face[1], face[2]);
+  }
+  return polytope.faceCount == 4;
+}
+
+} // namespace Internal
+
+template <typename T, typename ShapeA, typename ShapeB>
+EpaResult<T> EpaPenetration(
+    const ShapeA& a,
+    const ShapeB& b,
+    const GjkSimplex<T>& simplex
+) noexcept
+{
+  using Settings = EpaSettings<T>;
+
+  EpaResult<T> result{false, Vector3<T>(), static_cast<T>(0), Vector3<T>(), Vector3<T>(), 0};
+
+  Internal::EpaPolytope<T> polytope;
+  if (!Internal::EpaBuildTetrahedron(a, b, simplex, polytope))
+    return result;
+
+  u32 closest = 0;
+  for (;;) {
+    closest = 0;
+    for (u32 i = 1; i < polytope.faceCount; ++i)
+      if (polytope.faces[i].distance < polytope.faces[closest].distance)
+        closest = i;
+
+    const Internal::EpaFace<T> face = polytope.faces[closest];
+    if (result.iterations == Settings::maxIterations ||
+        polytope.vertexCount == Settings::maxVertices)
+      break;
+
+    SimplexVertex<T> vertex = MinkowskiSupport(a, b, face.normal);
+    ++result.iterations;
+
+    T distance = face.normal.Dot(vertex.w);
+    T scale = std::abs(distance) > static_cast<T>(1) ? std::abs(distance) : static_cast<T>(1);
+    if (distance - face.distance <= Settings::tolerance * scale)
+      break;
+
+    u32 index = polytope.vertexCount++;
+    polytope.vertices[index] = vertex;
+
+    // remove faces visible from the new vertex and collect their boundary
+    u32 horizon[Settings::maxHorizonEdges][2];
+    u32 horizonCount = 0;
+    bool overflow = false;
+    for (u32 i = 0; i < polytope.faceCount;) {
+      const Internal::EpaFace<T>& f = polytope.faces[i];
+      if (f.normal.Dot(vertex.w - polytope.vertices[f.indices[0]].w) <= static_cast<T>(0)) {
+        ++i;
+        continue;
+      }
+
+      for (u32 e = 0; e < 3; ++e) {
+        u32 from = f.indices[e];
+        u32 to = f.indices[(e + 1) % 3];
+
+        // an edge shared by two removed faces is interior, drop its twin
+        bool shared = false;
+        for (u32 h = 0; h < horizonCount; ++h) {
+          if (horizon[h][0] == to && horizon[h][1] == from) {
+            horizon[h][0] = horizon[horizonCount - 1][0];
+            horizon[h][1] = horizon[horizonCount - 1][1];
+            --horizonCount;
+            shared = true;
+            break;
+          }
+        }
+        if (shared)
+          continue;
+        if (horizonCount == Settings::maxHorizonEdges) {
+          overflow = true;
+          continue;
+        }
+        horizon[horizonCount][0] = from;
+        horizon[horizonCount][1] = to;
+        ++horizonCount;
+      }
+
+      polytope.faces[i] = polytope.faces[--polytope.faceCount];
+    }
+
+    for (u32 h = 0; h < horizonCount && !overflow; ++h)
+      overflow = !polytope.AddFace(horizon[h][0], horizon[h][1], index);
+
+    if (overflow || polytope.faceCount == 0)
+      return result;
+  }
+
+  const Internal::EpaFace<T>& face = polytope.faces[closest];
+  const SimplexVertex<T>& v0 = polytope.vertices[face.indices[0]];
+  const SimplexVertex<T>& v1 = polytope.vertices[face.indices[1]];
+  const SimplexVertex<T>& v2 = polytope.vertices[face.indices[2]];
+
+  // barycentric coordinates of origin projection onto the closest face
+  Vector3<T> p = face.normal * face.distance;
+  Vector3<T> e0 = v1.w - v0.w;
+  Vector3<T> e1 = v2.w - v0.w;
+  Vector3<T> e2 = p - v0.w;
+  T d00 = e0.Dot(e0);
+  T d01 = e0.Dot(e1);
+  T d11 = e1.Dot(e1);
+  T d20 = e2.Dot(e0);
+  T d21 = e2.Dot(e1);
+  T denominator = d00 * d11 - d01 * d01;
+  T v = static_cast<T>(1) / static_cast<T>(3);
+  T w = v;
+  if (std::abs(denominator) > std::numeric_limits<T>::min()) {
+    v = (d11 * d20 - d01 * d21) / denominator;
+    w = (d00 * d21 - d01 * d20) / denominator;
+  }
+  T u = static_cast<T>(1) - v - w;
+
+  result.valid = true;
+  result.normal = face.normal;
+  result.depth = face.distance > static_cast<T>(0) ? face.distance : static_cast<T>(0);
+  result.pointA = v0.a * u + v1.a * v + v2.a * w;
+  result.pointB = v0.b * u + v1.b * v + v2.b * w;
+  return result;
+}
+
+} // namespace Engine::Core::Physics
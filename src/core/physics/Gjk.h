@@ -0,0 +1,448 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Gjk.h
+ * @brief Gilbert-Johnson-Keerthi distance and intersection queries between convex shapes
+ *
+ * Shapes are any types providing Support(direction), see Shapes.h. GjkSimplex is both the working
+ * set of the algorithm and the cache between frames: when a simplex from the previous query of
+ * the same pair is passed back in, its vertices are recomputed along the stored search directions
+ * and iteration starts close to the answer.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/math/Vector3.h"
+
+#include <cmath>
+#include <limits>
+
+namespace Engine::Core::Physics
+{
+
+using Math::Vector3;
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+template <typename T>
+struct SimplexVertex
+{
+  /// Support point of shape A
+  Vector3<T> a;
+  /// Support point of shape B
+  Vector3<T> b;
+  /// Minkowski difference point a - b
+  Vector3<T> w;
+  /// Search direction which produced the vertex
+  Vector3<T> direction;
+};
+
+template <typename T>
+class GjkSimplex
+{
+ public:
+  SimplexVertex<T> vertices[4];
+  u32 count;
+
+  constexpr GjkSimplex() noexcept;
+
+  constexpr void Reset() noexcept;
+
+  /**
+   * @brief Finds point of the simplex closest to origin and drops vertices not supporting it
+   * @param barycentric weights of remaining vertices for the closest point
+   * @return false if origin is inside the simplex
+   */
+  constexpr bool Reduce(Vector3<T>& closest, T (&barycentric)[4]) noexcept;
+
+ private:
+  constexpr void Keep(u32 i0, u32 i1, u32 i2, u32 n) noexcept;
+  constexpr void ReduceSegment(u32 i0, u32 i1, Vector3<T>& closest, T (&barycentric)[4]) noexcept;
+  constexpr void ReduceTriangle(
+      u32 i0,
+      u32 i1,
+      u32 i2,
+      Vector3<T>& closest,
+      T (&barycentric)[4]
+  ) noexcept;
+  constexpr bool ReduceTetrahedron(Vector3<T>& closest, T (&barycentric)[4]) noexcept;
+};
+
+template <typename T>
+struct GjkResult
+{
+  bool intersecting;
+  /// Distance between shapes, zero when they intersect
+  T distance;
+  /// Closest point on shape A
+  Vector3<T> pointA;
+  /// Closest point on shape B
+  Vector3<T> pointB;
+  /// Number of support queries made by the main loop
+  u32 iterations;
+};
+
+template <typename T>
+struct GjkSettings
+{
+  static constexpr u32 maxIterations = 64;
+  /// Relative tolerance of squared distance used as termination criterion
+  static constexpr T tolerance = static_cast<T>(100) * std::numeric_limits<T>::epsilon();
+};
+
+template <typename T, typename ShapeA, typename ShapeB>
+constexpr SimplexVertex<T> MinkowskiSupport(
+    const ShapeA& a,
+    const ShapeB& b,
+    const Vector3<T>& direction
+) noexcept;
+
+/**
+ * @brief Computes distance and closest points between two convex shapes
+ * @param simplex simplex of the previous query of this pair or empty simplex, receives final one
+ */
+template <typename T, typename ShapeA, typename ShapeB>
+GjkResult<T> GjkDistance(const ShapeA& a, const ShapeB& b, GjkSimplex<T>& simplex) noexcept;
+
+/**
+ * @brief Boolean intersection test, stops as soon as a separating axis is found
+ */
+template <typename T, typename ShapeA, typename ShapeB>
+bool GjkIntersect(const ShapeA& a, const ShapeB& b, GjkSimplex<T>& simplex) noexcept;
+
+/* ------------------------------------------- Usings ------------------------------------------ */
+using GjkSimplexf = GjkSimplex<f32>;
+using GjkSimplexd = GjkSimplex<f64>;
+using GjkResultf = GjkResult<f32>;
+using GjkResultd = GjkResult<f64>;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+template <typename T>
+constexpr GjkSimplex<T>::GjkSimplex() noexcept
+    : vertices(),
+      count(0)
+{
+}
+
+template <typename T>
+constexpr void GjkSimplex<T>::Reset() noexcept
+{
+  count = 0;
+}
+
+template <typename T>
+constexpr void GjkSimplex<T>::Keep(u32 i0, u32 i1, u32 i2, u32 n) noexcept
+{
+  SimplexVertex<T> kept[3] = {vertices[i0], vertices[i1], vertices[i2]};
+  for (u32 i = 0; i < n; ++i)
+    vertices[i] = kept[i];
+  count = n;
+}
+
+template <typename T>
+constexpr void GjkSimplex<T>::ReduceSegment(
+    u32 i0,
+    u32 i1,
+    Vector3<T>& closest,
+    T (&barycentric)[4]
+) noexcept
+{
+  const Vector3<T>& a = vertices[i0].w;
+  const Vector3<T>& b = vertices[i1].w;
+  Vector3<T> ab = b - a;
+  T lengthSquared = ab.LengthSquared();
+  T t = lengthSquared > std::numeric_limits<T>::min() ? -a.Dot(ab) / lengthSquared
+                                                      : static_cast<T>(0);
+
+  if (t <= static_cast<T>(0)) {
+    closest = a;
+    barycentric[0] = static_cast<T>(1);
+    Keep(i0, i0, i0, 1);
+  } else if (t >= static_cast<T>(1)) {
+    closest = b;
+    barycentric[0] = static_cast<T>(1);
+    Keep(i1, i1, i1, 1);
+  } else {
+    closest = a + ab * t;
+    barycentric[0] = static_cast<T>(1) - t;
+    barycentric[1] = t;
+    Keep(i0, i1, i1, 2);
+  }
+}
+
+template <typename T>
+constexpr void GjkSimplex<T>::ReduceTriangle(
+    u32 i0,
+    u32 i1,
+    u32 i2,
+    Vector3<T>& closest,
+    T (&barycentric)[4]
+) noexcept
+{
+  // Voronoi region classification of the origin, see Ericson "Real-Time Collision Detection" 5.1.5
+  const Vector3<T>& a = vertices[i0].w;
+  const Vector3<T>& b = vertices[i1].w;
+  const Vector3<T>& c = vertices[i2].w;
+  Vector3<T> ab = b - a;
+  Vector3<T> ac = c - a;
+
+  T d1 = -ab.Dot(a);
+  T d2 = -ac.Dot(a);
+  if (d1 <= static_cast<T>(0) && d2 <= static_cast<T>(0)) {
+    closest = a;
+    barycentric[0] = static_cast<T>(1);
+    Keep(i0, i0, i0, 1);
+    return;
+  }
+
+  T d3 = -ab.Dot(b);
+  T d4 = -ac.Dot(b);
+  if (d3 >= static_cast<T>(0) && d4 <= d3) {
+    closest = b;
+    barycentric[0] = static_cast<T>(1);
+    Keep(i1, i1, i1, 1);
+    return;
+  }
+
+  T vc = d1 * d4 - d3 * d2;
+  if (vc <= static_cast<T>(0) && d1 >= static_cast<T>(0) && d3 <= static_cast<T>(0)) {
+    T t = d1 / (d1 - d3);
+    closest = a + ab * t;
+    barycentric[0] = static_cast<T>(1) - t;
+    barycentric[1] = t;
+    Keep(i0, i1, i1, 2);
+    return;
+  }
+
+  T d5 = -ab.Dot(c);
+  T d6 = -ac.Dot(c);
+  if (d6 >= static_cast<T>(0) && d5 <= d6) {
+    closest = c;
+    barycentric[0] = static_cast<T>(1);
+    Keep(i2, i2, i2, 1);
+    return;
+  }
+
+  T vb = d5 * d2 - d1 * d6;
+  if (vb <= static_cast<T>(0) && d2 >= static_cast<T>(0) && d6 <= static_cast<T>(0)) {
+    T t = d2 / (d2 - d6);
+    closest = a + ac * t;
+    barycentric[0] = static_cast<T>(1) - t;
+    barycentric[1] = t;
+    Keep(i0, i2, i2, 2);
+    return;
+  }
+
+  T va = d3 * d6 - d5 * d4;
+  if (va <= static_cast<T>(0) && d4 - d3 >= static_cast<T>(0) && d5 - d6 >= static_cast<T>(0)) {
+    T t = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+    closest = b + (c - b) * t;
+    barycentric[0] = static_cast<T>(1) - t;
+    barycentric[1] = t;
+    Keep(i1, i2, i2, 2);
+    return;
+  }
+
+  T sum = va + vb + vc;
+  if (sum <= std::numeric_limits<T>::min()) {
+    // degenerate triangle, fall back to its longest edge
+    u32 far = (b - a).LengthSquared() > (c - a).LengthSquared() ? i1 : i2;
+    ReduceSegment(i0, far, closest, barycentric);
+    return;
+  }
+
+  T v = vb / sum;
+  T w = vc / sum;
+  closest = a + ab * v + ac * w;
+  barycentric[0] = static_cast<T>(1) - v - w;
+  barycentric[1] = v;
+  barycentric[2] = w;
+  Keep(i0, i1, i2, 3);
+}
+
+template <typename T>
+constexpr bool GjkSimplex<T>::ReduceTetrahedron(Vector3<T>& closest, T (&barycentric)[4]) noexcept
+{
+  // faces with the vertex opposite to each of them
+  constexpr u32 faces[4][4] = {{0, 1, 2, 3}, {0, 2, 3, 1}, {0, 3, 1, 2}, {1, 3, 2, 0}};
+
+  bool outside[4] = {};
+  bool anyOutside = false;
+  for (u32 f = 0; f < 4; ++f) {
+    const Vector3<T>& a = vertices[faces[f][0]].w;
+    Vector3<T> n = (vertices[faces[f][1]].w - a).Cross(vertices[faces[f][2]].w - a);
+    T signOrigin = -n.Dot(a);
+    T signOpposite = n.Dot(vertices[faces[f][3]].w - a);
+    // flat tetrahedron has no inside, every face has to be checked
+    outside[f] = signOrigin * signOpposite <= static_cast<T>(0);
+    anyOutside = anyOutside || outside[f];
+  }
+
+  if (!anyOutside)
+    return false;
+
+  GjkSimplex<T> best;
+  Vector3<T> bestClosest;
+  T bestBarycentric[4] = {};
+  T bestDistance = std::numeric_limits<T>::max();
+  for (u32 f = 0; f < 4; ++f) {
+    if (!outside[f])
+      continue;
+
+    GjkSimplex<T> candidate = *this;
+    Vector3<T> point;
+    T weights[4] = {};
+    candidate.ReduceTriangle(faces[f][0], faces[f][1], faces[f][2], point, weights);
+
+    T distance = point.LengthSquared();
+    if (distance < bestDistance) {
+      bestDistance = distance;
+      best = candidate;
+      bestClosest = point;
+      for (u32 i = 0; i < 4; ++i)
+        bestBarycentric[i] = weights[i];
+    }
+  }
+
+  *this = best;
+  closest = bestClosest;
+  for (u32 i = 0; i < 4; ++i)
+    barycentric[i] = bestBarycentric[i];
+  return true;
+}
+
+template <typename T>
+constexpr bool GjkSimplex<T>::Reduce(Vector3<T>& closest, T (&barycentric)[4]) noexcept
+{
+  switch (count) {
+  case 1:
+    closest = vertices[0].w;
+    barycentric[0] = static_cast<T>(1);
+    return true;
+  case 2:
+    ReduceSegment(0, 1, closest, barycentric);
+    return true;
+  case 3:
+    ReduceTriangle(0, 1, 2, closest, barycentric);
+    return true;
+  case 4:
+    return ReduceTetrahedron(closest, barycentric);
+  default:
+    closest = Vector3<T>();
+    return true;
+  }
+}
+
+template <typename T, typename ShapeA, typename ShapeB>
+constexpr SimplexVertex<T> MinkowskiSupport(
+    const ShapeA& a,
+    const ShapeB& b,
+    const Vector3<T>& direction
+) noexcept
+{
+  SimplexVertex<T> vertex;
+  vertex.a = a.Support(direction);
+  vertex.b = b.Support(-direction);
+  vertex.w = vertex.a - vertex.b;
+  vertex.direction = direction;
+  return vertex;
+}
+
+namespace Internal
+{
+
+/**
+ * @brief Shared GJK loop, with earlyOut the loop stops as soon as shapes are proven separated
+ */
+template <typename T, typename ShapeA, typename ShapeB>
+GjkResult<T> GjkSolve(
+    const ShapeA& a,
+    const ShapeB& b,
+    GjkSimplex<T>& simplex,
+    bool earlyOut
+) noexcept
+{
+  using Settings = GjkSettings<T>;
+
+  GjkResult<T> result{false, static_cast<T>(0), Vector3<T>(), Vector3<T>(), 0};
+
+  // warm start: previous frame vertices are refreshed along their search directions
+  if (simplex.count > 0 && simplex.count <= 4) {
+    for (u32 i = 0; i < simplex.count; ++i)
+      simplex.vertices[i] = MinkowskiSupport(a, b, simplex.vertices[i].direction);
+  } else {
+    simplex.vertices[0] = MinkowskiSupport(a, b, Vector3<T>::UnitX());
+    simplex.count = 1;
+  }
+
+  Vector3<T> closest;
+  T barycentric[4] = {};
+  T maxVertexSquared = static_cast<T>(0);
+
+  for (;;) {
+    if (!simplex.Reduce(closest, barycentric)) {
+      result.intersecting = true;
+      break;
+    }
+
+    T distanceSquared = closest.LengthSquared();
+    for (u32 i = 0; i < simplex.count; ++i) {
+      T lengthSquared = simplex.vertices[i].w.LengthSquared();
+      maxVertexSquared = lengthSquared > maxVertexSquared ? lengthSquared : maxVertexSquared;
+    }
+    if (distanceSquared <= Settings::tolerance * maxVertexSquared) {
+      result.intersecting = true;
+      break;
+    }
+
+    if (result.iterations == Settings::maxIterations)
+      break;
+
+    SimplexVertex<T> vertex = MinkowskiSupport(a, b, -closest);
+    ++result.iterations;
+
+    T progress = closest.Dot(vertex.w);
+    if (earlyOut && progress > static_cast<T>(0))
+      break;
+    if (distanceSquared - progress <= Settings::tolerance * distanceSquared)
+      break;
+
+    // the same point again means no progress is possible
+    bool duplicate = false;
+    for (u32 i = 0; i < simplex.count; ++i)
+      duplicate = duplicate || (simplex.vertices[i].w - vertex.w).LengthSquared() <=
+                                   Settings::tolerance * maxVertexSquared;
+    if (duplicate)
+      break;
+
+    simplex.vertices[simplex.count++] = vertex;
+  }
+
+  if (result.intersecting)
+    return result;
+
+  for (u32 i = 0; i < simplex.count; ++i) {
+    result.pointA += simplex.vertices[i].a * barycentric[i];
+    result.pointB += simplex.vertices[i].b * barycentric[i];
+  }
+  result.distance = closest.Length();
+  return result;
+}
+
+} // namespace Internal
+
+template <typename T, typename ShapeA, typename ShapeB>
+GjkResult<T> GjkDistance(const ShapeA& a, const ShapeB& b, GjkSimplex<T>& simplex) noexcept
+{
+  return Internal::GjkSolve(a, b, simplex, false);
+}
+
+template <typename T, typename ShapeA, typename ShapeB>
+bool GjkIntersect(const ShapeA& a, const ShapeB& b, GjkSimplex<T>& simplex) noexcept
+{
+  return Internal::GjkSolve(a, b, simplex, true).intersecting;
+}
+
+} // namespace Engine::Core::Physics
@@ -0,0 +1,461 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Integrator.h
+ * @brief Batched integration kernels over PhysicsState
+ *
+ * Every kernel has a range form, which integrates bodies [begin, end) and may be called from any
+ * thread for disjoint ranges, and a ThreadPool form splitting the whole state into chunks. Range
+ * kernels walk the state in small tiles and process one component at a time with restrict
+ * qualified pointers, so the loops vectorize and the inverse masses of a tile stay in L1 between
+ * the x, y and z passes. Integrators consume accumulated forces and reset them to zero.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/math/Vector3.h"
+#include "core/parallel/ThreadPool.h"
+#include "core/physics/PhysicsState.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace Engine::Core::Physics
+{
+
+using Math::Vector3;
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+struct IntegratorSettings
+{
+  /// Bodies processed by one pass over the component arrays
+  static constexpr std::size_t tileSize = 1024;
+  /// Bodies per tile of the Runge-Kutta kernel, which keeps 19 arrays of a tile on the stack
+  static constexpr std::size_t rk4TileSize = 256;
+  /// Default number of bodies in one chunk of the parallel forms
+  static constexpr std::size_t grain = 16 * 1024;
+};
+
+/**
+ * @brief Semi-implicit (symplectic) Euler: v += a * dt, x += v * dt
+ */
+template <typename T>
+void IntegrateSemiImplicitEuler(
+    PhysicsState<T>& state,
+    T dt,
+    const Vector3<T>& gravity,
+    std::size_t begin,
+    std::size_t end
+) noexcept;
+
+template <typename T>
+void IntegrateSemiImplicitEuler(
+    PhysicsState<T>& state,
+    T dt,
+    const Vector3<T>& gravity,
+    Parallel::ThreadPool& pool,
+    std::size_t grain = IntegratorSettings::grain
+) noexcept;
+
+/**
+ * @brief First half of velocity Verlet step: v += a * dt / 2, x += v * dt
+ *
+ * Forces have to be evaluated at the new positions before IntegrateVerletEnd.
+ */
+template <typename T>
+void IntegrateVerletBegin(
+    PhysicsState<T>& state,
+    T dt,
+    const Vector3<T>& gravity,
+    std::size_t begin,
+    std::size_t end
+) noexcept;
+
+template <typename T>
+void IntegrateVerletBegin(
+    PhysicsState<T>& state,
+    T dt,
+    const Vector3<T>& gravity,
+    Parallel::ThreadPool& pool,
+    std::size_t grain = IntegratorSettings::grain
+) noexcept;
+
+/**
+ * @brief Second half of velocity Verlet step: v += a * dt / 2 with forces at new positions
+ */
+template <typename T>
+void IntegrateVerletEnd(
+    PhysicsState<T>& state,
+    T dt,
+    const Vector3<T>& gravity,
+    std::size_t begin,
+    std::size_t end
+) noexcept;
+
+template <typename T>
+void IntegrateVerletEnd(
+    PhysicsState<T>& state,
+    T dt,
+    const Vector3<T>& gravity,
+    Parallel::ThreadPool& pool,
+    std::size_t grain = IntegratorSettings::grain
+) noexcept;
+
+/**
+ * @brief Classic fourth order Runge-Kutta step
+ * @param field functor Vector3<T>(std::size_t index, const Vector3<T>& position,
+ * const Vector3<T>& velocity) returning position and velocity dependent acceleration, which is
+ * added to acceleration from accumulated force and gravity; like gravity it does not move static
+ * bodies
+ */
+template <typename T, typename Field>
+void IntegrateRK4(
+    PhysicsState<T>& state,
+    T dt,
+    const Vector3<T>& gravity,
+    const Field& field,
+    std::size_t begin,
+    std::size_t end
+) noexcept;
+
+template <typename T, typename Field>
+void IntegrateRK4(
+    PhysicsState<T>& state,
+    T dt,
+    const Vector3<T>& gravity,
+    const Field& field,
+    Parallel::ThreadPool& pool,
+    std::size_t grain = IntegratorSettings::grain
+) noexcept;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+namespace Internal
+{
+
+/// v += (f * m + g) * kick, x += v * drift, f = 0; gravity is not applied to static bodies
+template <typename T>
+void IntegrateAxis(
+    T* __restrict position,
+    T* __restrict velocity,
+    T* __restrict force,
+    const T* __restrict inverseMass,
+    T gravity,
+    T kick,
+    T drift,
+    std::size_t count
+) noexcept
+{
+  for (std::size_t i = 0; i < count; ++i) {
+    T dynamic = inverseMass[i] > static_cast<T>(0) ? static_cast<T>(1) : static_cast<T>(0);
+    T v = velocity[i] + (force[i] * inverseMass[i] + gravity * dynamic) * kick;
+    velocity[i] = v;
+    position[i] += v * drift;
+    force[i] = static_cast<T>(0);
+  }
+}
+
+template <typename T>
+void IntegrateRange(
+    PhysicsState<T>& state,
+    const Vector3<T>& gravity,
+    T kick,
+    T drift,
+    std::size_t begin,
+    std::size_t end
+) noexcept
+{
+  const T* inverseMass = state.inverseMasses.data();
+  for (std::size_t tile = begin; tile < end; tile += IntegratorSettings::tileSize) {
+    std::size_t count = std::min(IntegratorSettings::tileSize, end - tile);
+    IntegrateAxis(
+        state.positions.x.data() + tile, state.velocities.x.data() + tile,
+        state.forces.x.data() + tile, inverseMass + tile, gravity.x, kick, drift, count
+    );
+    IntegrateAxis(
+        state.positions.y.data() + tile, state.velocities.y.data() + tile,
+        state.forces.y.data() + tile, inverseMass + tile, gravity.y, kick, drift, count
+    );
+    IntegrateAxis(
+        state.positions.z.data() + tile, state.velocities.z.data() + tile,
+        state.forces.z.data() + tile, inverseMass + tile, gravity.z, kick, drift, count
+    );
+  }
+}
+
+template <typename T>
+T* Axis(Math::Vector3Array<T>& array, u32 axis) noexcept
+{
+  return axis == 0 ? array.x.data() : axis == 1 ? array.y.data() : array.z.data();
+}
+
+/// Per axis arrays of one tile of the Runge-Kutta kernel
+template <typename T, std::size_t Size>
+struct RK4Tile
+{
+  /// 1 for dynamic bodies, 0 for static ones
+  T dynamic[Size];
+  /// Force times inverse mass plus gravity, the same at every stage
+  T constant[3][Size];
+  /// State the field is evaluated at in the current stage
+  T position[3][Size];
+  T velocity[3][Size];
+  T acceleration[3][Size];
+  /// Weighted sums of the stage velocities and accelerations
+  T sumVelocity[3][Size];
+  T sumAcceleration[3][Size];
+};
+
+template <typename T>
+void RK4Start(
+    const T* __restrict position,
+    const T* __restrict velocity,
+    const T* __restrict force,
+    const T* __restrict inverseMass,
+    const T* __restrict dynamic,
+    T gravity,
+    T* __restrict constant,
+    T* __restrict stagePosition,
+    T* __restrict stageVelocity,
+    std::size_t count
+) noexcept
+{
+  for (std::size_t i = 0; i < count; ++i) {
+    constant[i] = force[i] * inverseMass[i] + gravity * dynamic[i];
+    stagePosition[i] = position[i];
+    stageVelocity[i] = velocity[i];
+  }
+}
+
+/// Moves the stage state step ahead along the velocity and acceleration of the previous stage
+template <typename T>
+void RK4Advance(
+    const T* __restrict position,
+    const T* __restrict velocity,
+    const T* __restrict acceleration,
+    T* __restrict stagePosition,
+    T* __restrict stageVelocity,
+    T step,
+    std::size_t count
+) noexcept
+{
+  for (std::size_t i = 0; i < count; ++i) {
+    stagePosition[i] = position[i] + stageVelocity[i] * step;
+    stageVelocity[i] = velocity[i] + acceleration[i] * step;
+  }
+}
+
+template <typename T>
+void RK4Accumulate(
+    const T* __restrict stageVelocity,
+    const T* __restrict acceleration,
+    T* __restrict sumVelocity,
+    T* __restrict sumAcceleration,
+    T weight,
+    bool first,
+    std::size_t count
+) noexcept
+{
+  if (first) {
+    for (std::size_t i = 0; i < count; ++i) {
+      sumVelocity[i] = stageVelocity[i] * weight;
+      sumAcceleration[i] = acceleration[i] * weight;
+    }
+    return;
+  }
+  for (std::size_t i = 0; i < count; ++i) {
+    sumVelocity[i] += stageVelocity[i] * weight;
+    sumAcceleration[i] += acceleration[i] * weight;
+  }
+}
+
+template <typename T>
+void RK4Finish(
+    T* __restrict position,
+    T* __restrict velocity,
+    T* __restrict force,
+    const T* __restrict sumVelocity,
+    const T* __restrict sumAcceleration,
+    T scale,
+    std::size_t count
+) noexcept
+{
+  for (std::size_t i = 0; i < count; ++i) {
+    position[i] += sumVelocity[i] * scale;
+    velocity[i] += sumAcceleration[i] * scale;
+    force[i] = static_cast<T>(0);
+  }
+}
+
+} // namespace Internal
+
+template <typename T>
+void IntegrateSemiImplicitEuler(
+    PhysicsState<T>& state,
+    T dt,
+    const Vector3<T>& gravity,
+    std::size_t begin,
+    std::size_t end
+) noexcept
+{
+  Internal::IntegrateRange(state, gravity, dt, dt, begin, end);
+}
+
+template <typename T>
+void IntegrateSemiImplicitEuler(
+    PhysicsState<T>& state,
+    T dt,
+    const Vector3<T>& gravity,
+    Parallel::ThreadPool& pool,
+    std::size_t grain
+) noexcept
+{
+  pool.ParallelFor(state.Size(), grain, [&](std::size_t begin, std::size_t end) {
+    IntegrateSemiImplicitEuler(state, dt, gravity, begin, end);
+  });
+}
+
+template <typename T>
+void IntegrateVerletBegin(
+    PhysicsState<T>& state,
+    T dt,
+    const Vector3<T>& gravity,
+    std::size_t begin,
+    std::size_t end
+) noexcept
+{
+  Internal::IntegrateRange(state, gravity, dt * static_cast<T>(0.5), dt, begin, end);
+}
+
+template <typename T>
+void IntegrateVerletBegin(
+    PhysicsState<T>& state,
+    T dt,
+    const Vector3<T>& gravity,
+    Parallel::ThreadPool& pool,
+    std::size_t grain
+) noexcept
+{
+  pool.ParallelFor(state.Size(), grain, [&](std::size_t begin, std::size_t end) {
+    IntegrateVerletBegin(state, dt, gravity, begin, end);
+  });
+}
+
+template <typename T>
+void IntegrateVerletEnd(
+    PhysicsState<T>& state,
+    T dt,
+    const Vector3<T>& gravity,
+    std::size_t begin,
+    std::size_t end
+) noexcept
+{
+  T kick = dt * static_cast<T>(0.5);
+  Internal::IntegrateRange(state, gravity, kick, static_cast<T>(0), begin, end);
+}
+
+template <typename T>
+void IntegrateVerletEnd(
+    PhysicsState<T>& state,
+    T dt,
+    const Vector3<T>& gravity,
+    Parallel::ThreadPool& pool,
+    std::size_t grain
+) noexcept
+{
+  pool.ParallelFor(state.Size(), grain, [&](std::size_t begin, std::size_t end) {
+    IntegrateVerletEnd(state, dt, gravity, begin, end);
+  });
+}
+
+template <typename T, typename Field>
+void IntegrateRK4(
+    PhysicsState<T>& state,
+    T dt,
+    const Vector3<T>& gravity,
+    const Field& field,
+    std::size_t begin,
+    std::size_t end
+) noexcept
+{
+  constexpr std::size_t tileSize = IntegratorSettings::rk4TileSize;
+  const T half = dt * static_cast<T>(0.5);
+  const T sixth = dt / static_cast<T>(6);
+  const T gravityAxes[3] = {gravity.x, gravity.y, gravity.z};
+  const T* inverseMass = state.inverseMasses.data();
+  Internal::RK4Tile<T, tileSize> t;
+
+  for (std::size_t tile = begin; tile < end; tile += tileSize) {
+    std::size_t count = std::min(tileSize, end - tile);
+    for (std::size_t i = 0; i < count; ++i)
+      t.dynamic[i] = inverseMass[tile + i] > 0 ? static_cast<T>(1) : static_cast<T>(0);
+    for (u32 axis = 0; axis < 3; ++axis) {
+      const T* x = Internal::Axis(state.positions, axis) + tile;
+      const T* v = Internal::Axis(state.velocities, axis) + tile;
+      const T* f = Internal::Axis(state.forces, axis) + tile;
+      Internal::RK4Start(
+          x, v, f, inverseMass + tile, t.dynamic, gravityAxes[axis], t.constant[axis],
+          t.position[axis], t.velocity[axis], count
+      );
+    }
+
+    // k1 at the start, k2 and k3 half a step ahead, k4 a whole step ahead
+    const T steps[4] = {0, half, half, dt};
+    const T weights[4] = {1, 2, 2, 1};
+    for (u32 stage = 0; stage < 4; ++stage) {
+      if (stage > 0) {
+        for (u32 axis = 0; axis < 3; ++axis) {
+          Internal::RK4Advance(
+              Internal::Axis(state.positions, axis) + tile,
+              Internal::Axis(state.velocities, axis) + tile, t.acceleration[axis],
+              t.position[axis], t.velocity[axis], steps[stage], count
+          );
+        }
+      }
+      // the field is an arbitrary functor, only this loop is scalar
+      for (std::size_t i = 0; i < count; ++i) {
+        Vector3<T> a = field(
+            tile + i, Vector3<T>(t.position[0][i], t.position[1][i], t.position[2][i]),
+            Vector3<T>(t.velocity[0][i], t.velocity[1][i], t.velocity[2][i])
+        );
+        t.acceleration[0][i] = t.constant[0][i] + a.x * t.dynamic[i];
+        t.acceleration[1][i] = t.constant[1][i] + a.y * t.dynamic[i];
+        t.acceleration[2][i] = t.constant[2][i] + a.z * t.dynamic[i];
+      }
+      for (u32 axis = 0; axis < 3; ++axis) {
+        Internal::RK4Accumulate(
+            t.velocity[axis], t.acceleration[axis], t.sumVelocity[axis],
+            t.sumAcceleration[axis], weights[stage], stage == 0, count
+        );
+      }
+    }
+
+    for (u32 axis = 0; axis < 3; ++axis) {
+      Internal::RK4Finish(
+          Internal::Axis(state.positions, axis) + tile,
+          Internal::Axis(state.velocities, axis) + tile,
+          Internal::Axis(state.forces, axis) + tile, t.sumVelocity[axis],
+          t.sumAcceleration[axis], sixth, count
+      );
+    }
+  }
+}
+
+template <typename T, typename Field>
+void IntegrateRK4(
+    PhysicsState<T>& state,
+    T dt,
+    const Vector3<T>& gravity,
+    const Field& field,
+    Parallel::ThreadPool& pool,
+    std::size_t grain
+) noexcept
+{
+  pool.ParallelFor(state.Size(), grain, [&](std::size_t begin, std::size_t end) {
+    IntegrateRK4(state, dt, gravity, field, begin, end);
+  });
+}
+
+} // namespace Engine::Core::Physics
@@ -0,0 +1,10 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file PhysicsState.cpp
+ * @brief All implementation contains in header file PhysicsState.h
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include "core/physics/PhysicsState.h"
@@ -0,0 +1,124 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file PhysicsState.h
+ * @brief Structure of arrays storage of body positions, velocities, forces and inverse masses
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/math/Vector3.h"
+#include "core/math/Vector3Array.h"
+#include "core/memory/AlignedAllocator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace Engine::Core::Physics
+{
+
+using Math::Vector3;
+using Math::Vector3Array;
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+template <typename T>
+class PhysicsState
+{
+ public:
+  Vector3Array<T> positions;
+  Vector3Array<T> velocities;
+  /// Forces accumulated for the next step, integrators reset them to zero
+  Vector3Array<T> forces;
+  /// Zero inverse mass makes body static
+  std::vector<T, Memory::AlignedAllocator<T>> inverseMasses;
+
+  std::size_t Size() const noexcept;
+  void Reserve(std::size_t count) noexcept;
+  void Clear() noexcept;
+
+  /// Adds body and returns its index, zero mass adds static body
+  std::size_t Add(const Vector3<T>& position, const Vector3<T>& velocity, T mass) noexcept;
+  /// Removes body by moving the last body into its index
+  void RemoveSwap(std::size_t index) noexcept;
+
+  void ApplyForce(std::size_t index, const Vector3<T>& force) noexcept;
+  void ClearForces() noexcept;
+};
+
+/* ------------------------------------------- Usings ------------------------------------------ */
+using PhysicsStatef = PhysicsState<f32>;
+using PhysicsStated = PhysicsState<f64>;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+template <typename T>
+std::size_t PhysicsState<T>::Size() const noexcept
+{
+  return inverseMasses.size();
+}
+
+template <typename T>
+void PhysicsState<T>::Reserve(std::size_t count) noexcept
+{
+  positions.Reserve(count);
+  velocities.Reserve(count);
+  forces.Reserve(count);
+  inverseMasses.reserve(count);
+}
+
+template <typename T>
+void PhysicsState<T>::Clear() noexcept
+{
+  positions.Clear();
+  velocities.Clear();
+  forces.Clear();
+  inverseMasses.clear();
+}
+
+template <typename T>
+std::size_t PhysicsState<T>::Add(
+    const Vector3<T>& position,
+    const Vector3<T>& velocity,
+    T mass
+) noexcept
+{
+  positions.PushBack(position);
+  velocities.PushBack(velocity);
+  forces.PushBack(Vector3<T>());
+  inverseMasses.push_back(mass > static_cast<T>(0) ? static_cast<T>(1) / mass : static_cast<T>(0));
+  return inverseMasses.size() - 1;
+}
+
+template <typename T>
+void PhysicsState<T>::RemoveSwap(std::size_t index) noexcept
+{
+  assert(index < Size() && "Index out of range");
+  positions.RemoveSwap(index);
+  velocities.RemoveSwap(index);
+  forces.RemoveSwap(index);
+  inverseMasses[index] = inverseMasses.back();
+  inverseMasses.pop_back();
+}
+
+template <typename T>
+void PhysicsState<T>::ApplyForce(std::size_t index, const Vector3<T>& force) noexcept
+{
+  assert(index < Size() && "Index out of range");
+  forces.x[index] += force.x;
+  forces.y[index] += force.y;
+  forces.z[index] += force.z;
+}
+
+template <typename T>
+void PhysicsState<T>::ClearForces() noexcept
+{
+  std::fill(forces.x.begin(), forces.x.end(), static_cast<T>(0));
+  std::fill(forces.y.begin(), forces.y.end(), static_cast<T>(0));
+  std::fill(forces.z.begin(), forces.z.end(), static_cast<T>(0));
+}
+
+} // namespace Engine::Core::Physics
@@ -0,0 +1,237 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Shapes.h
+ * @brief Convex shapes used by narrowphase collision detection
+ *
+ * Every shape is described in world space and provides Support(direction) which returns the point
+ * of the shape farthest along the direction. Direction is not required to be normalized.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/math/Vector3.h"
+
+#include <cstddef>
+#include <limits>
+
+namespace Engine::Core::Physics
+{
+
+using Math::Vector3;
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+template <typename T>
+class Sphere
+{
+ public:
+  Vector3<T> center;
+  T radius;
+
+  constexpr Sphere() noexcept;
+  constexpr Sphere(const Vector3<T>& center, T radius) noexcept;
+
+  constexpr Vector3<T> Support(const Vector3<T>& direction) const noexcept;
+};
+
+template <typename T>
+class Box
+{
+ public:
+  Vector3<T> center;
+  Vector3<T> halfExtents;
+  /// Orthonormal local axes of the box
+  Vector3<T> axes[3];
+
+  constexpr Box() noexcept;
+  constexpr Box(const Vector3<T>& center, const Vector3<T>& halfExtents) noexcept;
+  constexpr Box(
+      const Vector3<T>& center,
+      const Vector3<T>& halfExtents,
+      const Vector3<T>& axisX,
+      const Vector3<T>& axisY,
+      const Vector3<T>& axisZ
+  ) noexcept;
+
+  constexpr Vector3<T> Support(const Vector3<T>& direction) const noexcept;
+};
+
+template <typename T>
+class Capsule
+{
+ public:
+  Vector3<T> a;
+  Vector3<T> b;
+  T radius;
+
+  constexpr Capsule() noexcept;
+  constexpr Capsule(const Vector3<T>& a, const Vector3<T>& b, T radius) noexcept;
+
+  constexpr Vector3<T> Support(const Vector3<T>& direction) const noexcept;
+};
+
+/**
+ * @brief Convex hull over external vertex storage
+ *
+ * The hull does not own vertices, they must outlive the shape. Vertices are given in local space
+ * and translated by position.
+ */
+template <typename T>
+class ConvexHull
+{
+ public:
+  const Vector3<T>* vertices;
+  std::size_t count;
+  Vector3<T> position;
+
+  constexpr ConvexHull() noexcept;
+  constexpr ConvexHull(
+      const Vector3<T>* vertices,
+      std::size_t count,
+      const Vector3<T>& position = Vector3<T>()
+  ) noexcept;
+
+  constexpr Vector3<T> Support(const Vector3<T>& direction) const noexcept;
+};
+
+/* ------------------------------------------- Usings ------------------------------------------ */
+using Spheref = Sphere<f32>;
+using Sphered = Sphere<f64>;
+using Boxf = Box<f32>;
+using Boxd = Box<f64>;
+using Capsulef = Capsule<f32>;
+using Capsuled = Capsule<f64>;
+using ConvexHullf = ConvexHull<f32>;
+using ConvexHulld = ConvexHull<f64>;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+template <typename T>
+constexpr Sphere<T>::Sphere() noexcept
+    : center(),
+      radius(static_cast<T>(0))
+{
+}
+
+template <typename T>
+constexpr Sphere<T>::Sphere(const Vector3<T>& center, T radius) noexcept
+    : center(center),
+      radius(radius)
+{
+}
+
+template <typename T>
+constexpr Vector3<T> Sphere<T>::Support(const Vector3<T>& direction) const noexcept
+{
+  T length = direction.Length();
+  if (length > std::numeric_limits<T>::epsilon())
+    return center + direction * (radius / length);
+  return center + Vector3<T>::UnitX() * radius;
+}
+
+template <typename T>
+constexpr Box<T>::Box() noexcept
+    : center(),
+      halfExtents(),
+      axes{Vector3<T>::UnitX(), Vector3<T>::UnitY(), Vector3<T>::UnitZ()}
+{
+}
+
+template <typename T>
+constexpr Box<T>::Box(const Vector3<T>& center, const Vector3<T>& halfExtents) noexcept
+    : center(center),
+      halfExtents(halfExtents),
+      axes{Vector3<T>::UnitX(), Vector3<T>::UnitY(), Vector3<T>::UnitZ()}
+{
+}
+
+template <typename T>
+constexpr Box<T>::Box(
+    const Vector3<T>& center,
+    const Vector3<T>& halfExtents,
+    const Vector3<T>& axisX,
+    const Vector3<T>& axisY,
+    const Vector3<T>& axisZ
+) noexcept
+    : center(center),
+      halfExtents(halfExtents),
+      axes{axisX, axisY, axisZ}
+{
+}
+
+template <typename T>
+constexpr Vector3<T> Box<T>::Support(const Vector3<T>& direction) const noexcept
+{
+  T hx = direction.Dot(axes[0]) >= static_cast<T>(0) ? halfExtents.x : -halfExtents.x;
+  T hy = direction.Dot(axes[1]) >= static_cast<T>(0) ? halfExtents.y : -halfExtents.y;
+  T hz = direction.Dot(axes[2]) >= static_cast<T>(0) ? halfExtents.z : -halfExtents.z;
+  return center + axes[0] * hx + axes[1] * hy + axes[2] * hz;
+}
+
+template <typename T>
+constexpr Capsule<T>::Capsule() noexcept
+    : a(),
+      b(),
+      radius(static_cast<T>(0))
+{
+}
+
+template <typename T>
+constexpr Capsule<T>::Capsule(const Vector3<T>& a, const Vector3<T>& b, T radius) noexcept
+    : a(a),
+      b(b),
+      radius(radius)
+{
+}
+
+template <typename T>
+constexpr Vector3<T> Capsule<T>::Support(const Vector3<T>& direction) const noexcept
+{
+  const Vector3<T>& end = direction.Dot(b - a) >= static_cast<T>(0) ? b : a;
+  T length = direction.Length();
+  if (length > std::numeric_limits<T>::epsilon())
+    return end + direction * (radius / length);
+  return end + Vector3<T>::UnitX() * radius;
+}
+
+template <typename T>
+constexpr ConvexHull<T>::ConvexHull() noexcept
+    : vertices(nullptr),
+      count(0),
+      position()
+{
+}
+
+template <typename T>
+constexpr ConvexHull<T>::ConvexHull(
+    const Vector3<T>* vertices,
+    std::size_t count,
+    const Vector3<T>& position
+) noexcept
+    : vertices(vertices),
+      count(count),
+      position(position)
+{
+}
+
+template <typename T>
+constexpr Vector3<T> ConvexHull<T>::Support(const Vector3<T>& direction) const noexcept
+{
+  if (count == 0)
+    return position;
+
+  std::size_t best = 0;
+  T bestDot = direction.Dot(vertices[0]);
+  for (std::size_t i = 1; i < count; ++i) {
+    T dot = direction.Dot(vertices[i]);
+    if (dot > bestDot) {
+      bestDot = dot;
+      best = i;
+    }
+  }
+  return position + vertices[best];
+}
+
+} // namespace Engine::Core::Physics
@@ -0,0 +1,10 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file SweepAndPrune.cpp
+ * @brief All implementation contains in header file SweepAndPrune.h
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include "core/physics/SweepAndPrune.h"
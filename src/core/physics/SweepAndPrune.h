@@ -0,0 +1,415 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file SweepAndPrune.h
+ * @brief Sweep and prune broadphase with incremental sorted axis updates
+ *
+ * Box endpoints are kept sorted along the axes between updates. Bodies usually move a little per
+ * tick, so the insertion sort on the nearly sorted arrays costs close to O(n). In ThreeAxes mode
+ * every swap of a min and a max endpoint is an overlap change of the two bodies on that axis, so
+ * the pair set is patched in place and never rebuilt. SingleAxis mode keeps one axis sorted and
+ * sweeps it every update, which is cheaper when bodies move a lot.
+ *
+ * Bodies added since the last update are not run through the insertion sort, which would cost
+ * O(n^2) for a bulk add. Their endpoints are sorted on their own and merged into the axes, and
+ * their pairs are found by one sweep that tests only pairs with at least one new body.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/math/AABB.h"
+#include "core/math/Vector3.h"
+
+#include <algorithm>
+#include <cassert>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine::Core::Physics
+{
+
+using Math::AABB;
+using Math::Vector3;
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+struct BroadphasePair
+{
+  u32 a;
+  u32 b;
+};
+
+enum class SweepAndPruneMode : u8
+{
+  SingleAxis,
+  ThreeAxes
+};
+
+template <typename T>
+class SweepAndPrune
+{
+ public:
+  using Handle = u32;
+
+  static constexpr Handle invalidHandle = ~Handle(0);
+
+  explicit SweepAndPrune(
+      SweepAndPruneMode mode = SweepAndPruneMode::ThreeAxes,
+      u32 sweepAxis = 0
+  ) noexcept;
+
+  Handle Add(const AABB<T>& box) noexcept;
+  void Remove(Handle handle) noexcept;
+  /// Stores new bounds, sorted axes and pairs are updated by the next Update call
+  void SetBounds(Handle handle, const AABB<T>& box) noexcept;
+  const AABB<T>& GetBounds(Handle handle) const noexcept;
+
+  /// Re-sorts endpoints and brings the pair set in line with current bounds
+  void Update() noexcept;
+
+  /// Overlapping pairs with a < b, in no particular order
+  const std::vector<BroadphasePair>& Pairs() const noexcept;
+  u32 Size() const noexcept;
+
+ private:
+  struct Endpoint
+  {
+    T value;
+    /// Handle in the upper bits, 1 in the lowest bit for max endpoint
+    u32 data;
+
+    Handle GetHandle() const noexcept { return data >> 1; }
+    bool IsMax() const noexcept { return data & 1u; }
+  };
+
+  static T Axis(const Vector3<T>& v, u32 axis) noexcept;
+  static u64 Key(Handle a, Handle b) noexcept;
+  static bool Less(const Endpoint& lhs, const Endpoint& rhs) noexcept;
+
+  void AddPair(Handle a, Handle b) noexcept;
+  void RemovePair(Handle a, Handle b) noexcept;
+  void RemovePairsOf(Handle handle) noexcept;
+  void SortAxis(u32 axis, bool trackPairs) noexcept;
+  void MergeAdded(u32 axis) noexcept;
+  void SweepAxis(u32 axis) noexcept;
+  void SweepAdded(u32 axis) noexcept;
+
+  SweepAndPruneMode mode;
+  u32 sweepAxis;
+  u32 count;
+  std::vector<AABB<T>> bounds;
+  std::vector<bool> alive;
+  /// Bodies whose endpoints are still waiting in added
+  std::vector<bool> fresh;
+  u32 freshCount;
+  std::vector<Handle> freeHandles;
+  std::vector<Endpoint> endpoints[3];
+  std::vector<Endpoint> added[3];
+  std::vector<BroadphasePair> pairs;
+  std::unordered_map<u64, u32> pairIndex;
+  std::vector<Handle> active;
+  std::vector<Handle> activeFresh;
+};
+
+/* ------------------------------------------- Usings ------------------------------------------ */
+using SweepAndPrunef = SweepAndPrune<f32>;
+using SweepAndPruned = SweepAndPrune<f64>;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+template <typename T>
+SweepAndPrune<T>::SweepAndPrune(SweepAndPruneMode mode, u32 sweepAxis) noexcept
+    : mode(mode),
+      sweepAxis(sweepAxis < 3 ? sweepAxis : 0),
+      count(0),
+      freshCount(0)
+{
+}
+
+template <typename T>
+typename SweepAndPrune<T>::Handle SweepAndPrune<T>::Add(const AABB<T>& box) noexcept
+{
+  Handle handle;
+  if (!freeHandles.empty()) {
+    handle = freeHandles.back();
+    freeHandles.pop_back();
+    bounds[handle] = box;
+    alive[handle] = true;
+    fresh[handle] = true;
+  } else {
+    handle = static_cast<Handle>(bounds.size());
+    bounds.push_back(box);
+    alive.push_back(true);
+    fresh.push_back(true);
+  }
+  ++count;
+  ++freshCount;
+
+  // values are read from bounds when the next update merges the endpoints into the axis
+  for (u32 axis = 0; axis < 3; ++axis) {
+    if (mode == SweepAndPruneMode::SingleAxis && axis != sweepAxis)
+      continue;
+    added[axis].push_back({T(0), handle << 1});
+    added[axis].push_back({T(0), (handle << 1) | 1u});
+  }
+  return handle;
+}
+
+template <typename T>
+void SweepAndPrune<T>::Remove(Handle handle) noexcept
+{
+  assert(handle < bounds.size() && alive[handle] && "Invalid handle");
+  if (handle >= bounds.size() || !alive[handle])
+    return;
+
+  std::vector<Endpoint>* lists = fresh[handle] ? added : endpoints;
+  for (u32 axis = 0; axis < 3; ++axis) {
+    std::vector<Endpoint>& list = lists[axis];
+    std::size_t write = 0;
+    for (std::size_t read = 0; read < list.size(); ++read)
+      if (list[read].GetHandle() != handle)
+        list[write++] = list[read];
+    list.resize(write);
+  }
+
+  if (fresh[handle]) {
+    fresh[handle] = false;
+    --freshCount;
+  } else {
+    RemovePairsOf(handle);
+  }
+  alive[handle] = false;
+  freeHandles.push_back(handle);
+  --count;
+}
+
+template <typename T>
+void SweepAndPrune<T>::SetBounds(Handle handle, const AABB<T>& box) noexcept
+{
+  assert(handle < bounds.size() && alive[handle] && "Invalid handle");
+  bounds[handle] = box;
+}
+
+template <typename T>
+const AABB<T>& SweepAndPrune<T>::GetBounds(Handle handle) const noexcept
+{
+  assert(handle < bounds.size() && alive[handle] && "Invalid handle");
+  return bounds[handle];
+}
+
+template <typename T>
+void SweepAndPrune<T>::Update() noexcept
+{
+  if (mode == SweepAndPruneMode::ThreeAxes) {
+    for (u32 axis = 0; axis < 3; ++axis) {
+      SortAxis(axis, true);
+      MergeAdded(axis);
+    }
+    if (freshCount > 0)
+      SweepAdded(sweepAxis);
+  } else {
+    SortAxis(sweepAxis, false);
+    MergeAdded(sweepAxis);
+    SweepAxis(sweepAxis);
+  }
+
+  if (freshCount > 0) {
+    std::fill(fresh.begin(), fresh.end(), false);
+    freshCount = 0;
+  }
+}
+
+template <typename T>
+const std::vector<BroadphasePair>& SweepAndPrune<T>::Pairs() const noexcept
+{
+  return pairs;
+}
+
+template <typename T>
+u32 SweepAndPrune<T>::Size() const noexcept
+{
+  return count;
+}
+
+template <typename T>
+T SweepAndPrune<T>::Axis(const Vector3<T>& v, u32 axis) noexcept
+{
+  return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+template <typename T>
+u64 SweepAndPrune<T>::Key(Handle a, Handle b) noexcept
+{
+  return a < b ? (static_cast<u64>(a) << 32) | b : (static_cast<u64>(b) << 32) | a;
+}
+
+template <typename T>
+bool SweepAndPrune<T>::Less(const Endpoint& lhs, const Endpoint& rhs) noexcept
+{
+  // on equal values min goes first, so touching boxes are reported as overlapping
+  return lhs.value < rhs.value || (lhs.value == rhs.value && !lhs.IsMax() && rhs.IsMax());
+}
+
+template <typename T>
+void SweepAndPrune<T>::AddPair(Handle a, Handle b) noexcept
+{
+  bool inserted = pairIndex.emplace(Key(a, b), static_cast<u32>(pairs.size())).second;
+  if (inserted)
+    pairs.push_back(a < b ? BroadphasePair{a, b} : BroadphasePair{b, a});
+}
+
+template <typename T>
+void SweepAndPrune<T>::RemovePair(Handle a, Handle b) noexcept
+{
+  auto it = pairIndex.find(Key(a, b));
+  if (it == pairIndex.end())
+    return;
+
+  u32 index = it->second;
+  pairIndex.erase(it);
+  if (index + 1 != pairs.size()) {
+    pairs[index] = pairs.back();
+    pairIndex[Key(pairs[index].a, pairs[index].b)] = index;
+  }
+  pairs.pop_back();
+}
+
+template <typename T>
+void SweepAndPrune<T>::RemovePairsOf(Handle handle) noexcept
+{
+  std::size_t write = 0;
+  for (std::size_t read = 0; read < pairs.size(); ++read) {
+    const BroadphasePair pair = pairs[read];
+    if (pair.a == handle || pair.b == handle) {
+      pairIndex.erase(Key(pair.a, pair.b));
+      continue;
+    }
+    if (write != read) {
+      auto it = pairIndex.find(Key(pair.a, pair.b));
+      if (it != pairIndex.end())
+        it->second = static_cast<u32>(write);
+    }
+    pairs[write++] = pair;
+  }
+  pairs.resize(write);
+}
+
+template <typename T>
+void SweepAndPrune<T>::SortAxis(u32 axis, bool trackPairs) noexcept
+{
+  std::vector<Endpoint>& list = endpoints[axis];
+  for (Endpoint& endpoint : list) {
+    const AABB<T>& box = bounds[endpoint.GetHandle()];
+    endpoint.value = Axis(endpoint.IsMax() ? box.max : box.min, axis);
+  }
+
+  for (std::size_t i = 1; i < list.size(); ++i) {
+    Endpoint key = list[i];
+    std::size_t j = i;
+    while (j > 0 && Less(key, list[j - 1])) {
+      const Endpoint& other = list[j - 1];
+      if (trackPairs && key.IsMax() != other.IsMax()) {
+        Handle a = key.GetHandle();
+        Handle b = other.GetHandle();
+        // min passing max to the left starts overlap on this axis, max passing min ends it
+        if (!key.IsMax()) {
+          if (bounds[a].Overlaps(bounds[b]))
+            AddPair(a, b);
+        } else {
+          RemovePair(a, b);
+        }
+      }
+      list[j] = other;
+      --j;
+    }
+    list[j] = key;
+  }
+}
+
+template <typename T>
+void SweepAndPrune<T>::MergeAdded(u32 axis) noexcept
+{
+  std::vector<Endpoint>& list = endpoints[axis];
+  std::vector<Endpoint>& tail = added[axis];
+  if (tail.empty())
+    return;
+
+  for (Endpoint& endpoint : tail) {
+    const AABB<T>& box = bounds[endpoint.GetHandle()];
+    endpoint.value = Axis(endpoint.IsMax() ? box.max : box.min, axis);
+  }
+  std::sort(tail.begin(), tail.end(), Less);
+
+  std::size_t sorted = list.size();
+  list.insert(list.end(), tail.begin(), tail.end());
+  std::inplace_merge(list.begin(), list.begin() + sorted, list.end(), Less);
+  tail.clear();
+}
+
+template <typename T>
+void SweepAndPrune<T>::SweepAxis(u32 axis) noexcept
+{
+  pairs.clear();
+  pairIndex.clear();
+  active.clear();
+
+  for (const Endpoint& endpoint : endpoints[axis]) {
+    Handle handle = endpoint.GetHandle();
+    if (endpoint.IsMax()) {
+      for (std::size_t i = 0; i < active.size(); ++i) {
+        if (active[i] == handle) {
+          active[i] = active.back();
+          active.pop_back();
+          break;
+        }
+      }
+      continue;
+    }
+
+    const AABB<T>& box = bounds[handle];
+    for (Handle other : active)
+      if (box.Overlaps(bounds[other]))
+        pairs.push_back(handle < other ? BroadphasePair{handle, other}
+                                       : BroadphasePair{other, handle});
+    active.push_back(handle);
+  }
+}
+
+template <typename T>
+void SweepAndPrune<T>::SweepAdded(u32 axis) noexcept
+{
+  // pairs of two old bodies are already tracked by the insertion sort
+  active.clear();
+  activeFresh.clear();
+
+  auto erase = [](std::vector<Handle>& list, Handle handle) {
+    for (std::size_t i = 0; i < list.size(); ++i) {
+      if (list[i] == handle) {
+        list[i] = list.back();
+        list.pop_back();
+        return;
+      }
+    }
+  };
+
+  for (const Endpoint& endpoint : endpoints[axis]) {
+    Handle handle = endpoint.GetHandle();
+    if (endpoint.IsMax()) {
+      erase(active, handle);
+      if (fresh[handle])
+        erase(activeFresh, handle);
+      continue;
+    }
+
+    const AABB<T>& box = bounds[handle];
+    for (Handle other : fresh[handle] ? active : activeFresh)
+      if (box.Overlaps(bounds[other]))
+        AddPair(handle, other);
+    active.push_back(handle);
+    if (fresh[handle])
+      activeFresh.push_back(handle);
+  }
+}
+
+} // namespace Engine::Core::Physics
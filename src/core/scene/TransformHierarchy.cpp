@@ -0,0 +1,10 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file TransformHierarchy.cpp
+ * @brief All implementation contains in header file TransformHierarchy.h
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include "core/scene/TransformHierarchy.h"
@@ -0,0 +1,448 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file TransformHierarchy.h
+ * @brief Parent-child hierarchy of transforms with lazy world transform updates
+ *
+ * Nodes are kept in flat arrays sorted breadth first, so every parent precedes its children and
+ * the nodes of one depth level form a contiguous range. Setting a local transform only flags the
+ * node; Update walks the arrays once starting at the first flagged node, pushes flags down from
+ * parents to children and recomputes world transforms of flagged nodes only. Nodes of one level do
+ * not depend on each other, so a level is split between threads by the parallel form. Changes of
+ * the structure keep the order valid for removals and otherwise re-sort the arrays by depth on the
+ * next Update. Handles stay valid while nodes move in the arrays.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/math/Transform.h"
+#include "core/parallel/ThreadPool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace Engine::Core::Scene
+{
+
+using Math::Transform;
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+struct TransformHierarchySettings
+{
+  /// Levels smaller than this are updated on the calling thread by the parallel form
+  static constexpr std::size_t grain = 4 * 1024;
+};
+
+template <typename T>
+class TransformHierarchy
+{
+ public:
+  using Handle = u32;
+
+  static constexpr Handle invalidHandle = ~Handle(0);
+
+  TransformHierarchy() noexcept;
+
+  /// Adds node as a child of parent or as a root when parent is invalidHandle
+  Handle Add(const Transform<T>& local, Handle parent = invalidHandle) noexcept;
+  /// Removes node together with all its descendants
+  void Remove(Handle handle) noexcept;
+  /// Moves node with its subtree under parent, parent must not be inside the subtree
+  void SetParent(Handle handle, Handle parent) noexcept;
+  Handle GetParent(Handle handle) const noexcept;
+  void Clear() noexcept;
+
+  void SetLocal(Handle handle, const Transform<T>& local) noexcept;
+  const Transform<T>& GetLocal(Handle handle) const noexcept;
+  /// World transform as of the last Update
+  const Transform<T>& GetWorld(Handle handle) const noexcept;
+
+  /// Recomputes world transforms of changed nodes and their descendants
+  void Update() noexcept;
+  void Update(Parallel::ThreadPool& pool, std::size_t grain = TransformHierarchySettings::grain)
+      noexcept;
+
+  u32 Size() const noexcept;
+  /// Number of depth levels, valid after Update
+  u32 LevelCount() const noexcept;
+
+ private:
+  static constexpr u32 invalidIndex = ~u32(0);
+
+  bool IsValid(Handle handle) const noexcept;
+  void MarkDirty(u32 index) noexcept;
+  /// Re-sorts the arrays breadth first and rebuilds level ranges
+  void Linearize() noexcept;
+  /// Level of a node, requires breadth first order
+  u32 LevelOf(u32 index) const noexcept;
+  void UpdateRange(u32 begin, u32 end) noexcept;
+  /// Updates on the calling thread when pool is null
+  void UpdateLevels(Parallel::ThreadPool* pool, std::size_t grain) noexcept;
+
+  /// Arrays in breadth first order, parents hold array indices
+  std::vector<u32> parents;
+  std::vector<Handle> handles;
+  std::vector<Transform<T>> locals;
+  std::vector<Transform<T>> worlds;
+  std::vector<u8> dirty;
+  /// Level i occupies [levels[i], levels[i + 1])
+  std::vector<u32> levels;
+  /// Nodes before it are clean
+  u32 firstDirty;
+  /// False when the arrays are out of breadth first order and levels are stale
+  bool linear;
+
+  /// Array index of every handle, invalidIndex for free handles
+  std::vector<u32> indices;
+  std::vector<Handle> freeHandles;
+};
+
+/* ------------------------------------------- Usings ------------------------------------------ */
+using TransformHierarchyf = TransformHierarchy<f32>;
+using TransformHierarchyd = TransformHierarchy<f64>;
+
+
+/* --------------------------------------- Implementation -------------------------------------- */
+template <typename T>
+TransformHierarchy<T>::TransformHierarchy() noexcept
+{
+  Clear();
+}
+
+template <typename T>
+typename TransformHierarchy<T>::Handle TransformHierarchy<T>::Add(
+    const Transform<T>& local,
+    Handle parent
+) noexcept
+{
+  assert((parent == invalidHandle || IsValid(parent)) && "Invalid parent handle");
+  if (parent != invalidHandle && !IsValid(parent))
+    parent = invalidHandle;
+
+  Handle handle;
+  if (!freeHandles.empty()) {
+    handle = freeHandles.back();
+    freeHandles.pop_back();
+  } else {
+    handle = static_cast<Handle>(indices.size());
+    indices.push_back(invalidIndex);
+  }
+
+  u32 index = static_cast<u32>(parents.size());
+  u32 parentIndex = parent == invalidHandle ? invalidIndex : indices[parent];
+
+  // appending keeps the order only when the node belongs to the last level or starts a new one
+  if (linear) {
+    u32 levelCount = static_cast<u32>(levels.size()) - 1;
+    u32 level = parentIndex == invalidIndex ? 0 : LevelOf(parentIndex) + 1;
+    if (level + 1 == levelCount)
+      ++levels.back();
+    else if (level == levelCount)
+      levels.push_back(index + 1);
+    else
+      linear = false;
+  }
+
+  indices[handle] = index;
+  parents.push_back(parentIndex);
+  handles.push_back(handle);
+  locals.push_back(local);
+  worlds.push_back(local);
+  dirty.push_back(0);
+  MarkDirty(index);
+  return handle;
+}
+
+template <typename T>
+void TransformHierarchy<T>::Remove(Handle handle) noexcept
+{
+  assert(IsValid(handle) && "Invalid handle");
+  if (!IsValid(handle))
+    return;
+  if (!linear)
+    Linearize();
+
+  // descendants follow their parents, so one forward pass from the node finds the whole subtree
+  u32 root = indices[handle];
+  u32 count = static_cast<u32>(parents.size());
+  std::vector<u8> removed(count - root, 0);
+  removed[0] = 1;
+  for (u32 i = root + 1; i < count; ++i) {
+    u32 parent = parents[i];
+    removed[i - root] = parent != invalidIndex && parent >= root && removed[parent - root];
+  }
+
+  // compacting survivors in place preserves the order, remap[i] is the new index of node i or of
+  // the next survivor after it
+  std::vector<u32> remap(count - root + 1);
+  u32 written = root;
+  for (u32 i = root; i < count; ++i) {
+    remap[i - root] = written;
+    Handle nodeHandle = handles[i];
+    if (removed[i - root]) {
+      indices[nodeHandle] = invalidIndex;
+      freeHandles.push_back(nodeHandle);
+      continue;
+    }
+
+    u32 parent = parents[i];
+    parents[written] = parent == invalidIndex || parent < root ? parent : remap[parent - root];
+    handles[written] = nodeHandle;
+    locals[written] = locals[i];
+    worlds[written] = worlds[i];
+    dirty[written] = dirty[i];
+    indices[nodeHandle] = written;
+    ++written;
+  }
+  remap[count - root] = written;
+
+  parents.resize(written);
+  handles.resize(written);
+  locals.resize(written);
+  worlds.resize(written);
+  dirty.resize(written);
+
+  for (u32& level : levels) {
+    if (level > root)
+      level = remap[level - root];
+  }
+  // a level emptied by the removal leaves all deeper levels empty as well
+  while (levels.size() > 1 && levels[levels.size() - 2] == levels.back())
+    levels.pop_back();
+
+  if (firstDirty != invalidIndex && firstDirty > root)
+    firstDirty = remap[firstDirty - root];
+  if (firstDirty >= written)
+    firstDirty = invalidIndex;
+}
+
+template <typename T>
+void TransformHierarchy<T>::SetParent(Handle handle, Handle parent) noexcept
+{
+  assert(IsValid(handle) && "Invalid handle");
+  assert((parent == invalidHandle || IsValid(parent)) && "Invalid parent handle");
+  if (!IsValid(handle) || (parent != invalidHandle && !IsValid(parent)))
+    return;
+
+  u32 index = indices[handle];
+  u32 parentIndex = parent == invalidHandle ? invalidIndex : indices[parent];
+  if (parents[index] == parentIndex)
+    return;
+
+  for (u32 ancestor = parentIndex; ancestor != invalidIndex; ancestor = parents[ancestor]) {
+    assert(ancestor != index && "Parent is inside the subtree of the node");
+    if (ancestor == index)
+      return;
+  }
+
+  parents[index] = parentIndex;
+  linear = false;
+  MarkDirty(index);
+}
+
+template <typename T>
+typename TransformHierarchy<T>::Handle TransformHierarchy<T>::GetParent(Handle handle) const
+    noexcept
+{
+  assert(IsValid(handle) && "Invalid handle");
+  u32 parent = parents[indices[handle]];
+  return parent == invalidIndex ? invalidHandle : handles[parent];
+}
+
+template <typename T>
+void TransformHierarchy<T>::Clear() noexcept
+{
+  parents.clear();
+  handles.clear();
+  locals.clear();
+  worlds.clear();
+  dirty.clear();
+  levels.assign(1, 0);
+  firstDirty = invalidIndex;
+  linear = true;
+  indices.clear();
+  freeHandles.clear();
+}
+
+template <typename T>
+void TransformHierarchy<T>::SetLocal(Handle handle, const Transform<T>& local) noexcept
+{
+  assert(IsValid(handle) && "Invalid handle");
+  if (!IsValid(handle))
+    return;
+
+  u32 index = indices[handle];
+  locals[index] = local;
+  MarkDirty(index);
+}
+
+template <typename T>
+const Transform<T>& TransformHierarchy<T>::GetLocal(Handle handle) const noexcept
+{
+  assert(IsValid(handle) && "Invalid handle");
+  return locals[indices[handle]];
+}
+
+template <typename T>
+const Transform<T>& TransformHierarchy<T>::GetWorld(Handle handle) const noexcept
+{
+  assert(IsValid(handle) && "Invalid handle");
+  return worlds[indices[handle]];
+}
+
+template <typename T>
+void TransformHierarchy<T>::Update() noexcept
+{
+  UpdateLevels(nullptr, 0);
+}
+
+template <typename T>
+void TransformHierarchy<T>::Update(Parallel::ThreadPool& pool, std::size_t grain) noexcept
+{
+  UpdateLevels(&pool, grain);
+}
+
+template <typename T>
+u32 TransformHierarchy<T>::Size() const noexcept
+{
+  return static_cast<u32>(parents.size());
+}
+
+template <typename T>
+u32 TransformHierarchy<T>::LevelCount() const noexcept
+{
+  return static_cast<u32>(levels.size()) - 1;
+}
+
+template <typename T>
+bool TransformHierarchy<T>::IsValid(Handle handle) const noexcept
+{
+  return handle < indices.size() && indices[handle] != invalidIndex;
+}
+
+template <typename T>
+void TransformHierarchy<T>::MarkDirty(u32 index) noexcept
+{
+  dirty[index] = 1;
+  firstDirty = std::min(firstDirty, index);
+}
+
+template <typename T>
+void TransformHierarchy<T>::Linearize() noexcept
+{
+  u32 count = static_cast<u32>(parents.size());
+
+  // depth of every node, walking up to the nearest ancestor with a known depth
+  std::vector<u32> depths(count, invalidIndex);
+  std::vector<u32> path;
+  u32 levelCount = 0;
+  for (u32 i = 0; i < count; ++i) {
+    u32 node = i;
+    while (node != invalidIndex && depths[node] == invalidIndex) {
+      path.push_back(node);
+      node = parents[node];
+    }
+    u32 depth = node == invalidIndex ? 0 : depths[node] + 1;
+    for (auto it = path.rbegin(); it != path.rend(); ++it)
+      depths[*it] = depth++;
+    levelCount = std::max(levelCount, depth);
+    path.clear();
+  }
+
+  // counting sort by depth, stable so that siblings keep their relative order
+  levels.assign(levelCount + 1, 0);
+  for (u32 i = 0; i < count; ++i)
+    ++levels[depths[i] + 1];
+  for (u32 level = 0; level < levelCount; ++level)
+    levels[level + 1] += levels[level];
+
+  std::vector<u32> order(levels.begin(), levels.end() - 1);
+  std::vector<u32> newIndices(count);
+  for (u32 i = 0; i < count; ++i)
+    newIndices[i] = order[depths[i]]++;
+
+  std::vector<u32> sortedParents(count);
+  std::vector<Handle> sortedHandles(count);
+  std::vector<Transform<T>> sortedLocals(count);
+  std::vector<Transform<T>> sortedWorlds(count);
+  std::vector<u8> sortedDirty(count);
+  firstDirty = invalidIndex;
+  for (u32 i = 0; i < count; ++i) {
+    u32 index = newIndices[i];
+    sortedParents[index] = parents[i] == invalidIndex ? invalidIndex : newIndices[parents[i]];
+    sortedHandles[index] = handles[i];
+    sortedLocals[index] = locals[i];
+    sortedWorlds[index] = worlds[i];
+    sortedDirty[index] = dirty[i];
+    indices[handles[i]] = index;
+    if (dirty[i])
+      firstDirty = std::min(firstDirty, index);
+  }
+
+  parents.swap(sortedParents);
+  handles.swap(sortedHandles);
+  locals.swap(sortedLocals);
+  worlds.swap(sortedWorlds);
+  dirty.swap(sortedDirty);
+  linear = true;
+}
+
+template <typename T>
+u32 TransformHierarchy<T>::LevelOf(u32 index) const noexcept
+{
+  auto next = std::upper_bound(levels.begin(), levels.end(), index);
+  return static_cast<u32>(next - levels.begin()) - 1;
+}
+
+template <typename T>
+void TransformHierarchy<T>::UpdateRange(u32 begin, u32 end) noexcept
+{
+  for (u32 i = begin; i < end; ++i) {
+    u32 parent = parents[i];
+    if (parent == invalidIndex) {
+      if (dirty[i])
+        worlds[i] = locals[i];
+      continue;
+    }
+    // parents belong to the previous level, which is already updated
+    dirty[i] |= dirty[parent];
+    if (dirty[i])
+      worlds[i] = worlds[parent] * locals[i];
+  }
+}
+
+template <typename T>
+void TransformHierarchy<T>::UpdateLevels(Parallel::ThreadPool* pool, std::size_t grain) noexcept
+{
+  if (!linear)
+    Linearize();
+
+  u32 count = static_cast<u32>(parents.size());
+  if (firstDirty >= count) {
+    firstDirty = invalidIndex;
+    return;
+  }
+
+  u32 levelCount = LevelCount();
+  for (u32 level = LevelOf(firstDirty); level < levelCount; ++level) {
+    u32 begin = std::max(levels[level], firstDirty);
+    u32 end = levels[level + 1];
+    if (pool && end - begin >= 2 * std::max<std::size_t>(grain, 1)) {
+      pool->ParallelFor(end - begin, grain, [this, begin](std::size_t first, std::size_t last) {
+        UpdateRange(begin + static_cast<u32>(first), begin + static_cast<u32>(last));
+      });
+    } else {
+      UpdateRange(begin, end);
+    }
+  }
+
+  std::fill(dirty.begin() + firstDirty, dirty.end(), 0);
+  firstDirty = invalidIndex;
+}
+
+} // namespace Engine::Core::Scene
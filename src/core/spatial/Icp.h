@@ -0,0 +1,538 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Icp.h
+ * @brief Rigid registration of point sets with iterative closest point
+ *
+ * The target is indexed once by a KdTree and can be registered against any number of sources.
+ * Every iteration moves the source by the current estimate, finds the closest target point of
+ * every source point in parallel and accumulates the moments of the accepted pairs per block.
+ * Point-to-point ICP solves the best rotation in closed form as the dominant eigenvector of Horn's
+ * 4x4 quaternion matrix. Point-to-plane ICP linearizes the rotation and solves the 6x6 normal
+ * equations of the distances to the target tangent planes, which needs target normals and
+ * converges in far fewer iterations on smooth surfaces. Blocks have a fixed size and are summed
+ * in order, so the parallel form returns exactly the serial result.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/math/Quaternion.h"
+#include "core/math/SmallMatrix.h"
+#include "core/math/Transform.h"
+#include "core/math/Vector3.h"
+#include "core/parallel/ThreadPool.h"
+#include "core/spatial/KdTree.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace Engine::Core::Spatial
+{
+
+using Math::Quaternion;
+using Math::Transform;
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+struct IcpSettings
+{
+  /// Default number of source points in one chunk of the parallel forms
+  static constexpr std::size_t grain = 4096;
+  /// Neighbors fitted by EstimateNormals by default
+  static constexpr std::size_t normalNeighbors = 8;
+};
+
+enum class IcpMetric
+{
+  PointToPoint,
+  PointToPlane
+};
+
+template <typename T>
+struct IcpOptions
+{
+  IcpMetric metric = IcpMetric::PointToPoint;
+  u32 maxIterations = 30;
+  /// Pairs farther apart are ignored, bounds the influence of points without a counterpart
+  T maxDistance = std::numeric_limits<T>::max();
+  /// Stops when an iteration moves the source by less than this distance and angle in radians
+  T tolerance = static_cast<T>(1e-6);
+};
+
+template <typename T>
+struct IcpResult
+{
+  /// Maps source points onto the target
+  Transform<T> transform;
+  /// Root mean square point or plane distance of the pairs of the last iteration
+  T rmsError;
+  /// Accepted pairs of the last iteration
+  std::size_t correspondences;
+  u32 iterations;
+  /// False when the iteration limit was hit or there were too few pairs to solve
+  bool converged;
+};
+
+template <typename T>
+class Icp
+{
+ public:
+  /**
+   * @brief Indexes target points, a copy is kept
+   * @param normals unit normals of target points, required for IcpMetric::PointToPlane
+   */
+  void SetTarget(
+      const Vector3<T>* points,
+      std::size_t count,
+      const Vector3<T>* normals = nullptr
+  ) noexcept;
+  void SetTarget(
+      const Vector3<T>* points,
+      std::size_t count,
+      const Vector3<T>* normals,
+      Parallel::ThreadPool& pool
+  ) noexcept;
+
+  std::size_t TargetSize() const noexcept;
+  bool HasNormals() const noexcept;
+
+  /// Refines initial, the transform taking source onto the target
+  IcpResult<T> Align(
+      const Vector3<T>* source,
+      std::size_t count,
+      const Transform<T>& initial = Transform<T>::Identity(),
+      const IcpOptions<T>& options = IcpOptions<T>()
+  ) noexcept;
+  IcpResult<T> Align(
+      const Vector3<T>* source,
+      std::size_t count,
+      const Transform<T>& initial,
+      const IcpOptions<T>& options,
+      Parallel::ThreadPool& pool,
+      std::size_t grain = IcpSettings::grain
+  ) noexcept;
+
+ private:
+  /// Moments of the accepted pairs of one block
+  struct Sums
+  {
+    f64 count;
+    f64 error;
+    /// Point-to-point: sums of source and target points and of their outer products
+    f64 source[3];
+    f64 target[3];
+    f64 outer[3][3];
+    /// Point-to-plane: normal equations of [rotation, translation]
+    f64 normal[6][6];
+    f64 rhs[6];
+
+    Sums& operator+=(const Sums& b) noexcept
+    {
+      count += b.count;
+      error += b.error;
+      for (u32 r = 0; r < 3; ++r) {
+        source[r] += b.source[r];
+        target[r] += b.target[r];
+        for (u32 c = 0; c < 3; ++c)
+          outer[r][c] += b.outer[r][c];
+      }
+      for (u32 r = 0; r < 6; ++r) {
+        rhs[r] += b.rhs[r];
+        for (u32 c = 0; c < 6; ++c)
+          normal[r][c] += b.normal[r][c];
+      }
+      return *this;
+    }
+  };
+
+  IcpResult<T> Align(
+      const Vector3<T>* source,
+      std::size_t count,
+      const Transform<T>& initial,
+      const IcpOptions<T>& options,
+      Parallel::ThreadPool* pool,
+      std::size_t grain
+  ) noexcept;
+  void Accumulate(
+      const Vector3<T>* source,
+      std::size_t begin,
+      std::size_t end,
+      const Transform<T>& transform,
+      IcpMetric metric,
+      T maxDistanceSquared,
+      Sums& sums
+  ) const noexcept;
+  static bool SolvePointToPoint(const Sums& sums, Transform<T>& delta) noexcept;
+  static bool SolvePointToPlane(const Sums& sums, Transform<T>& delta) noexcept;
+
+  KdTree<T, 3> tree;
+  std::vector<Vector3<T>> targets;
+  std::vector<Vector3<T>> normals;
+  std::vector<Sums> partial;
+};
+
+/**
+ * @brief Estimates unit normals as the direction of least variance of the k nearest neighbors
+ * @param normals buffer of count entries, the sign of every normal is arbitrary
+ */
+template <typename T>
+void EstimateNormals(
+    const Vector3<T>* points,
+    std::size_t count,
+    Vector3<T>* normals,
+    std::size_t k = IcpSettings::normalNeighbors
+) noexcept;
+
+template <typename T>
+void EstimateNormals(
+    const Vector3<T>* points,
+    std::size_t count,
+    Vector3<T>* normals,
+    Parallel::ThreadPool& pool,
+    std::size_t k = IcpSettings::normalNeighbors,
+    std::size_t grain = IcpSettings::grain
+) noexcept;
+
+/* ------------------------------------------- Usings ------------------------------------------ */
+using Icpf = Icp<f32>;
+using Icpd = Icp<f64>;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+namespace Internal
+{
+
+/// Narrows a vector of the double precision solvers
+template <typename T>
+Vector3<T> ToVector3(f64 x, f64 y, f64 z) noexcept
+{
+  return Vector3<T>(static_cast<T>(x), static_cast<T>(y), static_cast<T>(z));
+}
+
+} // namespace Internal
+
+template <typename T>
+void Icp<T>::SetTarget(
+    const Vector3<T>* points,
+    std::size_t count,
+    const Vector3<T>* normals
+) noexcept
+{
+  targets.assign(points, points + count);
+  this->normals.clear();
+  if (normals)
+    this->normals.assign(normals, normals + count);
+  tree.Build(points, count);
+}
+
+template <typename T>
+void Icp<T>::SetTarget(
+    const Vector3<T>* points,
+    std::size_t count,
+    const Vector3<T>* normals,
+    Parallel::ThreadPool& pool
+) noexcept
+{
+  targets.assign(points, points + count);
+  this->normals.clear();
+  if (normals)
+    this->normals.assign(normals, normals + count);
+  tree.Build(points, count, pool);
+}
+
+template <typename T>
+std::size_t Icp<T>::TargetSize() const noexcept
+{
+  return targets.size();
+}
+
+template <typename T>
+bool Icp<T>::HasNormals() const noexcept
+{
+  return !normals.empty();
+}
+
+template <typename T>
+IcpResult<T> Icp<T>::Align(
+    const Vector3<T>* source,
+    std::size_t count,
+    const Transform<T>& initial,
+    const IcpOptions<T>& options
+) noexcept
+{
+  return Align(source, count, initial, options, nullptr, IcpSettings::grain);
+}
+
+template <typename T>
+IcpResult<T> Icp<T>::Align(
+    const Vector3<T>* source,
+    std::size_t count,
+    const Transform<T>& initial,
+    const IcpOptions<T>& options,
+    Parallel::ThreadPool& pool,
+    std::size_t grain
+) noexcept
+{
+  return Align(source, count, initial, options, &pool, grain);
+}
+
+template <typename T>
+IcpResult<T> Icp<T>::Align(
+    const Vector3<T>* source,
+    std::size_t count,
+    const Transform<T>& initial,
+    const IcpOptions<T>& options,
+    Parallel::ThreadPool* pool,
+    std::size_t grain
+) noexcept
+{
+  IcpResult<T> result = {initial, static_cast<T>(0), 0, 0, false};
+  result.transform.scale = Vector3<T>::One();
+
+  IcpMetric metric = options.metric;
+  assert((metric == IcpMetric::PointToPoint || HasNormals()) && "Point-to-plane needs normals");
+  if (!HasNormals())
+    metric = IcpMetric::PointToPoint;
+  if (count == 0 || tree.Empty())
+    return result;
+
+  T maxDistanceSquared = options.maxDistance < std::sqrt(std::numeric_limits<T>::max())
+                             ? options.maxDistance * options.maxDistance
+                             : std::numeric_limits<T>::max();
+  grain = std::max<std::size_t>(grain, 1);
+  std::size_t blocks = (count + grain - 1) / grain;
+  partial.resize(blocks);
+
+  for (u32 iteration = 0; iteration < options.maxIterations; ++iteration) {
+    auto accumulate = [&](std::size_t first, std::size_t last) {
+      for (std::size_t block = first; block < last; ++block) {
+        std::size_t begin = block * grain;
+        std::size_t end = std::min(count, begin + grain);
+        Accumulate(
+            source, begin, end, result.transform, metric, maxDistanceSquared, partial[block]
+        );
+      }
+    };
+    if (pool)
+      pool->ParallelFor(blocks, 1, accumulate);
+    else
+      accumulate(0, blocks);
+
+    Sums sums = partial[0];
+    for (std::size_t block = 1; block < blocks; ++block)
+      sums += partial[block];
+
+    result.iterations = iteration + 1;
+    result.correspondences = static_cast<std::size_t>(sums.count);
+    result.rmsError =
+        sums.count > 0.0 ? static_cast<T>(std::sqrt(sums.error / sums.count)) : static_cast<T>(0);
+
+    Transform<T> delta;
+    bool solved = metric == IcpMetric::PointToPoint ? SolvePointToPoint(sums, delta)
+                                                    : SolvePointToPlane(sums, delta);
+    if (!solved)
+      return result;
+
+    result.transform = delta * result.transform;
+    result.transform.rotation.Normalize();
+
+    T angle = static_cast<T>(2) * std::atan2(delta.rotation.Vector().Length(),
+                                             std::abs(delta.rotation.w));
+    if (delta.position.Length() < options.tolerance && angle < options.tolerance) {
+      result.converged = true;
+      return result;
+    }
+  }
+  return result;
+}
+
+template <typename T>
+void Icp<T>::Accumulate(
+    const Vector3<T>* source,
+    std::size_t begin,
+    std::size_t end,
+    const Transform<T>& transform,
+    IcpMetric metric,
+    T maxDistanceSquared,
+    Sums& sums
+) const noexcept
+{
+  sums = Sums{};
+  KdNeighbor<T> match;
+  for (std::size_t i = begin; i < end; ++i) {
+    Vector3<T> p = transform.TransformPoint(source[i]);
+    if (!tree.Nearest(p, match) || match.distanceSquared > maxDistanceSquared)
+      continue;
+
+    const Vector3<T>& q = targets[match.index];
+    sums.count += 1.0;
+    if (metric == IcpMetric::PointToPoint) {
+      const f64 a[3] = {p.x, p.y, p.z};
+      const f64 b[3] = {q.x, q.y, q.z};
+      for (u32 r = 0; r < 3; ++r) {
+        sums.source[r] += a[r];
+        sums.target[r] += b[r];
+        for (u32 c = 0; c < 3; ++c)
+          sums.outer[r][c] += a[r] * b[c];
+      }
+      sums.error += match.distanceSquared;
+    } else {
+      // distance to the plane after a small rotation w and translation t is
+      // (p x n) . w + n . t - (q - p) . n, linear in [w, t]
+      const Vector3<T>& n = normals[match.index];
+      Vector3<T> pn = p.Cross(n);
+      const f64 row[6] = {pn.x, pn.y, pn.z, n.x, n.y, n.z};
+      f64 residual = (q - p).Dot(n);
+      for (u32 r = 0; r < 6; ++r) {
+        sums.rhs[r] += row[r] * residual;
+        for (u32 c = r; c < 6; ++c)
+          sums.normal[r][c] += row[r] * row[c];
+      }
+      sums.error += residual * residual;
+    }
+  }
+}
+
+template <typename T>
+bool Icp<T>::SolvePointToPoint(const Sums& sums, Transform<T>& delta) noexcept
+{
+  if (sums.count < 3.0)
+    return false;
+
+  f64 sourceMean[3];
+  f64 targetMean[3];
+  for (u32 r = 0; r < 3; ++r) {
+    sourceMean[r] = sums.source[r] / sums.count;
+    targetMean[r] = sums.target[r] / sums.count;
+  }
+  f64 s[3][3];
+  for (u32 r = 0; r < 3; ++r) {
+    for (u32 c = 0; c < 3; ++c)
+      s[r][c] = sums.outer[r][c] / sums.count - sourceMean[r] * targetMean[c];
+  }
+
+  // Horn: the rotation is the eigenvector (w, x, y, z) of the largest eigenvalue of n
+  const f64 n[4][4] = {
+      {s[0][0] + s[1][1] + s[2][2], s[1][2] - s[2][1], s[2][0] - s[0][2], s[0][1] - s[1][0]},
+      {0.0, s[0][0] - s[1][1] - s[2][2], s[0][1] + s[1][0], s[2][0] + s[0][2]},
+      {0.0, 0.0, -s[0][0] + s[1][1] - s[2][2], s[1][2] + s[2][1]},
+      {0.0, 0.0, 0.0, -s[0][0] - s[1][1] + s[2][2]},
+  };
+  f64 values[4];
+  f64 vectors[4][4];
+  Math::SymmetricEigen(n, values, vectors);
+
+  Quaternion<T> rotation(
+      static_cast<T>(vectors[1][3]), static_cast<T>(vectors[2][3]), static_cast<T>(vectors[3][3]),
+      static_cast<T>(vectors[0][3])
+  );
+  rotation.Normalize();
+  Vector3<T> sourceCenter = Internal::ToVector3<T>(sourceMean[0], sourceMean[1], sourceMean[2]);
+  Vector3<T> targetCenter = Internal::ToVector3<T>(targetMean[0], targetMean[1], targetMean[2]);
+  delta = Transform<T>(targetCenter - rotation * sourceCenter, rotation);
+  return true;
+}
+
+template <typename T>
+bool Icp<T>::SolvePointToPlane(const Sums& sums, Transform<T>& delta) noexcept
+{
+  f64 x[6];
+  if (sums.count < 6.0 || !Math::SolveSymmetric(sums.normal, sums.rhs, x))
+    return false;
+
+  Vector3<T> rotation = Internal::ToVector3<T>(x[0], x[1], x[2]);
+  T angle = rotation.Length();
+  delta = Transform<T>(
+      Internal::ToVector3<T>(x[3], x[4], x[5]),
+      angle > static_cast<T>(0) ? Quaternion<T>::FromAxisAngle(rotation / angle, angle)
+                                : Quaternion<T>::Identity()
+  );
+  return true;
+}
+
+namespace Internal
+{
+
+template <typename T>
+void EstimateNormals(
+    const KdTree<T, 3>& tree,
+    const Vector3<T>* points,
+    std::size_t begin,
+    std::size_t end,
+    Vector3<T>* normals,
+    std::size_t k
+) noexcept
+{
+  std::vector<KdNeighbor<T>> neighbors(k);
+  for (std::size_t i = begin; i < end; ++i) {
+    std::size_t found = tree.KNearest(points[i], k, neighbors.data());
+    if (found < 3) {
+      normals[i] = Vector3<T>::UnitZ();
+      continue;
+    }
+
+    f64 mean[3] = {0.0, 0.0, 0.0};
+    for (std::size_t j = 0; j < found; ++j) {
+      const Vector3<T>& p = points[neighbors[j].index];
+      mean[0] += p.x;
+      mean[1] += p.y;
+      mean[2] += p.z;
+    }
+    for (f64& m : mean)
+      m /= static_cast<f64>(found);
+
+    f64 covariance[3][3] = {};
+    for (std::size_t j = 0; j < found; ++j) {
+      const Vector3<T>& p = points[neighbors[j].index];
+      const f64 d[3] = {p.x - mean[0], p.y - mean[1], p.z - mean[2]};
+      for (u32 r = 0; r < 3; ++r) {
+        for (u32 c = r; c < 3; ++c)
+          covariance[r][c] += d[r] * d[c];
+      }
+    }
+
+    f64 values[3];
+    f64 vectors[3][3];
+    Math::SymmetricEigen(covariance, values, vectors);
+    normals[i] = ToVector3<T>(vectors[0][0], vectors[1][0], vectors[2][0]);
+  }
+}
+
+} // namespace Internal
+
+template <typename T>
+void EstimateNormals(
+    const Vector3<T>* points,
+    std::size_t count,
+    Vector3<T>* normals,
+    std::size_t k
+) noexcept
+{
+  KdTree<T, 3> tree;
+  tree.Build(points, count);
+  Internal::EstimateNormals(tree, points, 0, count, normals, k);
+}
+
+template <typename T>
+void EstimateNormals(
+    const Vector3<T>* points,
+    std::size_t count,
+    Vector3<T>* normals,
+    Parallel::ThreadPool& pool,
+    std::size_t k,
+    std::size_t grain
+) noexcept
+{
+  KdTree<T, 3> tree;
+  tree.Build(points, count, pool);
+  pool.ParallelFor(count, grain, [&](std::size_t begin, std::size_t end) {
+    Internal::EstimateNormals(tree, points, begin, end, normals, k);
+  });
+}
+
+} // namespace Engine::Core::Spatial
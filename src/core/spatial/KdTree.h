@@ -0,0 +1,512 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file KdTree.h
+ * @brief k-d tree over static 2D or 3D point sets with batched nearest neighbor queries
+ *
+ * The tree is implicit: points are reordered so that every subtree occupies a contiguous range
+ * [lo, hi) with its splitting point at the middle, and small ranges are scanned as leaf buckets.
+ * Nodes need no child pointers, only a split axis per slot. The split axis is the axis of the
+ * largest extent of an evenly strided sample of the range. Queries compare squared distances and
+ * write into caller provided buffers, so repeated queries do not allocate.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/math/Vector2.h"
+#include "core/math/Vector3.h"
+#include "core/parallel/ThreadPool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace Engine::Core::Spatial
+{
+
+using Math::Vector2;
+using Math::Vector3;
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+template <typename T>
+struct KdNeighbor
+{
+  /// Index of the point in the array passed to Build
+  u32 index;
+  T distanceSquared;
+};
+
+struct KdTreeSettings
+{
+  /// Ranges of at most this many points are scanned linearly
+  static constexpr std::size_t leafSize = 8;
+  /// Points inspected to choose the split axis of a range
+  static constexpr std::size_t sampleSize = 64;
+  /// Default number of queries in one chunk of the parallel batch forms
+  static constexpr std::size_t grain = 256;
+  /// Limit of the traversal stack, enough for any balanced tree with 32 bit indices
+  static constexpr std::size_t maxDepth = 64;
+};
+
+template <typename T, u32 Dimension = 3>
+class KdTree
+{
+  static_assert(Dimension == 2 || Dimension == 3, "KdTree supports 2D and 3D points");
+
+ public:
+  using Point = std::conditional_t<Dimension == 2, Vector2<T>, Vector3<T>>;
+  using Neighbor = KdNeighbor<T>;
+
+  static constexpr u32 invalidIndex = ~u32(0);
+
+  KdTree() noexcept;
+
+  /// Builds the tree over a copy of input points, previous content is dropped
+  void Build(const Point* input, std::size_t count) noexcept;
+  /// Same as Build, independent subtrees below the top levels are built by the pool
+  void Build(const Point* input, std::size_t count, Parallel::ThreadPool& pool) noexcept;
+  void Clear() noexcept;
+
+  std::size_t Size() const noexcept;
+  bool Empty() const noexcept;
+
+  /// Returns false for an empty tree
+  bool Nearest(const Point& query, Neighbor& result) const noexcept;
+  /**
+   * @brief Finds up to k nearest points
+   * @param out buffer of at least k entries, filled in order of increasing distance
+   * @return number of points found, min(k, Size())
+   */
+  std::size_t KNearest(const Point& query, std::size_t k, Neighbor* out) const noexcept;
+  /**
+   * @brief Finds all points within radius (inclusive)
+   * @param out cleared and filled in no particular order, its capacity is reused
+   * @return number of points found
+   */
+  std::size_t Radius(const Point& query, T radius, std::vector<Neighbor>& out) const noexcept;
+
+  /**
+   * @brief Runs KNearest for every query
+   * @param out buffer of count * k entries, results of query i start at i * k, missing entries
+   * have index invalidIndex
+   */
+  void KNearestBatch(
+      const Point* queries,
+      std::size_t count,
+      std::size_t k,
+      Neighbor* out
+  ) const noexcept;
+
+  void KNearestBatch(
+      const Point* queries,
+      std::size_t count,
+      std::size_t k,
+      Neighbor* out,
+      Parallel::ThreadPool& pool,
+      std::size_t grain = KdTreeSettings::grain
+  ) const noexcept;
+
+  /**
+   * @brief Runs Radius for every query
+   * @param out results of all queries, results of query i are [offsets[i], offsets[i + 1])
+   * @param offsets resized to count + 1
+   */
+  void RadiusBatch(
+      const Point* queries,
+      std::size_t count,
+      T radius,
+      std::vector<Neighbor>& out,
+      std::vector<u32>& offsets
+  ) const noexcept;
+
+ private:
+  struct Range
+  {
+    u32 lo;
+    u32 hi;
+  };
+
+  struct KNearestVisitor;
+  struct RadiusVisitor;
+
+  static T Component(const Point& p, u32 axis) noexcept;
+  static T DistanceSquared(const Point& a, const Point& b) noexcept;
+
+  void Assign(std::size_t count) noexcept;
+  /// Chooses the axis and places the median of [lo, hi) at its middle
+  void Split(const Point* input, u32 lo, u32 hi) noexcept;
+  void BuildRange(const Point* input, u32 lo, u32 hi) noexcept;
+  void CollectTasks(
+      const Point* input,
+      Range range,
+      u32 depth,
+      std::vector<Range>& tasks
+  ) noexcept;
+  void Finish(const Point* input) noexcept;
+
+  template <typename Visitor>
+  void Search(const Point& query, Visitor& visitor) const noexcept;
+
+  /// Points in tree order
+  std::vector<Point> points;
+  /// Original index of every slot
+  std::vector<u32> indices;
+  /// Split axis of every internal node, stored at the slot of its splitting point
+  std::vector<u8> axes;
+};
+
+/* ------------------------------------------- Usings ------------------------------------------ */
+using KdTreef = KdTree<f32, 3>;
+using KdTreed = KdTree<f64, 3>;
+using KdTree2f = KdTree<f32, 2>;
+using KdTree2d = KdTree<f64, 2>;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+template <typename T, u32 Dimension>
+struct KdTree<T, Dimension>::KNearestVisitor
+{
+  Neighbor* out;
+  std::size_t k;
+  std::size_t count;
+
+  static bool Less(const Neighbor& a, const Neighbor& b) noexcept
+  {
+    return a.distanceSquared < b.distanceSquared;
+  }
+
+  T Limit() const noexcept
+  {
+    return count < k ? std::numeric_limits<T>::max() : out[0].distanceSquared;
+  }
+
+  /// out[0, count) is a max heap by distance while searching
+  void Visit(u32 index, T distanceSquared) noexcept
+  {
+    if (count < k) {
+      out[count++] = Neighbor{index, distanceSquared};
+      std::push_heap(out, out + count, Less);
+    } else if (distanceSquared < out[0].distanceSquared) {
+      std::pop_heap(out, out + count, Less);
+      out[count - 1] = Neighbor{index, distanceSquared};
+      std::push_heap(out, out + count, Less);
+    }
+  }
+};
+
+template <typename T, u32 Dimension>
+struct KdTree<T, Dimension>::RadiusVisitor
+{
+  std::vector<Neighbor>* out;
+  T radiusSquared;
+
+  T Limit() const noexcept { return radiusSquared; }
+
+  void Visit(u32 index, T distanceSquared) noexcept
+  {
+    if (distanceSquared <= radiusSquared)
+      out->push_back(Neighbor{index, distanceSquared});
+  }
+};
+
+template <typename T, u32 Dimension>
+KdTree<T, Dimension>::KdTree() noexcept
+    : points(),
+      indices(),
+      axes()
+{
+}
+
+template <typename T, u32 Dimension>
+void KdTree<T, Dimension>::Build(const Point* input, std::size_t count) noexcept
+{
+  Assign(count);
+  BuildRange(input, 0, static_cast<u32>(count));
+  Finish(input);
+}
+
+template <typename T, u32 Dimension>
+void KdTree<T, Dimension>::Build(
+    const Point* input,
+    std::size_t count,
+    Parallel::ThreadPool& pool
+) noexcept
+{
+  Assign(count);
+
+  // split the top levels here until there are a few subtrees per thread
+  u32 depth = 0;
+  while ((std::size_t(1) << depth) < (pool.WorkerCount() + 1) * 4)
+    ++depth;
+
+  std::vector<Range> tasks;
+  CollectTasks(input, Range{0, static_cast<u32>(count)}, depth, tasks);
+  pool.ParallelFor(tasks.size(), 1, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i)
+      BuildRange(input, tasks[i].lo, tasks[i].hi);
+  });
+
+  Finish(input);
+}
+
+template <typename T, u32 Dimension>
+void KdTree<T, Dimension>::Clear() noexcept
+{
+  points.clear();
+  indices.clear();
+  axes.clear();
+}
+
+template <typename T, u32 Dimension>
+std::size_t KdTree<T, Dimension>::Size() const noexcept
+{
+  return points.size();
+}
+
+template <typename T, u32 Dimension>
+bool KdTree<T, Dimension>::Empty() const noexcept
+{
+  return points.empty();
+}
+
+template <typename T, u32 Dimension>
+bool KdTree<T, Dimension>::Nearest(const Point& query, Neighbor& result) const noexcept
+{
+  return KNearest(query, 1, &result) == 1;
+}
+
+template <typename T, u32 Dimension>
+std::size_t KdTree<T, Dimension>::KNearest(
+    const Point& query,
+    std::size_t k,
+    Neighbor* out
+) const noexcept
+{
+  if (k == 0 || Empty())
+    return 0;
+
+  KNearestVisitor visitor{out, k, 0};
+  Search(query, visitor);
+  std::sort_heap(out, out + visitor.count, KNearestVisitor::Less);
+  return visitor.count;
+}
+
+template <typename T, u32 Dimension>
+std::size_t KdTree<T, Dimension>::Radius(
+    const Point& query,
+    T radius,
+    std::vector<Neighbor>& out
+) const noexcept
+{
+  out.clear();
+  if (Empty() || radius < static_cast<T>(0))
+    return 0;
+
+  RadiusVisitor visitor{&out, radius * radius};
+  Search(query, visitor);
+  return out.size();
+}
+
+template <typename T, u32 Dimension>
+void KdTree<T, Dimension>::KNearestBatch(
+    const Point* queries,
+    std::size_t count,
+    std::size_t k,
+    Neighbor* out
+) const noexcept
+{
+  for (std::size_t i = 0; i < count; ++i) {
+    Neighbor* result = out + i * k;
+    std::size_t found = KNearest(queries[i], k, result);
+    std::fill(result + found, result + k, Neighbor{invalidIndex, std::numeric_limits<T>::max()});
+  }
+}
+
+template <typename T, u32 Dimension>
+void KdTree<T, Dimension>::KNearestBatch(
+    const Point* queries,
+    std::size_t count,
+    std::size_t k,
+    Neighbor* out,
+    Parallel::ThreadPool& pool,
+    std::size_t grain
+) const noexcept
+{
+  pool.ParallelFor(count, grain, [&](std::size_t begin, std::size_t end) {
+    KNearestBatch(queries + begin, end - begin, k, out + begin * k);
+  });
+}
+
+template <typename T, u32 Dimension>
+void KdTree<T, Dimension>::RadiusBatch(
+    const Point* queries,
+    std::size_t count,
+    T radius,
+    std::vector<Neighbor>& out,
+    std::vector<u32>& offsets
+) const noexcept
+{
+  out.clear();
+  offsets.resize(count + 1);
+  offsets[0] = 0;
+  if (Empty() || radius < static_cast<T>(0)) {
+    std::fill(offsets.begin(), offsets.end(), 0u);
+    return;
+  }
+
+  RadiusVisitor visitor{&out, radius * radius};
+  for (std::size_t i = 0; i < count; ++i) {
+    Search(queries[i], visitor);
+    offsets[i + 1] = static_cast<u32>(out.size());
+  }
+}
+
+template <typename T, u32 Dimension>
+T KdTree<T, Dimension>::Component(const Point& p, u32 axis) noexcept
+{
+  if constexpr (Dimension == 2)
+    return axis == 0 ? p.x : p.y;
+  else
+    return axis == 0 ? p.x : (axis == 1 ? p.y : p.z);
+}
+
+template <typename T, u32 Dimension>
+T KdTree<T, Dimension>::DistanceSquared(const Point& a, const Point& b) noexcept
+{
+  return (a - b).LengthSquared();
+}
+
+template <typename T, u32 Dimension>
+void KdTree<T, Dimension>::Assign(std::size_t count) noexcept
+{
+  assert(count < invalidIndex && "Too many points");
+
+  indices.resize(count);
+  for (std::size_t i = 0; i < count; ++i)
+    indices[i] = static_cast<u32>(i);
+  axes.assign(count, 0);
+}
+
+template <typename T, u32 Dimension>
+void KdTree<T, Dimension>::Split(const Point* input, u32 lo, u32 hi) noexcept
+{
+  u32 count = hi - lo;
+  u32 step = std::max<u32>(1, count / static_cast<u32>(KdTreeSettings::sampleSize));
+
+  T minimum[Dimension];
+  T maximum[Dimension];
+  for (u32 axis = 0; axis < Dimension; ++axis)
+    minimum[axis] = maximum[axis] = Component(input[indices[lo]], axis);
+  for (u32 i = lo + step; i < hi; i += step) {
+    for (u32 axis = 0; axis < Dimension; ++axis) {
+      T value = Component(input[indices[i]], axis);
+      minimum[axis] = std::min(minimum[axis], value);
+      maximum[axis] = std::max(maximum[axis], value);
+    }
+  }
+
+  u32 best = 0;
+  for (u32 axis = 1; axis < Dimension; ++axis) {
+    if (maximum[axis] - minimum[axis] > maximum[best] - minimum[best])
+      best = axis;
+  }
+
+  u32 mid = lo + count / 2;
+  std::nth_element(
+      indices.begin() + lo, indices.begin() + mid, indices.begin() + hi,
+      [input, best](u32 a, u32 b) { return Component(input[a], best) < Component(input[b], best); }
+  );
+  axes[mid] = static_cast<u8>(best);
+}
+
+template <typename T, u32 Dimension>
+void KdTree<T, Dimension>::BuildRange(const Point* input, u32 lo, u32 hi) noexcept
+{
+  while (hi - lo > KdTreeSettings::leafSize) {
+    Split(input, lo, hi);
+    u32 mid = lo + (hi - lo) / 2;
+    BuildRange(input, lo, mid);
+    lo = mid + 1;
+  }
+}
+
+template <typename T, u32 Dimension>
+void KdTree<T, Dimension>::CollectTasks(
+    const Point* input,
+    Range range,
+    u32 depth,
+    std::vector<Range>& tasks
+) noexcept
+{
+  if (depth == 0 || range.hi - range.lo <= KdTreeSettings::leafSize) {
+    tasks.push_back(range);
+    return;
+  }
+
+  Split(input, range.lo, range.hi);
+  u32 mid = range.lo + (range.hi - range.lo) / 2;
+  CollectTasks(input, Range{range.lo, mid}, depth - 1, tasks);
+  CollectTasks(input, Range{mid + 1, range.hi}, depth - 1, tasks);
+}
+
+template <typename T, u32 Dimension>
+void KdTree<T, Dimension>::Finish(const Point* input) noexcept
+{
+  points.resize(indices.size());
+  for (std::size_t i = 0; i < indices.size(); ++i)
+    points[i] = input[indices[i]];
+}
+
+template <typename T, u32 Dimension>
+template <typename Visitor>
+void KdTree<T, Dimension>::Search(const Point& query, Visitor& visitor) const noexcept
+{
+  struct Entry
+  {
+    u32 lo;
+    u32 hi;
+    /// Lower bound of the squared distance from query to the range
+    T bound;
+  };
+
+  Entry stack[KdTreeSettings::maxDepth];
+  std::size_t top = 0;
+  stack[top++] = Entry{0, static_cast<u32>(points.size()), static_cast<T>(0)};
+
+  while (top > 0) {
+    Entry entry = stack[--top];
+    if (entry.bound > visitor.Limit())
+      continue;
+
+    u32 lo = entry.lo;
+    u32 hi = entry.hi;
+    while (hi - lo > KdTreeSettings::leafSize) {
+      u32 mid = lo + (hi - lo) / 2;
+      visitor.Visit(indices[mid], DistanceSquared(query, points[mid]));
+
+      T diff = Component(query, axes[mid]) - Component(points[mid], axes[mid]);
+      T farBound = std::max(entry.bound, diff * diff);
+      Entry far = diff < static_cast<T>(0) ? Entry{mid + 1, hi, farBound}
+                                           : Entry{lo, mid, farBound};
+      if (diff < static_cast<T>(0))
+        hi = mid;
+      else
+        lo = mid + 1;
+
+      if (far.lo < far.hi && farBound <= visitor.Limit()) {
+        assert(top < KdTreeSettings::maxDepth && "Traversal stack overflow");
+        stack[top++] = far;
+      }
+    }
+
+    for (u32 i = lo; i < hi; ++i)
+      visitor.Visit(indices[i], DistanceSquared(query, points[i]));
+  }
+}
+
+} // namespace Engine::Core::Spatial
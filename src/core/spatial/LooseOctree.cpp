@@ -0,0 +1,10 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file LooseOctree.cpp
+ * @brief All implementation contains in header file LooseOctree.h
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include "core/spatial/LooseOctree.h"
@@ -0,0 +1,556 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file LooseOctree.h
+ * @brief Loose octree of moving bounding boxes with frustum, sphere and ray queries
+ *
+ * Every node owns a cubic cell and accepts objects whose box lies inside the cell scaled by the
+ * looseness factor, so an object is stored by its size and center only and never straddles a
+ * split plane. Moving an object keeps it in its node while the new box stays inside the loose
+ * bounds, otherwise it is relinked below the nearest ancestor which still contains it. Nodes live
+ * in a pool with a free list and are created on demand and released when their subtree empties.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/math/AABB.h"
+#include "core/math/Frustum.h"
+#include "core/math/Vector3.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace Engine::Core::Spatial
+{
+
+using Math::AABB;
+using Math::Frustum;
+using Math::Intersection;
+using Math::Vector3;
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+struct LooseOctreeSettings
+{
+  /// Deepest level a tree may be created with
+  static constexpr u32 maxDepth = 16;
+};
+
+template <typename T>
+class LooseOctree
+{
+ public:
+  using Handle = u32;
+
+  static constexpr Handle invalidHandle = ~Handle(0);
+
+  /**
+   * @param bounds world region covered by the root cell, objects outside of it are kept in root
+   * @param depth number of levels below root, clamped to LooseOctreeSettings::maxDepth
+   * @param looseness scale of node bounds relative to their cell, at least 1
+   */
+  explicit LooseOctree(
+      const AABB<T>& bounds,
+      u32 depth = 8,
+      T looseness = static_cast<T>(2)
+  ) noexcept;
+
+  Handle Add(const AABB<T>& box) noexcept;
+  void Remove(Handle handle) noexcept;
+  /// Moves object, relinking it only when the box leaves the loose bounds of its node
+  void SetBounds(Handle handle, const AABB<T>& box) noexcept;
+  const AABB<T>& GetBounds(Handle handle) const noexcept;
+  void Clear() noexcept;
+
+  u32 Size() const noexcept;
+  /// Number of allocated nodes including root
+  u32 NodeCount() const noexcept;
+
+  /// Queries clear out and fill it with handles of matching objects in no particular order
+  void QueryFrustum(const Frustum<T>& frustum, std::vector<Handle>& out) const noexcept;
+  void QuerySphere(const Vector3<T>& center, T radius, std::vector<Handle>& out) const noexcept;
+  void QueryAABB(const AABB<T>& box, std::vector<Handle>& out) const noexcept;
+  /// Objects hit by segment origin + direction * t, t in [0, maxDistance]
+  void QueryRay(
+      const Vector3<T>& origin,
+      const Vector3<T>& direction,
+      T maxDistance,
+      std::vector<Handle>& out
+  ) const noexcept;
+
+ private:
+  static constexpr u32 invalidIndex = ~u32(0);
+  static constexpr std::size_t stackSize = 7 * LooseOctreeSettings::maxDepth + 1;
+
+  struct Node
+  {
+    Vector3<T> center;
+    /// Half size of the cell, loose bounds are larger by looseness
+    T halfSize;
+    u32 depth;
+    u32 parent;
+    u32 children[8];
+    u32 firstObject;
+    /// Objects in this node and all its descendants
+    u32 subtreeCount;
+  };
+
+  struct Object
+  {
+    AABB<T> box;
+    u32 node;
+    u32 prev;
+    u32 next;
+  };
+
+  static Vector3<T> ChildCenter(const Node& node, u32 octant) noexcept;
+  AABB<T> LooseBounds(const Vector3<T>& center, T halfSize) const noexcept;
+  u32 AllocateNode(u32 parent, u32 octant) noexcept;
+  /// Finds or creates the deepest node below start whose loose bounds contain box
+  u32 FindNode(u32 start, const AABB<T>& box) noexcept;
+  void Link(Handle handle, u32 node) noexcept;
+  void Unlink(Handle handle) noexcept;
+  /// Counts an object in node and its ancestors
+  void Retain(u32 node) noexcept;
+  /// Uncounts an object in node and its ancestors and releases nodes whose subtree emptied
+  void Release(u32 node) noexcept;
+  void CollectSubtree(u32 node, std::vector<Handle>& out) const noexcept;
+
+  template <typename NodeTest, typename ObjectTest>
+  void Query(const NodeTest& nodeTest, const ObjectTest& objectTest, std::vector<Handle>& out)
+      const noexcept;
+
+  static bool RayHitsBox(
+      const AABB<T>& box,
+      const Vector3<T>& origin,
+      const Vector3<T>& inverseDirection,
+      T maxDistance
+  ) noexcept;
+
+  AABB<T> bounds;
+  u32 depth;
+  T looseness;
+  u32 count;
+  std::vector<Node> nodes;
+  std::vector<u32> freeNodes;
+  std::vector<Object> objects;
+  std::vector<Handle> freeHandles;
+};
+
+/* ------------------------------------------- Usings ------------------------------------------ */
+using LooseOctreef = LooseOctree<f32>;
+using LooseOctreed = LooseOctree<f64>;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+template <typename T>
+LooseOctree<T>::LooseOctree(const AABB<T>& bounds, u32 depth, T looseness) noexcept
+    : bounds(bounds),
+      depth(std::min(depth, LooseOctreeSettings::maxDepth)),
+      looseness(std::max(looseness, static_cast<T>(1))),
+      count(0)
+{
+  Clear();
+}
+
+template <typename T>
+typename LooseOctree<T>::Handle LooseOctree<T>::Add(const AABB<T>& box) noexcept
+{
+  Handle handle;
+  if (!freeHandles.empty()) {
+    handle = freeHandles.back();
+    freeHandles.pop_back();
+  } else {
+    handle = static_cast<Handle>(objects.size());
+    objects.push_back(Object());
+  }
+
+  objects[handle].box = box;
+  u32 node = FindNode(0, box);
+  Link(handle, node);
+  Retain(node);
+  ++count;
+  return handle;
+}
+
+template <typename T>
+void LooseOctree<T>::Remove(Handle handle) noexcept
+{
+  assert(handle < objects.size() && objects[handle].node != invalidIndex && "Invalid handle");
+  if (handle >= objects.size() || objects[handle].node == invalidIndex)
+    return;
+
+  u32 node = objects[handle].node;
+  Unlink(handle);
+  Release(node);
+  objects[handle].node = invalidIndex;
+  freeHandles.push_back(handle);
+  --count;
+}
+
+template <typename T>
+void LooseOctree<T>::SetBounds(Handle handle, const AABB<T>& box) noexcept
+{
+  assert(handle < objects.size() && objects[handle].node != invalidIndex && "Invalid handle");
+  Object& object = objects[handle];
+  object.box = box;
+
+  u32 current = object.node;
+  const Node& node = nodes[current];
+  if (current != 0 && LooseBounds(node.center, node.halfSize).Contains(box))
+    return;
+
+  u32 ancestor = current;
+  while (ancestor != 0) {
+    ancestor = nodes[ancestor].parent;
+    if (LooseBounds(nodes[ancestor].center, nodes[ancestor].halfSize).Contains(box))
+      break;
+  }
+
+  u32 target = FindNode(ancestor, box);
+  if (target == current)
+    return;
+
+  // count the object on the new path first, so shared ancestors are not released
+  Retain(target);
+  Unlink(handle);
+  Release(current);
+  Link(handle, target);
+}
+
+template <typename T>
+const AABB<T>& LooseOctree<T>::GetBounds(Handle handle) const noexcept
+{
+  assert(handle < objects.size() && objects[handle].node != invalidIndex && "Invalid handle");
+  return objects[handle].box;
+}
+
+template <typename T>
+void LooseOctree<T>::Clear() noexcept
+{
+  nodes.clear();
+  freeNodes.clear();
+  objects.clear();
+  freeHandles.clear();
+  count = 0;
+
+  Vector3<T> size = bounds.Size();
+  Node root;
+  root.center = bounds.Center();
+  root.halfSize = std::max(size.x, std::max(size.y, size.z)) * static_cast<T>(0.5);
+  root.depth = 0;
+  root.parent = invalidIndex;
+  std::fill(root.children, root.children + 8, invalidIndex);
+  root.firstObject = invalidIndex;
+  root.subtreeCount = 0;
+  nodes.push_back(root);
+}
+
+template <typename T>
+u32 LooseOctree<T>::Size() const noexcept
+{
+  return count;
+}
+
+template <typename T>
+u32 LooseOctree<T>::NodeCount() const noexcept
+{
+  return static_cast<u32>(nodes.size() - freeNodes.size());
+}
+
+template <typename T>
+void LooseOctree<T>::QueryFrustum(
+    const Frustum<T>& frustum,
+    std::vector<Handle>& out
+) const noexcept
+{
+  Query(
+      [&frustum](const AABB<T>& box, u8& mask) {
+        return frustum.ClassifyAABB(box.min, box.max, mask);
+      },
+      [&frustum](const AABB<T>& box, u8 mask) {
+        return frustum.ClassifyAABB(box.min, box.max, mask) != Intersection::Outside;
+      },
+      out
+  );
+}
+
+template <typename T>
+void LooseOctree<T>::QuerySphere(
+    const Vector3<T>& center,
+    T radius,
+    std::vector<Handle>& out
+) const noexcept
+{
+  T radiusSquared = radius * radius;
+  Query(
+      [&center, radiusSquared](const AABB<T>& box, u8&) {
+        return box.DistanceSquaredTo(center) <= radiusSquared ? Intersection::Intersecting
+                                                              : Intersection::Outside;
+      },
+      [&center, radiusSquared](const AABB<T>& box, u8) {
+        return box.DistanceSquaredTo(center) <= radiusSquared;
+      },
+      out
+  );
+}
+
+template <typename T>
+void LooseOctree<T>::QueryAABB(const AABB<T>& box, std::vector<Handle>& out) const noexcept
+{
+  Query(
+      [&box](const AABB<T>& node, u8&) {
+        if (box.Contains(node))
+          return Intersection::Inside;
+        return box.Overlaps(node) ? Intersection::Intersecting : Intersection::Outside;
+      },
+      [&box](const AABB<T>& object, u8) { return box.Overlaps(object); },
+      out
+  );
+}
+
+template <typename T>
+void LooseOctree<T>::QueryRay(
+    const Vector3<T>& origin,
+    const Vector3<T>& direction,
+    T maxDistance,
+    std::vector<Handle>& out
+) const noexcept
+{
+  constexpr T one = static_cast<T>(1);
+  constexpr T infinity = std::numeric_limits<T>::infinity();
+  Vector3<T> inverse(
+      direction.x != static_cast<T>(0) ? one / direction.x : infinity,
+      direction.y != static_cast<T>(0) ? one / direction.y : infinity,
+      direction.z != static_cast<T>(0) ? one / direction.z : infinity
+  );
+
+  Query(
+      [&](const AABB<T>& box, u8&) {
+        return RayHitsBox(box, origin, inverse, maxDistance) ? Intersection::Intersecting
+                                                             : Intersection::Outside;
+      },
+      [&](const AABB<T>& box, u8) { return RayHitsBox(box, origin, inverse, maxDistance); },
+      out
+  );
+}
+
+template <typename T>
+Vector3<T> LooseOctree<T>::ChildCenter(const Node& node, u32 octant) noexcept
+{
+  T quarter = node.halfSize * static_cast<T>(0.5);
+  return node.center + Vector3<T>(
+      octant & 1u ? quarter : -quarter,
+      octant & 2u ? quarter : -quarter,
+      octant & 4u ? quarter : -quarter
+  );
+}
+
+template <typename T>
+AABB<T> LooseOctree<T>::LooseBounds(const Vector3<T>& center, T halfSize) const noexcept
+{
+  T half = halfSize * looseness;
+  return AABB<T>::FromCenterExtents(center, Vector3<T>(half, half, half));
+}
+
+template <typename T>
+u32 LooseOctree<T>::AllocateNode(u32 parent, u32 octant) noexcept
+{
+  u32 index;
+  if (!freeNodes.empty()) {
+    index = freeNodes.back();
+    freeNodes.pop_back();
+  } else {
+    index = static_cast<u32>(nodes.size());
+    nodes.push_back(Node());
+  }
+
+  const Node& owner = nodes[parent];
+  Node& node = nodes[index];
+  node.center = ChildCenter(owner, octant);
+  node.halfSize = owner.halfSize * static_cast<T>(0.5);
+  node.depth = owner.depth + 1;
+  node.parent = parent;
+  std::fill(node.children, node.children + 8, invalidIndex);
+  node.firstObject = invalidIndex;
+  node.subtreeCount = 0;
+
+  nodes[parent].children[octant] = index;
+  return index;
+}
+
+template <typename T>
+u32 LooseOctree<T>::FindNode(u32 start, const AABB<T>& box) noexcept
+{
+  Vector3<T> center = box.Center();
+  Vector3<T> size = box.Size();
+  T extent = std::max(size.x, std::max(size.y, size.z));
+
+  u32 current = start;
+  while (nodes[current].depth < depth) {
+    const Node& node = nodes[current];
+    // a child cell is halfSize wide, box fits in its loose bounds when not larger than the slack
+    if (extent > node.halfSize * (looseness - static_cast<T>(1)))
+      break;
+
+    u32 octant = (center.x >= node.center.x ? 1u : 0u) | (center.y >= node.center.y ? 2u : 0u) |
+                 (center.z >= node.center.z ? 4u : 0u);
+    // objects outside of the world bounds stop at the first cell which does not contain them
+    T childHalfSize = node.halfSize * static_cast<T>(0.5);
+    if (!LooseBounds(ChildCenter(node, octant), childHalfSize).Contains(box))
+      break;
+
+    u32 child = node.children[octant];
+    current = child != invalidIndex ? child : AllocateNode(current, octant);
+  }
+  return current;
+}
+
+template <typename T>
+void LooseOctree<T>::Link(Handle handle, u32 node) noexcept
+{
+  Object& object = objects[handle];
+  object.node = node;
+  object.prev = invalidIndex;
+  object.next = nodes[node].firstObject;
+  if (object.next != invalidIndex)
+    objects[object.next].prev = handle;
+  nodes[node].firstObject = handle;
+}
+
+template <typename T>
+void LooseOctree<T>::Unlink(Handle handle) noexcept
+{
+  const Object& object = objects[handle];
+  if (object.prev != invalidIndex)
+    objects[object.prev].next = object.next;
+  else
+    nodes[object.node].firstObject = object.next;
+  if (object.next != invalidIndex)
+    objects[object.next].prev = object.prev;
+}
+
+template <typename T>
+void LooseOctree<T>::Retain(u32 node) noexcept
+{
+  for (u32 i = node; i != invalidIndex; i = nodes[i].parent)
+    ++nodes[i].subtreeCount;
+}
+
+template <typename T>
+void LooseOctree<T>::Release(u32 node) noexcept
+{
+  for (u32 i = node; i != invalidIndex;) {
+    u32 parent = nodes[i].parent;
+    if (--nodes[i].subtreeCount == 0 && parent != invalidIndex) {
+      std::replace(nodes[parent].children, nodes[parent].children + 8, i, invalidIndex);
+      freeNodes.push_back(i);
+    }
+    i = parent;
+  }
+}
+
+template <typename T>
+void LooseOctree<T>::CollectSubtree(u32 node, std::vector<Handle>& out) const noexcept
+{
+  u32 stack[stackSize];
+  std::size_t top = 0;
+  stack[top++] = node;
+
+  while (top > 0) {
+    const Node& current = nodes[stack[--top]];
+    for (u32 i = current.firstObject; i != invalidIndex; i = objects[i].next)
+      out.push_back(i);
+    for (u32 child : current.children) {
+      if (child != invalidIndex)
+        stack[top++] = child;
+    }
+  }
+}
+
+template <typename T>
+template <typename NodeTest, typename ObjectTest>
+void LooseOctree<T>::Query(
+    const NodeTest& nodeTest,
+    const ObjectTest& objectTest,
+    std::vector<Handle>& out
+) const noexcept
+{
+  struct Entry
+  {
+    u32 node;
+    u8 mask;
+  };
+
+  out.clear();
+  if (count == 0)
+    return;
+
+  // root also holds objects outside of the world bounds, so it is never culled
+  Entry stack[stackSize];
+  std::size_t top = 0;
+  stack[top++] = Entry{0, Frustum<T>::allPlanes};
+
+  while (top > 0) {
+    Entry entry = stack[--top];
+    const Node& current = nodes[entry.node];
+
+    for (u32 i = current.firstObject; i != invalidIndex; i = objects[i].next) {
+      if (objectTest(objects[i].box, entry.mask))
+        out.push_back(i);
+    }
+
+    for (u32 child : current.children) {
+      if (child == invalidIndex)
+        continue;
+
+      u8 mask = entry.mask;
+      const Node& node = nodes[child];
+      Intersection intersection = nodeTest(LooseBounds(node.center, node.halfSize), mask);
+      if (intersection == Intersection::Inside)
+        CollectSubtree(child, out);
+      else if (intersection == Intersection::Intersecting)
+        stack[top++] = Entry{child, mask};
+    }
+  }
+}
+
+template <typename T>
+bool LooseOctree<T>::RayHitsBox(
+    const AABB<T>& box,
+    const Vector3<T>& origin,
+    const Vector3<T>& inverseDirection,
+    T maxDistance
+) noexcept
+{
+  T enter = static_cast<T>(0);
+  T exit = maxDistance;
+  const T origins[3] = {origin.x, origin.y, origin.z};
+  const T inverses[3] = {inverseDirection.x, inverseDirection.y, inverseDirection.z};
+  const T mins[3] = {box.min.x, box.min.y, box.min.z};
+  const T maxs[3] = {box.max.x, box.max.y, box.max.z};
+
+  for (u32 axis = 0; axis < 3; ++axis) {
+    if (inverses[axis] == std::numeric_limits<T>::infinity()) {
+      // ray parallel to the slab
+      if (origins[axis] < mins[axis] || origins[axis] > maxs[axis])
+        return false;
+      continue;
+    }
+    T t0 = (mins[axis] - origins[axis]) * inverses[axis];
+    T t1 = (maxs[axis] - origins[axis]) * inverses[axis];
+    if (t0 > t1)
+      std::swap(t0, t1);
+    enter = std::max(enter, t0);
+    exit = std::min(exit, t1);
+    if (enter > exit)
+      return false;
+  }
+  return true;
+}
+
+} // namespace Engine::Core::Spatial
@@ -0,0 +1,77 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file PointCloudFilter.cpp
+ * @brief Implementation of random index sampling
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include "core/spatial/PointCloudFilter.h"
+
+#include "core/container/FlatHashMap.h"
+#include "core/container/Hash.h"
+
+namespace Engine::Core::Spatial
+{
+
+namespace
+{
+
+void SampleIndices(
+    std::size_t count,
+    std::size_t sampleCount,
+    u64 seed,
+    std::vector<u32>& indices,
+    Parallel::ThreadPool* pool,
+    std::size_t grain
+) noexcept
+{
+  sampleCount = std::min(sampleCount, count);
+  indices.clear();
+  indices.reserve(sampleCount);
+  Container::FlatHashMap<u32, u8> chosen(static_cast<u32>(sampleCount));
+
+  // Floyd's algorithm: every step adds exactly one index, each subset is equally likely, and
+  // only the chosen indices are stored however large count is
+  for (std::size_t j = count - sampleCount; j < count; ++j) {
+    u32 t = static_cast<u32>(Container::CombineHash(seed, j) % (j + 1));
+    if (!chosen.Insert(t, 0).second) {
+      t = static_cast<u32>(j);
+      chosen.Insert(t, 0);
+    }
+    indices.push_back(t);
+  }
+
+  std::vector<u32> scratch(indices.size());
+  if (pool)
+    Parallel::RadixSort(indices.data(), indices.size(), scratch.data(), *pool, grain);
+  else
+    Parallel::RadixSort(indices.data(), indices.size(), scratch.data());
+}
+
+} // namespace
+
+void RandomSample(
+    std::size_t count,
+    std::size_t sampleCount,
+    u64 seed,
+    std::vector<u32>& indices
+) noexcept
+{
+  SampleIndices(count, sampleCount, seed, indices, nullptr, PointCloudFilterSettings::grain);
+}
+
+void RandomSample(
+    std::size_t count,
+    std::size_t sampleCount,
+    u64 seed,
+    std::vector<u32>& indices,
+    Parallel::ThreadPool& pool,
+    std::size_t grain
+) noexcept
+{
+  SampleIndices(count, sampleCount, seed, indices, &pool, grain);
+}
+
+} // namespace Engine::Core::Spatial
@@ -0,0 +1,501 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file PointCloudFilter.h
+ * @brief Reduction of point clouds: voxel grid downsampling, sampling and outlier removal
+ *
+ * Voxel downsampling needs no tree: every point gets the Morton code of its voxel as a key, the
+ * keys are radix sorted and every run of equal keys is replaced by the centroid of its points, so
+ * the output also comes out in Z-order. Random sampling draws indices with Floyd's algorithm into
+ * a hash set of the sample size, and farthest point sampling keeps the distance of every point to
+ * the chosen set, one parallel pass per sample. Statistical outlier removal compares the mean
+ * distance of every point to its k nearest neighbors with the mean and standard deviation of that
+ * distance over the cloud.
+ * Sampling and outlier removal return sorted indices, so payloads are gathered the same way as
+ * the points.
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/math/AABB.h"
+#include "core/math/Morton.h"
+#include "core/math/Vector3.h"
+#include "core/parallel/Compact.h"
+#include "core/parallel/RadixSort.h"
+#include "core/parallel/ThreadPool.h"
+#include "core/spatial/KdTree.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace Engine::Core::Spatial
+{
+
+using Math::AABB;
+
+/* ------------------------------------- Class declaration ------------------------------------- */
+struct PointCloudFilterSettings
+{
+  /// Default number of points in one chunk of the parallel forms
+  static constexpr std::size_t grain = 16 * 1024;
+  /// Default number of neighbor queries in one chunk of outlier removal
+  static constexpr std::size_t queryGrain = 256;
+};
+
+/**
+ * @brief Replaces the points of every voxel by their centroid
+ * @param voxelSize edge of the cubic voxels aligned to the minimum corner of the points, the
+ * cloud must span at most 2^21 voxels along every axis
+ * @param out cleared and filled with one point per occupied voxel in Z-order of the voxels
+ */
+template <typename T>
+void VoxelDownsample(
+    const Vector3<T>* points,
+    std::size_t count,
+    T voxelSize,
+    std::vector<Vector3<T>>& out
+) noexcept;
+
+template <typename T>
+void VoxelDownsample(
+    const Vector3<T>* points,
+    std::size_t count,
+    T voxelSize,
+    std::vector<Vector3<T>>& out,
+    Parallel::ThreadPool& pool,
+    std::size_t grain = PointCloudFilterSettings::grain
+) noexcept;
+
+/**
+ * @brief Picks min(sampleCount, count) distinct indices of [0, count) uniformly at random
+ * @param indices cleared and filled in ascending order, the same seed gives the same indices
+ */
+void RandomSample(
+    std::size_t count,
+    std::size_t sampleCount,
+    u64 seed,
+    std::vector<u32>& indices
+) noexcept;
+
+void RandomSample(
+    std::size_t count,
+    std::size_t sampleCount,
+    u64 seed,
+    std::vector<u32>& indices,
+    Parallel::ThreadPool& pool,
+    std::size_t grain = PointCloudFilterSettings::grain
+) noexcept;
+
+/**
+ * @brief Greedily picks points farthest from all previously picked ones, starting with first
+ * @param indices cleared and filled in the order of picking, min(sampleCount, count) entries
+ * unless every remaining point coincides with a picked one, which stops the picking early
+ */
+template <typename T>
+void FarthestPointSample(
+    const Vector3<T>* points,
+    std::size_t count,
+    std::size_t sampleCount,
+    std::vector<u32>& indices,
+    u32 first = 0
+) noexcept;
+
+template <typename T>
+void FarthestPointSample(
+    const Vector3<T>* points,
+    std::size_t count,
+    std::size_t sampleCount,
+    std::vector<u32>& indices,
+    Parallel::ThreadPool& pool,
+    u32 first = 0,
+    std::size_t grain = PointCloudFilterSettings::grain
+) noexcept;
+
+/**
+ * @brief Keeps points whose mean distance to their k nearest neighbors is at most
+ * mean + stdRatio * deviation of that distance over all points
+ * @param inliers cleared and filled with indices of kept points in ascending order
+ */
+template <typename T>
+void RemoveStatisticalOutliers(
+    const Vector3<T>* points,
+    std::size_t count,
+    std::size_t k,
+    T stdRatio,
+    std::vector<u32>& inliers
+) noexcept;
+
+template <typename T>
+void RemoveStatisticalOutliers(
+    const Vector3<T>* points,
+    std::size_t count,
+    std::size_t k,
+    T stdRatio,
+    std::vector<u32>& inliers,
+    Parallel::ThreadPool& pool,
+    std::size_t grain = PointCloudFilterSettings::queryGrain
+) noexcept;
+
+/* --------------------------------------- Implementation -------------------------------------- */
+namespace Internal
+{
+
+/// Calls func(block, begin, end) for consecutive blocks of [0, count), pool may be null
+template <typename Func>
+std::size_t ForEachBlock(
+    std::size_t count,
+    Parallel::ThreadPool* pool,
+    std::size_t grain,
+    Func&& func
+) noexcept
+{
+  std::size_t blocks = 1;
+  if (pool)
+    blocks = std::clamp<std::size_t>(count / std::max<std::size_t>(grain, 1), 1,
+                                     pool->WorkerCount() + 1);
+  std::size_t blockSize = (count + blocks - 1) / blocks;
+
+  auto run = [&](std::size_t first, std::size_t last) {
+    for (std::size_t block = first; block < last; ++block)
+      func(block, std::min(count, block * blockSize), std::min(count, (block + 1) * blockSize));
+  };
+  if (blocks > 1)
+    pool->ParallelFor(blocks, 1, run);
+  else
+    run(0, 1);
+  return blocks;
+}
+
+/// Sets bit i of a mask laid out for CompactBits when predicate(i) holds
+template <typename Predicate>
+void FillMask(
+    std::size_t count,
+    std::vector<u8>& mask,
+    Parallel::ThreadPool* pool,
+    std::size_t grain,
+    Predicate&& predicate
+) noexcept
+{
+  // blocks own whole bytes, so no byte is written by two threads
+  mask.assign((count + 7) / 8, 0);
+  ForEachBlock(mask.size(), pool, grain / 8, [&](std::size_t, std::size_t begin, std::size_t end) {
+    for (std::size_t byte = begin; byte < end; ++byte) {
+      u8 bits = 0;
+      for (std::size_t bit = 0; bit < 8 && byte * 8 + bit < count; ++bit)
+        bits |= static_cast<u8>(predicate(byte * 8 + bit) ? 1u << bit : 0u);
+      mask[byte] = bits;
+    }
+  });
+}
+
+inline void CompactMask(
+    const std::vector<u8>& mask,
+    std::size_t count,
+    std::vector<u32>& indices,
+    Parallel::ThreadPool* pool
+) noexcept
+{
+  indices.resize(count);
+  std::size_t found = pool ? Parallel::CompactBits(mask.data(), count, indices.data(), *pool)
+                           : Parallel::CompactBits(mask.data(), count, indices.data());
+  indices.resize(found);
+}
+
+template <typename T>
+AABB<T> Bounds(
+    const Vector3<T>* points,
+    std::size_t count,
+    Parallel::ThreadPool* pool,
+    std::size_t grain
+) noexcept
+{
+  std::vector<AABB<T>> partial(pool ? pool->WorkerCount() + 1 : 1, AABB<T>::Empty());
+  ForEachBlock(count, pool, grain, [&](std::size_t block, std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i)
+      partial[block].Merge(points[i]);
+  });
+
+  AABB<T> bounds = AABB<T>::Empty();
+  for (const AABB<T>& box : partial)
+    bounds.Merge(box);
+  return bounds;
+}
+
+template <typename T>
+void VoxelDownsample(
+    const Vector3<T>* points,
+    std::size_t count,
+    T voxelSize,
+    std::vector<Vector3<T>>& out,
+    Parallel::ThreadPool* pool,
+    std::size_t grain
+) noexcept
+{
+  out.clear();
+  assert(voxelSize > static_cast<T>(0) && "Voxel size must be positive");
+  if (count == 0 || !(voxelSize > static_cast<T>(0)))
+    return;
+
+  AABB<T> bounds = Bounds(points, count, pool, grain);
+  Vector3<T> cells = bounds.Size() / voxelSize;
+  constexpr T maxCells = static_cast<T>(Math::MortonSettings::maxCoordinate);
+  bool fits = cells.x <= maxCells && cells.y <= maxCells && cells.z <= maxCells;
+  assert(fits && "Too many voxels along an axis");
+  if (!fits)
+    return;
+
+  // key of a voxel is the Morton code of its cell, so sorting groups points of one voxel
+  T inverse = static_cast<T>(1) / voxelSize;
+  auto cell = [inverse, maxCells](T value, T min) {
+    return static_cast<u32>(std::min(std::floor((value - min) * inverse), maxCells));
+  };
+  std::vector<u64> keys(count);
+  std::vector<u32> order(count);
+  ForEachBlock(count, pool, grain, [&](std::size_t, std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      const Vector3<T>& p = points[i];
+      keys[i] = Math::MortonEncode(
+          cell(p.x, bounds.min.x), cell(p.y, bounds.min.y), cell(p.z, bounds.min.z)
+      );
+      order[i] = static_cast<u32>(i);
+    }
+  });
+
+  std::vector<u64> keyScratch(count);
+  std::vector<u32> orderScratch(count);
+  if (pool) {
+    Parallel::RadixSort(
+        keys.data(), order.data(), count, keyScratch.data(), orderScratch.data(), *pool
+    );
+  } else {
+    Parallel::RadixSort(keys.data(), order.data(), count, keyScratch.data(), orderScratch.data());
+  }
+
+  std::vector<u8> mask;
+  FillMask(count, mask, pool, grain, [&keys](std::size_t i) {
+    return i == 0 || keys[i] != keys[i - 1];
+  });
+  std::vector<u32> starts;
+  CompactMask(mask, count, starts, pool);
+  starts.push_back(static_cast<u32>(count));
+
+  std::size_t voxels = starts.size() - 1;
+  out.resize(voxels);
+  ForEachBlock(voxels, pool, grain, [&](std::size_t, std::size_t begin, std::size_t end) {
+    for (std::size_t voxel = begin; voxel < end; ++voxel) {
+      Vector3<T> sum = Vector3<T>::Zero();
+      for (u32 i = starts[voxel]; i < starts[voxel + 1]; ++i)
+        sum += points[order[i]];
+      out[voxel] = sum / static_cast<T>(starts[voxel + 1] - starts[voxel]);
+    }
+  });
+}
+
+template <typename T>
+void FarthestPointSample(
+    const Vector3<T>* points,
+    std::size_t count,
+    std::size_t sampleCount,
+    std::vector<u32>& indices,
+    u32 first,
+    Parallel::ThreadPool* pool,
+    std::size_t grain
+) noexcept
+{
+  struct Farthest
+  {
+    T distanceSquared;
+    u32 index;
+  };
+
+  indices.clear();
+  assert((count == 0 || first < count) && "First index out of range");
+  if (count == 0 || sampleCount == 0 || first >= count)
+    return;
+
+  sampleCount = std::min(sampleCount, count);
+  indices.reserve(sampleCount);
+  std::vector<T> distances(count, std::numeric_limits<T>::max());
+  std::vector<Farthest> partial(pool ? pool->WorkerCount() + 1 : 1);
+  u32 current = first;
+  indices.push_back(current);
+
+  while (indices.size() < sampleCount) {
+    Vector3<T> sample = points[current];
+    std::size_t blocks = ForEachBlock(
+        count, pool, grain,
+        [&](std::size_t block, std::size_t begin, std::size_t end) {
+          Farthest farthest = {static_cast<T>(-1), 0};
+          for (std::size_t i = begin; i < end; ++i) {
+            T distance = std::min(distances[i], (points[i] - sample).LengthSquared());
+            distances[i] = distance;
+            if (distance > farthest.distanceSquared)
+              farthest = {distance, static_cast<u32>(i)};
+          }
+          partial[block] = farthest;
+        }
+    );
+
+    // blocks are in index order, so ties go to the lowest index as in one serial pass
+    Farthest farthest = partial[0];
+    for (std::size_t block = 1; block < blocks; ++block) {
+      if (partial[block].distanceSquared > farthest.distanceSquared)
+        farthest = partial[block];
+    }
+    // only duplicates of picked points are left
+    if (!(farthest.distanceSquared > 0))
+      break;
+    current = farthest.index;
+    indices.push_back(current);
+  }
+}
+
+template <typename T>
+void RemoveStatisticalOutliers(
+    const Vector3<T>* points,
+    std::size_t count,
+    std::size_t k,
+    T stdRatio,
+    std::vector<u32>& inliers,
+    Parallel::ThreadPool* pool,
+    std::size_t grain
+) noexcept
+{
+  using Neighbor = typename KdTree<T, 3>::Neighbor;
+
+  inliers.clear();
+  if (count == 0)
+    return;
+
+  KdTree<T, 3> tree;
+  if (pool)
+    tree.Build(points, count, *pool);
+  else
+    tree.Build(points, count);
+
+  // the nearest neighbor of every point is the point itself and is skipped
+  std::vector<T> meanDistances(count);
+  auto measure = [&](std::size_t begin, std::size_t end) {
+    std::vector<Neighbor> neighbors(k + 1);
+    for (std::size_t i = begin; i < end; ++i) {
+      std::size_t found = tree.KNearest(points[i], k + 1, neighbors.data());
+      T sum = static_cast<T>(0);
+      for (std::size_t j = 1; j < found; ++j)
+        sum += std::sqrt(neighbors[j].distanceSquared);
+      meanDistances[i] = found > 1 ? sum / static_cast<T>(found - 1) : static_cast<T>(0);
+    }
+  };
+  if (pool)
+    pool->ParallelFor(count, grain, measure);
+  else
+    measure(0, count);
+
+  f64 sum = 0.0;
+  f64 sumSquares = 0.0;
+  for (T distance : meanDistances) {
+    sum += distance;
+    sumSquares += static_cast<f64>(distance) * distance;
+  }
+  f64 mean = sum / count;
+  f64 variance = count > 1 ? std::max(0.0, (sumSquares - sum * mean) / (count - 1)) : 0.0;
+  T threshold = static_cast<T>(mean + stdRatio * std::sqrt(variance));
+
+  std::vector<u8> mask;
+  FillMask(count, mask, pool, PointCloudFilterSettings::grain, [&](std::size_t i) {
+    return meanDistances[i] <= threshold;
+  });
+  CompactMask(mask, count, inliers, pool);
+}
+
+} // namespace Internal
+
+template <typename T>
+void VoxelDownsample(
+    const Vector3<T>* points,
+    std::size_t count,
+    T voxelSize,
+    std::vector<Vector3<T>>& out
+) noexcept
+{
+  Internal::VoxelDownsample(
+      points, count, voxelSize, out, nullptr, PointCloudFilterSettings::grain
+  );
+}
+
+template <typename T>
+void VoxelDownsample(
+    const Vector3<T>* points,
+    std::size_t count,
+    T voxelSize,
+    std::vector<Vector3<T>>& out,
+    Parallel::ThreadPool& pool,
+    std::size_t grain
+) noexcept
+{
+  Internal::VoxelDownsample(points, count, voxelSize, out, &pool, grain);
+}
+
+template <typename T>
+void FarthestPointSample(
+    const Vector3<T>* points,
+    std::size_t count,
+    std::size_t sampleCount,
+    std::vector<u32>& indices,
+    u32 first
+) noexcept
+{
+  Internal::FarthestPointSample(
+      points, count, sampleCount, indices, first, nullptr, PointCloudFilterSettings::grain
+  );
+}
+
+template <typename T>
+void FarthestPointSample(
+    const Vector3<T>* points,
+    std::size_t count,
+    std::size_t sampleCount,
+    std::vector<u32>& indices,
+    Parallel::ThreadPool& pool,
+    u32 first,
+    std::size_t grain
+) noexcept
+{
+  Internal::FarthestPointSample(points, count, sampleCount, indices, first, &pool, grain);
+}
+
+template <typename T>
+void RemoveStatisticalOutliers(
+    const Vector3<T>* points,
+    std::size_t count,
+    std::size_t k,
+    T stdRatio,
+    std::vector<u32>& inliers
+) noexcept
+{
+  Internal::RemoveStatisticalOutliers(
+      points, count, k, stdRatio, inliers, nullptr, PointCloudFilterSettings::queryGrain
+  );
+}
+
+template <typename T>
+void RemoveStatisticalOutliers(
+    const Vector3<T>* points,
+    std::size_t count,
+    std::size_t k,
+    T stdRatio,
+    std::vector<u32>& inliers,
+    Parallel::ThreadPool& pool,
+    std::size_t grain
+) noexcept
+{
+  Internal::RemoveStatisticalOutliers(points, count, k, stdRatio, inliers, &pool, grain);
+}
+
+} // namespace Engine::Core::Spatial
@@ -0,0 +1,170 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file AnimationTrack.test.cpp
+ * @brief Tests for keyframe tracks with reduction and quantized storage
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <core/animation/AnimationTrack.h>
+#include <random>
+#include <vector>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Animation;
+using Engine::Core::Math::Quaternionf;
+using Engine::Core::Math::Vector3f;
+
+namespace
+{
+
+std::vector<Keyframe<Vector3f>> Wave(u32 count)
+{
+  std::vector<Keyframe<Vector3f>> keys;
+  for (u32 i = 0; i < count; ++i) {
+    f32 time = static_cast<f32>(i) / 30.0f;
+    keys.push_back({time, Vector3f(std::sin(time * 2.0f), std::cos(time), time * 0.5f)});
+  }
+  return keys;
+}
+
+/// Rotation angle between a and b, from the chord to stay accurate for tiny angles
+f32 Angle(const Quaternionf& a, const Quaternionf& b)
+{
+  f32 chord = std::min((a - b).Length(), (a + b).Length());
+  return 4.0f * std::asin(std::min(chord * 0.5f, 1.0f));
+}
+
+} // namespace
+
+/* ---- Interpolation ---- */
+TEST(AnimationTrackTest, ConstantSteps)
+{
+  std::vector<Keyframe<Vector3f>> keys = {
+      {0.0f, Vector3f(0.0f)},
+      {1.0f, Vector3f(1.0f)},
+      {2.0f, Vector3f(1.0f)},
+      {3.0f, Vector3f(4.0f)},
+  };
+  VectorTrackf track;
+  track.Build(keys.data(), keys.size(), Interpolation::Constant);
+  // the key at time 2 repeats its predecessor
+  EXPECT_EQ(track.KeyCount(), 3u);
+  EXPECT_LT(track.Sample(0.5f).DistanceTo(Vector3f(0.0f)), 1e-3f);
+  EXPECT_LT(track.Sample(2.5f).DistanceTo(Vector3f(1.0f)), 1e-3f);
+  EXPECT_LT(track.Sample(3.0f).DistanceTo(Vector3f(4.0f)), 1e-3f);
+  EXPECT_LT(track.Sample(10.0f).DistanceTo(Vector3f(4.0f)), 1e-3f);
+  EXPECT_LT(track.Sample(-1.0f).DistanceTo(Vector3f(0.0f)), 1e-3f);
+}
+
+TEST(AnimationTrackTest, LinearDropsCollinearKeys)
+{
+  std::vector<Keyframe<Vector3f>> keys;
+  for (i32 i = 0; i <= 100; ++i) {
+    f32 t = static_cast<f32>(i) * 0.1f;
+    keys.push_back({t, Vector3f(t, 2.0f * t, -t)});
+  }
+  VectorTrackf track;
+  track.Build(keys.data(), keys.size(), Interpolation::Linear, 1e-4f);
+  EXPECT_EQ(track.KeyCount(), 2u);
+  EXPECT_EQ(track.MemorySize(), 2u * 8u);
+  Vector3f middle = track.Sample(5.0f);
+  EXPECT_NEAR(middle.x, 5.0f, 1e-3f);
+  EXPECT_NEAR(middle.y, 10.0f, 1e-3f);
+  EXPECT_NEAR(track.EndTime(), 10.0f, 1e-4f);
+}
+
+TEST(AnimationTrackTest, ReductionStaysWithinTolerance)
+{
+  std::vector<Keyframe<Vector3f>> keys = Wave(300);
+  for (Interpolation mode : {Interpolation::Linear, Interpolation::Cubic}) {
+    VectorTrackf track;
+    track.Build(keys.data(), keys.size(), mode, 1e-3f);
+    EXPECT_LT(track.KeyCount(), keys.size());
+    for (const Keyframe<Vector3f>& key : keys)
+      EXPECT_LE(track.Sample(key.time).DistanceTo(key.value), 1e-3f + 1e-4f) << key.time;
+  }
+
+  VectorTrackf linear;
+  VectorTrackf cubic;
+  linear.Build(keys.data(), keys.size(), Interpolation::Linear, 1e-3f);
+  cubic.Build(keys.data(), keys.size(), Interpolation::Cubic, 1e-3f);
+  // cubic keys follow the curve, so the same tolerance keeps far fewer of them
+  EXPECT_LT(cubic.KeyCount() * 3 / 2, linear.KeyCount());
+}
+
+TEST(AnimationTrackTest, LosslessBuildKeepsKeys)
+{
+  std::vector<Keyframe<Vector3f>> keys = Wave(50);
+  VectorTrackf track;
+  track.Build(keys.data(), keys.size(), Interpolation::Cubic);
+  EXPECT_EQ(track.KeyCount(), keys.size());
+  for (const Keyframe<Vector3f>& key : keys)
+    EXPECT_LE(track.Sample(key.time).DistanceTo(key.value), 1e-4f);
+}
+
+/* ---- Cursor ---- */
+TEST(AnimationTrackTest, CursorMatchesSearch)
+{
+  std::vector<Keyframe<Vector3f>> keys = Wave(200);
+  VectorTrackf track;
+  track.Build(keys.data(), keys.size(), Interpolation::Cubic, 1e-4f);
+
+  TrackCursor cursor;
+  // two loops of playback and a few jumps backward
+  for (u32 frame = 0; frame < 800; ++frame) {
+    f32 time = std::fmod(static_cast<f32>(frame) / 60.0f, 6.0f);
+    Vector3f sequential = track.Sample(time, cursor);
+    Vector3f searched = track.Sample(time);
+    ASSERT_EQ(sequential, searched) << time;
+  }
+  for (f32 time : {5.0f, 1.0f, 6.5f, -1.0f, 3.0f}) {
+    Vector3f sequential = track.Sample(time, cursor);
+    EXPECT_EQ(sequential, track.Sample(time));
+  }
+}
+
+/* ---- Rotations ---- */
+TEST(AnimationTrackTest, RotationQuantization)
+{
+  std::mt19937 random(4);
+  std::normal_distribution<f32> component(0.0f, 1.0f);
+  std::vector<Keyframe<Quaternionf>> keys;
+  for (i32 i = 0; i < 100; ++i) {
+    Quaternionf q(component(random), component(random), component(random), component(random));
+    keys.push_back({static_cast<f32>(i), q.Normalized()});
+  }
+  RotationTrackf track;
+  track.Build(keys.data(), keys.size(), Interpolation::Constant);
+  ASSERT_EQ(track.KeyCount(), keys.size());
+  EXPECT_EQ(track.MemorySize(), keys.size() * 8u);
+  for (const Keyframe<Quaternionf>& key : keys) {
+    Quaternionf sample = track.Sample(key.time);
+    EXPECT_NEAR(sample.Length(), 1.0f, 1e-5f);
+    EXPECT_LT(Angle(sample, key.value), 2e-4f);
+  }
+}
+
+TEST(AnimationTrackTest, RotationReduction)
+{
+  Vector3f axis = Vector3f(1.0f, 2.0f, 2.0f).Normalized();
+  std::vector<Keyframe<Quaternionf>> keys;
+  for (i32 i = 0; i <= 120; ++i) {
+    f32 time = static_cast<f32>(i) / 30.0f;
+    // uneven angular speed, sign flips must not matter
+    Quaternionf q = Quaternionf::FromAxisAngle(axis, std::sin(time) * 3.0f);
+    keys.push_back({time, i % 2 == 0 ? q : -q});
+  }
+
+  for (Interpolation mode : {Interpolation::Linear, Interpolation::Cubic}) {
+    RotationTrackf track;
+    track.Build(keys.data(), keys.size(), mode, 2e-3f);
+    EXPECT_LT(track.KeyCount(), keys.size() / 2);
+    for (const Keyframe<Quaternionf>& key : keys)
+      EXPECT_LT(Angle(track.Sample(key.time), key.value), 2e-3f + 4e-4f) << key.time;
+  }
+}
@@ -0,0 +1,251 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Skinning.test.cpp
+ * @brief Tests for linear blend and dual quaternion skinning
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <core/animation/Skinning.h>
+#include <random>
+#include <vector>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Animation;
+using Engine::Core::Math::Quaternionf;
+using Engine::Core::Math::Transformf;
+using Engine::Core::Math::Vector3Arrayf;
+using Engine::Core::Math::Vector3f;
+
+namespace
+{
+
+std::vector<Transformf> RandomBones(u32 count, std::mt19937& random)
+{
+  std::uniform_real_distribution<f32> offset(-2.0f, 2.0f);
+  std::uniform_real_distribution<f32> angle(-3.0f, 3.0f);
+  std::vector<Transformf> bones;
+  for (u32 i = 0; i < count; ++i) {
+    Vector3f axis = Vector3f(offset(random), offset(random), offset(random) + 0.1f).Normalized();
+    bones.emplace_back(
+        Vector3f(offset(random), offset(random), offset(random)),
+        Quaternionf::FromAxisAngle(axis, angle(random))
+    );
+  }
+  return bones;
+}
+
+Vector3Arrayf RandomPoints(u32 count, std::mt19937& random)
+{
+  std::uniform_real_distribution<f32> coordinate(-1.0f, 1.0f);
+  Vector3Arrayf points;
+  for (u32 i = 0; i < count; ++i)
+    points.PushBack(Vector3f(coordinate(random), coordinate(random), coordinate(random)));
+  return points;
+}
+
+/// Two influences per vertex, the second one zero for every third vertex
+void RandomInfluences(
+    u32 vertexCount,
+    u32 boneCount,
+    std::mt19937& random,
+    std::vector<u16>& bones,
+    std::vector<f32>& weights
+)
+{
+  std::uniform_int_distribution<u32> bone(0, boneCount - 1);
+  std::uniform_real_distribution<f32> weight(0.1f, 1.0f);
+  for (u32 i = 0; i < vertexCount; ++i) {
+    bones.push_back(static_cast<u16>(bone(random)));
+    bones.push_back(static_cast<u16>(bone(random)));
+    weights.push_back(weight(random));
+    weights.push_back(i % 3 == 0 ? 0.0f : weight(random));
+  }
+}
+
+} // namespace
+
+/* ---- Weights ---- */
+TEST(SkinningTest, WeightsKeepLargestInfluences)
+{
+  std::vector<u16> bones = {7, 3, 5, 1, 2, 9, 0, 0, 0, 0, 0, 4};
+  std::vector<f32> weights = {0.1f, 0.4f, 0.05f, 0.2f, 0.2f, 0.3f, 0, 0, 0, 0, 0, 0};
+  SkinWeights skin;
+  skin.Build(bones.data(), weights.data(), 2, 6);
+  EXPECT_EQ(skin.VertexCount(), 2u);
+  EXPECT_EQ(skin.SlotCount(), 4u);
+  EXPECT_EQ(skin.BoneCount(), 10u);
+
+  // 0.1 and 0.05 are dropped and the rest renormalized
+  EXPECT_EQ(skin.Bones(0)[0], 3u);
+  EXPECT_EQ(skin.Bones(1)[0], 9u);
+  EXPECT_NEAR(skin.Weights(0)[0], 0.4f / 1.1f, 1e-6f);
+  f32 sum = 0.0f;
+  for (u32 slot = 0; slot < 4; ++slot)
+    sum += skin.Weights(slot)[0];
+  EXPECT_NEAR(sum, 1.0f, 1e-6f);
+
+  // without weights the vertex follows its first bone
+  EXPECT_EQ(skin.Bones(0)[1], 0u);
+  EXPECT_EQ(skin.Weights(0)[1], 1.0f);
+  EXPECT_EQ(skin.Weights(1)[1], 0.0f);
+}
+
+/* ---- Linear blend ---- */
+TEST(SkinningTest, LinearBlendMatchesTransforms)
+{
+  std::mt19937 random(7);
+  std::vector<Transformf> bones = RandomBones(6, random);
+  bones[2].scale = Vector3f(2.0f, 0.5f, 1.5f);
+  Vector3Arrayf positions = RandomPoints(101, random);
+  std::vector<u16> vertexBones;
+  std::vector<f32> vertexWeights;
+  RandomInfluences(101, 6, random, vertexBones, vertexWeights);
+
+  SkinPose pose;
+  pose.Set(bones.data(), bones.size());
+  SkinWeights skin;
+  skin.Build(vertexBones.data(), vertexWeights.data(), 101, 2);
+  Vector3Arrayf skinned;
+  Skin(SkinningMethod::LinearBlend, pose, skin, positions, skinned);
+  ASSERT_EQ(skinned.Size(), positions.Size());
+
+  for (u32 i = 0; i < 101; ++i) {
+    Vector3f expected = Vector3f::Zero();
+    for (u32 slot = 0; slot < skin.SlotCount(); ++slot) {
+      const Transformf& bone = bones[skin.Bones(slot)[i]];
+      expected += bone.TransformPoint(positions.Get(i)) * skin.Weights(slot)[i];
+    }
+    EXPECT_LT(skinned.Get(i).DistanceTo(expected), 1e-4f) << i;
+  }
+}
+
+TEST(SkinningTest, NormalsFollowRotation)
+{
+  std::mt19937 random(3);
+  std::vector<Transformf> bones = RandomBones(1, random);
+  Vector3Arrayf positions = RandomPoints(37, random);
+  Vector3Arrayf normals;
+  for (u32 i = 0; i < 37; ++i)
+    normals.PushBack(positions.Get(i).Normalized());
+  std::vector<u16> vertexBones(37, 0);
+  std::vector<f32> vertexWeights(37, 1.0f);
+  SkinPose pose;
+  pose.Set(bones.data(), bones.size());
+  SkinWeights skin;
+  skin.Build(vertexBones.data(), vertexWeights.data(), 37, 1);
+
+  for (SkinningMethod method : {SkinningMethod::LinearBlend, SkinningMethod::DualQuaternion}) {
+    Vector3Arrayf outPositions;
+    Vector3Arrayf outNormals;
+    Skin(method, pose, skin, positions, normals, outPositions, outNormals);
+    for (u32 i = 0; i < 37; ++i) {
+      Vector3f point = bones[0].TransformPoint(positions.Get(i));
+      Vector3f normal = bones[0].TransformVector(normals.Get(i));
+      EXPECT_LT(outPositions.Get(i).DistanceTo(point), 1e-4f);
+      EXPECT_LT(outNormals.Get(i).DistanceTo(normal), 1e-4f);
+    }
+  }
+}
+
+/* ---- Dual quaternion ---- */
+TEST(SkinningTest, DualQuaternionRigidBones)
+{
+  std::mt19937 random(11);
+  std::vector<Transformf> bones = RandomBones(5, random);
+  Vector3Arrayf positions = RandomPoints(64, random);
+  std::vector<u16> vertexBones;
+  std::vector<f32> vertexWeights;
+  for (u32 i = 0; i < 64; ++i) {
+    // the same bone twice, one of them with the negated quaternion
+    vertexBones.insert(vertexBones.end(), {static_cast<u16>(i % 5), static_cast<u16>(i % 5)});
+    vertexWeights.insert(vertexWeights.end(), {0.3f, 0.7f});
+  }
+  SkinPose pose;
+  pose.Set(bones.data(), bones.size());
+  SkinWeights skin;
+  skin.Build(vertexBones.data(), vertexWeights.data(), 64, 2);
+  Vector3Arrayf skinned;
+  Skin(SkinningMethod::DualQuaternion, pose, skin, positions, skinned);
+  for (u32 i = 0; i < 64; ++i) {
+    Vector3f expected = bones[i % 5].TransformPoint(positions.Get(i));
+    EXPECT_LT(skinned.Get(i).DistanceTo(expected), 1e-4f) << i;
+  }
+
+  // q and -q describe the same bone
+  std::vector<Transformf> flipped = bones;
+  for (Transformf& bone : flipped)
+    bone.rotation = -bone.rotation;
+  flipped.insert(flipped.end(), bones.begin(), bones.end());
+  for (u32 i = 0; i < 64; ++i)
+    vertexBones[2 * i + 1] = static_cast<u16>(i % 5 + 5);
+  pose.Set(flipped.data(), flipped.size());
+  skin.Build(vertexBones.data(), vertexWeights.data(), 64, 2);
+  Vector3Arrayf mixed;
+  Skin(SkinningMethod::DualQuaternion, pose, skin, positions, mixed);
+  for (u32 i = 0; i < 64; ++i)
+    EXPECT_LT(mixed.Get(i).DistanceTo(skinned.Get(i)), 1e-4f) << i;
+}
+
+TEST(SkinningTest, DualQuaternionKeepsVolumeOnTwist)
+{
+  // a vertex on a unit circle around a joint twisted by 180 degrees
+  std::vector<Transformf> bones = {
+      Transformf(),
+      Transformf(Vector3f::Zero(), Quaternionf::FromAxisAngle(Vector3f(1.0f, 0.0f, 0.0f), 3.1f)),
+  };
+  Vector3Arrayf positions;
+  positions.PushBack(Vector3f(0.0f, 1.0f, 0.0f));
+  std::vector<u16> vertexBones = {0, 1};
+  std::vector<f32> vertexWeights = {0.5f, 0.5f};
+  SkinPose pose;
+  pose.Set(bones.data(), bones.size());
+  SkinWeights skin;
+  skin.Build(vertexBones.data(), vertexWeights.data(), 1, 2);
+
+  Vector3Arrayf linear;
+  Vector3Arrayf dual;
+  Skin(SkinningMethod::LinearBlend, pose, skin, positions, linear);
+  Skin(SkinningMethod::DualQuaternion, pose, skin, positions, dual);
+  // linear blending collapses the vertex onto the axis
+  EXPECT_LT(linear.Get(0).Length(), 0.1f);
+  EXPECT_NEAR(dual.Get(0).Length(), 1.0f, 1e-4f);
+}
+
+/* ---- Parallel ---- */
+TEST(SkinningTest, ParallelMatchesSerial)
+{
+  std::mt19937 random(5);
+  std::vector<Transformf> bones = RandomBones(16, random);
+  Vector3Arrayf positions = RandomPoints(5003, random);
+  Vector3Arrayf normals = RandomPoints(5003, random);
+  std::vector<u16> vertexBones;
+  std::vector<f32> vertexWeights;
+  RandomInfluences(5003, 16, random, vertexBones, vertexWeights);
+  SkinPose pose;
+  pose.Set(bones.data(), bones.size());
+  SkinWeights skin;
+  skin.Build(vertexBones.data(), vertexWeights.data(), 5003, 2);
+
+  Parallel::ThreadPool pool(3);
+  for (SkinningMethod method : {SkinningMethod::LinearBlend, SkinningMethod::DualQuaternion}) {
+    Vector3Arrayf serialPositions;
+    Vector3Arrayf serialNormals;
+    Vector3Arrayf parallelPositions;
+    Vector3Arrayf parallelNormals;
+    Skin(method, pose, skin, positions, normals, serialPositions, serialNormals);
+    Skin(method, pose, skin, positions, normals, parallelPositions, parallelNormals, pool, 256);
+    EXPECT_EQ(serialPositions.x, parallelPositions.x);
+    EXPECT_EQ(serialPositions.z, parallelPositions.z);
+    EXPECT_EQ(serialNormals.y, parallelNormals.y);
+
+    // skinning in place gives the same result
+    Vector3Arrayf inPlace = positions;
+    Skin(method, pose, skin, inPlace, inPlace, pool);
+    EXPECT_EQ(inPlace.y, serialPositions.y);
+  }
+}
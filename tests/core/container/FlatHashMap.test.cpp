@@ -0,0 +1,177 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file FlatHashMap.test.cpp
+ * @brief Tests for FlatHashMap class
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/container/FlatHashMap.h>
+#include <limits>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Container;
+using namespace Engine::Core::Math;
+
+namespace
+{
+
+/// Sends all keys to one group to exercise probing
+struct CollidingHash
+{
+  u64 operator()(u32 key) const noexcept
+  {
+    return key & 0x7f;
+  }
+};
+
+} // namespace
+
+/* ------------------------------------------ Updates ------------------------------------------ */
+
+TEST(FlatHashMapTest, InsertFind)
+{
+  FlatHashMap<u32, i32> map;
+  EXPECT_TRUE(map.Empty());
+  EXPECT_EQ(map.Find(1), (FlatHashMap<u32, i32>::invalidHandle));
+
+  auto [handle, inserted] = map.Insert(1, 10);
+  EXPECT_TRUE(inserted);
+  EXPECT_FALSE(map.Insert(1, 20).second);
+  EXPECT_EQ(map.ValueAt(handle), 10);
+
+  map.InsertOrAssign(1, 30);
+  EXPECT_EQ(*map.Get(1), 30);
+  map[2] += 5;
+  EXPECT_EQ(map[2], 5);
+  EXPECT_EQ(map.Size(), 2u);
+  EXPECT_EQ(map.Get(3), nullptr);
+}
+
+TEST(FlatHashMapTest, HandlesSurviveRehash)
+{
+  FlatHashMap<u32, u32> map;
+  std::vector<u32> handles;
+  for (u32 i = 0; i < 10000; ++i)
+    handles.push_back(map.Insert(i * 7919, i).first);
+  EXPECT_GE(map.Capacity(), 10000u);
+
+  for (u32 i = 0; i < 10000; ++i) {
+    EXPECT_EQ(map.KeyAt(handles[i]), i * 7919);
+    EXPECT_EQ(map.ValueAt(handles[i]), i);
+  }
+}
+
+TEST(FlatHashMapTest, EraseAndReuse)
+{
+  FlatHashMap<u32, u32> map;
+  for (u32 i = 0; i < 100; ++i)
+    map.Insert(i, i);
+  u32 handle = map.Find(50);
+  EXPECT_TRUE(map.Erase(50u));
+  EXPECT_FALSE(map.Erase(50u));
+  EXPECT_FALSE(map.IsValid(handle));
+  EXPECT_FALSE(map.Contains(50));
+
+  map.EraseAt(map.Find(51));
+  EXPECT_EQ(map.Size(), 98u);
+  EXPECT_EQ(map.Insert(1000, 7).first, 51u);
+
+  u32 sum = 0;
+  map.ForEach([&sum](const u32&, u32& value) { sum += value; });
+  EXPECT_EQ(sum, 99u * 100u / 2u - 50u - 51u + 7u);
+}
+
+TEST(FlatHashMapTest, Reserve)
+{
+  FlatHashMap<u32, u32> map(1000);
+  u32 capacity = map.Capacity();
+  EXPECT_GE(capacity * 7 / 8, 1000u);
+  for (u32 i = 0; i < 1000; ++i)
+    map.Insert(i, i);
+  EXPECT_EQ(map.Capacity(), capacity);
+
+  map.Clear();
+  EXPECT_TRUE(map.Empty());
+  EXPECT_FALSE(map.Contains(5));
+  EXPECT_EQ(map.Capacity(), capacity);
+}
+
+/* ------------------------------------------ Probing ------------------------------------------ */
+
+TEST(FlatHashMapTest, CollisionsAndTombstones)
+{
+  FlatHashMap<u32, u32, CollidingHash> map;
+  // every insert and erase cycle leaves deleted slots behind in full groups
+  for (u32 round = 0; round < 20; ++round) {
+    for (u32 i = 0; i < 200; ++i)
+      map.Insert(round * 1000 + i, i);
+    for (u32 i = 0; i < 200; i += 2)
+      map.Erase(round * 1000 + i);
+  }
+  EXPECT_EQ(map.Size(), 20u * 100u);
+  for (u32 round = 0; round < 20; ++round) {
+    for (u32 i = 0; i < 200; ++i)
+      EXPECT_EQ(map.Contains(round * 1000 + i), i % 2 == 1);
+  }
+}
+
+TEST(FlatHashMapTest, RandomAgainstUnorderedMap)
+{
+  std::mt19937 random(3);
+  FlatHashMap<u64, u32> map;
+  std::unordered_map<u64, u32> reference;
+  for (u32 i = 0; i < 50000; ++i) {
+    u64 key = random() % 5000;
+    if (random() % 3 == 0) {
+      EXPECT_EQ(map.Erase(key), reference.erase(key) == 1);
+    } else {
+      map.InsertOrAssign(key, i);
+      reference[key] = i;
+    }
+  }
+  EXPECT_EQ(map.Size(), reference.size());
+  for (const auto& [key, value] : reference)
+    EXPECT_EQ(*map.Get(key), value);
+}
+
+/* ---------------------------------------- Spatial keys --------------------------------------- */
+
+TEST(FlatHashMapTest, GridCells)
+{
+  FlatHashMap<Vector3<i32>, u32> cells;
+  for (i32 x = -10; x < 10; ++x) {
+    for (i32 y = -10; y < 10; ++y)
+      cells[Vector3<i32>(x, y, x ^ y)] += 1;
+  }
+  EXPECT_EQ(cells.Size(), 400u);
+  EXPECT_EQ(*cells.Get(Vector3<i32>(-3, 4, -3 ^ 4)), 1u);
+
+  FlatHashMap<Vector3f, u32> points;
+  points.Insert(Vector3f(0.5f, 1.5f, 2.5f), 1);
+  EXPECT_TRUE(points.Contains(Vector3f(0.5f, 1.5f, 2.5f)));
+  EXPECT_FALSE(points.Contains(Vector3f(0.5f, 1.5f, 2.5000002f)));
+}
+
+TEST(FlatHashMapTest, NaNKeyFindsItsEntry)
+{
+  f32 nan = std::numeric_limits<f32>::quiet_NaN();
+  FlatHashMap<f32, u32> values;
+  EXPECT_TRUE(values.Insert(nan, 1).second);
+  EXPECT_FALSE(values.Insert(-nan, 2).second);
+  values[nan] += 1;
+  EXPECT_EQ(values.Size(), 1u);
+  EXPECT_EQ(*values.Get(nan), 2u);
+
+  FlatHashMap<Vector3f, u32> points;
+  points[Vector3f(nan, 0.0f, 1.0f)] += 1;
+  points[Vector3f(nan, 0.0f, 1.0f)] += 1;
+  EXPECT_EQ(points.Size(), 1u);
+  EXPECT_EQ(*points.Get(Vector3f(nan, 0.0f, 1.0f)), 2u);
+}
@@ -0,0 +1,75 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Hash.test.cpp
+ * @brief Tests for hash and equality functors
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <core/container/Hash.h>
+#include <limits>
+#include <set>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Container;
+using namespace Engine::Core::Math;
+
+/* ------------------------------------------- Hashes ------------------------------------------ */
+
+TEST(HashTest, Integers)
+{
+  Hash<u32> hash;
+  std::set<u64> low;
+  // consecutive keys must differ in the low bits used as tags
+  for (u32 i = 0; i < 1000; ++i)
+    low.insert(hash(i) & 0x7f);
+  EXPECT_GT(low.size(), 120u);
+  EXPECT_EQ(hash(42u), hash(42u));
+}
+
+TEST(HashTest, FloatZeros)
+{
+  EXPECT_EQ(Hash<f32>()(0.0f), Hash<f32>()(-0.0f));
+  Hash<Vector3f> hash;
+  EXPECT_EQ(hash(Vector3f(0.0f, -0.0f, 1.0f)), hash(Vector3f(0.0f, 0.0f, 1.0f)));
+}
+
+TEST(HashTest, VectorComponentsOrder)
+{
+  Hash<Vector3<i32>> hash;
+  EXPECT_NE(hash(Vector3<i32>(1, 2, 3)), hash(Vector3<i32>(3, 2, 1)));
+  EXPECT_NE(hash(Vector3<i32>(1, 0, 0)), hash(Vector3<i32>(0, 1, 0)));
+}
+
+TEST(HashTest, EdgeKeyIgnoresDirection)
+{
+  EXPECT_EQ(EdgeKey(3, 7), EdgeKey(7, 3));
+  EXPECT_NE(EdgeKey(3, 7), EdgeKey(3, 8));
+  EXPECT_EQ(EdgeKey(0xffffffffu, 1), (u64(1) << 32) | 0xffffffffu);
+}
+
+/* ------------------------------------------ Equality ----------------------------------------- */
+
+TEST(HashTest, VectorEqualityIsExact)
+{
+  Equal<Vector3f> equal;
+  EXPECT_TRUE(equal(Vector3f(1.0f, 2.0f, 3.0f), Vector3f(1.0f, 2.0f, 3.0f)));
+  EXPECT_FALSE(equal(Vector3f(1.0f, 2.0f, 3.0f), Vector3f(1.0f, 2.0f, 3.0000002f)));
+  EXPECT_TRUE(equal(Vector3f(0.0f, 0.0f, 0.0f), Vector3f(-0.0f, 0.0f, 0.0f)));
+}
+
+TEST(HashTest, NaNIsOneKey)
+{
+  f32 nan = std::numeric_limits<f32>::quiet_NaN();
+  f32 negative = -std::numeric_limits<f32>::quiet_NaN();
+  EXPECT_TRUE(Equal<f32>()(nan, negative));
+  EXPECT_FALSE(Equal<f32>()(nan, 1.0f));
+  EXPECT_EQ(Hash<f32>()(nan), Hash<f32>()(negative));
+  EXPECT_EQ(Hash<f64>()(std::nan("1")), Hash<f64>()(std::nan("2")));
+  EXPECT_TRUE(Equal<Vector2f>()(Vector2f(nan, 1.0f), Vector2f(negative, 1.0f)));
+  EXPECT_EQ(Hash<Vector2f>()(Vector2f(nan, 1.0f)), Hash<Vector2f>()(Vector2f(negative, 1.0f)));
+}
@@ -0,0 +1,121 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file CommandBuffer.test.cpp
+ * @brief Tests for CommandBuffer class
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/ecs/CommandBuffer.h>
+#include <vector>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Ecs;
+
+namespace
+{
+
+struct Lifetime
+{
+  i32 frames;
+};
+
+struct Spawned
+{
+  i32 parent;
+};
+
+} // namespace
+
+/* ------------------------------------------ Playback ----------------------------------------- */
+
+TEST(CommandBufferTest, DeferredChangesDuringIteration)
+{
+  World world;
+  for (i32 i = 0; i < 100; ++i)
+    world.Create(Lifetime{i % 4});
+
+  CommandBuffer commands;
+  world.ForEachChunk<const Lifetime>([&](const ChunkView& chunk) {
+    const Lifetime* lifetimes = chunk.Column<const Lifetime>();
+    for (u32 i = 0; i < chunk.Size(); ++i) {
+      if (lifetimes[i].frames == 0)
+        commands.Destroy(chunk.Entities()[i]);
+    }
+  });
+  EXPECT_EQ(world.Size(), 100u);
+  EXPECT_FALSE(commands.Empty());
+
+  commands.Playback(world);
+  EXPECT_TRUE(commands.Empty());
+  EXPECT_EQ(world.Size(), 75u);
+}
+
+TEST(CommandBufferTest, CreatedPlaceholders)
+{
+  World world;
+  CommandBuffer commands;
+  Entity a = commands.Create(Lifetime{3});
+  Entity b = commands.Create(Lifetime{5}, Spawned{7});
+  commands.Add(a, Spawned{1});
+  commands.Remove<Lifetime>(b);
+  commands.Playback(world);
+
+  std::vector<i32> parents;
+  u32 withLifetime = 0;
+  world.ForEach<const Spawned>([&](const Spawned& spawned) { parents.push_back(spawned.parent); });
+  world.ForEach<const Lifetime>([&](const Lifetime&) { ++withLifetime; });
+  EXPECT_EQ(world.Size(), 2u);
+  EXPECT_EQ(withLifetime, 1u);
+  ASSERT_EQ(parents.size(), 2u);
+  EXPECT_EQ(parents[0] + parents[1], 8);
+}
+
+/* --------------------------------------- Stale entities -------------------------------------- */
+
+TEST(CommandBufferTest, TwoBuffersDestroySameEntity)
+{
+  World world;
+  Entity entity = world.Create(Lifetime{0});
+  Entity other = world.Create(Lifetime{1});
+  CommandBuffer first;
+  CommandBuffer second;
+  first.Destroy(entity);
+  second.Destroy(entity);
+  second.Destroy(entity);
+
+  first.Playback(world);
+  second.Playback(world);
+  EXPECT_FALSE(world.IsAlive(entity));
+  EXPECT_TRUE(world.IsAlive(other));
+  EXPECT_EQ(world.Size(), 1u);
+  EXPECT_TRUE(second.Empty());
+}
+
+TEST(CommandBufferTest, ChangesOfDestroyedEntityAreDropped)
+{
+  World world;
+  Entity entity = world.Create(Lifetime{0});
+  CommandBuffer destroy;
+  CommandBuffer change;
+  destroy.Destroy(entity);
+  change.Add(entity, Spawned{2});
+  change.Remove<Lifetime>(entity);
+  Entity created = change.Create(Lifetime{4});
+  change.Destroy(created);
+  change.Add(created, Spawned{3});
+
+  destroy.Playback(world);
+  // the handle slot is reused, the stale handle must not reach the new entity
+  Entity reused = world.Create(Lifetime{5});
+  change.Playback(world);
+
+  u32 spawned = 0;
+  world.ForEach<const Spawned>([&](const Spawned&) { ++spawned; });
+  EXPECT_EQ(spawned, 0u);
+  EXPECT_TRUE(world.IsAlive(reused));
+  EXPECT_EQ(world.Size(), 1u);
+}
@@ -0,0 +1,55 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Component.test.cpp
+ * @brief Tests for component type registry
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/ecs/Component.h>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Ecs;
+
+namespace
+{
+
+struct Health
+{
+  f32 value;
+};
+
+struct Armor
+{
+  f64 value;
+  u8 kind;
+};
+
+} // namespace
+
+TEST(ComponentTest, StableIdsAndInfo)
+{
+  ComponentId health = ComponentTypeId<Health>();
+  ComponentId armor = ComponentTypeId<Armor>();
+  EXPECT_NE(health, armor);
+  EXPECT_EQ(ComponentTypeId<const Health>(), health);
+  EXPECT_EQ(GetComponentInfo(armor).size, sizeof(Armor));
+  EXPECT_EQ(GetComponentInfo(armor).alignment, alignof(Armor));
+  ComponentMask mask = (ComponentMask(1) << health) | (ComponentMask(1) << armor);
+  EXPECT_EQ((ComponentMaskOf<Health, Armor>()), mask);
+}
+
+TEST(ComponentTest, TooManyTypesAbort)
+{
+  // the registry is global, so the types are only registered in the child process of the test
+  EXPECT_DEATH(
+      {
+        for (u32 i = 0; i <= ComponentSettings::maxComponents; ++i)
+          Internal::RegisterComponent(4, 4);
+      },
+      "Too many component types"
+  );
+}
@@ -0,0 +1,125 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Scheduler.test.cpp
+ * @brief Tests for Scheduler class
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/ecs/Scheduler.h>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Ecs;
+
+namespace
+{
+
+struct A
+{
+  f32 value;
+};
+
+struct B
+{
+  f32 value;
+};
+
+struct C
+{
+  f32 value;
+};
+
+} // namespace
+
+/* ------------------------------------------- Stages ------------------------------------------ */
+
+TEST(SchedulerTest, StagesFollowConflicts)
+{
+  Scheduler scheduler;
+  scheduler.Add<A, const B>([](World&, CommandBuffer&) {});
+  scheduler.Add<const B, C>([](World&, CommandBuffer&) {});
+  scheduler.Add<const A>([](World&, CommandBuffer&) {});
+  scheduler.Add<const B>([](World&, CommandBuffer&) {});
+  scheduler.Add<B>([](World&, CommandBuffer&) {});
+
+  EXPECT_EQ(scheduler.StageOf(0), 0u);
+  EXPECT_EQ(scheduler.StageOf(1), 0u);
+  EXPECT_EQ(scheduler.StageOf(2), 1u);
+  EXPECT_EQ(scheduler.StageOf(3), 0u);
+  EXPECT_EQ(scheduler.StageOf(4), 1u);
+  EXPECT_EQ(scheduler.StageCount(), 2u);
+}
+
+/* ------------------------------------------ Running ------------------------------------------ */
+
+TEST(SchedulerTest, RunMatchesSequentialOrder)
+{
+  World world;
+  for (i32 i = 0; i < 5000; ++i)
+    world.Create(A{1.0f}, B{2.0f}, C{0.0f});
+
+  Scheduler scheduler;
+  scheduler.Add<A, const B>([](World& w, CommandBuffer&) {
+    w.ForEach<A, const B>([](A& a, const B& b) { a.value += b.value; });
+  });
+  scheduler.Add<const B, C>([](World& w, CommandBuffer&) {
+    w.ForEach<const B, C>([](const B& b, C& c) { c.value = b.value * 10.0f; });
+  });
+  scheduler.Add<const A, C>([](World& w, CommandBuffer& commands) {
+    w.ForEachChunk<const A, C>([&](const ChunkView& chunk) {
+      const A* a = chunk.Column<const A>();
+      C* c = chunk.Column<C>();
+      for (u32 i = 0; i < chunk.Size(); ++i) {
+        c[i].value += a[i].value;
+        if (i == 0)
+          commands.Destroy(chunk.Entities()[i]);
+      }
+    });
+  });
+
+  Parallel::ThreadPool pool(3);
+  scheduler.Run(world, pool);
+
+  u32 matches = 0;
+  world.ForEach<const A, const C>([&](const A& a, const C& c) {
+    matches += a.value == 3.0f && c.value == 23.0f;
+  });
+  EXPECT_LT(world.Size(), 5000u);
+  EXPECT_EQ(matches, world.Size());
+}
+
+TEST(SchedulerTest, SystemsOfOneStageDestroySameEntity)
+{
+  World world;
+  Entity target = world.Create(A{1.0f}, B{0.0f});
+  world.Create(A{2.0f}, B{0.0f});
+
+  // both systems only read, so they share a stage and play back one after the other
+  Scheduler scheduler;
+  auto destroyFirst = [](World& w, CommandBuffer& commands) {
+    w.ForEachChunk<const A>([&](const ChunkView& chunk) {
+      const A* a = chunk.Column<const A>();
+      for (u32 i = 0; i < chunk.Size(); ++i) {
+        if (a[i].value == 1.0f)
+          commands.Destroy(chunk.Entities()[i]);
+      }
+    });
+  };
+  scheduler.Add<const A>(destroyFirst);
+  scheduler.Add<const A>(destroyFirst);
+  scheduler.Add<const B>([target](World&, CommandBuffer& commands) {
+    commands.Add(target, C{1.0f});
+  });
+  ASSERT_EQ(scheduler.StageCount(), 1u);
+
+  Parallel::ThreadPool pool(3);
+  scheduler.Run(world, pool);
+  EXPECT_FALSE(world.IsAlive(target));
+  EXPECT_EQ(world.Size(), 1u);
+  u32 withC = 0;
+  world.ForEach<const C>([&](const C&) { ++withC; });
+  EXPECT_EQ(withC, 0u);
+}
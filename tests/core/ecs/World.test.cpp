@@ -0,0 +1,146 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file World.test.cpp
+ * @brief Tests for World class
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/ecs/World.h>
+#include <core/math/Vector3.h>
+#include <vector>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Ecs;
+using namespace Engine::Core::Math;
+
+namespace
+{
+
+struct Position
+{
+  Vector3f value;
+};
+
+struct Velocity
+{
+  Vector3f value;
+};
+
+struct Health
+{
+  i32 value;
+};
+
+} // namespace
+
+/* ------------------------------------------ Entities ----------------------------------------- */
+
+TEST(WorldTest, CreateDestroy)
+{
+  World world;
+  Entity a = world.Create(Position{Vector3f(1.0f, 2.0f, 3.0f)});
+  Entity b = world.Create();
+  EXPECT_EQ(world.Size(), 2u);
+  EXPECT_TRUE(world.Has<Position>(a));
+  EXPECT_FALSE(world.Has<Position>(b));
+  EXPECT_EQ(world.Get<Position>(a)->value, Vector3f(1.0f, 2.0f, 3.0f));
+  EXPECT_EQ(world.Get<Position>(b), nullptr);
+
+  world.Destroy(a);
+  EXPECT_FALSE(world.IsAlive(a));
+  EXPECT_TRUE(world.IsAlive(b));
+  EXPECT_EQ(world.Size(), 1u);
+
+  // the reused index gets a new generation
+  Entity c = world.Create();
+  EXPECT_EQ(c.index, a.index);
+  EXPECT_FALSE(world.IsAlive(a));
+  EXPECT_TRUE(world.IsAlive(c));
+}
+
+TEST(WorldTest, AddRemoveComponents)
+{
+  World world;
+  Entity e = world.Create(Position{Vector3f(1.0f, 0.0f, 0.0f)});
+  world.Add(e, Velocity{Vector3f(0.0f, 1.0f, 0.0f)});
+  world.Add(e, Health{10});
+  EXPECT_EQ(world.Get<Position>(e)->value, Vector3f(1.0f, 0.0f, 0.0f));
+  EXPECT_EQ(world.Get<Velocity>(e)->value, Vector3f(0.0f, 1.0f, 0.0f));
+
+  world.Add(e, Health{20});
+  EXPECT_EQ(world.Get<Health>(e)->value, 20);
+
+  world.Remove<Velocity>(e);
+  EXPECT_FALSE(world.Has<Velocity>(e));
+  EXPECT_EQ(world.Get<Position>(e)->value, Vector3f(1.0f, 0.0f, 0.0f));
+  EXPECT_EQ(world.Get<Health>(e)->value, 20);
+}
+
+TEST(WorldTest, DestroyKeepsOtherEntities)
+{
+  World world;
+  std::vector<Entity> entities;
+  for (i32 i = 0; i < 3000; ++i)
+    entities.push_back(world.Create(Health{i}));
+  for (i32 i = 0; i < 3000; i += 3)
+    world.Destroy(entities[i]);
+
+  for (i32 i = 0; i < 3000; ++i) {
+    if (i % 3 == 0)
+      EXPECT_FALSE(world.IsAlive(entities[i]));
+    else
+      EXPECT_EQ(world.Get<Health>(entities[i])->value, i);
+  }
+  EXPECT_EQ(world.Size(), 2000u);
+}
+
+/* ------------------------------------------ Queries ------------------------------------------ */
+
+TEST(WorldTest, ForEachMatchesArchetypes)
+{
+  World world;
+  for (i32 i = 0; i < 1000; ++i) {
+    Entity e = world.Create(Position{Vector3f::Zero()}, Velocity{Vector3f::UnitX()});
+    if (i % 2 == 0)
+      world.Add(e, Health{i});
+  }
+  world.Create(Position{Vector3f(5.0f, 0.0f, 0.0f)});
+  EXPECT_EQ(world.ArchetypeCount(), 4u);
+
+  world.ForEach<Position, const Velocity>([](Position& position, const Velocity& velocity) {
+    position.value += velocity.value;
+  });
+
+  u32 moved = 0;
+  u32 chunks = 0;
+  world.ForEachChunk<Position>([&](const ChunkView& chunk) {
+    ++chunks;
+    const Position* positions = chunk.Column<const Position>();
+    for (u32 i = 0; i < chunk.Size(); ++i)
+      moved += positions[i].value == Vector3f(1.0f, 0.0f, 0.0f);
+  });
+  EXPECT_EQ(moved, 1000u);
+  EXPECT_GT(chunks, 3u);
+}
+
+TEST(WorldTest, ForEachParallel)
+{
+  World world;
+  for (i32 i = 0; i < 20000; ++i)
+    world.Create(Position{Vector3f(0.0f, 0.0f, 0.0f)}, Velocity{Vector3f(0.0f, 2.0f, 0.0f)});
+
+  Parallel::ThreadPool pool(3);
+  world.ForEach<Position, const Velocity>(
+      [](Position& position, const Velocity& velocity) { position.value += velocity.value; }, pool
+  );
+
+  u32 moved = 0;
+  world.ForEach<const Position>([&](const Position& position) {
+    moved += position.value == Vector3f(0.0f, 2.0f, 0.0f);
+  });
+  EXPECT_EQ(moved, 20000u);
+}
@@ -0,0 +1,232 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file DistanceField.test.cpp
+ * @brief Tests for signed distance fields of triangle meshes
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <core/geometry/DistanceField.h>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Geometry;
+using Engine::Core::Math::Vector3f;
+
+namespace
+{
+
+/// Axis aligned cube with half extent size around the origin, wound counterclockwise from outside
+Meshf Cube(f32 size)
+{
+  Meshf cube;
+  for (u32 v = 0; v < 8; ++v) {
+    cube.positions.PushBack(
+        Vector3f(v & 1 ? size : -size, v & 2 ? size : -size, v & 4 ? size : -size)
+    );
+  }
+  cube.indices = {0, 2, 3, 0, 3, 1, 4, 5, 7, 4, 7, 6, 0, 1, 5, 0, 5, 4,
+                  2, 6, 7, 2, 7, 3, 0, 4, 6, 0, 6, 2, 1, 3, 7, 1, 7, 5};
+  return cube;
+}
+
+f32 CubeDistance(const Vector3f& p, f32 size)
+{
+  Vector3f q(std::abs(p.x) - size, std::abs(p.y) - size, std::abs(p.z) - size);
+  Vector3f outside(std::max(q.x, 0.0f), std::max(q.y, 0.0f), std::max(q.z, 0.0f));
+  return outside.Length() + std::min(std::max({q.x, q.y, q.z}), 0.0f);
+}
+
+/// Closed latitude longitude sphere of unit radius
+Meshf Sphere(u32 rings, u32 segments)
+{
+  Meshf sphere;
+  auto point = [&](u32 ring, u32 segment) {
+    f32 theta = 3.14159265f * static_cast<f32>(ring) / static_cast<f32>(rings);
+    f32 phi = 2.0f * 3.14159265f * static_cast<f32>(segment) / static_cast<f32>(segments);
+    return Vector3f(
+        std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta)
+    );
+  };
+  for (u32 ring = 0; ring < rings; ++ring) {
+    for (u32 segment = 0; segment < segments; ++segment) {
+      Vector3f a = point(ring, segment);
+      Vector3f b = point(ring + 1, segment);
+      Vector3f c = point(ring + 1, segment + 1);
+      Vector3f d = point(ring, segment + 1);
+      for (const Vector3f& p : {a, b, c, a, c, d}) {
+        sphere.indices.push_back(static_cast<u32>(sphere.positions.Size()));
+        sphere.positions.PushBack(p);
+      }
+    }
+  }
+  sphere.Weld();
+  return sphere;
+}
+
+std::vector<Vector3f> RandomPoints(std::size_t count, f32 range, u32 seed)
+{
+  std::mt19937 random(seed);
+  std::uniform_real_distribution<f32> coordinate(-range, range);
+  std::vector<Vector3f> points(count);
+  for (Vector3f& p : points)
+    p = Vector3f(coordinate(random), coordinate(random), coordinate(random));
+  return points;
+}
+
+} // namespace
+
+/* ---- Build ---- */
+TEST(DistanceFieldTest, CubeDistances)
+{
+  DistanceFieldOptions<f32> options;
+  options.voxelSize = 0.1f;
+  options.padding = 0.3f;
+  DistanceFieldf field;
+  ASSERT_TRUE(field.Build(Cube(1.0f), options));
+  EXPECT_FALSE(field.IsSparse());
+  EXPECT_EQ(field.StoredBrickCount(), field.BrickCount());
+  EXPECT_TRUE(field.Bounds().Contains(Vector3f(1.3f, 1.3f, 1.3f)));
+  EXPECT_TRUE(field.Bounds().Contains(Vector3f(-1.3f, -1.3f, -1.3f)));
+
+  // the samples are exact, interpolation errs at the kinks of the distance inside the cube
+  f32 total = 0.0f;
+  std::vector<Vector3f> points = RandomPoints(2000, 1.3f, 1);
+  for (const Vector3f& p : points) {
+    f32 exact = CubeDistance(p, 1.0f);
+    f32 sampled = field.Sample(p);
+    EXPECT_NEAR(sampled, exact, 0.05f);
+    if (std::abs(exact) > 0.05f) {
+      EXPECT_EQ(sampled < 0.0f, exact < 0.0f);
+    }
+    total += std::abs(sampled - exact);
+  }
+  EXPECT_LT(total / static_cast<f32>(points.size()), 5e-3f);
+  EXPECT_NEAR(field.Sample(Vector3f(0.0f, 0.0f, 0.0f)), -1.0f, 1e-5f);
+  EXPECT_NEAR(field.Sample(Vector3f(1.2f, 1.2f, 1.2f)), std::sqrt(0.12f), 1e-2f);
+}
+
+TEST(DistanceFieldTest, InvalidInput)
+{
+  DistanceFieldf field;
+  DistanceFieldOptions<f32> options;
+  EXPECT_FALSE(field.Build(Meshf(), options));
+  EXPECT_TRUE(field.Empty());
+
+  // a triangle of zero area has no sides
+  Meshf flat;
+  for (const Vector3f& p : {Vector3f(0.0f), Vector3f(1.0f), Vector3f(2.0f)})
+    flat.positions.PushBack(p);
+  flat.indices = {0, 1, 2};
+  EXPECT_FALSE(field.Build(flat, options));
+  EXPECT_TRUE(field.Empty());
+}
+
+/* ---- Sampling ---- */
+TEST(DistanceFieldTest, SphereGradient)
+{
+  DistanceFieldOptions<f32> options;
+  options.voxelSize = 0.1f;
+  options.padding = 0.5f;
+  DistanceFieldf field;
+  ASSERT_TRUE(field.Build(Sphere(24, 48), options));
+
+  std::vector<Vector3f> points = RandomPoints(1000, 1.4f, 2);
+  points.erase(
+      std::remove_if(
+          points.begin(), points.end(), [](const Vector3f& p) { return p.Length() < 0.4f; }
+      ),
+      points.end()
+  );
+  std::vector<f32> distances(points.size());
+  std::vector<Vector3f> gradients(points.size());
+  field.Sample(points.data(), distances.data(), points.size());
+  field.Gradient(points.data(), gradients.data(), points.size());
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    EXPECT_NEAR(distances[i], points[i].Length() - 1.0f, 0.03f);
+    EXPECT_LT(gradients[i].DistanceTo(points[i].Normalized()), 0.15f);
+  }
+
+  // outside the box the distance to the box is added
+  EXPECT_NEAR(field.Sample(Vector3f(5.0f, 0.0f, 0.0f)), 4.0f, 0.03f);
+  Vector3f right = field.Gradient(Vector3f(5.0f, 0.0f, 0.0f));
+  Vector3f down = field.Gradient(Vector3f(0.0f, -4.0f, 0.0f));
+  EXPECT_LT(right.DistanceTo(Vector3f(1.0f, 0.0f, 0.0f)), 0.1f);
+  EXPECT_LT(down.DistanceTo(Vector3f(0.0f, -1.0f, 0.0f)), 0.1f);
+
+  f32 nan = std::numeric_limits<f32>::quiet_NaN();
+  EXPECT_TRUE(std::isnan(field.Sample(Vector3f(nan, 0.0f, 0.0f))));
+  EXPECT_TRUE(std::isnan(field.Sample(Vector3f(0.0f, 0.0f, nan))));
+}
+
+/* ---- Sparse ---- */
+TEST(DistanceFieldTest, SparseMatchesDenseInBand)
+{
+  Meshf cube = Cube(0.5f);
+  DistanceFieldOptions<f32> options;
+  options.voxelSize = 0.1f;
+  options.padding = 1.2f;
+  DistanceFieldf dense;
+  ASSERT_TRUE(dense.Build(cube, options));
+  options.narrowBand = 0.3f;
+  DistanceFieldf sparse;
+  ASSERT_TRUE(sparse.Build(cube, options));
+  EXPECT_TRUE(sparse.IsSparse());
+  EXPECT_EQ(sparse.BrickCount(), dense.BrickCount());
+  EXPECT_LT(sparse.StoredBrickCount(), dense.BrickCount() / 2);
+
+  std::vector<Vector3f> points = RandomPoints(2000, 1.6f, 3);
+  for (const Vector3f& p : points) {
+    f32 d = dense.Sample(p);
+    f32 s = sparse.Sample(p);
+    if (std::abs(d) < 0.1f) {
+      EXPECT_EQ(s, d);
+    } else if (dense.Bounds().Contains(p)) {
+      EXPECT_NEAR(s, std::clamp(d, -0.3f, 0.3f), 0.1f);
+    }
+  }
+  // deep inside and far outside the band the value is the clamped one
+  EXPECT_EQ(sparse.Sample(Vector3f(0.0f, 0.0f, 0.0f)), -0.3f);
+  EXPECT_EQ(sparse.Sample(Vector3f(1.6f, 1.6f, 1.6f)), 0.3f);
+  EXPECT_EQ(sparse.Gradient(Vector3f(1.6f, 1.6f, 1.6f)), Vector3f(0.0f, 0.0f, 0.0f));
+}
+
+/* ---- Parallel ---- */
+TEST(DistanceFieldTest, ParallelMatchesSerial)
+{
+  Meshf sphere = Sphere(12, 24);
+  DistanceFieldOptions<f32> options;
+  options.voxelSize = 0.1f;
+  options.padding = 0.3f;
+  options.narrowBand = 0.25f;
+  DistanceFieldf serial;
+  ASSERT_TRUE(serial.Build(sphere, options));
+  Parallel::ThreadPool pool(3);
+  DistanceFieldf parallel;
+  ASSERT_TRUE(parallel.Build(sphere, options, pool));
+  EXPECT_EQ(parallel.StoredBrickCount(), serial.StoredBrickCount());
+
+  std::vector<Vector3f> points = RandomPoints(3000, 1.5f, 4);
+  std::vector<f32> expected(points.size());
+  std::vector<f32> distances(points.size());
+  serial.Sample(points.data(), expected.data(), points.size());
+  parallel.Sample(points.data(), distances.data(), points.size(), pool, 100);
+  EXPECT_EQ(distances, expected);
+
+  std::vector<Vector3f> expectedGradients(points.size());
+  std::vector<Vector3f> gradients(points.size());
+  serial.Gradient(points.data(), expectedGradients.data(), points.size());
+  parallel.Gradient(points.data(), gradients.data(), points.size(), pool, 100);
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    EXPECT_EQ(gradients[i].x, expectedGradients[i].x);
+    EXPECT_EQ(gradients[i].y, expectedGradients[i].y);
+    EXPECT_EQ(gradients[i].z, expectedGradients[i].z);
+  }
+}
@@ -0,0 +1,224 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Mesh.test.cpp
+ * @brief Tests for mesh welding, normal and tangent generation and vertex cache optimization
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <core/geometry/Mesh.h>
+#include <random>
+#include <vector>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Geometry;
+using Engine::Core::Math::Vector2f;
+using Engine::Core::Math::Vector3f;
+
+namespace
+{
+
+/// Grid of n by n quads of the given size in the z = 0 plane, uv follows x and y
+Meshf GridMesh(u32 n, f32 size)
+{
+  Meshf mesh;
+  for (u32 y = 0; y <= n; ++y) {
+    for (u32 x = 0; x <= n; ++x) {
+      f32 u = static_cast<f32>(x) / static_cast<f32>(n);
+      f32 v = static_cast<f32>(y) / static_cast<f32>(n);
+      mesh.positions.PushBack(Vector3f(u * size, v * size, 0.0f));
+      mesh.uvs.emplace_back(u, v);
+    }
+  }
+  for (u32 y = 0; y < n; ++y) {
+    for (u32 x = 0; x < n; ++x) {
+      u32 corner = y * (n + 1) + x;
+      mesh.indices.insert(mesh.indices.end(), {corner, corner + 1, corner + n + 2});
+      mesh.indices.insert(mesh.indices.end(), {corner, corner + n + 2, corner + n + 1});
+    }
+  }
+  return mesh;
+}
+
+/// Every triangle of mesh with its own vertices, positions moved by up to noise
+Meshf Soup(const Meshf& mesh, f32 noise, std::mt19937& random)
+{
+  std::uniform_real_distribution<f32> offset(-noise, noise);
+  Meshf soup;
+  for (u32 index : mesh.indices) {
+    Vector3f p = mesh.positions.Get(index);
+    soup.positions.PushBack(p + Vector3f(offset(random), offset(random), offset(random)));
+    soup.indices.push_back(static_cast<u32>(soup.indices.size()));
+  }
+  return soup;
+}
+
+/// Latitude longitude sphere of unit radius with duplicated seam and pole vertices
+Meshf SphereSoup(u32 rings, u32 segments)
+{
+  Meshf sphere;
+  auto point = [&](u32 ring, u32 segment) {
+    f32 theta = 3.14159265f * static_cast<f32>(ring) / static_cast<f32>(rings);
+    f32 phi = 2.0f * 3.14159265f * static_cast<f32>(segment) / static_cast<f32>(segments);
+    return Vector3f(
+        std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta)
+    );
+  };
+  for (u32 ring = 0; ring < rings; ++ring) {
+    for (u32 segment = 0; segment < segments; ++segment) {
+      Vector3f a = point(ring, segment);
+      Vector3f b = point(ring + 1, segment);
+      Vector3f c = point(ring + 1, segment + 1);
+      Vector3f d = point(ring, segment + 1);
+      for (const Vector3f& p : {a, b, c, a, c, d}) {
+        sphere.indices.push_back(static_cast<u32>(sphere.positions.Size()));
+        sphere.positions.PushBack(p);
+      }
+    }
+  }
+  return sphere;
+}
+
+using Triangle = std::array<u32, 3>;
+
+std::vector<Triangle> SortedTriangles(const std::vector<u32>& indices)
+{
+  std::vector<Triangle> triangles;
+  for (std::size_t i = 0; i < indices.size(); i += 3)
+    triangles.push_back({indices[i], indices[i + 1], indices[i + 2]});
+  std::sort(triangles.begin(), triangles.end());
+  return triangles;
+}
+
+} // namespace
+
+/* ---- Welding ---- */
+TEST(MeshTest, WeldSoupToGrid)
+{
+  std::mt19937 random(1);
+  Meshf grid = GridMesh(20, 10.0f);
+  Meshf soup = Soup(grid, 2e-6f, random);
+  ASSERT_EQ(soup.VertexCount(), 2400u);
+  EXPECT_EQ(soup.Weld(), 441u);
+  EXPECT_EQ(soup.VertexCount(), 441u);
+  ASSERT_EQ(soup.indices.size(), grid.indices.size());
+  for (std::size_t i = 0; i < grid.indices.size(); ++i) {
+    Vector3f expected = grid.positions.Get(grid.indices[i]);
+    EXPECT_LT(soup.positions.Get(soup.indices[i]).DistanceTo(expected), 1e-5f);
+  }
+
+  // a tolerance below the noise keeps the vertices apart
+  Meshf exact = Soup(grid, 2e-6f, random);
+  EXPECT_EQ(exact.Weld(Math::FloatComparator<f32>(1e-9f)), 2400u);
+}
+
+TEST(MeshTest, WeldKeepsSeamsAndNearOrigin)
+{
+  Meshf mesh;
+  for (const Vector3f& p : {Vector3f(1e-9f, 0.0f, 0.0f), Vector3f(1.0f, 0.0f, 0.0f),
+                            Vector3f(0.0f, 1.0f, 0.0f), Vector3f(-1e-9f, 0.0f, 0.0f),
+                            Vector3f(0.0f, 1.0f, 0.0f), Vector3f(-1.0f, 0.0f, 0.0f)}) {
+    mesh.positions.PushBack(p);
+  }
+  mesh.indices = {0, 1, 2, 3, 4, 5};
+  Meshf withUvs = mesh;
+  withUvs.uvs = {
+      Vector2f(0.0f, 0.0f), Vector2f(1.0f, 0.0f), Vector2f(0.0f, 1.0f),
+      Vector2f(0.0f, 0.0f), Vector2f(0.5f, 1.0f), Vector2f(1.0f, 0.0f),
+  };
+
+  // vertices 1e-9 off the origin are equal for a mesh of size one
+  EXPECT_EQ(mesh.Weld(), 4u);
+  EXPECT_EQ(mesh.indices[3], mesh.indices[0]);
+  EXPECT_EQ(mesh.indices[4], mesh.indices[2]);
+  // the top vertex differs in uv
+  EXPECT_EQ(withUvs.Weld(), 5u);
+  EXPECT_EQ(withUvs.indices[3], withUvs.indices[0]);
+  EXPECT_NE(withUvs.indices[4], withUvs.indices[2]);
+}
+
+/* ---- Normals ---- */
+TEST(MeshTest, PlaneNormals)
+{
+  Meshf mesh = GridMesh(8, 2.0f);
+  mesh.ComputeNormals();
+  ASSERT_EQ(mesh.normals.Size(), mesh.VertexCount());
+  for (std::size_t v = 0; v < mesh.VertexCount(); ++v)
+    EXPECT_LT(mesh.normals.Get(v).DistanceTo(Vector3f(0.0f, 0.0f, 1.0f)), 1e-6f);
+}
+
+TEST(MeshTest, SphereNormals)
+{
+  Meshf sphere = SphereSoup(24, 48);
+  sphere.Weld();
+  // seam and pole copies merge into a closed sphere
+  EXPECT_EQ(sphere.VertexCount(), 23u * 48u + 2u);
+  sphere.ComputeNormals();
+  for (std::size_t v = 0; v < sphere.VertexCount(); ++v) {
+    Vector3f outward = sphere.positions.Get(v).Normalized();
+    EXPECT_LT(sphere.normals.Get(v).DistanceTo(outward), 5e-2f) << v;
+  }
+
+  Meshf parallel = sphere;
+  parallel.normals.Clear();
+  Parallel::ThreadPool pool(3);
+  parallel.ComputeNormals(pool, 64);
+  EXPECT_EQ(parallel.normals.x, sphere.normals.x);
+  EXPECT_EQ(parallel.normals.y, sphere.normals.y);
+  EXPECT_EQ(parallel.normals.z, sphere.normals.z);
+}
+
+/* ---- Tangents ---- */
+TEST(MeshTest, Tangents)
+{
+  Meshf mesh = GridMesh(4, 1.0f);
+  mesh.ComputeNormals();
+  mesh.ComputeTangents();
+  ASSERT_EQ(mesh.tangents.Size(), mesh.VertexCount());
+  for (std::size_t v = 0; v < mesh.VertexCount(); ++v) {
+    EXPECT_LT(mesh.tangents.Get(v).DistanceTo(Vector3f(1.0f, 0.0f, 0.0f)), 1e-6f);
+    EXPECT_EQ(mesh.tangentSigns[v], 1.0f);
+  }
+
+  // mirrored texture turns the tangent around and flips the bitangent sign
+  Meshf mirrored = GridMesh(4, 1.0f);
+  for (Vector2f& uv : mirrored.uvs)
+    uv.x = -uv.x;
+  mirrored.ComputeNormals();
+  Parallel::ThreadPool pool(3);
+  mirrored.ComputeTangents(pool, 4);
+  for (std::size_t v = 0; v < mirrored.VertexCount(); ++v) {
+    EXPECT_LT(mirrored.tangents.Get(v).DistanceTo(Vector3f(-1.0f, 0.0f, 0.0f)), 1e-6f);
+    EXPECT_EQ(mirrored.tangentSigns[v], -1.0f);
+  }
+}
+
+/* ---- Vertex cache ---- */
+TEST(MeshTest, OptimizeVertexCache)
+{
+  Meshf mesh = GridMesh(64, 1.0f);
+  std::vector<Triangle> triangles = SortedTriangles(mesh.indices);
+  // shuffle the triangles
+  std::mt19937 random(9);
+  std::vector<u32> order(mesh.TriangleCount());
+  for (u32 i = 0; i < order.size(); ++i)
+    order[i] = i;
+  std::shuffle(order.begin(), order.end(), random);
+  std::vector<u32> shuffled;
+  for (u32 triangle : order)
+    shuffled.insert(shuffled.end(), &mesh.indices[3 * triangle], &mesh.indices[3 * triangle + 3]);
+  mesh.indices = shuffled;
+
+  f32 before = AverageCacheMissRatio(mesh.indices.data(), mesh.indices.size(), mesh.VertexCount());
+  mesh.OptimizeVertexCache();
+  f32 after = AverageCacheMissRatio(mesh.indices.data(), mesh.indices.size(), mesh.VertexCount());
+  EXPECT_GT(before, 2.0f);
+  EXPECT_LT(after, 0.8f);
+  EXPECT_EQ(SortedTriangles(mesh.indices), triangles);
+}
@@ -0,0 +1,226 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Simplify.test.cpp
+ * @brief Tests for quadric error metric mesh simplification
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <core/geometry/Simplify.h>
+#include <vector>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Geometry;
+using Engine::Core::Math::Vector3f;
+
+namespace
+{
+
+/// Grid of n by n quads of the given size in the z = 0 plane
+Meshf GridMesh(u32 n, f32 size)
+{
+  Meshf mesh;
+  for (u32 y = 0; y <= n; ++y) {
+    for (u32 x = 0; x <= n; ++x) {
+      mesh.positions.PushBack(
+          Vector3f(size * static_cast<f32>(x) / n, size * static_cast<f32>(y) / n, 0.0f)
+      );
+    }
+  }
+  for (u32 y = 0; y < n; ++y) {
+    for (u32 x = 0; x < n; ++x) {
+      u32 corner = y * (n + 1) + x;
+      mesh.indices.insert(mesh.indices.end(), {corner, corner + 1, corner + n + 2});
+      mesh.indices.insert(mesh.indices.end(), {corner, corner + n + 2, corner + n + 1});
+    }
+  }
+  return mesh;
+}
+
+/// Closed latitude longitude sphere of unit radius
+Meshf Sphere(u32 rings, u32 segments)
+{
+  Meshf sphere;
+  auto point = [&](u32 ring, u32 segment) {
+    f32 theta = 3.14159265f * static_cast<f32>(ring) / static_cast<f32>(rings);
+    f32 phi = 2.0f * 3.14159265f * static_cast<f32>(segment) / static_cast<f32>(segments);
+    return Vector3f(
+        std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta)
+    );
+  };
+  for (u32 ring = 0; ring < rings; ++ring) {
+    for (u32 segment = 0; segment < segments; ++segment) {
+      Vector3f a = point(ring, segment);
+      Vector3f b = point(ring + 1, segment);
+      Vector3f c = point(ring + 1, segment + 1);
+      Vector3f d = point(ring, segment + 1);
+      for (const Vector3f& p : {a, b, c, a, c, d}) {
+        sphere.indices.push_back(static_cast<u32>(sphere.positions.Size()));
+        sphere.positions.PushBack(p);
+      }
+    }
+  }
+  sphere.Weld();
+  return sphere;
+}
+
+/// Sum of triangle areas signed by the z component of their normals
+f32 SignedAreaZ(const Meshf& mesh, const std::vector<u32>& indices)
+{
+  f32 area = 0.0f;
+  for (std::size_t i = 0; i < indices.size(); i += 3) {
+    Vector3f a = mesh.positions.Get(indices[i]);
+    Vector3f b = mesh.positions.Get(indices[i + 1]);
+    Vector3f c = mesh.positions.Get(indices[i + 2]);
+    area += (b - a).Cross(c - a).z / 2.0f;
+  }
+  return area;
+}
+
+/// Number of triangles of a sphere whose normal does not point away from the center
+u32 InwardTriangles(const Meshf& mesh, const std::vector<u32>& indices)
+{
+  u32 inward = 0;
+  for (std::size_t i = 0; i < indices.size(); i += 3) {
+    Vector3f a = mesh.positions.Get(indices[i]);
+    Vector3f b = mesh.positions.Get(indices[i + 1]);
+    Vector3f c = mesh.positions.Get(indices[i + 2]);
+    if (!((b - a).Cross(c - a).Dot(a + b + c) > 0.0f))
+      ++inward;
+  }
+  return inward;
+}
+
+/// Largest distance of a triangle centroid below the unit sphere
+f32 SphereDeviation(const Meshf& mesh, const std::vector<u32>& indices)
+{
+  f32 deviation = 0.0f;
+  for (std::size_t i = 0; i < indices.size(); i += 3) {
+    Vector3f centroid = (mesh.positions.Get(indices[i]) + mesh.positions.Get(indices[i + 1]) +
+                         mesh.positions.Get(indices[i + 2])) /
+                        3.0f;
+    deviation = std::max(deviation, 1.0f - centroid.Length());
+  }
+  return deviation;
+}
+
+} // namespace
+
+/* ---- Planes ---- */
+TEST(SimplifyTest, FlatGridKeepsLockedBorder)
+{
+  Meshf grid = GridMesh(16, 1.0f);
+  SimplifyOptions<f32> options;
+  std::vector<u32> indices;
+  f32 error = Simplify(grid, options, indices);
+  EXPECT_LT(error, 1e-4f);
+  // only the 64 border vertices are left, a polygon of 64 vertices needs 62 triangles
+  EXPECT_LE(indices.size() / 3, 70u);
+  EXPECT_NEAR(SignedAreaZ(grid, indices), 1.0f, 1e-4f);
+}
+
+TEST(SimplifyTest, FreeBorderSlidesAlongEdges)
+{
+  Meshf grid = GridMesh(16, 1.0f);
+  SimplifyOptions<f32> options;
+  options.lockBorder = false;
+  options.maxError = 1e-3f;
+  std::vector<u32> indices;
+  Simplify(grid, options, indices);
+  // the outline stays a square, corners cannot move without leaving it
+  EXPECT_LE(indices.size() / 3, 8u);
+  EXPECT_NEAR(SignedAreaZ(grid, indices), 1.0f, 1e-4f);
+}
+
+/* ---- Closed meshes ---- */
+TEST(SimplifyTest, ErrorLimit)
+{
+  Meshf sphere = Sphere(24, 48);
+  std::size_t triangles = sphere.TriangleCount();
+  SimplifyOptions<f32> options;
+  options.maxError = 0.01f;
+  std::vector<u32> indices;
+  f32 error = Simplify(sphere, options, indices);
+  EXPECT_LE(error, 0.01f);
+  EXPECT_LT(indices.size() / 3, triangles / 2);
+  EXPECT_EQ(InwardTriangles(sphere, indices), 0u);
+
+  std::vector<u32> finer;
+  options.maxError = 0.001f;
+  EXPECT_LE(Simplify(sphere, options, finer), 0.001f);
+  EXPECT_GT(finer.size(), indices.size());
+}
+
+TEST(SimplifyTest, TargetTriangles)
+{
+  Meshf sphere = Sphere(24, 48);
+  SimplifyOptions<f32> options;
+  options.targetTriangles = 200;
+  std::vector<u32> indices;
+  Simplify(sphere, options, indices);
+  EXPECT_LE(indices.size() / 3, 200u);
+  EXPECT_GT(indices.size() / 3, 150u);
+  EXPECT_EQ(InwardTriangles(sphere, indices), 0u);
+  for (u32 index : indices)
+    EXPECT_LT(index, sphere.VertexCount());
+}
+
+TEST(SimplifyTest, AttributesRaiseCost)
+{
+  // normals turning by the golden angle from vertex to vertex make every collapse expensive
+  Meshf grid = GridMesh(8, 1.0f);
+  for (std::size_t v = 0; v < grid.VertexCount(); ++v) {
+    f32 angle = 2.4f * static_cast<f32>(v);
+    grid.normals.PushBack(Vector3f(std::cos(angle), std::sin(angle), 0.0f));
+  }
+  SimplifyOptions<f32> options;
+  options.maxError = 0.1f;
+  std::vector<u32> plain;
+  std::vector<u32> weighted;
+  options.attributeWeight = 0.0f;
+  Simplify(grid, options, plain);
+  options.attributeWeight = 1.0f;
+  Simplify(grid, options, weighted);
+  EXPECT_LE(plain.size() / 3, 32u);
+  EXPECT_GT(weighted.size() / 3, 64u);
+}
+
+/* ---- Parallel ---- */
+TEST(SimplifyTest, PartitionedSimplification)
+{
+  Meshf sphere = Sphere(64, 128);
+  SimplifyOptions<f32> options;
+  options.targetTriangles = 1000;
+  Parallel::ThreadPool pool(3);
+  std::vector<u32> indices;
+  f32 error = Simplify(sphere, options, indices, pool, 2048);
+  EXPECT_LE(indices.size() / 3, 1000u);
+  EXPECT_GT(indices.size() / 3, 900u);
+  EXPECT_EQ(InwardTriangles(sphere, indices), 0u);
+
+  std::vector<u32> serial;
+  f32 serialError = Simplify(sphere, options, serial);
+  EXPECT_LT(error, 6.0f * serialError);
+}
+
+TEST(SimplifyTest, PartitionedErrorLimit)
+{
+  // partitions charge their error to the final pass, which then stops where the serial form
+  // stops instead of removing another maxError worth of detail
+  Meshf sphere = Sphere(32, 64);
+  SimplifyOptions<f32> options;
+  options.maxError = 0.005f;
+  Parallel::ThreadPool pool(3);
+  std::vector<u32> indices;
+  std::vector<u32> serial;
+  EXPECT_LE(Simplify(sphere, options, indices, pool, 256), 0.005f);
+  Simplify(sphere, options, serial);
+  EXPECT_GT(indices.size(), serial.size() * 95 / 100);
+  EXPECT_LT(SphereDeviation(sphere, indices), 1.1f * SphereDeviation(sphere, serial));
+  EXPECT_EQ(InwardTriangles(sphere, indices), 0u);
+}
@@ -0,0 +1,74 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file MappedFile.test.cpp
+ * @brief Tests for MappedFile class
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/io/MappedFile.h>
+#include <cstdio>
+#include <string>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Io;
+
+namespace
+{
+
+std::string WriteTemporary(const std::string& name, const std::string& contents)
+{
+  std::string path = testing::TempDir() + name;
+  std::FILE* file = std::fopen(path.c_str(), "wb");
+  std::fwrite(contents.data(), 1, contents.size(), file);
+  std::fclose(file);
+  return path;
+}
+
+} // namespace
+
+TEST(MappedFileTest, ReadsContents)
+{
+  std::string path = WriteTemporary("mapped_file_contents.txt", "hello mapped file");
+  MappedFile file;
+  ASSERT_TRUE(file.Open(path.c_str()));
+  EXPECT_TRUE(file.IsOpen());
+  ASSERT_EQ(file.Size(), 17u);
+  EXPECT_EQ(std::string(file.Data(), file.Size()), "hello mapped file");
+
+  file.Close();
+  EXPECT_FALSE(file.IsOpen());
+  EXPECT_EQ(file.Size(), 0u);
+  std::remove(path.c_str());
+}
+
+TEST(MappedFileTest, EmptyFile)
+{
+  std::string path = WriteTemporary("mapped_file_empty.txt", "");
+  MappedFile file;
+  ASSERT_TRUE(file.Open(path.c_str()));
+  EXPECT_EQ(file.Size(), 0u);
+  std::remove(path.c_str());
+}
+
+TEST(MappedFileTest, MissingFile)
+{
+  MappedFile file;
+  EXPECT_FALSE(file.Open((testing::TempDir() + "mapped_file_missing.txt").c_str()));
+  EXPECT_FALSE(file.IsOpen());
+}
+
+TEST(MappedFileTest, ReopenReplacesFile)
+{
+  std::string first = WriteTemporary("mapped_file_first.txt", "first");
+  std::string second = WriteTemporary("mapped_file_second.txt", "second file");
+  MappedFile file;
+  ASSERT_TRUE(file.Open(first.c_str()));
+  ASSERT_TRUE(file.Open(second.c_str()));
+  EXPECT_EQ(std::string(file.Data(), file.Size()), "second file");
+  std::remove(first.c_str());
+  std::remove(second.c_str());
+}
@@ -0,0 +1,202 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file PointCloudLoader.test.cpp
+ * @brief Tests for point cloud parsing and loading
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <core/io/PointCloudLoader.h>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <string>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Io;
+using Engine::Core::Math::Vector3Array;
+using Engine::Core::Parallel::ThreadPool;
+
+namespace
+{
+
+PointCloudStatus Parse(const std::string& text, Vector3Array<f32>& points)
+{
+  return ParsePointCloud(text.data(), text.size(), points);
+}
+
+template <typename T>
+void AppendBinary(std::string& data, T value, bool bigEndian)
+{
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  if (bigEndian)
+    std::reverse(bytes, bytes + sizeof(T));
+  data.append(bytes, sizeof(T));
+}
+
+} // namespace
+
+/* ---- XYZ ---- */
+TEST(PointCloudLoaderTest, Xyz)
+{
+  Vector3Array<f32> points;
+  std::string text = "# scan\n1 2 3\n\n-4.5\t+5e1\t6\n7,8,9 255 0 0\r\n  10;11;12";
+  ASSERT_EQ(Parse(text, points), PointCloudStatus::Ok);
+  ASSERT_EQ(points.Size(), 4u);
+  EXPECT_EQ(points.Get(0), Math::Vector3f(1.0f, 2.0f, 3.0f));
+  EXPECT_EQ(points.Get(1), Math::Vector3f(-4.5f, 50.0f, 6.0f));
+  EXPECT_EQ(points.Get(2), Math::Vector3f(7.0f, 8.0f, 9.0f));
+  EXPECT_EQ(points.Get(3), Math::Vector3f(10.0f, 11.0f, 12.0f));
+}
+
+TEST(PointCloudLoaderTest, XyzMalformed)
+{
+  Vector3Array<f32> points(3);
+  EXPECT_EQ(Parse("1 2 3\n4 5\n", points), PointCloudStatus::Malformed);
+  EXPECT_TRUE(points.Empty());
+  EXPECT_EQ(Parse("1 2 x\n", points), PointCloudStatus::Malformed);
+}
+
+TEST(PointCloudLoaderTest, ParallelMatchesSerial)
+{
+  std::mt19937 generator(7);
+  std::uniform_real_distribution<f64> distribution(-1000.0, 1000.0);
+  std::ostringstream text;
+  text.precision(17);
+  for (u32 i = 0; i < 20000; ++i) {
+    if (i % 1000 == 0)
+      text << "# block " << i << "\n";
+    text << distribution(generator) << ' ' << distribution(generator) << ' '
+         << distribution(generator) << '\n';
+  }
+  std::string data = text.str();
+
+  Vector3Array<f64> serial;
+  ASSERT_EQ(ParsePointCloud(data.data(), data.size(), serial), PointCloudStatus::Ok);
+  ASSERT_EQ(serial.Size(), 20000u);
+
+  ThreadPool pool(3);
+  Vector3Array<f64> parallel;
+  ASSERT_EQ(
+      ParsePointCloud(data.data(), data.size(), parallel, pool, PointCloudFormat::Auto, 4096),
+      PointCloudStatus::Ok
+  );
+  EXPECT_EQ(parallel.x, serial.x);
+  EXPECT_EQ(parallel.y, serial.y);
+  EXPECT_EQ(parallel.z, serial.z);
+}
+
+/* ---- PLY ---- */
+TEST(PointCloudLoaderTest, PlyAscii)
+{
+  std::string text =
+      "ply\r\nformat ascii 1.0\r\ncomment test\r\nelement vertex 2\r\nproperty uchar red\r\n"
+      "property float z\r\nproperty float x\r\nproperty float y\r\nelement face 1\r\n"
+      "property list uchar int vertex_indices\r\nend_header\r\n"
+      "255 3 1 2\r\n0 6 4 5\r\n3 0 1 1\r\n";
+  Vector3Array<f32> points;
+  ASSERT_EQ(Parse(text, points), PointCloudStatus::Ok);
+  ASSERT_EQ(points.Size(), 2u);
+  EXPECT_EQ(points.Get(0), Math::Vector3f(1.0f, 2.0f, 3.0f));
+  EXPECT_EQ(points.Get(1), Math::Vector3f(4.0f, 5.0f, 6.0f));
+}
+
+TEST(PointCloudLoaderTest, PlyAsciiTooFewVertices)
+{
+  std::string text = "ply\nformat ascii 1.0\nelement vertex 3\nproperty float x\n"
+                     "property float y\nproperty float z\nend_header\n1 2 3\n4 5 6\n";
+  Vector3Array<f32> points;
+  EXPECT_EQ(Parse(text, points), PointCloudStatus::Malformed);
+}
+
+TEST(PointCloudLoaderTest, PlyBinary)
+{
+  for (bool bigEndian : {false, true}) {
+    std::string data = std::string("ply\nformat ") +
+                       (bigEndian ? "binary_big_endian" : "binary_little_endian") +
+                       " 1.0\nelement vertex 3\nproperty double x\nproperty float y\n"
+                       "property short z\nproperty uchar alpha\nend_header\n";
+    for (i32 i = 0; i < 3; ++i) {
+      AppendBinary<f64>(data, 0.5 * i, bigEndian);
+      AppendBinary<f32>(data, -1.0f * i, bigEndian);
+      AppendBinary<i16>(data, static_cast<i16>(-300 * i), bigEndian);
+      AppendBinary<u8>(data, 255, bigEndian);
+    }
+
+    Vector3Array<f32> points;
+    ASSERT_EQ(ParsePointCloud(data.data(), data.size(), points), PointCloudStatus::Ok);
+    ASSERT_EQ(points.Size(), 3u);
+    for (u32 i = 0; i < 3; ++i)
+      EXPECT_EQ(points.Get(i), Math::Vector3f(0.5f * i, -1.0f * i, -300.0f * i));
+
+    data.pop_back();
+    EXPECT_EQ(ParsePointCloud(data.data(), data.size(), points), PointCloudStatus::Malformed);
+  }
+}
+
+TEST(PointCloudLoaderTest, PlyBinaryParallel)
+{
+  std::string data = "ply\nformat binary_little_endian 1.0\nelement vertex 10000\n"
+                     "property float x\nproperty float y\nproperty float z\nend_header\n";
+  for (u32 i = 0; i < 10000; ++i) {
+    AppendBinary<f32>(data, static_cast<f32>(i), false);
+    AppendBinary<f32>(data, static_cast<f32>(2 * i), false);
+    AppendBinary<f32>(data, static_cast<f32>(3 * i), false);
+  }
+
+  ThreadPool pool(3);
+  Vector3Array<f32> points;
+  ASSERT_EQ(
+      ParsePointCloud(data.data(), data.size(), points, pool, PointCloudFormat::Ply, 1024),
+      PointCloudStatus::Ok
+  );
+  ASSERT_EQ(points.Size(), 10000u);
+  for (u32 i = 0; i < points.Size(); ++i)
+    ASSERT_EQ(points.Get(i), Math::Vector3f(i, 2.0f * i, 3.0f * i));
+}
+
+TEST(PointCloudLoaderTest, PlyUnsupported)
+{
+  Vector3Array<f32> points;
+  EXPECT_EQ(
+      Parse("ply\nformat ascii 1.0\nelement face 1\nend_header\n", points),
+      PointCloudStatus::UnsupportedFormat
+  );
+  EXPECT_EQ(
+      Parse("ply\nformat ascii 1.0\nelement vertex 1\nproperty float x\nend_header\n1\n", points),
+      PointCloudStatus::Malformed
+  );
+  std::string text = "solid";
+  EXPECT_EQ(
+      ParsePointCloud(text.data(), text.size(), points, PointCloudFormat::Ply),
+      PointCloudStatus::UnsupportedFormat
+  );
+}
+
+/* ---- Files ---- */
+TEST(PointCloudLoaderTest, LoadFile)
+{
+  std::string path = testing::TempDir() + "point_cloud_loader.xyz";
+  std::FILE* file = std::fopen(path.c_str(), "wb");
+  std::fputs("1 2 3\n4 5 6\n", file);
+  std::fclose(file);
+
+  Vector3Array<f32> points;
+  ASSERT_EQ(LoadPointCloud(path.c_str(), points), PointCloudStatus::Ok);
+  ASSERT_EQ(points.Size(), 2u);
+  EXPECT_EQ(points.Get(1), Math::Vector3f(4.0f, 5.0f, 6.0f));
+
+  ThreadPool pool(2);
+  ASSERT_EQ(LoadPointCloud(path.c_str(), points, pool), PointCloudStatus::Ok);
+  EXPECT_EQ(points.Size(), 2u);
+  std::remove(path.c_str());
+
+  EXPECT_EQ(LoadPointCloud(path.c_str(), points), PointCloudStatus::OpenFailed);
+  EXPECT_TRUE(points.Empty());
+}
@@ -0,0 +1,111 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file AABB.test.cpp
+ * @brief Tests for AABB class
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/math/AABB.h>
+#include <string>
+
+using namespace Engine::Core::Math;
+
+/* ---------------------------------------- Constructors --------------------------------------- */
+
+TEST(AABBTest, ConstructorDefault)
+{
+  AABBf b;
+
+  EXPECT_TRUE(b.min == Vector3f::Zero());
+  EXPECT_TRUE(b.max == Vector3f::Zero());
+  EXPECT_TRUE(b.IsValid());
+}
+
+TEST(AABBTest, MethodEmpty)
+{
+  AABBf b = AABBf::Empty();
+
+  EXPECT_FALSE(b.IsValid());
+
+  b.Merge(Vector3f(1.0f, 2.0f, 3.0f));
+
+  EXPECT_TRUE(b.IsValid());
+  EXPECT_TRUE(b.min == Vector3f(1.0f, 2.0f, 3.0f));
+  EXPECT_TRUE(b.max == Vector3f(1.0f, 2.0f, 3.0f));
+}
+
+TEST(AABBTest, MethodFromCenterExtents)
+{
+  AABBf b = AABBf::FromCenterExtents(Vector3f(1.0f, 1.0f, 1.0f), Vector3f(1.0f, 2.0f, 3.0f));
+
+  EXPECT_TRUE(b.min == Vector3f(0.0f, -1.0f, -2.0f));
+  EXPECT_TRUE(b.max == Vector3f(2.0f, 3.0f, 4.0f));
+  EXPECT_TRUE(b.Center() == Vector3f(1.0f, 1.0f, 1.0f));
+  EXPECT_TRUE(b.Extents() == Vector3f(1.0f, 2.0f, 3.0f));
+}
+
+/* ------------------------------------------ Methods ------------------------------------------ */
+
+TEST(AABBTest, MethodMeasures)
+{
+  AABBf b(Vector3f::Zero(), Vector3f(1.0f, 2.0f, 3.0f));
+
+  EXPECT_TRUE(b.Size() == Vector3f(1.0f, 2.0f, 3.0f));
+  EXPECT_FLOAT_EQ(b.SurfaceArea(), 22.0f);
+  EXPECT_FLOAT_EQ(b.Volume(), 6.0f);
+}
+
+TEST(AABBTest, MethodContains)
+{
+  AABBf b(Vector3f::Zero(), Vector3f(2.0f, 2.0f, 2.0f));
+
+  EXPECT_TRUE(b.Contains(Vector3f(1.0f, 2.0f, 0.0f)));
+  EXPECT_FALSE(b.Contains(Vector3f(1.0f, 2.5f, 0.0f)));
+  EXPECT_TRUE(b.Contains(AABBf(Vector3f(0.5f, 0.5f, 0.5f), Vector3f(1.0f, 1.0f, 1.0f))));
+  EXPECT_FALSE(b.Contains(AABBf(Vector3f(0.5f, 0.5f, 0.5f), Vector3f(3.0f, 1.0f, 1.0f))));
+}
+
+TEST(AABBTest, MethodOverlaps)
+{
+  AABBf b(Vector3f::Zero(), Vector3f(2.0f, 2.0f, 2.0f));
+
+  EXPECT_TRUE(b.Overlaps(AABBf(Vector3f(1.0f, 1.0f, 1.0f), Vector3f(3.0f, 3.0f, 3.0f))));
+  EXPECT_TRUE(b.Overlaps(AABBf(Vector3f(2.0f, 0.0f, 0.0f), Vector3f(3.0f, 1.0f, 1.0f))));
+  EXPECT_FALSE(b.Overlaps(AABBf(Vector3f(1.0f, 2.5f, 1.0f), Vector3f(3.0f, 3.0f, 3.0f))));
+}
+
+TEST(AABBTest, MethodDistanceSquaredTo)
+{
+  AABBf b(Vector3f::Zero(), Vector3f(1.0f, 1.0f, 1.0f));
+
+  EXPECT_FLOAT_EQ(b.DistanceSquaredTo(Vector3f(0.5f, 0.5f, 0.5f)), 0.0f);
+  EXPECT_FLOAT_EQ(b.DistanceSquaredTo(Vector3f(3.0f, 0.5f, -1.0f)), 5.0f);
+}
+
+TEST(AABBTest, MethodMergedExpanded)
+{
+  AABBf a(Vector3f::Zero(), Vector3f(1.0f, 1.0f, 1.0f));
+  AABBf b(Vector3f(-1.0f, 0.5f, 0.5f), Vector3f(0.5f, 2.0f, 0.5f));
+
+  AABBf merged = a.Merged(b);
+  AABBf expanded = a.Expanded(1.0f);
+
+  EXPECT_TRUE(merged.min == Vector3f(-1.0f, 0.0f, 0.0f));
+  EXPECT_TRUE(merged.max == Vector3f(1.0f, 2.0f, 1.0f));
+  EXPECT_TRUE(expanded.min == Vector3f(-1.0f, -1.0f, -1.0f));
+  EXPECT_TRUE(expanded.max == Vector3f(2.0f, 2.0f, 2.0f));
+}
+
+/* ------------------------------------------- Debug ------------------------------------------- */
+
+TEST(AABBTest, MethodToString)
+{
+  AABBf b(Vector3f::Zero(), Vector3f(1.0f, 2.0f, 3.0f));
+
+  std::string expected = "((0.00, 0.00, 0.00), (1.00, 2.00, 3.00))";
+  EXPECT_TRUE(b.ToString() == expected);
+}
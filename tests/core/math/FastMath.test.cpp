@@ -0,0 +1,140 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file FastMath.test.cpp
+ * @brief Tests for polynomial approximations of elementary functions
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <core/math/FastMath.h>
+#include <vector>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Math;
+
+/* ---- Scalar accuracy ---- */
+TEST(FastMathTest, SinCos)
+{
+  for (f64 x = -1000.0; x <= 1000.0; x += 0.013) {
+    f32 value = static_cast<f32>(x);
+    EXPECT_NEAR(FastSin(value), std::sin(static_cast<f64>(value)), 2e-7);
+    EXPECT_NEAR(FastCos(value), std::cos(static_cast<f64>(value)), 2e-7);
+  }
+  EXPECT_EQ(FastSin(0.0f), 0.0f);
+  EXPECT_EQ(FastCos(0.0f), 1.0f);
+}
+
+TEST(FastMathTest, Atan2)
+{
+  for (f64 t = -3.14; t <= 3.14; t += 0.001) {
+    for (f32 radius : {1e-3f, 1.0f, 1e3f}) {
+      f32 y = static_cast<f32>(std::sin(t)) * radius;
+      f32 x = static_cast<f32>(std::cos(t)) * radius;
+      EXPECT_NEAR(FastAtan2(y, x), std::atan2(static_cast<f64>(y), static_cast<f64>(x)), 5e-7);
+    }
+  }
+  EXPECT_EQ(FastAtan2(0.0f, 0.0f), 0.0f);
+  EXPECT_NEAR(FastAtan2(0.0f, -1.0f), 3.14159265f, 1e-6);
+  EXPECT_NEAR(FastAtan2(-1.0f, 0.0f), -1.57079633f, 1e-6);
+}
+
+TEST(FastMathTest, Acos)
+{
+  for (f64 x = -1.0; x <= 1.0; x += 1e-4) {
+    f32 value = static_cast<f32>(x);
+    EXPECT_NEAR(FastAcos(value), std::acos(static_cast<f64>(value)), 6e-7);
+  }
+  EXPECT_NEAR(FastAcos(1.0f), 0.0f, 1e-7);
+  EXPECT_NEAR(FastAcos(-1.0f), 3.14159265f, 1e-6);
+}
+
+TEST(FastMathTest, ExpLog)
+{
+  for (f64 x = -80.0; x <= 80.0; x += 0.01) {
+    f32 value = static_cast<f32>(x);
+    f64 expected = std::exp(static_cast<f64>(value));
+    EXPECT_NEAR(FastExp(value) / expected, 1.0, 2e-7);
+
+    f32 positive = static_cast<f32>(expected);
+    f64 log = std::log(static_cast<f64>(positive));
+    EXPECT_NEAR(FastLog(positive), log, std::max(1e-7, std::abs(log) * 2e-7));
+  }
+  EXPECT_EQ(FastLog(1.0f), 0.0f);
+  EXPECT_TRUE(std::isfinite(FastExp(1000.0f)));
+  EXPECT_GT(FastExp(-1000.0f), 0.0f);
+}
+
+/* ---- Lanes ---- */
+TEST(FastMathTest, LanesMatchScalar)
+{
+  f32 input[8] = {-7.5f, -1.0f, -0.25f, 0.0f, 0.5f, 0.99f, 3.0f, 1e3f};
+  f32 four[4];
+  f32 eight[8];
+
+  FastSin(Float4::Load(input)).Store(four);
+  FastSin(Float8::Load(input)).Store(eight);
+  for (u32 i = 0; i < 8; ++i) {
+    EXPECT_NEAR(eight[i], FastSin(input[i]), 1e-7);
+    if (i < 4) {
+      EXPECT_NEAR(four[i], FastSin(input[i]), 1e-7);
+    }
+  }
+
+  FastAtan2(Float8::Load(input), Float8(-0.5f)).Store(eight);
+  for (u32 i = 0; i < 8; ++i)
+    EXPECT_NEAR(eight[i], FastAtan2(input[i], -0.5f), 1e-7);
+
+  FastLog(Abs(Float4::Load(input + 4)) + Float4(1.0f)).Store(four);
+  for (u32 i = 0; i < 4; ++i)
+    EXPECT_NEAR(four[i], FastLog(std::abs(input[i + 4]) + 1.0f), 1e-7);
+}
+
+/* ---- Batches ---- */
+TEST(FastMathTest, Batches)
+{
+  std::vector<f32> x(1001);
+  for (std::size_t i = 0; i < x.size(); ++i)
+    x[i] = static_cast<f32>(i) * 0.002f - 1.0f;
+
+  std::vector<f32> sin(x.size());
+  std::vector<f32> cos(x.size());
+  std::vector<f32> out(x.size());
+  FastSinCos(x.data(), sin.data(), cos.data(), x.size());
+  FastAcos(x.data(), out.data(), x.size());
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    EXPECT_NEAR(sin[i], std::sin(x[i]), 2e-7);
+    EXPECT_NEAR(cos[i], std::cos(x[i]), 2e-7);
+    EXPECT_NEAR(out[i], std::acos(x[i]), 6e-7);
+  }
+
+  FastExp(x.data(), out.data(), x.size());
+  FastLog(out.data(), out.data(), out.size());
+  for (std::size_t i = 0; i < x.size(); ++i)
+    EXPECT_NEAR(out[i], x[i], 3e-7);
+}
+
+TEST(FastMathTest, AngleToMany)
+{
+  std::vector<Vector2f> to2;
+  std::vector<Vector3f> to3;
+  for (u32 i = 0; i < 300; ++i) {
+    f32 t = static_cast<f32>(i) * 0.021f - 3.1f;
+    to2.emplace_back(std::cos(t) * 2.0f, std::sin(t) * 2.0f);
+    to3.emplace_back(std::cos(t), std::sin(t) * 0.5f, std::sin(t));
+  }
+
+  Vector2f from2(0.6f, 0.8f);
+  Vector3f from3(1.0f, 0.0f, 0.0f);
+  std::vector<f32> angles(to2.size());
+  AngleToMany(from2, to2.data(), angles.data(), to2.size());
+  for (std::size_t i = 0; i < to2.size(); ++i)
+    EXPECT_NEAR(angles[i], from2.AngleTo(to2[i]), 1e-6);
+
+  AngleToMany(from3, to3.data(), angles.data(), to3.size());
+  for (std::size_t i = 0; i < to3.size(); ++i)
+    EXPECT_NEAR(angles[i], from3.AngleTo(to3[i]), 1e-6);
+}
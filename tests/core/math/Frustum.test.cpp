@@ -0,0 +1,197 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Frustum.test.cpp
+ * @brief Tests for Frustum class
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/math/Frustum.h>
+#include <random>
+#include <vector>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Math;
+
+namespace
+{
+
+Frustumf MakeCamera()
+{
+  // camera at origin looking down -Z with 90 degrees vertical fov
+  return Frustumf::FromPerspective(
+      Vector3f::Zero(), -Vector3f::UnitZ(), Vector3f::UnitY(), 1.5707963f, 1.0f, 1.0f, 100.0f
+  );
+}
+
+bool IsVisible(const std::vector<u8>& mask, std::size_t i)
+{
+  return (mask[i / 8] >> (i % 8)) & 1u;
+}
+
+} // namespace
+
+/* ---------------------------------------- Construction --------------------------------------- */
+
+TEST(FrustumTest, PerspectivePlanesPointInside)
+{
+  Frustumf f = MakeCamera();
+
+  for (const Planef& plane : f.planes)
+    EXPECT_GT(plane.SignedDistance(Vector3f(0.0f, 0.0f, -10.0f)), 0.0f);
+}
+
+TEST(FrustumTest, PerspectiveContains)
+{
+  Frustumf f = MakeCamera();
+
+  EXPECT_TRUE(f.Contains(Vector3f(0.0f, 0.0f, -10.0f)));
+  EXPECT_TRUE(f.Contains(Vector3f(9.0f, -9.0f, -10.0f)));
+  EXPECT_FALSE(f.Contains(Vector3f(11.0f, 0.0f, -10.0f)));
+  EXPECT_FALSE(f.Contains(Vector3f(0.0f, 0.0f, 10.0f)));
+  EXPECT_FALSE(f.Contains(Vector3f(0.0f, 0.0f, -0.5f)));
+  EXPECT_FALSE(f.Contains(Vector3f(0.0f, 0.0f, -101.0f)));
+}
+
+TEST(FrustumTest, OrthographicContains)
+{
+  Frustumf f = Frustumf::FromOrthographic(
+      Vector3f::Zero(), -Vector3f::UnitZ(), Vector3f::UnitY(), 2.0f, 1.0f, 0.0f, 10.0f
+  );
+
+  EXPECT_TRUE(f.Contains(Vector3f(1.5f, 0.5f, -5.0f)));
+  EXPECT_FALSE(f.Contains(Vector3f(2.5f, 0.5f, -5.0f)));
+  EXPECT_FALSE(f.Contains(Vector3f(1.5f, 1.5f, -5.0f)));
+  EXPECT_FALSE(f.Contains(Vector3f(0.0f, 0.0f, -11.0f)));
+}
+
+/* ---------------------------------------- Single tests --------------------------------------- */
+
+TEST(FrustumTest, MethodIntersectsSphere)
+{
+  Frustumf f = MakeCamera();
+
+  EXPECT_TRUE(f.IntersectsSphere(Vector3f(0.0f, 0.0f, -10.0f), 1.0f));
+  EXPECT_TRUE(f.IntersectsSphere(Vector3f(0.0f, 0.0f, -0.5f), 1.0f));
+  EXPECT_FALSE(f.IntersectsSphere(Vector3f(0.0f, 0.0f, 5.0f), 1.0f));
+}
+
+TEST(FrustumTest, MethodIntersectsSphereCached)
+{
+  Frustumf f = MakeCamera();
+  u8 lastFailedPlane = 0;
+
+  EXPECT_FALSE(f.IntersectsSphere(Vector3f(0.0f, 0.0f, -200.0f), 1.0f, lastFailedPlane));
+  EXPECT_EQ(lastFailedPlane, Frustumf::Far);
+  EXPECT_FALSE(f.IntersectsSphere(Vector3f(0.0f, 0.0f, -210.0f), 1.0f, lastFailedPlane));
+  EXPECT_EQ(lastFailedPlane, Frustumf::Far);
+  EXPECT_TRUE(f.IntersectsSphere(Vector3f(0.0f, 0.0f, -20.0f), 1.0f, lastFailedPlane));
+}
+
+TEST(FrustumTest, MethodIntersectsAABB)
+{
+  Frustumf f = MakeCamera();
+
+  EXPECT_TRUE(f.IntersectsAABB(Vector3f(-1.0f, -1.0f, -11.0f), Vector3f(1.0f, 1.0f, -9.0f)));
+  EXPECT_TRUE(f.IntersectsAABB(Vector3f(9.0f, -1.0f, -11.0f), Vector3f(20.0f, 1.0f, -9.0f)));
+  EXPECT_FALSE(f.IntersectsAABB(Vector3f(12.0f, -1.0f, -11.0f), Vector3f(20.0f, 1.0f, -9.0f)));
+}
+
+TEST(FrustumTest, MethodClassifyAABB)
+{
+  Frustumf f = MakeCamera();
+
+  u8 mask = Frustumf::allPlanes;
+  Intersection inside =
+      f.ClassifyAABB(Vector3f(-1.0f, -1.0f, -11.0f), Vector3f(1.0f, 1.0f, -9.0f), mask);
+  EXPECT_EQ(inside, Intersection::Inside);
+  EXPECT_EQ(mask, 0);
+
+  mask = Frustumf::allPlanes;
+  Intersection crossing =
+      f.ClassifyAABB(Vector3f(-1.0f, -1.0f, -11.0f), Vector3f(20.0f, 1.0f, -9.0f), mask);
+  EXPECT_EQ(crossing, Intersection::Intersecting);
+  EXPECT_EQ(mask, 1u << Frustumf::Right);
+
+  mask = Frustumf::allPlanes;
+  Intersection outside =
+      f.ClassifyAABB(Vector3f(-1.0f, -1.0f, 1.0f), Vector3f(1.0f, 1.0f, 2.0f), mask);
+  EXPECT_EQ(outside, Intersection::Outside);
+}
+
+/* ------------------------------------------ Batched ------------------------------------------ */
+
+TEST(FrustumTest, MethodCullSpheresMatchesScalar)
+{
+  Frustumf f = MakeCamera();
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> position(-150.0f, 150.0f);
+  std::uniform_real_distribution<float> size(0.1f, 5.0f);
+
+  const std::size_t count = 1001;
+  std::vector<float> x(count), y(count), z(count), r(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    x[i] = position(rng);
+    y[i] = position(rng);
+    z[i] = position(rng);
+    r[i] = size(rng);
+  }
+
+  std::vector<u8> visibility((count + 7) / 8);
+  std::vector<u8> cache((count + 7) / 8, 0);
+  for (int frame = 0; frame < 2; ++frame) {
+    f.CullSpheres(x.data(), y.data(), z.data(), r.data(), count, visibility.data(), cache.data());
+
+    for (std::size_t i = 0; i < count; ++i)
+      EXPECT_EQ(IsVisible(visibility, i), f.IntersectsSphere(Vector3f(x[i], y[i], z[i]), r[i]));
+  }
+}
+
+TEST(FrustumTest, MethodCullAABBsMatchesScalar)
+{
+  Frustumf f = MakeCamera();
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> position(-150.0f, 150.0f);
+  std::uniform_real_distribution<float> size(0.1f, 5.0f);
+
+  const std::size_t count = 515;
+  std::vector<float> minX(count), minY(count), minZ(count), maxX(count), maxY(count), maxZ(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    minX[i] = position(rng);
+    minY[i] = position(rng);
+    minZ[i] = position(rng);
+    maxX[i] = minX[i] + size(rng);
+    maxY[i] = minY[i] + size(rng);
+    maxZ[i] = minZ[i] + size(rng);
+  }
+
+  std::vector<u8> visibility((count + 7) / 8);
+  f.CullAABBs(
+      minX.data(), minY.data(), minZ.data(), maxX.data(), maxY.data(), maxZ.data(), count,
+      visibility.data()
+  );
+
+  for (std::size_t i = 0; i < count; ++i) {
+    bool expected = f.IntersectsAABB(
+        Vector3f(minX[i], minY[i], minZ[i]), Vector3f(maxX[i], maxY[i], maxZ[i])
+    );
+    EXPECT_EQ(IsVisible(visibility, i), expected);
+  }
+}
+
+TEST(FrustumTest, MethodCullSpheresPartialBlock)
+{
+  Frustumf f = MakeCamera();
+  float x[3] = {0.0f, 0.0f, 0.0f};
+  float y[3] = {0.0f, 0.0f, 0.0f};
+  float z[3] = {-10.0f, 10.0f, -50.0f};
+  float r[3] = {1.0f, 1.0f, 1.0f};
+  u8 visibility = 0xFF;
+
+  f.CullSpheres(x, y, z, r, 3, &visibility);
+
+  EXPECT_EQ(visibility, 0b101);
+}
@@ -0,0 +1,127 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Morton.test.cpp
+ * @brief Tests for Morton code functions
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/math/Morton.h>
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Math;
+using namespace Engine::Core::Parallel;
+
+namespace
+{
+
+std::vector<Vector3f> RandomPoints(std::size_t count)
+{
+  std::mt19937 generator(3);
+  std::uniform_real_distribution<f32> coordinate(-5.0f, 5.0f);
+  std::vector<Vector3f> points(count);
+  for (Vector3f& p : points)
+    p = Vector3f(coordinate(generator), coordinate(generator), coordinate(generator));
+  return points;
+}
+
+} // namespace
+
+/* ------------------------------------------- Codes ------------------------------------------- */
+
+TEST(MortonTest, Interleave)
+{
+  EXPECT_EQ(MortonEncode(1u, 0u, 0u), 1u);
+  EXPECT_EQ(MortonEncode(0u, 1u, 0u), 2u);
+  EXPECT_EQ(MortonEncode(0u, 0u, 1u), 4u);
+  EXPECT_EQ(MortonEncode(3u, 3u, 3u), 63u);
+  EXPECT_EQ(MortonEncode(0u, 0u, MortonSettings::maxCoordinate), 0x4924924924924924ull);
+}
+
+TEST(MortonTest, RoundTrip)
+{
+  std::mt19937 generator(1);
+  for (int i = 0; i < 1000; ++i) {
+    u32 x = generator() & MortonSettings::maxCoordinate;
+    u32 y = generator() & MortonSettings::maxCoordinate;
+    u32 z = generator() & MortonSettings::maxCoordinate;
+    u32 dx, dy, dz;
+
+    MortonDecode(MortonEncode(x, y, z), dx, dy, dz);
+
+    EXPECT_EQ(dx, x);
+    EXPECT_EQ(dy, y);
+    EXPECT_EQ(dz, z);
+  }
+}
+
+TEST(MortonTest, Bounds)
+{
+  AABBf bounds(Vector3f(-1.0f, -1.0f, -1.0f), Vector3f(1.0f, 1.0f, 1.0f));
+  Vector3f point(0.25f, -0.5f, 0.75f);
+
+  Vector3f decoded = MortonDecode(MortonEncode(point, bounds), bounds);
+
+  EXPECT_NEAR(decoded.x, point.x, 1e-5f);
+  EXPECT_NEAR(decoded.y, point.y, 1e-5f);
+  EXPECT_NEAR(decoded.z, point.z, 1e-5f);
+  EXPECT_EQ(MortonEncode(Vector3f(-9.0f, -9.0f, -9.0f), bounds), 0u);
+  EXPECT_EQ(MortonEncode(Vector3f(9.0f, 9.0f, 9.0f), bounds), 0x7fffffffffffffffull);
+
+  Vector3f corner = MortonDecode(0x7fffffffffffffffull, bounds);
+  EXPECT_EQ(corner.x, 1.0f);
+  EXPECT_EQ(corner.y, 1.0f);
+  EXPECT_EQ(corner.z, 1.0f);
+
+  f32 nan = std::numeric_limits<f32>::quiet_NaN();
+  EXPECT_EQ(MortonEncode(Vector3f(nan, nan, nan), bounds), 0u);
+  u64 yOnly = MortonEncode(0u, MortonSettings::maxCoordinate, 0u);
+  EXPECT_EQ(MortonEncode(Vector3f(nan, 9.0f, -9.0f), bounds), yOnly);
+}
+
+/* ------------------------------------------ Sorting ------------------------------------------ */
+
+TEST(MortonTest, SortOrdersCodes)
+{
+  std::vector<Vector3f> points = RandomPoints(5000);
+  std::vector<Vector3f> original = points;
+  AABBf bounds(Vector3f(-5.0f, -5.0f, -5.0f), Vector3f(5.0f, 5.0f, 5.0f));
+  std::vector<u32> order;
+
+  MortonSort(points.data(), points.size(), bounds, order);
+
+  for (std::size_t i = 0; i < points.size(); ++i)
+    EXPECT_TRUE(points[i] == original[order[i]]);
+  for (std::size_t i = 1; i < points.size(); ++i)
+    EXPECT_LE(MortonEncode(points[i - 1], bounds), MortonEncode(points[i], bounds));
+}
+
+TEST(MortonTest, SortArrayWithPayload)
+{
+  std::vector<Vector3f> points = RandomPoints(20000);
+  AABBf bounds(Vector3f(-5.0f, -5.0f, -5.0f), Vector3f(5.0f, 5.0f, 5.0f));
+  Vector3Arrayf serial(points.data(), points.size());
+  Vector3Arrayf parallel(points.data(), points.size());
+  std::vector<u32> payload(points.size());
+  for (u32 i = 0; i < payload.size(); ++i)
+    payload[i] = i;
+  std::vector<u32> serialOrder;
+  std::vector<u32> parallelOrder;
+  ThreadPool pool(3);
+
+  MortonSort(serial, bounds, serialOrder);
+  MortonSort(parallel, bounds, parallelOrder, pool, 1000);
+  Permute(parallelOrder, payload.data());
+
+  EXPECT_EQ(serialOrder, parallelOrder);
+  EXPECT_TRUE(parallel.x == serial.x);
+  for (std::size_t i = 0; i < points.size(); ++i)
+    EXPECT_TRUE(parallel.Get(i) == points[payload[i]]);
+}
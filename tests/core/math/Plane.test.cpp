@@ -0,0 +1,93 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Plane.test.cpp
+ * @brief Tests for Plane class
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/math/Plane.h>
+#include <string>
+
+using namespace Engine::Core::Math;
+
+/* ---------------------------------------- Constructors --------------------------------------- */
+
+TEST(PlaneTest, ConstructorDefault)
+{
+  Planef p;
+
+  EXPECT_TRUE(p.normal == Vector3f::UnitY());
+  EXPECT_FLOAT_EQ(p.d, 0.0f);
+}
+
+TEST(PlaneTest, ConstructorNormalPoint)
+{
+  Planef p(Vector3f::UnitY(), Vector3f(5.0f, 2.0f, -3.0f));
+
+  EXPECT_TRUE(p.normal == Vector3f::UnitY());
+  EXPECT_FLOAT_EQ(p.d, -2.0f);
+}
+
+TEST(PlaneTest, MethodFromPoints)
+{
+  Planef p = Planef::FromPoints(
+      Vector3f(0.0f, 1.0f, 0.0f), Vector3f(0.0f, 1.0f, 1.0f), Vector3f(1.0f, 1.0f, 0.0f)
+  );
+
+  EXPECT_TRUE(p.normal == Vector3f::UnitY());
+  EXPECT_FLOAT_EQ(p.d, -1.0f);
+}
+
+/* ------------------------------------------ Methods ------------------------------------------ */
+
+TEST(PlaneTest, MethodSignedDistance)
+{
+  Planef p(Vector3f::UnitZ(), 2.0f);
+
+  EXPECT_FLOAT_EQ(p.SignedDistance(Vector3f(1.0f, 1.0f, 1.0f)), 3.0f);
+  EXPECT_FLOAT_EQ(p.SignedDistance(Vector3f(1.0f, 1.0f, -5.0f)), -3.0f);
+  EXPECT_FLOAT_EQ(p.DistanceTo(Vector3f(1.0f, 1.0f, -5.0f)), 3.0f);
+}
+
+TEST(PlaneTest, MethodClosestPoint)
+{
+  Planef p(Vector3f::UnitX(), -1.0f);
+
+  Vector3f result = p.ClosestPoint(Vector3f(4.0f, 2.0f, 3.0f));
+
+  EXPECT_TRUE(result == Vector3f(1.0f, 2.0f, 3.0f));
+}
+
+TEST(PlaneTest, MethodNormalized)
+{
+  Planef p(Vector3f(0.0f, 2.0f, 0.0f), 4.0f);
+
+  Planef result = p.Normalized();
+
+  EXPECT_TRUE(result.normal == Vector3f::UnitY());
+  EXPECT_FLOAT_EQ(result.d, 2.0f);
+}
+
+TEST(PlaneTest, MethodFlipped)
+{
+  Planef p(Vector3f::UnitY(), 1.0f);
+
+  Planef result = p.Flipped();
+
+  EXPECT_TRUE(result.normal == -Vector3f::UnitY());
+  EXPECT_FLOAT_EQ(result.d, -1.0f);
+}
+
+/* ------------------------------------------- Debug ------------------------------------------- */
+
+TEST(PlaneTest, MethodToString)
+{
+  Planef p(Vector3f::UnitY(), -1.0f);
+
+  std::string expected = "((0.00, 1.00, 0.00), -1.00)";
+  EXPECT_TRUE(p.ToString() == expected);
+}
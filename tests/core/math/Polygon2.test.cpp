@@ -0,0 +1,242 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Polygon2.test.cpp
+ * @brief Tests for planar polygon kernels
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <core/math/Polygon2.h>
+#include <random>
+#include <vector>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Math;
+using Engine::Core::Parallel::ThreadPool;
+
+namespace
+{
+
+/// Counterclockwise star with a concave notch at every other vertex
+std::vector<Vector2d> Star(std::size_t tips, f64 outer, f64 inner)
+{
+  std::vector<Vector2d> polygon;
+  for (std::size_t i = 0; i < tips * 2; ++i) {
+    f64 angle = 3.14159265358979 * static_cast<f64>(i) / static_cast<f64>(tips);
+    f64 radius = i % 2 == 0 ? outer : inner;
+    polygon.emplace_back(radius * std::cos(angle), radius * std::sin(angle));
+  }
+  return polygon;
+}
+
+} // namespace
+
+/* ---- Area ---- */
+TEST(Polygon2Test, SignedArea)
+{
+  std::vector<Vector2d> square = {{1.0, 1.0}, {3.0, 1.0}, {3.0, 4.0}, {1.0, 4.0}};
+  EXPECT_DOUBLE_EQ(SignedArea(square.data(), square.size()), 6.0);
+  std::vector<Vector2d> reversed(square.rbegin(), square.rend());
+  EXPECT_DOUBLE_EQ(SignedArea(reversed.data(), reversed.size()), -6.0);
+  EXPECT_EQ(SignedArea(square.data(), 2), 0.0);
+
+  std::vector<Vector2d> far = {{1e6, 1e6}, {1e6 + 1.0, 1e6}, {1e6, 1e6 + 1.0}};
+  EXPECT_DOUBLE_EQ(SignedArea(far.data(), far.size()), 0.5);
+}
+
+/* ---- Point in polygon ---- */
+TEST(Polygon2Test, PointInConcavePolygon)
+{
+  // U shape opening upward
+  std::vector<Vector2d> u = {{0.0, 0.0}, {3.0, 0.0}, {3.0, 3.0}, {2.0, 3.0},
+                             {2.0, 1.0}, {1.0, 1.0}, {1.0, 3.0}, {0.0, 3.0}};
+  EXPECT_TRUE(PointInPolygon(u.data(), u.size(), Vector2d(0.5, 2.0)));
+  EXPECT_TRUE(PointInPolygon(u.data(), u.size(), Vector2d(1.5, 0.5)));
+  EXPECT_FALSE(PointInPolygon(u.data(), u.size(), Vector2d(1.5, 2.0)));
+  EXPECT_FALSE(PointInPolygon(u.data(), u.size(), Vector2d(4.0, 1.0)));
+  EXPECT_EQ(WindingNumber(u.data(), u.size(), Vector2d(2.5, 1.0)), 1);
+
+  std::vector<Vector2d> clockwise(u.rbegin(), u.rend());
+  EXPECT_EQ(WindingNumber(clockwise.data(), clockwise.size(), Vector2d(2.5, 1.0)), -1);
+}
+
+TEST(Polygon2Test, WindingOfSelfOverlap)
+{
+  // the same square traversed twice
+  std::vector<Vector2d> twice = {{0.0, 0.0}, {1.0, 0.0}, {1.0, 1.0}, {0.0, 1.0},
+                                 {0.0, 0.0}, {1.0, 0.0}, {1.0, 1.0}, {0.0, 1.0}};
+  EXPECT_EQ(WindingNumber(twice.data(), twice.size(), Vector2d(0.5, 0.5)), 2);
+  EXPECT_EQ(WindingNumber(twice.data(), twice.size(), Vector2d(1.5, 0.5)), 0);
+}
+
+TEST(Polygon2Test, BatchMatchesScalar)
+{
+  std::vector<Vector2d> star = Star(7, 10.0, 4.0);
+  std::mt19937 random(5);
+  std::uniform_real_distribution<f64> coordinate(-12.0, 12.0);
+  std::vector<Vector2d> points(10000);
+  for (Vector2d& point : points)
+    point = Vector2d(coordinate(random), coordinate(random));
+
+  std::vector<u8> inside(points.size());
+  PointsInPolygon(star.data(), star.size(), points.data(), points.size(), inside.data());
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    EXPECT_EQ(inside[i] != 0, PointInPolygon(star.data(), star.size(), points[i]));
+    count += inside[i];
+  }
+  EXPECT_GT(count, 0u);
+  EXPECT_LT(count, points.size());
+
+  ThreadPool pool(3);
+  std::vector<u8> parallel(points.size());
+  PointsInPolygon(star.data(), star.size(), points.data(), points.size(), parallel.data(), pool,
+                  100);
+  EXPECT_EQ(parallel, inside);
+}
+
+TEST(Polygon2Test, BatchFloat)
+{
+  std::vector<Vector2f> square = {{0.0f, 0.0f}, {2.0f, 0.0f}, {2.0f, 2.0f}, {0.0f, 2.0f}};
+  std::vector<Vector2f> points;
+  for (i32 i = 0; i < 100; ++i)
+    points.emplace_back(static_cast<f32>(i) * 0.03f - 0.5f, 1.0f);
+  std::vector<u8> inside(points.size());
+  PointsInPolygon(square.data(), square.size(), points.data(), points.size(), inside.data());
+  for (std::size_t i = 0; i < points.size(); ++i)
+    EXPECT_EQ(inside[i] != 0, points[i].x > 0.0f && points[i].x < 2.0f) << points[i].x;
+}
+
+/* ---- Convex hull ---- */
+TEST(Polygon2Test, ConvexHullOfGrid)
+{
+  std::vector<Vector2d> points;
+  for (i32 y = 0; y < 5; ++y) {
+    for (i32 x = 0; x < 5; ++x)
+      points.emplace_back(static_cast<f64>(x), static_cast<f64>(y));
+  }
+  points.push_back(points[7]);
+
+  std::vector<u32> hull;
+  ConvexHull(points.data(), points.size(), hull);
+  EXPECT_EQ(hull, (std::vector<u32>{0, 4, 24, 20}));
+}
+
+TEST(Polygon2Test, ConvexHullContainsAllPoints)
+{
+  std::mt19937 random(9);
+  std::normal_distribution<f64> coordinate(0.0, 5.0);
+  std::vector<Vector2d> points(2000);
+  for (Vector2d& point : points)
+    point = Vector2d(coordinate(random), coordinate(random));
+
+  std::vector<u32> hull;
+  ConvexHull(points.data(), points.size(), hull);
+  ASSERT_GE(hull.size(), 3u);
+  std::vector<Vector2d> polygon;
+  for (u32 index : hull)
+    polygon.push_back(points[index]);
+
+  EXPECT_GT(SignedArea(polygon.data(), polygon.size()), 0.0);
+  for (std::size_t i = 0; i < polygon.size(); ++i) {
+    const Vector2d& a = polygon[i];
+    const Vector2d& b = polygon[(i + 1) % polygon.size()];
+    for (const Vector2d& point : points)
+      EXPECT_GE((b - a).Cross(point - a), 0.0);
+  }
+}
+
+TEST(Polygon2Test, ConvexHullDegenerate)
+{
+  std::vector<u32> hull;
+  ConvexHull<f64>(nullptr, 0, hull);
+  EXPECT_TRUE(hull.empty());
+
+  std::vector<Vector2d> same = {{1.0, 1.0}, {1.0, 1.0}, {1.0, 1.0}};
+  ConvexHull(same.data(), same.size(), hull);
+  EXPECT_EQ(hull.size(), 1u);
+
+  std::vector<Vector2d> line = {{2.0, 2.0}, {0.0, 0.0}, {1.0, 1.0}, {3.0, 3.0}};
+  ConvexHull(line.data(), line.size(), hull);
+  EXPECT_EQ(hull, (std::vector<u32>{1, 3}));
+}
+
+/* ---- Segments ---- */
+TEST(Polygon2Test, SegmentIntersection)
+{
+  Vector2d point;
+  ASSERT_TRUE(SegmentIntersection(Vector2d(0.0, 0.0), Vector2d(2.0, 2.0), Vector2d(0.0, 2.0),
+                                  Vector2d(2.0, 0.0), point));
+  EXPECT_DOUBLE_EQ(point.x, 1.0);
+  EXPECT_DOUBLE_EQ(point.y, 1.0);
+
+  // touching at an endpoint
+  ASSERT_TRUE(SegmentIntersection(Vector2d(0.0, 0.0), Vector2d(1.0, 0.0), Vector2d(1.0, 0.0),
+                                  Vector2d(1.0, 5.0), point));
+  EXPECT_DOUBLE_EQ(point.x, 1.0);
+
+  EXPECT_FALSE(SegmentIntersection(Vector2d(0.0, 0.0), Vector2d(1.0, 0.0), Vector2d(2.0, -1.0),
+                                   Vector2d(2.0, 1.0), point));
+  EXPECT_FALSE(SegmentIntersection(Vector2d(0.0, 0.0), Vector2d(1.0, 0.0), Vector2d(0.0, 1.0),
+                                   Vector2d(1.0, 1.0), point));
+}
+
+TEST(Polygon2Test, CollinearSegments)
+{
+  Vector2d point;
+  ASSERT_TRUE(SegmentIntersection(Vector2d(0.0, 0.0), Vector2d(4.0, 0.0), Vector2d(5.0, 0.0),
+                                  Vector2d(2.0, 0.0), point));
+  EXPECT_DOUBLE_EQ(point.x, 2.0);
+  EXPECT_FALSE(SegmentIntersection(Vector2d(0.0, 0.0), Vector2d(1.0, 0.0), Vector2d(2.0, 0.0),
+                                   Vector2d(3.0, 0.0), point));
+
+  // a degenerate segment is a point
+  ASSERT_TRUE(SegmentIntersection(Vector2d(1.0, 1.0), Vector2d(1.0, 1.0), Vector2d(0.0, 0.0),
+                                  Vector2d(2.0, 2.0), point));
+  EXPECT_DOUBLE_EQ(point.x, 1.0);
+  EXPECT_FALSE(SegmentIntersection(Vector2d(1.0, 1.0), Vector2d(1.0, 1.0), Vector2d(2.0, 2.0),
+                                   Vector2d(2.0, 2.0), point));
+}
+
+/* ---- Clipping ---- */
+TEST(Polygon2Test, ClipOverlappingSquares)
+{
+  std::vector<Vector2d> subject = {{0.0, 0.0}, {2.0, 0.0}, {2.0, 2.0}, {0.0, 2.0}};
+  std::vector<Vector2d> clip = {{1.0, 1.0}, {3.0, 1.0}, {3.0, 3.0}, {1.0, 3.0}};
+  std::vector<Vector2d> out;
+  ClipPolygon(subject.data(), subject.size(), clip.data(), clip.size(), out);
+  ASSERT_EQ(out.size(), 4u);
+  EXPECT_DOUBLE_EQ(SignedArea(out.data(), out.size()), 1.0);
+
+  // clockwise clip polygons give the same result
+  std::vector<Vector2d> clockwise(clip.rbegin(), clip.rend());
+  ClipPolygon(subject.data(), subject.size(), clockwise.data(), clockwise.size(), out);
+  EXPECT_DOUBLE_EQ(SignedArea(out.data(), out.size()), 1.0);
+
+  std::vector<Vector2d> away = {{5.0, 5.0}, {6.0, 5.0}, {6.0, 6.0}};
+  ClipPolygon(subject.data(), subject.size(), away.data(), away.size(), out);
+  EXPECT_TRUE(out.empty());
+}
+
+TEST(Polygon2Test, ClipConcaveSubject)
+{
+  std::vector<Vector2d> star = Star(5, 2.0, 1.0);
+  std::vector<Vector2d> box = {{-10.0, -10.0}, {10.0, -10.0}, {10.0, 10.0}, {-10.0, 10.0}};
+  std::vector<Vector2d> out;
+  ClipPolygon(star.data(), star.size(), box.data(), box.size(), out);
+  EXPECT_EQ(out.size(), star.size());
+
+  // the right half of the star
+  std::vector<Vector2d> half = {{0.0, -10.0}, {10.0, -10.0}, {10.0, 10.0}, {0.0, 10.0}};
+  ClipPolygon(star.data(), star.size(), half.data(), half.size(), out);
+  f64 full = SignedArea(star.data(), star.size());
+  f64 right = SignedArea(out.data(), out.size());
+  EXPECT_GT(right, 0.5 * full);
+  EXPECT_LT(right, full);
+  for (const Vector2d& point : out)
+    EXPECT_GE(point.x, -1e-12);
+}
@@ -0,0 +1,114 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Quaternion.test.cpp
+ * @brief Tests for Quaternion class
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/math/Quaternion.h>
+#include <cmath>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Math;
+
+namespace
+{
+
+constexpr f32 pi = 3.14159265358979f;
+
+void ExpectNear(const Vector3f& a, const Vector3f& b)
+{
+  EXPECT_NEAR(a.x, b.x, 1e-5f);
+  EXPECT_NEAR(a.y, b.y, 1e-5f);
+  EXPECT_NEAR(a.z, b.z, 1e-5f);
+}
+
+} // namespace
+
+/* ---------------------------------------- Constructors --------------------------------------- */
+
+TEST(QuaternionTest, ConstructorDefault)
+{
+  Quaternionf q;
+  EXPECT_EQ(q, Quaternionf::Identity());
+  EXPECT_EQ(q * Vector3f(1.0f, 2.0f, 3.0f), Vector3f(1.0f, 2.0f, 3.0f));
+}
+
+TEST(QuaternionTest, FromAxisAngle)
+{
+  Quaternionf q = Quaternionf::FromAxisAngle(Vector3f::UnitZ(), pi / 2.0f);
+  ExpectNear(q * Vector3f::UnitX(), Vector3f::UnitY());
+  ExpectNear(q * Vector3f::UnitZ(), Vector3f::UnitZ());
+  EXPECT_NEAR(q.Length(), 1.0f, 1e-6f);
+}
+
+TEST(QuaternionTest, FromTo)
+{
+  Vector3f from = Vector3f(1.0f, 2.0f, -1.0f).Normalized();
+  Vector3f to = Vector3f(-3.0f, 0.5f, 2.0f).Normalized();
+  ExpectNear(Quaternionf::FromTo(from, to) * from, to);
+  ExpectNear(Quaternionf::FromTo(from, -from) * from, -from);
+}
+
+/* ----------------------------------------- Operations ---------------------------------------- */
+
+TEST(QuaternionTest, ProductComposesRotations)
+{
+  Quaternionf a = Quaternionf::FromAxisAngle(Vector3f::UnitZ(), pi / 2.0f);
+  Quaternionf b = Quaternionf::FromAxisAngle(Vector3f::UnitX(), pi / 2.0f);
+  Vector3f v(0.3f, -1.2f, 2.0f);
+  ExpectNear((a * b) * v, a * (b * v));
+}
+
+TEST(QuaternionTest, Inverse)
+{
+  Quaternionf q = Quaternionf::FromAxisAngle(Vector3f(1.0f, 1.0f, 0.0f).Normalized(), 0.7f);
+  EXPECT_TRUE((q * q.Inversed()).SameRotation(Quaternionf::Identity()));
+  EXPECT_EQ(q.Conjugated(), q.Inversed());
+
+  Quaternionf scaled = q * 2.0f;
+  EXPECT_TRUE((scaled * scaled.Inversed()).SameRotation(Quaternionf::Identity()));
+}
+
+TEST(QuaternionTest, Normalize)
+{
+  Quaternionf q(1.0f, 2.0f, 3.0f, 4.0f);
+  EXPECT_NEAR(q.Normalized().Length(), 1.0f, 1e-6f);
+  EXPECT_EQ(Quaternionf(0.0f, 0.0f, 0.0f, 0.0f).Normalized(), Quaternionf::Identity());
+}
+
+/* --------------------------------------- Interpolation --------------------------------------- */
+
+TEST(QuaternionTest, Slerp)
+{
+  Quaternionf a = Quaternionf::Identity();
+  Quaternionf b = Quaternionf::FromAxisAngle(Vector3f::UnitY(), pi / 2.0f);
+  Quaternionf half = Quaternionf::FromAxisAngle(Vector3f::UnitY(), pi / 4.0f);
+
+  EXPECT_TRUE(Quaternionf::Slerp(a, b, 0.0f).SameRotation(a));
+  EXPECT_TRUE(Quaternionf::Slerp(a, b, 1.0f).SameRotation(b));
+  ExpectNear(Quaternionf::Slerp(a, b, 0.5f) * Vector3f::UnitX(), half * Vector3f::UnitX());
+  // takes the shorter arc for the negated end
+  ExpectNear(Quaternionf::Slerp(a, -b, 0.5f) * Vector3f::UnitX(), half * Vector3f::UnitX());
+}
+
+TEST(QuaternionTest, Nlerp)
+{
+  Quaternionf a = Quaternionf::FromAxisAngle(Vector3f::UnitX(), 0.2f);
+  Quaternionf b = Quaternionf::FromAxisAngle(Vector3f::UnitX(), 0.4f);
+  Quaternionf q = Quaternionf::Nlerp(a, b, 0.5f);
+  EXPECT_NEAR(q.Length(), 1.0f, 1e-6f);
+  ExpectNear(q * Vector3f::UnitY(), Quaternionf::FromAxisAngle(Vector3f::UnitX(), 0.3f) *
+                                        Vector3f::UnitY());
+}
+
+/* ------------------------------------------- Other ------------------------------------------- */
+
+TEST(QuaternionTest, ToString)
+{
+  EXPECT_EQ(Quaternionf(1.0f, 2.0f, 3.0f, 4.0f).ToString(), "(1.00, 2.00, 3.00, 4.00)");
+}
@@ -0,0 +1,74 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file SmallMatrix.test.cpp
+ * @brief Tests for small symmetric eigen decomposition and linear solves
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/math/SmallMatrix.h>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Math;
+
+TEST(SmallMatrixTest, EigenDiagonal)
+{
+  const f64 matrix[3][3] = {{3.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 2.0}};
+  f64 values[3];
+  f64 vectors[3][3];
+  SymmetricEigen(matrix, values, vectors);
+
+  EXPECT_DOUBLE_EQ(values[0], 1.0);
+  EXPECT_DOUBLE_EQ(values[1], 2.0);
+  EXPECT_DOUBLE_EQ(values[2], 3.0);
+  EXPECT_DOUBLE_EQ(std::abs(vectors[1][0]), 1.0);
+  EXPECT_DOUBLE_EQ(std::abs(vectors[2][1]), 1.0);
+  EXPECT_DOUBLE_EQ(std::abs(vectors[0][2]), 1.0);
+}
+
+TEST(SmallMatrixTest, EigenReconstructs)
+{
+  // only the upper triangle is read
+  const f64 matrix[4][4] = {
+      {4.0, 1.0, -2.0, 0.5}, {0.0, 3.0, 0.25, 1.0}, {0.0, 0.0, -1.0, 2.0}, {0.0, 0.0, 0.0, 2.0}};
+  f64 values[4];
+  f64 vectors[4][4];
+  SymmetricEigen(matrix, values, vectors);
+
+  for (u32 i = 0; i < 3; ++i)
+    EXPECT_LE(values[i], values[i + 1]);
+  for (u32 r = 0; r < 4; ++r) {
+    for (u32 c = r; c < 4; ++c) {
+      f64 value = 0.0;
+      for (u32 k = 0; k < 4; ++k)
+        value += vectors[r][k] * values[k] * vectors[c][k];
+      EXPECT_NEAR(value, matrix[r][c], 1e-12);
+    }
+  }
+}
+
+TEST(SmallMatrixTest, Solve)
+{
+  const f64 matrix[3][3] = {{4.0, 2.0, 0.4}, {2.0, 5.0, 1.0}, {0.4, 1.0, 3.0}};
+  const f64 expected[3] = {1.0, -2.0, 0.5};
+  f64 rhs[3];
+  for (u32 r = 0; r < 3; ++r)
+    rhs[r] = matrix[r][0] * expected[0] + matrix[r][1] * expected[1] + matrix[r][2] * expected[2];
+
+  f64 solution[3];
+  ASSERT_TRUE(SolveSymmetric(matrix, rhs, solution));
+  for (u32 i = 0; i < 3; ++i)
+    EXPECT_NEAR(solution[i], expected[i], 1e-12);
+}
+
+TEST(SmallMatrixTest, SolveSingular)
+{
+  const f64 matrix[2][2] = {{1.0, 1.0}, {1.0, 1.0}};
+  const f64 rhs[2] = {1.0, 1.0};
+  f64 solution[2] = {7.0, 7.0};
+  EXPECT_FALSE(SolveSymmetric(matrix, rhs, solution));
+  EXPECT_EQ(solution[0], 7.0);
+}
@@ -0,0 +1,210 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Spline.test.cpp
+ * @brief Tests for cubic spline curves
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <core/math/Spline.h>
+#include <random>
+#include <vector>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Math;
+using Engine::Core::Parallel::ThreadPool;
+
+namespace
+{
+
+constexpr f64 halfPi = 1.57079632679490;
+
+/// Distance from point to the nearest piece of a polyline
+f64 DistanceToPolyline(const Vector2d& point, const std::vector<Vector2d>& polyline)
+{
+  f64 best = 1e30;
+  for (std::size_t i = 0; i + 1 < polyline.size(); ++i) {
+    Vector2d chord = polyline[i + 1] - polyline[i];
+    f64 s = std::clamp((point - polyline[i]).Dot(chord) / chord.LengthSquared(), 0.0, 1.0);
+    best = std::min(best, (polyline[i] + chord * s - point).Length());
+  }
+  return best;
+}
+
+/// Unit quarter circle as one cubic Bezier segment
+std::vector<Vector2d> QuarterCircle()
+{
+  constexpr f64 k = 0.5522847498;
+  return {{1.0, 0.0}, {1.0, k}, {k, 1.0}, {0.0, 1.0}};
+}
+
+} // namespace
+
+/* ---- Evaluation ---- */
+TEST(SplineTest, BezierMatchesDeCasteljau)
+{
+  std::vector<Vector3d> controls = {{0.0, 0.0, 0.0}, {1.0, 2.0, 0.5}, {3.0, -1.0, 1.0},
+                                    {4.0, 0.0, 0.0}, {5.0, 1.0, -1.0}, {7.0, 3.0, 0.0},
+                                    {8.0, 0.0, 2.0}};
+  Spline3d spline;
+  spline.Build(SplineType::Bezier, controls.data(), controls.size());
+  ASSERT_EQ(spline.SegmentCount(), 2u);
+  for (f64 t = 0.0; t <= 2.0; t += 0.05) {
+    std::size_t segment = std::min<std::size_t>(static_cast<std::size_t>(t), 1);
+    Vector3d expected = DeCasteljau(controls.data() + segment * 3, 4, t - segment);
+    Vector3d point = spline.Evaluate(t);
+    EXPECT_NEAR(point.x, expected.x, 1e-12);
+    EXPECT_NEAR(point.y, expected.y, 1e-12);
+    EXPECT_NEAR(point.z, expected.z, 1e-12);
+  }
+  EXPECT_EQ(spline.Evaluate(-1.0), controls.front());
+  EXPECT_EQ(spline.Evaluate(5.0), controls.back());
+
+  // the end tangent of a Bezier segment is three times the last control leg
+  Vector3d tangent = spline.Derivative(1.0);
+  EXPECT_NEAR(tangent.x, 3.0, 1e-12);
+  EXPECT_NEAR(tangent.y, 3.0, 1e-12);
+}
+
+TEST(SplineTest, DeCasteljauHigherDegree)
+{
+  std::vector<Vector2d> line = {{0.0, 0.0}, {1.0, 1.0}, {2.0, 2.0}, {3.0, 3.0}, {4.0, 4.0}};
+  Vector2d point = DeCasteljau(line.data(), line.size(), 0.3);
+  EXPECT_NEAR(point.x, 1.2, 1e-12);
+  EXPECT_NEAR(point.y, 1.2, 1e-12);
+  EXPECT_EQ(DeCasteljau(line.data(), 1, 0.7), line[0]);
+}
+
+TEST(SplineTest, CatmullRomInterpolates)
+{
+  std::vector<Vector2d> points = {{0.0, 0.0}, {1.0, 2.0}, {3.0, 3.0}, {4.0, 1.0}, {6.0, 0.0}};
+  Spline2d spline;
+  spline.Build(SplineType::CatmullRom, points.data(), points.size());
+  ASSERT_EQ(spline.SegmentCount(), 4u);
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    Vector2d point = spline.Evaluate(static_cast<f64>(i));
+    EXPECT_NEAR(point.x, points[i].x, 1e-12);
+    EXPECT_NEAR(point.y, points[i].y, 1e-12);
+  }
+  Vector2d tangent = spline.Derivative(2.0);
+  EXPECT_NEAR(tangent.x, (points[3].x - points[1].x) * 0.5, 1e-12);
+  EXPECT_NEAR(tangent.y, (points[3].y - points[1].y) * 0.5, 1e-12);
+}
+
+TEST(SplineTest, BSplineApproximates)
+{
+  std::vector<Vector2d> points = {{0.0, 0.0}, {1.0, 3.0}, {2.0, 0.0}, {3.0, 3.0}, {4.0, 0.0}};
+  Spline2d spline;
+  spline.Build(SplineType::BSpline, points.data(), points.size());
+  ASSERT_EQ(spline.SegmentCount(), 2u);
+  Vector2d start = spline.Evaluate(0.0);
+  EXPECT_NEAR(start.x, 1.0, 1e-12);
+  EXPECT_NEAR(start.y, (0.0 + 4.0 * 3.0 + 0.0) / 6.0, 1e-12);
+
+  // C2 continuity at the joint
+  Vector2d before = spline.Derivative(1.0 - 1e-7);
+  Vector2d after = spline.Derivative(1.0 + 1e-7);
+  EXPECT_NEAR(before.x, after.x, 1e-5);
+  EXPECT_NEAR(before.y, after.y, 1e-5);
+}
+
+TEST(SplineTest, BatchMatchesScalar)
+{
+  std::vector<Vector3f> points;
+  for (i32 i = 0; i < 20; ++i)
+    points.emplace_back(static_cast<f32>(i), std::sin(static_cast<f32>(i)), 0.5f * i);
+  Spline3f spline;
+  spline.Build(SplineType::CatmullRom, points.data(), points.size());
+
+  std::mt19937 random(3);
+  std::uniform_real_distribution<f32> parameter(-1.0f, 20.0f);
+  std::vector<f32> parameters(5000);
+  for (f32& t : parameters)
+    t = parameter(random);
+  // sorted runs as produced by uniform sampling
+  std::sort(parameters.begin(), parameters.begin() + 2500);
+
+  std::vector<Vector3f> out(parameters.size());
+  spline.Evaluate(parameters.data(), out.data(), parameters.size());
+  for (std::size_t i = 0; i < parameters.size(); ++i) {
+    Vector3f expected = spline.Evaluate(parameters[i]);
+    ASSERT_EQ(out[i].x, expected.x) << parameters[i];
+    ASSERT_EQ(out[i].y, expected.y) << parameters[i];
+    ASSERT_EQ(out[i].z, expected.z) << parameters[i];
+  }
+
+  ThreadPool pool(3);
+  std::vector<Vector3f> parallel(parameters.size());
+  spline.Evaluate(parameters.data(), parallel.data(), parameters.size(), pool, 100);
+  for (std::size_t i = 0; i < parameters.size(); ++i)
+    ASSERT_EQ(parallel[i].x, out[i].x);
+}
+
+/* ---- Arc length ---- */
+TEST(SplineTest, ArcLength)
+{
+  std::vector<Vector2d> quarter = QuarterCircle();
+  Spline2d spline;
+  spline.Build(SplineType::Bezier, quarter.data(), quarter.size());
+  spline.BuildArcLengthTable();
+  EXPECT_NEAR(spline.Length(), halfPi, 1e-3);
+
+  // unevenly spaced controls on a line, arc length is distance along it
+  std::vector<Vector2d> line = {{0.0, 0.0}, {0.1, 0.0}, {0.2, 0.0}, {1.0, 0.0}};
+  spline.Build(SplineType::Bezier, line.data(), line.size());
+  spline.BuildArcLengthTable(32);
+  EXPECT_NEAR(spline.Length(), 1.0, 1e-9);
+  for (f64 distance = 0.0; distance <= 1.0; distance += 0.05)
+    EXPECT_NEAR(spline.EvaluateAtDistance(distance).x, distance, 2e-3);
+  EXPECT_EQ(spline.ParameterAtDistance(-1.0), 0.0);
+  EXPECT_EQ(spline.ParameterAtDistance(2.0), 1.0);
+}
+
+TEST(SplineTest, EvaluateEvenly)
+{
+  std::vector<Vector2d> points = {{0.0, 0.0}, {1.0, 2.0}, {3.0, 3.0}, {4.0, 1.0}, {6.0, 0.0}};
+  Spline2d spline;
+  spline.Build(SplineType::CatmullRom, points.data(), points.size());
+  spline.BuildArcLengthTable(64);
+
+  std::vector<Vector2d> out(50);
+  spline.EvaluateEvenly(out.data(), out.size());
+  EXPECT_EQ(out.front(), points.front());
+  EXPECT_NEAR(out.back().x, points.back().x, 1e-9);
+  f64 spacing = spline.Length() / 49.0;
+  for (std::size_t i = 0; i + 1 < out.size(); ++i) {
+    EXPECT_NEAR(out[i].DistanceTo(out[i + 1]), spacing, spacing * 0.02);
+    EXPECT_EQ(out[i + 1], spline.EvaluateAtDistance(spacing * static_cast<f64>(i + 1)));
+  }
+}
+
+/* ---- Tessellation ---- */
+TEST(SplineTest, TessellateWithinTolerance)
+{
+  std::vector<Vector2d> points = {{0.0, 0.0}, {1.0, 2.0}, {3.0, 3.0}, {4.0, 1.0}, {6.0, 0.0}};
+  Spline2d spline;
+  spline.Build(SplineType::CatmullRom, points.data(), points.size());
+
+  std::vector<Vector2d> coarse;
+  std::vector<Vector2d> fine;
+  spline.Tessellate(0.05, coarse);
+  spline.Tessellate(0.001, fine);
+  EXPECT_LT(coarse.size(), fine.size());
+  EXPECT_EQ(coarse.front(), points.front());
+  EXPECT_EQ(coarse.back(), points.back());
+  for (f64 t = 0.0; t <= 4.0; t += 0.01) {
+    EXPECT_LE(DistanceToPolyline(spline.Evaluate(t), coarse), 0.05 * 1.5);
+    EXPECT_LE(DistanceToPolyline(spline.Evaluate(t), fine), 0.001 * 1.5);
+  }
+
+  // straight segments need no subdivision
+  std::vector<Vector2d> line = {{0.0, 0.0}, {1.0, 1.0}, {2.0, 2.0}, {3.0, 3.0}};
+  spline.Build(SplineType::Bezier, line.data(), line.size());
+  spline.Tessellate(0.01, coarse);
+  EXPECT_EQ(coarse.size(), 2u);
+}
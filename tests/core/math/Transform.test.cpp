@@ -0,0 +1,47 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Transform.test.cpp
+ * @brief Tests for Transform class
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/math/Transform.h>
+
+using namespace Engine::Core::Math;
+
+/* ----------------------------------------- Operations ---------------------------------------- */
+
+TEST(TransformTest, TransformPoint)
+{
+  Transformf t(
+      Vector3f(1.0f, 2.0f, 3.0f), Quaternionf::FromAxisAngle(Vector3f::UnitZ(), 1.5707963f),
+      Vector3f(2.0f, 2.0f, 2.0f)
+  );
+  Vector3f p = t.TransformPoint(Vector3f(1.0f, 0.0f, 0.0f));
+  EXPECT_NEAR(p.x, 1.0f, 1e-5f);
+  EXPECT_NEAR(p.y, 4.0f, 1e-5f);
+  EXPECT_NEAR(p.z, 3.0f, 1e-5f);
+  EXPECT_EQ(Transformf::Identity().TransformPoint(p), p);
+}
+
+TEST(TransformTest, ProductComposesTransforms)
+{
+  Transformf parent(
+      Vector3f(5.0f, 0.0f, -1.0f), Quaternionf::FromAxisAngle(Vector3f::UnitY(), 0.8f),
+      Vector3f(3.0f, 3.0f, 3.0f)
+  );
+  Transformf child(
+      Vector3f(0.5f, 1.0f, 2.0f), Quaternionf::FromAxisAngle(Vector3f::UnitX(), -0.3f),
+      Vector3f(1.0f, 2.0f, 0.5f)
+  );
+  Vector3f point(1.0f, -2.0f, 0.25f);
+  Vector3f expected = parent.TransformPoint(child.TransformPoint(point));
+  Vector3f actual = (parent * child).TransformPoint(point);
+  EXPECT_NEAR(actual.x, expected.x, 1e-4f);
+  EXPECT_NEAR(actual.y, expected.y, 1e-4f);
+  EXPECT_NEAR(actual.z, expected.z, 1e-4f);
+}
@@ -0,0 +1,84 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Vector3Array.test.cpp
+ * @brief Tests for Vector3Array class
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/math/Vector3Array.h>
+#include <cstdint>
+
+using namespace Engine::Core::Math;
+
+/* ---------------------------------------- Constructors --------------------------------------- */
+
+TEST(Vector3ArrayTest, ConstructorCountValue)
+{
+  Vector3Arrayf a(5, Vector3f(1.0f, 2.0f, 3.0f));
+
+  EXPECT_EQ(a.Size(), 5u);
+  EXPECT_TRUE(a.Get(4) == Vector3f(1.0f, 2.0f, 3.0f));
+}
+
+TEST(Vector3ArrayTest, ConstructorFromAoS)
+{
+  Vector3f vectors[2] = {{1.0f, 2.0f, 3.0f}, {4.0f, 5.0f, 6.0f}};
+
+  Vector3Arrayf a(vectors, 2);
+
+  EXPECT_FLOAT_EQ(a.x[1], 4.0f);
+  EXPECT_FLOAT_EQ(a.y[1], 5.0f);
+  EXPECT_FLOAT_EQ(a.z[1], 6.0f);
+}
+
+/* ------------------------------------------ Methods ------------------------------------------ */
+
+TEST(Vector3ArrayTest, ComponentsAreAligned)
+{
+  Vector3Arrayf a(17);
+
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(a.x.data()) % 64, 0u);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(a.y.data()) % 64, 0u);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(a.z.data()) % 64, 0u);
+}
+
+TEST(Vector3ArrayTest, MethodPushBackSet)
+{
+  Vector3Arrayf a;
+
+  a.PushBack(Vector3f(1.0f, 2.0f, 3.0f));
+  a.PushBack(Vector3f(4.0f, 5.0f, 6.0f));
+  a.Set(0, Vector3f(7.0f, 8.0f, 9.0f));
+
+  EXPECT_EQ(a.Size(), 2u);
+  EXPECT_TRUE(a.Get(0) == Vector3f(7.0f, 8.0f, 9.0f));
+  EXPECT_TRUE(a.Get(1) == Vector3f(4.0f, 5.0f, 6.0f));
+}
+
+TEST(Vector3ArrayTest, MethodRemoveSwap)
+{
+  Vector3Arrayf a;
+  a.PushBack(Vector3f(1.0f, 0.0f, 0.0f));
+  a.PushBack(Vector3f(2.0f, 0.0f, 0.0f));
+  a.PushBack(Vector3f(3.0f, 0.0f, 0.0f));
+
+  a.RemoveSwap(0);
+
+  EXPECT_EQ(a.Size(), 2u);
+  EXPECT_TRUE(a.Get(0) == Vector3f(3.0f, 0.0f, 0.0f));
+}
+
+TEST(Vector3ArrayTest, MethodToAoS)
+{
+  Vector3Arrayf a(2, Vector3f(1.0f, 2.0f, 3.0f));
+  Vector3f out[2];
+
+  a.ToAoS(out);
+
+  EXPECT_TRUE(out[0] == Vector3f(1.0f, 2.0f, 3.0f));
+  EXPECT_TRUE(out[1] == Vector3f(1.0f, 2.0f, 3.0f));
+}
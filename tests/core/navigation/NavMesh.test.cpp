@@ -0,0 +1,227 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file NavMesh.test.cpp
+ * @brief Tests for navigation mesh pathfinding
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/navigation/NavMesh.h>
+#include <string>
+#include <vector>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Navigation;
+using Engine::Core::Math::Vector2d;
+
+namespace
+{
+
+/// Unit squares of a grid, rows listed from y = 0 upward and '#' marks a walkable square
+NavMeshd GridMesh(const std::vector<std::string>& rows)
+{
+  u32 width = static_cast<u32>(rows[0].size());
+  u32 height = static_cast<u32>(rows.size());
+  std::vector<Vector2d> vertices;
+  for (u32 y = 0; y <= height; ++y) {
+    for (u32 x = 0; x <= width; ++x)
+      vertices.emplace_back(static_cast<f64>(x), static_cast<f64>(y));
+  }
+
+  std::vector<u32> indices;
+  std::vector<u32> sizes;
+  for (u32 y = 0; y < height; ++y) {
+    for (u32 x = 0; x < width; ++x) {
+      if (rows[y][x] != '#')
+        continue;
+      u32 corner = y * (width + 1) + x;
+      indices.insert(indices.end(), {corner, corner + 1, corner + width + 2, corner + width + 1});
+      sizes.push_back(4);
+    }
+  }
+
+  NavMeshd mesh;
+  EXPECT_TRUE(mesh.Build(vertices.data(), vertices.size(), indices.data(), sizes.data(),
+                         sizes.size()));
+  return mesh;
+}
+
+} // namespace
+
+/* ---- Mesh ---- */
+TEST(NavMeshTest, BuildLinksPortals)
+{
+  NavMeshd mesh = GridMesh({"##", "#."});
+  EXPECT_EQ(mesh.PolygonCount(), 3u);
+  EXPECT_EQ(mesh.PortalCount(), 4u);
+  // polygon 0 is the square at (0, 0), its right edge leads to polygon 1
+  EXPECT_EQ(mesh.Neighbor(0, 1), 1u);
+  EXPECT_EQ(mesh.Neighbor(0, 2), 2u);
+  EXPECT_EQ(mesh.Neighbor(1, 2), NavMeshd::invalidPolygon);
+  EXPECT_EQ(mesh.Centroid(2).x, 0.5);
+  EXPECT_EQ(mesh.Centroid(2).y, 1.5);
+}
+
+TEST(NavMeshTest, FindPolygon)
+{
+  NavMeshd mesh = GridMesh({"###", "#.#", "###"});
+  EXPECT_EQ(mesh.FindPolygon(Vector2d(0.5, 0.5)), 0u);
+  EXPECT_EQ(mesh.FindPolygon(Vector2d(2.5, 2.5)), 7u);
+  EXPECT_EQ(mesh.FindPolygon(Vector2d(1.5, 1.5)), NavMeshd::invalidPolygon);
+  EXPECT_EQ(mesh.FindPolygon(Vector2d(-0.5, 1.0)), NavMeshd::invalidPolygon);
+  EXPECT_EQ(mesh.FindPolygon(Vector2d(3.0, 3.0)), 7u);
+}
+
+TEST(NavMeshTest, RejectsInvalidPolygons)
+{
+  std::vector<Vector2d> vertices = {{0.0, 0.0}, {1.0, 0.0}, {1.0, 1.0}, {0.0, 1.0}, {2.0, 2.0}};
+  NavMeshd mesh;
+
+  std::vector<u32> clockwise = {0, 3, 2, 1};
+  u32 four = 4;
+  EXPECT_FALSE(mesh.Build(vertices.data(), vertices.size(), clockwise.data(), &four, 1));
+  EXPECT_EQ(mesh.PolygonCount(), 0u);
+
+  std::vector<u32> missing = {0, 1, 9};
+  u32 three = 3;
+  EXPECT_FALSE(mesh.Build(vertices.data(), vertices.size(), missing.data(), &three, 1));
+
+  // three triangles on the edge from vertex 0 to vertex 2
+  std::vector<u32> fan = {0, 1, 2, 0, 2, 3, 2, 0, 4};
+  std::vector<u32> sizes = {3, 3, 3};
+  EXPECT_FALSE(mesh.Build(vertices.data(), vertices.size(), fan.data(), sizes.data(), 3));
+}
+
+/* ---- Paths ---- */
+TEST(NavMeshTest, StraightPath)
+{
+  NavMeshd mesh = GridMesh({"#####"});
+  NavMeshQueryd query(mesh);
+  std::vector<Vector2d> path;
+  ASSERT_EQ(query.FindPath(Vector2d(0.2, 0.5), Vector2d(4.5, 0.7), path), NavPathStatus::Found);
+  ASSERT_EQ(path.size(), 2u);
+  EXPECT_EQ(path[1].x, 4.5);
+
+  ASSERT_EQ(query.FindPath(Vector2d(0.2, 0.5), Vector2d(0.8, 0.1), path), NavPathStatus::Found);
+  EXPECT_EQ(path.size(), 2u);
+}
+
+TEST(NavMeshTest, PathBendsAroundCorners)
+{
+  // S shaped corridor
+  NavMeshd mesh = GridMesh({
+      "###..",
+      "..#..",
+      "..###",
+  });
+  NavMeshQueryd query(mesh);
+  std::vector<Vector2d> path;
+  ASSERT_EQ(query.FindPath(Vector2d(0.5, 0.5), Vector2d(4.5, 2.5), path), NavPathStatus::Found);
+  ASSERT_EQ(path.size(), 4u);
+  EXPECT_EQ(path[1], Vector2d(2.0, 1.0));
+  EXPECT_EQ(path[2], Vector2d(3.0, 2.0));
+  EXPECT_EQ(path[3], Vector2d(4.5, 2.5));
+
+  // the same corridor walked backward bends around the same corners
+  ASSERT_EQ(query.FindPath(Vector2d(4.5, 2.5), Vector2d(0.5, 0.5), path), NavPathStatus::Found);
+  ASSERT_EQ(path.size(), 4u);
+  EXPECT_EQ(path[1], Vector2d(3.0, 2.0));
+  EXPECT_EQ(path[2], Vector2d(2.0, 1.0));
+}
+
+TEST(NavMeshTest, PathAvoidsObstacle)
+{
+  NavMeshd mesh = GridMesh({
+      "#####",
+      "#####",
+      "##.##",
+      "##.##",
+      "#####",
+  });
+  NavMeshQueryd query(mesh);
+  std::vector<Vector2d> path;
+  ASSERT_EQ(query.FindPath(Vector2d(2.5, 1.5), Vector2d(2.5, 4.5), path), NavPathStatus::Found);
+  ASSERT_EQ(path.size(), 4u);
+  EXPECT_EQ(path[1].y, 2.0);
+  EXPECT_EQ(path[2].y, 4.0);
+  EXPECT_TRUE(path[1].x == 2.0 || path[1].x == 3.0);
+  EXPECT_EQ(path[1].x, path[2].x);
+}
+
+TEST(NavMeshTest, FailureStatuses)
+{
+  NavMeshd mesh = GridMesh({"##.##"});
+  NavMeshQueryd query(mesh);
+  std::vector<Vector2d> path;
+  EXPECT_EQ(query.FindPath(Vector2d(-1.0, 0.5), Vector2d(0.5, 0.5), path),
+            NavPathStatus::StartOffMesh);
+  EXPECT_EQ(query.FindPath(Vector2d(0.5, 0.5), Vector2d(2.5, 0.5), path),
+            NavPathStatus::GoalOffMesh);
+  EXPECT_EQ(query.FindPath(Vector2d(0.5, 0.5), Vector2d(4.5, 0.5), path),
+            NavPathStatus::Unreachable);
+  EXPECT_TRUE(path.empty());
+}
+
+/* ---- Cache ---- */
+TEST(NavMeshTest, CorridorCache)
+{
+  NavMeshd mesh = GridMesh({
+      "######",
+      "#....#",
+      "######",
+  });
+  NavMeshQueryd query(mesh);
+  std::vector<Vector2d> path;
+  ASSERT_EQ(query.FindPath(Vector2d(0.5, 1.5), Vector2d(5.5, 1.2), path), NavPathStatus::Found);
+  std::vector<Vector2d> first = path;
+  EXPECT_EQ(query.CacheMisses(), 1u);
+
+  // another pair of points in the same polygons reuses the corridor
+  ASSERT_EQ(query.FindPath(Vector2d(0.4, 1.6), Vector2d(5.6, 1.8), path), NavPathStatus::Found);
+  EXPECT_EQ(query.CacheHits(), 1u);
+  EXPECT_EQ(path.size(), first.size());
+  ASSERT_EQ(query.FindPath(Vector2d(0.5, 1.5), Vector2d(5.5, 1.2), path), NavPathStatus::Found);
+  EXPECT_EQ(path, first);
+
+  std::vector<u32> corridor = query.FindCorridor(0, 13);
+  NavMeshQueryd uncached(mesh, 0);
+  EXPECT_EQ(uncached.FindCorridor(0, 13), corridor);
+  EXPECT_EQ(uncached.CacheHits(), 0u);
+
+  query.ClearCache();
+  query.FindCorridor(0, 13);
+  EXPECT_EQ(query.CacheHits(), 0u);
+  EXPECT_EQ(query.CacheMisses(), 1u);
+}
+
+TEST(NavMeshTest, ManySearchesAgree)
+{
+  std::vector<std::string> rows = {
+      "##########",
+      "#..#...#.#",
+      "#.##.#.#.#",
+      "#....#...#",
+      "##########",
+  };
+  for (std::string& row : rows) {
+    for (char& c : row)
+      c = c == '#' ? '.' : '#';
+  }
+  NavMeshd mesh = GridMesh(rows);
+  NavMeshQueryd cached(mesh, 4);
+  NavMeshQueryd uncached(mesh, 0);
+  for (u32 a = 0; a < mesh.PolygonCount(); ++a) {
+    for (u32 b = 0; b < mesh.PolygonCount(); ++b) {
+      std::vector<u32> expected = uncached.FindCorridor(a, b);
+      EXPECT_EQ(cached.FindCorridor(a, b), expected);
+      EXPECT_EQ(cached.FindCorridor(a, b), expected);
+      ASSERT_FALSE(expected.empty());
+      EXPECT_EQ(expected.front(), a);
+      EXPECT_EQ(expected.back(), b);
+    }
+  }
+  EXPECT_GT(cached.CacheHits(), 0u);
+}
@@ -0,0 +1,80 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file BatchSlab.test.cpp
+ * @brief Tests for BatchSlab class
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/math/Vector3.h>
+#include <core/parallel/BatchSlab.h>
+#include <core/parallel/SpscQueue.h>
+#include <cstdint>
+#include <thread>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Math;
+using namespace Engine::Core::Parallel;
+
+/* ------------------------------------------- Basics ------------------------------------------ */
+
+TEST(BatchSlabTest, AcquireRelease)
+{
+  BatchSlab<Vector3f> slab(3, 100);
+  Batch<Vector3f> a, b, c, d;
+  ASSERT_TRUE(slab.TryAcquire(a));
+  ASSERT_TRUE(slab.TryAcquire(b));
+  ASSERT_TRUE(slab.TryAcquire(c));
+  EXPECT_FALSE(slab.TryAcquire(d));
+
+  EXPECT_EQ(a.size, 0u);
+  EXPECT_EQ(a.capacity, 100u);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(b.data) % 64, 0u);
+  EXPECT_GE(b.data - a.data, 100);
+
+  slab.Release(b);
+  ASSERT_TRUE(slab.TryAcquire(d));
+  EXPECT_EQ(d.data, b.data);
+}
+
+/* ------------------------------------------ Threads ------------------------------------------ */
+
+TEST(BatchSlabTest, StreamPointBatches)
+{
+  constexpr u32 batches = 2000;
+  BatchSlab<Vector3f> slab(8, 256);
+  SpscQueue<Batch<Vector3f>> queue(8);
+
+  std::thread producer([&]() {
+    for (u32 b = 0; b < batches; ++b) {
+      Batch<Vector3f> batch;
+      while (!slab.TryAcquire(batch))
+        std::this_thread::yield();
+      batch.size = 1 + b % batch.capacity;
+      for (u32 i = 0; i < batch.size; ++i)
+        batch[i] = Vector3f(1.0f, static_cast<f32>(b), 0.0f);
+      while (!queue.TryPush(batch))
+        std::this_thread::yield();
+    }
+  });
+
+  u64 points = 0;
+  u64 expected = 0;
+  bool consistent = true;
+  for (u32 b = 0; b < batches; ++b) {
+    Batch<Vector3f> batch;
+    while (!queue.TryPop(batch))
+      std::this_thread::yield();
+    for (const Vector3f& point : batch)
+      consistent &= point.y == static_cast<f32>(b);
+    points += batch.size;
+    expected += 1 + b % 256;
+    slab.Release(batch);
+  }
+  producer.join();
+  EXPECT_TRUE(consistent);
+  EXPECT_EQ(points, expected);
+}
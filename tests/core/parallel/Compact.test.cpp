@@ -0,0 +1,74 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Compact.test.cpp
+ * @brief Tests for stream compaction functions
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/parallel/Compact.h>
+#include <random>
+#include <vector>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Parallel;
+
+TEST(CompactTest, ByteMask)
+{
+  std::vector<i32> input = {10, 20, 30, 40, 50};
+  std::vector<u8> mask = {1, 0, 0, 1, 1};
+  std::vector<i32> output(input.size());
+
+  ASSERT_EQ(Compact(input.data(), mask.data(), input.size(), output.data()), 3u);
+  EXPECT_EQ(output[0], 10);
+  EXPECT_EQ(output[1], 40);
+  EXPECT_EQ(output[2], 50);
+}
+
+TEST(CompactTest, ParallelByteMask)
+{
+  std::mt19937 generator(5);
+  std::vector<u32> input(50000);
+  std::vector<u8> mask(input.size());
+  std::vector<u32> expected;
+  for (u32 i = 0; i < input.size(); ++i) {
+    input[i] = i;
+    mask[i] = generator() % 3 == 0;
+    if (mask[i])
+      expected.push_back(i);
+  }
+  std::vector<u32> output(input.size());
+  ThreadPool pool(3);
+
+  std::size_t written =
+      Compact(input.data(), mask.data(), input.size(), output.data(), pool, 1000);
+
+  output.resize(written);
+  EXPECT_EQ(output, expected);
+}
+
+TEST(CompactTest, Bits)
+{
+  std::mt19937 generator(9);
+  const std::size_t count = 10007;
+  std::vector<u8> bits((count + 7) / 8);
+  for (u8& byte : bits)
+    byte = static_cast<u8>(generator());
+  std::vector<u32> expected;
+  for (u32 i = 0; i < count; ++i) {
+    if (bits[i / 8] & (1u << (i % 8)))
+      expected.push_back(i);
+  }
+  std::vector<u32> serial(count);
+  std::vector<u32> parallel(count);
+  ThreadPool pool(3);
+
+  serial.resize(CompactBits(bits.data(), count, serial.data()));
+  parallel.resize(CompactBits(bits.data(), count, parallel.data(), pool, 100));
+
+  EXPECT_EQ(serial, expected);
+  EXPECT_EQ(parallel, expected);
+}
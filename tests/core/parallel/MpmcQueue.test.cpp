@@ -0,0 +1,80 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file MpmcQueue.test.cpp
+ * @brief Tests for MpmcQueue class
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/parallel/MpmcQueue.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Parallel;
+
+/* ------------------------------------------- Basics ------------------------------------------ */
+
+TEST(MpmcQueueTest, FullAndEmpty)
+{
+  MpmcQueue<u32> queue(4);
+  u32 value;
+  EXPECT_FALSE(queue.TryPop(value));
+  for (u32 lap = 0; lap < 3; ++lap) {
+    for (u32 i = 0; i < 4; ++i)
+      EXPECT_TRUE(queue.TryPush(lap * 10 + i));
+    EXPECT_FALSE(queue.TryPush(99));
+    for (u32 i = 0; i < 4; ++i) {
+      ASSERT_TRUE(queue.TryPop(value));
+      EXPECT_EQ(value, lap * 10 + i);
+    }
+    EXPECT_FALSE(queue.TryPop(value));
+  }
+}
+
+/* ------------------------------------------ Threads ------------------------------------------ */
+
+TEST(MpmcQueueTest, ManyProducersAndConsumers)
+{
+  constexpr u32 producers = 3;
+  constexpr u32 consumers = 3;
+  constexpr u32 perProducer = 50000;
+  MpmcQueue<u32> queue(128);
+  std::atomic<u64> sum{0};
+  std::atomic<u32> received{0};
+
+  std::vector<std::thread> threads;
+  for (u32 p = 0; p < producers; ++p) {
+    threads.emplace_back([&queue, p]() {
+      for (u32 i = 0; i < perProducer; ++i) {
+        while (!queue.TryPush(p * perProducer + i))
+          std::this_thread::yield();
+      }
+    });
+  }
+  for (u32 c = 0; c < consumers; ++c) {
+    threads.emplace_back([&]() {
+      u64 local = 0;
+      u32 value;
+      while (received.load() < producers * perProducer) {
+        if (queue.TryPop(value)) {
+          local += value;
+          received.fetch_add(1);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+      sum.fetch_add(local);
+    });
+  }
+  for (std::thread& thread : threads)
+    thread.join();
+
+  u64 total = producers * perProducer;
+  EXPECT_EQ(received.load(), total);
+  EXPECT_EQ(sum.load(), total * (total - 1) / 2);
+}
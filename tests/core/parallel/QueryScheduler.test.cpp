@@ -0,0 +1,196 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file QueryScheduler.test.cpp
+ * @brief Tests for time sliced batched queries
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <core/math/Vector2.h>
+#include <core/math/Vector3.h>
+#include <core/parallel/QueryScheduler.h>
+#include <thread>
+#include <vector>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Parallel;
+using Engine::Core::Math::Vector2f;
+using Engine::Core::Math::Vector3f;
+
+namespace
+{
+
+struct Segment
+{
+  Vector2f from;
+  Vector2f to;
+};
+
+void Length(const Segment& segment, f32& length)
+{
+  length = segment.from.DistanceTo(segment.to);
+}
+
+} // namespace
+
+/* ---- Handles ---- */
+TEST(QuerySchedulerTest, SubmitTickTake)
+{
+  QueryChannel<Segment, f32> lengths(Length);
+  QueryScheduler scheduler;
+  scheduler.Add(lengths);
+
+  QueryHandle a = lengths.Submit({Vector2f(0.0f, 0.0f), Vector2f(3.0f, 4.0f)});
+  QueryHandle b = lengths.Submit({Vector2f(1.0f, 1.0f), Vector2f(1.0f, 3.0f)});
+  EXPECT_EQ(lengths.Status(a), QueryStatus::Pending);
+  EXPECT_EQ(scheduler.PendingCount(), 2u);
+
+  EXPECT_EQ(scheduler.Tick(std::chrono::seconds(1)), 2u);
+  EXPECT_EQ(scheduler.PendingCount(), 0u);
+  f32 length = 0.0f;
+  ASSERT_TRUE(lengths.Take(b, length));
+  EXPECT_EQ(length, 2.0f);
+  ASSERT_TRUE(lengths.Take(a, length));
+  EXPECT_EQ(length, 5.0f);
+
+  // taken handles are stale, also after their slot is reused
+  EXPECT_EQ(lengths.Status(a), QueryStatus::Invalid);
+  EXPECT_FALSE(lengths.Take(a, length));
+  QueryHandle c = lengths.Submit({Vector2f(0.0f, 0.0f), Vector2f(1.0f, 0.0f)});
+  EXPECT_EQ(lengths.Status(a), QueryStatus::Invalid);
+  EXPECT_EQ(lengths.Status(b), QueryStatus::Invalid);
+  EXPECT_EQ(lengths.Status(c), QueryStatus::Pending);
+  EXPECT_EQ(lengths.Status(QueryHandle()), QueryStatus::Invalid);
+}
+
+TEST(QuerySchedulerTest, Cancel)
+{
+  u32 calls = 0;
+  QueryChannel<Segment, f32> lengths([&](const Segment& segment, f32& length) {
+    ++calls;
+    Length(segment, length);
+  });
+  QueryScheduler scheduler;
+  scheduler.Add(lengths);
+
+  QueryHandle a = lengths.Submit({Vector2f(0.0f, 0.0f), Vector2f(1.0f, 0.0f)});
+  QueryHandle b = lengths.Submit({Vector2f(0.0f, 0.0f), Vector2f(2.0f, 0.0f)});
+  EXPECT_TRUE(lengths.Cancel(a));
+  EXPECT_FALSE(lengths.Cancel(a));
+  EXPECT_EQ(lengths.PendingCount(), 1u);
+
+  EXPECT_EQ(scheduler.Tick(std::chrono::seconds(1)), 1u);
+  EXPECT_EQ(calls, 1u);
+  EXPECT_EQ(lengths.Status(a), QueryStatus::Invalid);
+  EXPECT_TRUE(lengths.Cancel(b));
+  EXPECT_EQ(lengths.Status(b), QueryStatus::Invalid);
+}
+
+/* ---- Time slicing ---- */
+TEST(QuerySchedulerTest, ZeroBudgetRunsOneChunk)
+{
+  QueryChannel<Segment, f32> lengths(Length);
+  QueryScheduler scheduler;
+  scheduler.Add(lengths);
+
+  std::vector<QueryHandle> handles;
+  for (i32 i = 0; i < 10; ++i)
+    handles.push_back(lengths.Submit({Vector2f(0.0f), Vector2f(static_cast<f32>(i), 0.0f)}));
+
+  EXPECT_EQ(scheduler.Tick(std::chrono::nanoseconds(0), 4), 4u);
+  for (i32 i = 0; i < 10; ++i)
+    EXPECT_EQ(lengths.Status(handles[i]), i < 4 ? QueryStatus::Ready : QueryStatus::Pending);
+  EXPECT_EQ(scheduler.Tick(std::chrono::nanoseconds(0), 4), 4u);
+  EXPECT_EQ(scheduler.Tick(std::chrono::nanoseconds(0), 4), 2u);
+  EXPECT_EQ(scheduler.Tick(std::chrono::nanoseconds(0), 4), 0u);
+
+  f32 length = 0.0f;
+  ASSERT_TRUE(lengths.Take(handles[9], length));
+  EXPECT_EQ(length, 9.0f);
+}
+
+TEST(QuerySchedulerTest, ChannelsTakeTurns)
+{
+  QueryChannel<Segment, f32> lengths(Length);
+  QueryChannel<Vector3f, Vector3f> normals([](const Vector3f& v, Vector3f& n) {
+    n = v.Normalized();
+  });
+  QueryScheduler scheduler;
+  scheduler.Add(lengths);
+  scheduler.Add(normals);
+  for (i32 i = 0; i < 3; ++i) {
+    lengths.Submit({Vector2f(0.0f), Vector2f(1.0f)});
+    normals.Submit(Vector3f(1.0f, 2.0f, 3.0f));
+  }
+
+  EXPECT_EQ(scheduler.Tick(std::chrono::nanoseconds(0), 2), 2u);
+  EXPECT_EQ(lengths.PendingCount(), 1u);
+  EXPECT_EQ(normals.PendingCount(), 3u);
+  EXPECT_EQ(scheduler.Tick(std::chrono::nanoseconds(0), 2), 2u);
+  EXPECT_EQ(normals.PendingCount(), 1u);
+  EXPECT_EQ(scheduler.Tick(std::chrono::seconds(1), 2), 2u);
+  EXPECT_EQ(scheduler.PendingCount(), 0u);
+}
+
+TEST(QuerySchedulerTest, BudgetSpreadsBurst)
+{
+  QueryChannel<i32, i32> slow([](const i32& request, i32& result) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    result = request * 2;
+  });
+  QueryScheduler scheduler;
+  scheduler.Add(slow);
+  std::vector<QueryHandle> handles;
+  for (i32 i = 0; i < 200; ++i)
+    handles.push_back(slow.Submit(i));
+
+  std::size_t first = scheduler.Tick(std::chrono::milliseconds(5), 1);
+  EXPECT_GE(first, 1u);
+  EXPECT_LT(first, 200u);
+  u32 ticks = 1;
+  while (scheduler.PendingCount() != 0) {
+    scheduler.Tick(std::chrono::milliseconds(20), 1);
+    ++ticks;
+  }
+  EXPECT_GT(ticks, 1u);
+  for (i32 i = 0; i < 200; ++i) {
+    i32 result = 0;
+    ASSERT_TRUE(slow.Take(handles[i], result));
+    EXPECT_EQ(result, i * 2);
+  }
+}
+
+/* ---- Parallel ---- */
+TEST(QuerySchedulerTest, ParallelTick)
+{
+  std::atomic<u32> calls = 0;
+  QueryChannel<Segment, f32> lengths([&](const Segment& segment, f32& length) {
+    calls.fetch_add(1, std::memory_order_relaxed);
+    Length(segment, length);
+  });
+  QueryScheduler scheduler;
+  scheduler.Add(lengths);
+  std::vector<QueryHandle> handles;
+  for (i32 i = 0; i < 1000; ++i)
+    handles.push_back(lengths.Submit({Vector2f(0.0f), Vector2f(0.0f, static_cast<f32>(i))}));
+
+  ThreadPool pool(3);
+  EXPECT_EQ(scheduler.Tick(std::chrono::seconds(10), pool), 1000u);
+  EXPECT_EQ(calls.load(), 1000u);
+  for (i32 i = 0; i < 1000; ++i) {
+    f32 length = 0.0f;
+    ASSERT_TRUE(lengths.Take(handles[i], length));
+    EXPECT_EQ(length, static_cast<f32>(i));
+  }
+
+  // with no time left only the first chunk runs
+  for (i32 i = 0; i < 100; ++i)
+    lengths.Submit({Vector2f(0.0f), Vector2f(1.0f)});
+  EXPECT_EQ(scheduler.Tick(std::chrono::nanoseconds(0), pool, 10), 10u);
+  EXPECT_EQ(lengths.PendingCount(), 90u);
+}
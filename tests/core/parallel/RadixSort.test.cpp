@@ -0,0 +1,119 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file RadixSort.test.cpp
+ * @brief Tests for RadixSort functions
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/parallel/RadixSort.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Parallel;
+
+namespace
+{
+
+struct Pair
+{
+  u64 key;
+  u32 value;
+};
+
+std::vector<Pair> RandomPairs(std::size_t count, u64 keyMask)
+{
+  std::mt19937_64 generator(7);
+  std::vector<Pair> pairs(count);
+  for (std::size_t i = 0; i < count; ++i)
+    pairs[i] = Pair{generator() & keyMask, static_cast<u32>(i)};
+  return pairs;
+}
+
+} // namespace
+
+TEST(RadixSortTest, Stable)
+{
+  std::vector<Pair> pairs = RandomPairs(10000, 0xff00ff);
+  std::vector<u64> keys(pairs.size());
+  std::vector<u32> values(pairs.size());
+  std::vector<u64> keyScratch(pairs.size());
+  std::vector<u32> valueScratch(pairs.size());
+  for (std::size_t i = 0; i < pairs.size(); ++i) {
+    keys[i] = pairs[i].key;
+    values[i] = pairs[i].value;
+  }
+
+  RadixSort(keys.data(), values.data(), keys.size(), keyScratch.data(), valueScratch.data());
+  std::stable_sort(pairs.begin(), pairs.end(), [](const Pair& a, const Pair& b) {
+    return a.key < b.key;
+  });
+
+  for (std::size_t i = 0; i < pairs.size(); ++i) {
+    EXPECT_EQ(keys[i], pairs[i].key);
+    EXPECT_EQ(values[i], pairs[i].value);
+  }
+}
+
+TEST(RadixSortTest, ParallelMatchesSerial)
+{
+  std::vector<Pair> pairs = RandomPairs(50000, ~u64(0));
+  std::vector<u64> keys(pairs.size());
+  std::vector<u32> values(pairs.size());
+  std::vector<u64> keyScratch(pairs.size());
+  std::vector<u32> valueScratch(pairs.size());
+  for (std::size_t i = 0; i < pairs.size(); ++i) {
+    keys[i] = pairs[i].key;
+    values[i] = pairs[i].value;
+  }
+  std::vector<u64> serialKeys = keys;
+  std::vector<u32> serialValues = values;
+  ThreadPool pool(3);
+
+  RadixSort(keys.data(), values.data(), keys.size(), keyScratch.data(), valueScratch.data(), pool,
+            1000);
+  RadixSort(serialKeys.data(), serialValues.data(), keys.size(), keyScratch.data(),
+            valueScratch.data());
+
+  EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+  EXPECT_EQ(keys, serialKeys);
+  EXPECT_EQ(values, serialValues);
+}
+
+TEST(RadixSortTest, KeysOnly32)
+{
+  std::mt19937 generator(11);
+  std::vector<u32> keys(30000);
+  for (u32& key : keys)
+    key = generator();
+  std::vector<u32> expected = keys;
+  std::vector<u32> parallel = keys;
+  std::vector<u32> scratch(keys.size());
+  ThreadPool pool(2);
+
+  RadixSort(keys.data(), keys.size(), scratch.data());
+  RadixSort(parallel.data(), parallel.size(), scratch.data(), pool, 1000);
+  std::sort(expected.begin(), expected.end());
+
+  EXPECT_EQ(keys, expected);
+  EXPECT_EQ(parallel, expected);
+}
+
+TEST(RadixSortTest, SkipsConstantDigits)
+{
+  // only the lowest and the highest digit vary, so three of four passes are performed
+  std::vector<u32> keys = {0x01000005u, 3u, 0x01000001u, 7u, 0u};
+  std::vector<u16> values = {0, 1, 2, 3, 4};
+  std::vector<u32> keyScratch(keys.size());
+  std::vector<u16> valueScratch(keys.size());
+
+  RadixSort(keys.data(), values.data(), keys.size(), keyScratch.data(), valueScratch.data());
+
+  EXPECT_EQ(keys, (std::vector<u32>{0u, 3u, 7u, 0x01000001u, 0x01000005u}));
+  EXPECT_EQ(values, (std::vector<u16>{4, 1, 3, 2, 0}));
+}
@@ -0,0 +1,53 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Scan.test.cpp
+ * @brief Tests for prefix sum functions
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/parallel/Scan.h>
+#include <numeric>
+#include <vector>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Parallel;
+
+TEST(ScanTest, Exclusive)
+{
+  std::vector<u32> input = {3, 1, 4, 1, 5};
+  std::vector<u32> output(input.size());
+
+  EXPECT_EQ(ExclusiveScan(input.data(), output.data(), input.size(), 10u), 24u);
+  EXPECT_EQ(output, (std::vector<u32>{10, 13, 14, 18, 19}));
+}
+
+TEST(ScanTest, InclusiveInPlace)
+{
+  std::vector<f32> values = {1.0f, 2.0f, 3.0f};
+
+  EXPECT_FLOAT_EQ(InclusiveScan(values.data(), values.data(), values.size()), 6.0f);
+  EXPECT_EQ(values, (std::vector<f32>{1.0f, 3.0f, 6.0f}));
+}
+
+TEST(ScanTest, ParallelMatchesSerial)
+{
+  std::vector<u64> input(100003);
+  std::iota(input.begin(), input.end(), 1);
+  std::vector<u64> exclusive(input.size());
+  std::vector<u64> inclusive(input.size());
+  std::vector<u64> parallel(input.size());
+  ThreadPool pool(3);
+
+  u64 total = ExclusiveScan(input.data(), exclusive.data(), input.size());
+  EXPECT_EQ(ExclusiveScan(input.data(), parallel.data(), input.size(), pool, u64(0), 1000), total);
+  EXPECT_EQ(parallel, exclusive);
+
+  InclusiveScan(input.data(), inclusive.data(), input.size());
+  EXPECT_EQ(InclusiveScan(input.data(), parallel.data(), input.size(), pool, 1000), total);
+  EXPECT_EQ(parallel, inclusive);
+  EXPECT_EQ(total, u64(100003) * 100004 / 2);
+}
@@ -0,0 +1,78 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file SpscQueue.test.cpp
+ * @brief Tests for SpscQueue class
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/parallel/SpscQueue.h>
+#include <thread>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Parallel;
+
+/* ------------------------------------------- Basics ------------------------------------------ */
+
+TEST(SpscQueueTest, FullAndEmpty)
+{
+  SpscQueue<u32> queue(3);
+  EXPECT_EQ(queue.Capacity(), 4u);
+
+  u32 value;
+  EXPECT_FALSE(queue.TryPop(value));
+  for (u32 i = 0; i < 4; ++i)
+    EXPECT_TRUE(queue.TryPush(i));
+  EXPECT_FALSE(queue.TryPush(4));
+  EXPECT_EQ(queue.SizeApprox(), 4u);
+
+  for (u32 i = 0; i < 4; ++i) {
+    ASSERT_TRUE(queue.TryPop(value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_FALSE(queue.TryPop(value));
+}
+
+TEST(SpscQueueTest, CapacityRounding)
+{
+  EXPECT_EQ(Internal::RoundUpToPowerOfTwo(1), 1u);
+  EXPECT_EQ(Internal::RoundUpToPowerOfTwo(5), 8u);
+  EXPECT_EQ(Internal::RoundUpToPowerOfTwo((1u << 30) + 1), 1u << 31);
+  EXPECT_EQ(Internal::RoundUpToPowerOfTwo(1u << 31), 1u << 31);
+  // doubling past 2^31 would wrap to 0 and never end, larger values are clamped
+  EXPECT_DEBUG_DEATH(
+      EXPECT_EQ(Internal::RoundUpToPowerOfTwo(~0u), 1u << 31), "Capacity above 2\\^31"
+  );
+}
+
+/* ------------------------------------------ Threads ------------------------------------------ */
+
+TEST(SpscQueueTest, StreamKeepsOrder)
+{
+  constexpr u32 count = 200000;
+  SpscQueue<u32> queue(64);
+
+  std::thread producer([&queue]() {
+    for (u32 i = 0; i < count; ++i) {
+      while (!queue.TryPush(i))
+        std::this_thread::yield();
+    }
+  });
+
+  u32 expected = 0;
+  bool ordered = true;
+  while (expected < count) {
+    u32 value;
+    if (!queue.TryPop(value)) {
+      std::this_thread::yield();
+      continue;
+    }
+    ordered &= value == expected;
+    ++expected;
+  }
+  producer.join();
+  EXPECT_TRUE(ordered);
+}
@@ -0,0 +1,79 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file ThreadPool.test.cpp
+ * @brief Tests for ThreadPool class
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/parallel/ThreadPool.h>
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Parallel;
+
+/* ---------------------------------------- ParallelFor ---------------------------------------- */
+
+TEST(ThreadPoolTest, ParallelForCoversRangeOnce)
+{
+  ThreadPool pool(3);
+  std::vector<int> hits(100003, 0);
+
+  pool.ParallelFor(hits.size(), 1000, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i)
+      ++hits[i];
+  });
+
+  for (int hit : hits)
+    EXPECT_EQ(hit, 1);
+}
+
+TEST(ThreadPoolTest, ParallelForWithoutWorkers)
+{
+  ThreadPool pool(0);
+  std::size_t sum = 0;
+
+  pool.ParallelFor(1000, 7, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i)
+      sum += i;
+  });
+
+  EXPECT_EQ(pool.WorkerCount(), 0u);
+  EXPECT_EQ(sum, 999u * 1000u / 2u);
+}
+
+TEST(ThreadPoolTest, ParallelForRepeated)
+{
+  ThreadPool pool(4);
+  std::atomic<u64> sum{0};
+
+  for (int run = 0; run < 200; ++run) {
+    pool.ParallelFor(4096, 64, [&](std::size_t begin, std::size_t end) {
+      u64 local = 0;
+      for (std::size_t i = begin; i < end; ++i)
+        local += i;
+      sum.fetch_add(local, std::memory_order_relaxed);
+    });
+  }
+
+  EXPECT_EQ(sum.load(), 200ull * (4095ull * 4096ull / 2ull));
+}
+
+TEST(ThreadPoolTest, ParallelForNested)
+{
+  ThreadPool pool(2);
+  std::atomic<u32> count{0};
+
+  pool.ParallelFor(8, 1, [&](std::size_t, std::size_t) {
+    pool.ParallelFor(10, 1, [&](std::size_t begin, std::size_t end) {
+      count.fetch_add(static_cast<u32>(end - begin), std::memory_order_relaxed);
+    });
+  });
+
+  EXPECT_EQ(count.load(), 80u);
+}
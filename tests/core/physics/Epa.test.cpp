@@ -0,0 +1,76 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Epa.test.cpp
+ * @brief Tests for EPA penetration depth query
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/physics/Epa.h>
+#include <core/physics/Gjk.h>
+#include <core/physics/Shapes.h>
+
+using namespace Engine::Core::Math;
+using namespace Engine::Core::Physics;
+
+/* ---------------------------------------- Penetration ---------------------------------------- */
+
+TEST(EpaTest, PenetrationBoxes)
+{
+  Boxf a(Vector3f::Zero(), Vector3f(1.0f, 1.0f, 1.0f));
+  Boxf b(Vector3f(1.75f, 0.2f, 0.1f), Vector3f(1.0f, 1.0f, 1.0f));
+  GjkSimplexf simplex;
+
+  ASSERT_TRUE(GjkDistance(a, b, simplex).intersecting);
+  EpaResultf result = EpaPenetration(a, b, simplex);
+
+  ASSERT_TRUE(result.valid);
+  EXPECT_NEAR(result.depth, 0.25f, 1e-4f);
+  EXPECT_NEAR(result.normal.x, 1.0f, 1e-4f);
+  EXPECT_NEAR(result.pointA.x, 1.0f, 1e-4f);
+  EXPECT_NEAR(result.pointB.x, 0.75f, 1e-4f);
+}
+
+TEST(EpaTest, PenetrationSpheres)
+{
+  Spheref a(Vector3f::Zero(), 1.0f);
+  Spheref b(Vector3f(0.0f, 1.5f, 0.0f), 1.0f);
+  GjkSimplexf simplex;
+
+  ASSERT_TRUE(GjkIntersect(a, b, simplex));
+  EpaResultf result = EpaPenetration(a, b, simplex);
+
+  ASSERT_TRUE(result.valid);
+  EXPECT_NEAR(result.depth, 0.5f, 1e-2f);
+  EXPECT_NEAR(result.normal.y, 1.0f, 1e-2f);
+}
+
+TEST(EpaTest, PenetrationCapsuleBox)
+{
+  Boxf box(Vector3f::Zero(), Vector3f(2.0f, 0.5f, 2.0f));
+  Capsulef capsule(Vector3f(-1.0f, 0.8f, 0.0f), Vector3f(1.0f, 0.8f, 0.0f), 0.5f);
+  GjkSimplexf simplex;
+
+  ASSERT_TRUE(GjkDistance(box, capsule, simplex).intersecting);
+  EpaResultf result = EpaPenetration(box, capsule, simplex);
+
+  ASSERT_TRUE(result.valid);
+  EXPECT_NEAR(result.depth, 0.2f, 1e-2f);
+  EXPECT_NEAR(result.normal.y, 1.0f, 1e-2f);
+}
+
+TEST(EpaTest, TouchingSimplexIsExpanded)
+{
+  Boxf a(Vector3f::Zero(), Vector3f(1.0f, 1.0f, 1.0f));
+  Boxf b(Vector3f(0.0f, 0.0f, 1.9f), Vector3f(1.0f, 1.0f, 1.0f));
+  GjkSimplexf empty;
+
+  EpaResultf result = EpaPenetration(a, b, empty);
+
+  ASSERT_TRUE(result.valid);
+  EXPECT_NEAR(result.depth, 0.1f, 1e-4f);
+  EXPECT_NEAR(result.normal.z, 1.0f, 1e-4f);
+}
@@ -0,0 +1,123 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Gjk.test.cpp
+ * @brief Tests for GJK distance and intersection queries
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/physics/Gjk.h>
+#include <core/physics/Shapes.h>
+
+using namespace Engine::Core::Math;
+using namespace Engine::Core::Physics;
+
+/* ------------------------------------------- Shapes ------------------------------------------ */
+
+TEST(GjkTest, ShapeSupport)
+{
+  Spheref sphere(Vector3f(1.0f, 0.0f, 0.0f), 2.0f);
+  Boxf box(Vector3f::Zero(), Vector3f(1.0f, 2.0f, 3.0f));
+  Capsulef capsule(Vector3f(0.0f, -1.0f, 0.0f), Vector3f(0.0f, 1.0f, 0.0f), 0.5f);
+  Vector3f vertices[3] = {{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}};
+  ConvexHullf hull(vertices, 3, Vector3f(0.0f, 0.0f, 5.0f));
+
+  EXPECT_TRUE(sphere.Support(Vector3f(0.0f, 3.0f, 0.0f)) == Vector3f(1.0f, 2.0f, 0.0f));
+  EXPECT_TRUE(box.Support(Vector3f(-1.0f, 1.0f, -1.0f)) == Vector3f(-1.0f, 2.0f, -3.0f));
+  EXPECT_TRUE(capsule.Support(Vector3f(0.0f, 1.0f, 0.0f)) == Vector3f(0.0f, 1.5f, 0.0f));
+  EXPECT_TRUE(hull.Support(Vector3f(1.0f, 0.2f, 0.0f)) == Vector3f(1.0f, 0.0f, 5.0f));
+}
+
+/* ------------------------------------------ Distance ----------------------------------------- */
+
+TEST(GjkTest, DistanceSpheres)
+{
+  Spheref a(Vector3f::Zero(), 1.0f);
+  Spheref b(Vector3f(5.0f, 0.0f, 0.0f), 2.0f);
+  GjkSimplexf simplex;
+
+  GjkResultf result = GjkDistance(a, b, simplex);
+
+  EXPECT_FALSE(result.intersecting);
+  EXPECT_NEAR(result.distance, 2.0f, 1e-3f);
+  EXPECT_NEAR(result.pointA.x, 1.0f, 1e-3f);
+  EXPECT_NEAR(result.pointB.x, 3.0f, 1e-3f);
+}
+
+TEST(GjkTest, DistanceBoxes)
+{
+  Boxf a(Vector3f::Zero(), Vector3f(1.0f, 1.0f, 1.0f));
+  Boxf b(Vector3f(4.0f, 3.0f, 0.5f), Vector3f(1.0f, 1.0f, 1.0f));
+  GjkSimplexf simplex;
+
+  GjkResultf result = GjkDistance(a, b, simplex);
+
+  EXPECT_FALSE(result.intersecting);
+  EXPECT_NEAR(result.distance, std::sqrt(4.0f + 1.0f), 1e-4f);
+  EXPECT_NEAR(result.pointA.x, 1.0f, 1e-4f);
+  EXPECT_NEAR(result.pointA.y, 1.0f, 1e-4f);
+  EXPECT_NEAR(result.pointB.x, 3.0f, 1e-4f);
+  EXPECT_NEAR(result.pointB.y, 2.0f, 1e-4f);
+}
+
+TEST(GjkTest, DistanceCapsuleHull)
+{
+  Capsulef capsule(Vector3f(-5.0f, 3.0f, 0.0f), Vector3f(5.0f, 3.0f, 0.0f), 0.5f);
+  Vector3f vertices[4] = {
+      {-1.0f, 0.0f, -1.0f}, {1.0f, 0.0f, -1.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 1.0f, 0.0f}
+  };
+  ConvexHullf hull(vertices, 4);
+  GjkSimplexf simplex;
+
+  GjkResultf result = GjkDistance(capsule, hull, simplex);
+
+  EXPECT_FALSE(result.intersecting);
+  EXPECT_NEAR(result.distance, 1.5f, 1e-3f);
+}
+
+TEST(GjkTest, DistanceIntersecting)
+{
+  Boxf a(Vector3f::Zero(), Vector3f(1.0f, 1.0f, 1.0f));
+  Spheref b(Vector3f(1.5f, 0.0f, 0.0f), 1.0f);
+  GjkSimplexf simplex;
+
+  GjkResultf result = GjkDistance(a, b, simplex);
+
+  EXPECT_TRUE(result.intersecting);
+  EXPECT_FLOAT_EQ(result.distance, 0.0f);
+}
+
+TEST(GjkTest, WarmStartConvergesFaster)
+{
+  Boxf a(Vector3f::Zero(), Vector3f(1.0f, 1.0f, 1.0f));
+  Boxf b(Vector3f(3.0f, 2.5f, 1.5f), Vector3f(1.0f, 1.0f, 1.0f));
+  GjkSimplexf simplex;
+
+  GjkResultf cold = GjkDistance(a, b, simplex);
+  b.center += Vector3f(0.01f, 0.0f, 0.01f);
+  GjkResultf warm = GjkDistance(a, b, simplex);
+
+  GjkSimplexf empty;
+  GjkResultf reference = GjkDistance(a, b, empty);
+
+  EXPECT_LE(warm.iterations, 2u);
+  EXPECT_LT(warm.iterations, cold.iterations);
+  EXPECT_NEAR(warm.distance, reference.distance, 1e-4f);
+}
+
+/* ---------------------------------------- Intersection --------------------------------------- */
+
+TEST(GjkTest, Intersect)
+{
+  Spheref a(Vector3f::Zero(), 1.0f);
+  Capsulef touching(Vector3f(0.5f, -2.0f, 0.0f), Vector3f(0.5f, 2.0f, 0.0f), 0.6f);
+  Capsulef separated(Vector3f(2.0f, -2.0f, 0.0f), Vector3f(2.0f, 2.0f, 0.0f), 0.6f);
+  GjkSimplexf simplex;
+
+  EXPECT_TRUE(GjkIntersect(a, touching, simplex));
+  simplex.Reset();
+  EXPECT_FALSE(GjkIntersect(a, separated, simplex));
+}
@@ -0,0 +1,136 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Integrator.test.cpp
+ * @brief Tests for PhysicsState and integration kernels
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/physics/Integrator.h>
+#include <core/physics/PhysicsState.h>
+#include <cmath>
+
+using namespace Engine::Core::Math;
+using namespace Engine::Core::Parallel;
+using namespace Engine::Core::Physics;
+
+namespace
+{
+
+struct Spring
+{
+  Vector3d operator()(std::size_t, const Vector3d& position, const Vector3d&) const
+  {
+    return -position;
+  }
+};
+
+} // namespace
+
+/* ------------------------------------------- State ------------------------------------------- */
+
+TEST(IntegratorTest, StateAddRemove)
+{
+  PhysicsStatef state;
+
+  state.Add(Vector3f(1.0f, 0.0f, 0.0f), Vector3f(), 2.0f);
+  state.Add(Vector3f(2.0f, 0.0f, 0.0f), Vector3f(), 0.0f);
+  state.RemoveSwap(0);
+
+  EXPECT_EQ(state.Size(), 1u);
+  EXPECT_TRUE(state.positions.Get(0) == Vector3f(2.0f, 0.0f, 0.0f));
+  EXPECT_FLOAT_EQ(state.inverseMasses[0], 0.0f);
+}
+
+/* ----------------------------------------- Integrators --------------------------------------- */
+
+TEST(IntegratorTest, SemiImplicitEuler)
+{
+  PhysicsStatef state;
+  state.Add(Vector3f(), Vector3f(1.0f, 0.0f, 0.0f), 2.0f);
+  state.Add(Vector3f(), Vector3f(), 0.0f);
+  state.ApplyForce(0, Vector3f(0.0f, 4.0f, 0.0f));
+
+  IntegrateSemiImplicitEuler(state, 0.5f, Vector3f(0.0f, 0.0f, -10.0f), 0, state.Size());
+
+  EXPECT_TRUE(state.velocities.Get(0) == Vector3f(1.0f, 1.0f, -5.0f));
+  EXPECT_TRUE(state.positions.Get(0) == Vector3f(0.5f, 0.5f, -2.5f));
+  EXPECT_TRUE(state.forces.Get(0) == Vector3f());
+  EXPECT_TRUE(state.positions.Get(1) == Vector3f());
+  EXPECT_TRUE(state.velocities.Get(1) == Vector3f());
+}
+
+TEST(IntegratorTest, VerletProjectileIsExact)
+{
+  PhysicsStated state;
+  state.Add(Vector3d(), Vector3d(3.0, 10.0, 0.0), 1.0);
+  Vector3d gravity(0.0, -9.8, 0.0);
+
+  for (int step = 0; step < 100; ++step) {
+    IntegrateVerletBegin(state, 0.01, gravity, 0, state.Size());
+    IntegrateVerletEnd(state, 0.01, gravity, 0, state.Size());
+  }
+
+  EXPECT_NEAR(state.positions.x[0], 3.0, 1e-9);
+  EXPECT_NEAR(state.positions.y[0], 10.0 - 4.9, 1e-9);
+  EXPECT_NEAR(state.velocities.y[0], 10.0 - 9.8, 1e-9);
+}
+
+TEST(IntegratorTest, RK4HarmonicOscillator)
+{
+  PhysicsStated state;
+  state.Add(Vector3d(1.0, 0.0, 0.0), Vector3d(), 1.0);
+  const double pi = 3.14159265358979323846;
+
+  for (int step = 0; step < 1000; ++step)
+    IntegrateRK4(state, pi / 1000.0, Vector3d(), Spring(), 0, state.Size());
+
+  EXPECT_NEAR(state.positions.x[0], -1.0, 1e-9);
+  EXPECT_NEAR(state.velocities.x[0], 0.0, 1e-9);
+}
+
+TEST(IntegratorTest, RK4FieldSkipsStaticBodies)
+{
+  // enough bodies for several tiles, every third one static
+  PhysicsStated state;
+  for (int i = 0; i < 1000; ++i)
+    state.Add(Vector3d(1.0, 0.0, 0.0), Vector3d(), i % 3 == 0 ? 0.0 : 1.0);
+  ThreadPool pool(3);
+
+  for (int step = 0; step < 10; ++step)
+    IntegrateRK4(state, 0.01, Vector3d(0.0, -9.8, 0.0), Spring(), pool, 100);
+
+  for (std::size_t i = 0; i < state.Size(); ++i) {
+    if (i % 3 == 0) {
+      EXPECT_TRUE(state.positions.Get(i) == Vector3d(1.0, 0.0, 0.0)) << i;
+      EXPECT_TRUE(state.velocities.Get(i) == Vector3d()) << i;
+    } else {
+      EXPECT_NEAR(state.positions.x[i], std::cos(0.1), 1e-9) << i;
+      EXPECT_LT(state.velocities.y[i], 0.0) << i;
+    }
+  }
+}
+
+TEST(IntegratorTest, ParallelMatchesSerial)
+{
+  PhysicsStatef serial;
+  for (int i = 0; i < 100000; ++i) {
+    float f = static_cast<float>(i);
+    serial.Add(Vector3f(f, -f, 0.5f * f), Vector3f(1.0f, 2.0f, 3.0f), 1.0f + (i % 5));
+    serial.ApplyForce(i, Vector3f(0.1f * f, 0.0f, -1.0f));
+  }
+  PhysicsStatef parallel = serial;
+  ThreadPool pool(3);
+
+  IntegrateSemiImplicitEuler(serial, 0.016f, Vector3f(0.0f, -9.8f, 0.0f), 0, serial.Size());
+  IntegrateSemiImplicitEuler(parallel, 0.016f, Vector3f(0.0f, -9.8f, 0.0f), pool, 4096);
+
+  for (std::size_t i = 0; i < serial.Size(); ++i) {
+    ASSERT_FLOAT_EQ(serial.positions.x[i], parallel.positions.x[i]);
+    ASSERT_FLOAT_EQ(serial.positions.y[i], parallel.positions.y[i]);
+    ASSERT_FLOAT_EQ(serial.velocities.z[i], parallel.velocities.z[i]);
+  }
+}
@@ -0,0 +1,170 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file SweepAndPrune.test.cpp
+ * @brief Tests for SweepAndPrune broadphase
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/physics/SweepAndPrune.h>
+#include <algorithm>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Math;
+using namespace Engine::Core::Physics;
+
+namespace
+{
+
+using PairSet = std::set<std::pair<u32, u32>>;
+
+PairSet ToSet(const std::vector<BroadphasePair>& pairs)
+{
+  PairSet result;
+  for (const BroadphasePair& pair : pairs) {
+    EXPECT_LT(pair.a, pair.b);
+    result.insert({pair.a, pair.b});
+  }
+  EXPECT_EQ(result.size(), pairs.size());
+  return result;
+}
+
+PairSet BruteForce(const std::vector<AABBf>& boxes, const std::vector<u32>& handles)
+{
+  PairSet result;
+  for (std::size_t i = 0; i < boxes.size(); ++i)
+    for (std::size_t j = i + 1; j < boxes.size(); ++j)
+      if (boxes[i].Overlaps(boxes[j]))
+        result.insert({std::min(handles[i], handles[j]), std::max(handles[i], handles[j])});
+  return result;
+}
+
+void RunRandomMotion(SweepAndPruneMode mode)
+{
+  std::mt19937 rng(1234);
+  std::uniform_real_distribution<float> position(0.0f, 50.0f);
+  std::uniform_real_distribution<float> size(0.5f, 3.0f);
+  std::uniform_real_distribution<float> step(-0.3f, 0.3f);
+
+  SweepAndPrunef sap(mode);
+  std::vector<AABBf> boxes;
+  std::vector<u32> handles;
+  for (int i = 0; i < 300; ++i) {
+    Vector3f min(position(rng), position(rng), position(rng));
+    boxes.emplace_back(min, min + Vector3f(size(rng), size(rng), size(rng)));
+    handles.push_back(sap.Add(boxes.back()));
+  }
+
+  for (int frame = 0; frame < 20; ++frame) {
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+      Vector3f offset(step(rng), step(rng), step(rng));
+      boxes[i] = AABBf(boxes[i].min + offset, boxes[i].max + offset);
+      sap.SetBounds(handles[i], boxes[i]);
+    }
+
+    // remove one body and add a new one every frame
+    sap.Remove(handles[frame]);
+    Vector3f min(position(rng), position(rng), position(rng));
+    boxes[frame] = AABBf(min, min + Vector3f(2.0f, 2.0f, 2.0f));
+    handles[frame] = sap.Add(boxes[frame]);
+
+    sap.Update();
+
+    EXPECT_EQ(ToSet(sap.Pairs()), BruteForce(boxes, handles));
+  }
+}
+
+} // namespace
+
+/* ------------------------------------------ Updates ------------------------------------------ */
+
+TEST(SweepAndPruneTest, ThreeAxesMatchesBruteForce)
+{
+  RunRandomMotion(SweepAndPruneMode::ThreeAxes);
+}
+
+TEST(SweepAndPruneTest, SingleAxisMatchesBruteForce)
+{
+  RunRandomMotion(SweepAndPruneMode::SingleAxis);
+}
+
+TEST(SweepAndPruneTest, PairsFollowMotion)
+{
+  SweepAndPrunef sap;
+  u32 a = sap.Add(AABBf(Vector3f::Zero(), Vector3f(1.0f, 1.0f, 1.0f)));
+  u32 b = sap.Add(AABBf(Vector3f(2.0f, 0.0f, 0.0f), Vector3f(3.0f, 1.0f, 1.0f)));
+  sap.Update();
+
+  EXPECT_TRUE(sap.Pairs().empty());
+
+  sap.SetBounds(b, AABBf(Vector3f(0.5f, 0.0f, 0.0f), Vector3f(1.5f, 1.0f, 1.0f)));
+  sap.Update();
+
+  ASSERT_EQ(sap.Pairs().size(), 1u);
+  EXPECT_EQ(sap.Pairs()[0].a, a);
+  EXPECT_EQ(sap.Pairs()[0].b, b);
+
+  sap.SetBounds(b, AABBf(Vector3f(0.5f, 2.0f, 0.0f), Vector3f(1.5f, 3.0f, 1.0f)));
+  sap.Update();
+
+  EXPECT_TRUE(sap.Pairs().empty());
+}
+
+TEST(SweepAndPruneTest, RemoveDropsPairs)
+{
+  SweepAndPrunef sap;
+  sap.Add(AABBf(Vector3f::Zero(), Vector3f(1.0f, 1.0f, 1.0f)));
+  u32 b = sap.Add(AABBf(Vector3f(0.5f, 0.5f, 0.5f), Vector3f(2.0f, 2.0f, 2.0f)));
+  sap.Update();
+
+  ASSERT_EQ(sap.Pairs().size(), 1u);
+
+  sap.Remove(b);
+
+  EXPECT_TRUE(sap.Pairs().empty());
+  EXPECT_EQ(sap.Size(), 1u);
+}
+
+TEST(SweepAndPruneTest, BulkAddMatchesBruteForce)
+{
+  std::mt19937 rng(99);
+  std::uniform_real_distribution<float> position(0.0f, 100.0f);
+  std::uniform_real_distribution<float> size(0.5f, 4.0f);
+
+  for (SweepAndPruneMode mode : {SweepAndPruneMode::ThreeAxes, SweepAndPruneMode::SingleAxis}) {
+    SweepAndPrunef sap(mode);
+    std::vector<AABBf> boxes;
+    std::vector<u32> handles;
+    auto addBodies = [&](int bodies) {
+      for (int i = 0; i < bodies; ++i) {
+        Vector3f min(position(rng), position(rng), position(rng));
+        boxes.emplace_back(min, min + Vector3f(size(rng), size(rng), size(rng)));
+        handles.push_back(sap.Add(boxes.back()));
+      }
+    };
+
+    // the second batch lands among moved bodies and one of it is removed before the update
+    addBodies(3000);
+    sap.Update();
+    EXPECT_EQ(ToSet(sap.Pairs()), BruteForce(boxes, handles));
+
+    for (std::size_t i = 0; i < boxes.size(); i += 2) {
+      boxes[i] = AABBf(boxes[i].min + Vector3f(0.5f, 0.0f, 0.0f), boxes[i].max);
+      sap.SetBounds(handles[i], boxes[i]);
+    }
+    addBodies(1000);
+    sap.Remove(handles.back());
+    boxes.pop_back();
+    handles.pop_back();
+    sap.Update();
+    EXPECT_EQ(ToSet(sap.Pairs()), BruteForce(boxes, handles));
+    EXPECT_EQ(sap.Size(), 3999u);
+  }
+}
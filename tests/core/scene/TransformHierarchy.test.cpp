@@ -0,0 +1,167 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file TransformHierarchy.test.cpp
+ * @brief Tests for TransformHierarchy class
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/scene/TransformHierarchy.h>
+#include <random>
+#include <vector>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Math;
+using namespace Engine::Core::Scene;
+
+namespace
+{
+
+Transformf Offset(f32 x, f32 y, f32 z)
+{
+  return Transformf(Vector3f(x, y, z));
+}
+
+/// World transform computed by walking up the parents
+Transformf Reference(const TransformHierarchyf& hierarchy, u32 handle)
+{
+  Transformf world = hierarchy.GetLocal(handle);
+  for (u32 parent = hierarchy.GetParent(handle); parent != TransformHierarchyf::invalidHandle;
+       parent = hierarchy.GetParent(parent))
+    world = hierarchy.GetLocal(parent) * world;
+  return world;
+}
+
+void ExpectNear(const Vector3f& a, const Vector3f& b)
+{
+  EXPECT_NEAR(a.x, b.x, 1e-3f);
+  EXPECT_NEAR(a.y, b.y, 1e-3f);
+  EXPECT_NEAR(a.z, b.z, 1e-3f);
+}
+
+} // namespace
+
+/* ------------------------------------------ Updates ------------------------------------------ */
+
+TEST(TransformHierarchyTest, Chain)
+{
+  TransformHierarchyf hierarchy;
+  u32 root = hierarchy.Add(Offset(1.0f, 0.0f, 0.0f));
+  u32 child = hierarchy.Add(Offset(0.0f, 2.0f, 0.0f), root);
+  u32 grandchild = hierarchy.Add(Offset(0.0f, 0.0f, 3.0f), child);
+  hierarchy.Update();
+
+  EXPECT_EQ(hierarchy.LevelCount(), 3u);
+  EXPECT_EQ(hierarchy.GetWorld(grandchild).position, Vector3f(1.0f, 2.0f, 3.0f));
+
+  hierarchy.SetLocal(root, Offset(-1.0f, 0.0f, 0.0f));
+  hierarchy.Update();
+  EXPECT_EQ(hierarchy.GetWorld(child).position, Vector3f(-1.0f, 2.0f, 0.0f));
+  EXPECT_EQ(hierarchy.GetWorld(grandchild).position, Vector3f(-1.0f, 2.0f, 3.0f));
+}
+
+TEST(TransformHierarchyTest, OnlyChangedSubtreesAreRecomputed)
+{
+  TransformHierarchyf hierarchy;
+  u32 a = hierarchy.Add(Offset(1.0f, 0.0f, 0.0f));
+  u32 b = hierarchy.Add(Offset(2.0f, 0.0f, 0.0f));
+  u32 childA = hierarchy.Add(Offset(0.0f, 1.0f, 0.0f), a);
+  u32 childB = hierarchy.Add(Offset(0.0f, 1.0f, 0.0f), b);
+  hierarchy.Update();
+  Transformf worldB = hierarchy.GetWorld(childB);
+
+  hierarchy.SetLocal(a, Offset(5.0f, 0.0f, 0.0f));
+  // world transforms stay as of the last update until the next one
+  EXPECT_EQ(hierarchy.GetWorld(childA).position, Vector3f(1.0f, 1.0f, 0.0f));
+  hierarchy.Update();
+  EXPECT_EQ(hierarchy.GetWorld(childA).position, Vector3f(5.0f, 1.0f, 0.0f));
+  EXPECT_EQ(hierarchy.GetWorld(childB), worldB);
+}
+
+/* ----------------------------------------- Structure ----------------------------------------- */
+
+TEST(TransformHierarchyTest, SetParentReorders)
+{
+  TransformHierarchyf hierarchy;
+  u32 a = hierarchy.Add(Offset(1.0f, 0.0f, 0.0f));
+  u32 b = hierarchy.Add(Offset(0.0f, 1.0f, 0.0f), a);
+  u32 c = hierarchy.Add(Offset(0.0f, 0.0f, 1.0f));
+  hierarchy.Update();
+
+  // moving a root below a deeper node puts it after that node
+  hierarchy.SetParent(c, b);
+  hierarchy.Update();
+  EXPECT_EQ(hierarchy.GetParent(c), b);
+  EXPECT_EQ(hierarchy.LevelCount(), 3u);
+  EXPECT_EQ(hierarchy.GetWorld(c).position, Vector3f(1.0f, 1.0f, 1.0f));
+
+  hierarchy.SetParent(b, TransformHierarchyf::invalidHandle);
+  hierarchy.Update();
+  EXPECT_EQ(hierarchy.GetWorld(c).position, Vector3f(0.0f, 1.0f, 1.0f));
+}
+
+TEST(TransformHierarchyTest, RemoveSubtree)
+{
+  TransformHierarchyf hierarchy;
+  u32 root = hierarchy.Add(Offset(1.0f, 0.0f, 0.0f));
+  u32 a = hierarchy.Add(Offset(0.0f, 1.0f, 0.0f), root);
+  u32 b = hierarchy.Add(Offset(0.0f, 2.0f, 0.0f), root);
+  hierarchy.Add(Offset(0.0f, 0.0f, 1.0f), a);
+  u32 leaf = hierarchy.Add(Offset(0.0f, 0.0f, 2.0f), b);
+  hierarchy.Update();
+
+  hierarchy.Remove(a);
+  EXPECT_EQ(hierarchy.Size(), 3u);
+  hierarchy.SetLocal(root, Offset(3.0f, 0.0f, 0.0f));
+  hierarchy.Update();
+  EXPECT_EQ(hierarchy.GetWorld(leaf).position, Vector3f(3.0f, 2.0f, 2.0f));
+  EXPECT_EQ(hierarchy.LevelCount(), 3u);
+
+  hierarchy.Remove(b);
+  hierarchy.Update();
+  EXPECT_EQ(hierarchy.Size(), 1u);
+  EXPECT_EQ(hierarchy.LevelCount(), 1u);
+
+  // freed handles are reused
+  u32 added = hierarchy.Add(Offset(0.0f, 0.0f, 0.0f), root);
+  EXPECT_LE(added, 4u);
+  hierarchy.Update();
+  EXPECT_EQ(hierarchy.GetWorld(added).position, Vector3f(3.0f, 0.0f, 0.0f));
+}
+
+/* ------------------------------------------ Parallel ----------------------------------------- */
+
+TEST(TransformHierarchyTest, RandomTreeParallel)
+{
+  std::mt19937 random(7);
+  std::uniform_real_distribution<f32> offset(-1.0f, 1.0f);
+  auto randomTransform = [&]() {
+    Vector3f axis = Vector3f(offset(random), offset(random), offset(random) + 2.0f).Normalized();
+    return Transformf(
+        Vector3f(offset(random), offset(random), offset(random)),
+        Quaternionf::FromAxisAngle(axis, offset(random))
+    );
+  };
+
+  TransformHierarchyf hierarchy;
+  std::vector<u32> nodes;
+  for (u32 i = 0; i < 20000; ++i) {
+    u32 parent = i < 4 ? TransformHierarchyf::invalidHandle : nodes[random() % nodes.size()];
+    nodes.push_back(hierarchy.Add(randomTransform(), parent));
+  }
+
+  Parallel::ThreadPool pool(3);
+  hierarchy.Update(pool, 64);
+  for (u32 i = 0; i < nodes.size(); i += 97)
+    ExpectNear(hierarchy.GetWorld(nodes[i]).position, Reference(hierarchy, nodes[i]).position);
+
+  for (u32 i = 0; i < 50; ++i)
+    hierarchy.SetLocal(nodes[random() % nodes.size()], randomTransform());
+  hierarchy.SetParent(nodes[10], nodes[5000]);
+  hierarchy.Update(pool, 64);
+  for (u32 i = 0; i < nodes.size(); i += 31)
+    ExpectNear(hierarchy.GetWorld(nodes[i]).position, Reference(hierarchy, nodes[i]).position);
+}
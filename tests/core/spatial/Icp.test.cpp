@@ -0,0 +1,173 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file Icp.test.cpp
+ * @brief Tests for iterative closest point registration
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <core/spatial/Icp.h>
+#include <random>
+#include <vector>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Spatial;
+using Engine::Core::Math::Quaterniond;
+using Engine::Core::Math::Transformd;
+using Engine::Core::Math::Vector3d;
+using Engine::Core::Parallel::ThreadPool;
+
+namespace
+{
+
+/// Points on a bumpy height field with analytic normals
+void Surface(std::size_t side, std::vector<Vector3d>& points, std::vector<Vector3d>& normals)
+{
+  for (std::size_t i = 0; i < side; ++i) {
+    for (std::size_t j = 0; j < side; ++j) {
+      f64 x = 4.0 * i / side - 2.0;
+      f64 y = 4.0 * j / side - 2.0;
+      f64 z = 0.5 * std::sin(2.0 * x) * std::cos(1.5 * y) + 0.1 * x * y;
+      f64 dx = std::cos(2.0 * x) * std::cos(1.5 * y) + 0.1 * y;
+      f64 dy = -0.75 * std::sin(2.0 * x) * std::sin(1.5 * y) + 0.1 * x;
+      points.emplace_back(x, y, z);
+      normals.push_back(Vector3d(-dx, -dy, 1.0).Normalized());
+    }
+  }
+}
+
+Transformd SmallMotion()
+{
+  Vector3d axis = Vector3d(1.0, 2.0, 3.0).Normalized();
+  return Transformd(Vector3d(0.08, -0.05, 0.03), Quaterniond::FromAxisAngle(axis, 0.08));
+}
+
+std::vector<Vector3d> Moved(const std::vector<Vector3d>& points, const Transformd& transform)
+{
+  std::vector<Vector3d> moved;
+  for (const Vector3d& p : points)
+    moved.push_back(transform.TransformPoint(p));
+  return moved;
+}
+
+void ExpectInverse(const Transformd& found, const Transformd& motion, f64 tolerance)
+{
+  Transformd identity = found * motion;
+  EXPECT_LT(identity.position.Length(), tolerance);
+  EXPECT_LT(identity.rotation.Vector().Length(), tolerance);
+}
+
+} // namespace
+
+TEST(IcpTest, PointToPoint)
+{
+  std::vector<Vector3d> target;
+  std::vector<Vector3d> normals;
+  Surface(60, target, normals);
+  Transformd motion = SmallMotion();
+  std::vector<Vector3d> source = Moved(target, motion);
+
+  Icpd icp;
+  icp.SetTarget(target.data(), target.size());
+  IcpOptions<f64> options;
+  options.maxIterations = 100;
+  IcpResult<f64> result = icp.Align(source.data(), source.size(), Transformd(), options);
+
+  EXPECT_TRUE(result.converged);
+  EXPECT_EQ(result.correspondences, source.size());
+  ExpectInverse(result.transform, motion, 1e-3);
+}
+
+TEST(IcpTest, PointToPlane)
+{
+  std::vector<Vector3d> target;
+  std::vector<Vector3d> normals;
+  Surface(60, target, normals);
+  Transformd motion = SmallMotion();
+  std::vector<Vector3d> source = Moved(target, motion);
+
+  Icpd icp;
+  icp.SetTarget(target.data(), target.size(), normals.data());
+  IcpOptions<f64> options;
+  options.metric = IcpMetric::PointToPlane;
+  IcpResult<f64> result = icp.Align(source.data(), source.size(), Transformd(), options);
+
+  EXPECT_TRUE(result.converged);
+  EXPECT_LT(result.iterations, 20u);
+  EXPECT_LT(result.rmsError, 1e-6);
+  ExpectInverse(result.transform, motion, 1e-5);
+}
+
+TEST(IcpTest, ParallelMatchesSerial)
+{
+  std::vector<Vector3d> target;
+  std::vector<Vector3d> normals;
+  Surface(80, target, normals);
+  std::vector<Vector3d> source = Moved(target, SmallMotion());
+
+  ThreadPool pool(3);
+  Icpd icp;
+  icp.SetTarget(target.data(), target.size(), normals.data(), pool);
+  IcpOptions<f64> options;
+  options.metric = IcpMetric::PointToPlane;
+  IcpResult<f64> serial = icp.Align(source.data(), source.size(), Transformd(), options);
+  IcpResult<f64> parallel =
+      icp.Align(source.data(), source.size(), Transformd(), options, pool, IcpSettings::grain);
+
+  EXPECT_EQ(parallel.iterations, serial.iterations);
+  EXPECT_EQ(parallel.transform.position, serial.transform.position);
+  EXPECT_EQ(parallel.rmsError, serial.rmsError);
+}
+
+TEST(IcpTest, MaxDistanceRejectsOutliers)
+{
+  std::vector<Vector3d> target;
+  std::vector<Vector3d> normals;
+  Surface(40, target, normals);
+  Transformd motion(Vector3d(0.02, 0.01, 0.0));
+  std::vector<Vector3d> source = Moved(target, motion);
+  for (u32 i = 0; i < 50; ++i)
+    source.emplace_back(10.0 + i, 0.0, 5.0);
+
+  Icpd icp;
+  icp.SetTarget(target.data(), target.size());
+  IcpOptions<f64> options;
+  options.maxDistance = 0.5;
+  options.maxIterations = 100;
+  IcpResult<f64> result = icp.Align(source.data(), source.size(), Transformd(), options);
+
+  EXPECT_EQ(result.correspondences, target.size());
+  ExpectInverse(result.transform, motion, 1e-3);
+}
+
+TEST(IcpTest, TooFewPairs)
+{
+  std::vector<Vector3d> target = {{0.0, 0.0, 0.0}, {1.0, 0.0, 0.0}};
+  Icpd icp;
+  icp.SetTarget(target.data(), target.size());
+  IcpResult<f64> result = icp.Align(target.data(), 2);
+  EXPECT_FALSE(result.converged);
+  EXPECT_EQ(result.transform, Transformd());
+}
+
+TEST(IcpTest, EstimateNormals)
+{
+  std::vector<Vector3d> points;
+  std::vector<Vector3d> normals;
+  Surface(50, points, normals);
+
+  std::vector<Vector3d> estimated(points.size());
+  EstimateNormals(points.data(), points.size(), estimated.data());
+  std::vector<Vector3d> parallel(points.size());
+  ThreadPool pool(3);
+  EstimateNormals(points.data(), points.size(), parallel.data(), pool);
+
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    EXPECT_GT(std::abs(estimated[i].Dot(normals[i])), 0.95);
+    EXPECT_EQ(parallel[i], estimated[i]);
+  }
+}
@@ -0,0 +1,195 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file KdTree.test.cpp
+ * @brief Tests for KdTree class
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/spatial/KdTree.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Math;
+using namespace Engine::Core::Parallel;
+using namespace Engine::Core::Spatial;
+
+namespace
+{
+
+std::vector<Vector3f> RandomPoints(std::size_t count, u32 seed)
+{
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<f32> coordinate(-10.0f, 10.0f);
+  std::vector<Vector3f> points(count);
+  for (Vector3f& p : points)
+    p = Vector3f(coordinate(generator), coordinate(generator) * 0.1f, coordinate(generator));
+  return points;
+}
+
+std::vector<f32> BruteForceDistances(const std::vector<Vector3f>& points, const Vector3f& query)
+{
+  std::vector<f32> distances;
+  for (const Vector3f& p : points)
+    distances.push_back((p - query).LengthSquared());
+  std::sort(distances.begin(), distances.end());
+  return distances;
+}
+
+} // namespace
+
+/* ------------------------------------------ Queries ------------------------------------------ */
+
+TEST(KdTreeTest, Empty)
+{
+  KdTreef tree;
+  KdNeighbor<f32> result;
+  std::vector<KdNeighbor<f32>> found;
+
+  EXPECT_TRUE(tree.Empty());
+  EXPECT_FALSE(tree.Nearest(Vector3f(), result));
+  EXPECT_EQ(tree.Radius(Vector3f(), 1.0f, found), 0u);
+}
+
+TEST(KdTreeTest, Nearest)
+{
+  std::vector<Vector3f> points = {
+    Vector3f(0.0f, 0.0f, 0.0f), Vector3f(5.0f, 0.0f, 0.0f), Vector3f(0.0f, 3.0f, 0.0f)
+  };
+  KdTreef tree;
+  tree.Build(points.data(), points.size());
+  KdNeighbor<f32> result;
+
+  EXPECT_TRUE(tree.Nearest(Vector3f(4.0f, 0.0f, 0.0f), result));
+  EXPECT_EQ(result.index, 1u);
+  EXPECT_FLOAT_EQ(result.distanceSquared, 1.0f);
+}
+
+TEST(KdTreeTest, KNearestMatchesBruteForce)
+{
+  std::vector<Vector3f> points = RandomPoints(2000, 1);
+  std::vector<Vector3f> queries = RandomPoints(50, 2);
+  KdTreef tree;
+  tree.Build(points.data(), points.size());
+
+  KdNeighbor<f32> result[7];
+  for (const Vector3f& query : queries) {
+    std::vector<f32> expected = BruteForceDistances(points, query);
+
+    ASSERT_EQ(tree.KNearest(query, 7, result), 7u);
+    for (std::size_t i = 0; i < 7; ++i) {
+      EXPECT_FLOAT_EQ(result[i].distanceSquared, expected[i]);
+      EXPECT_FLOAT_EQ((points[result[i].index] - query).LengthSquared(), expected[i]);
+    }
+  }
+}
+
+TEST(KdTreeTest, KNearestMoreThanSize)
+{
+  std::vector<Vector3f> points = RandomPoints(5, 3);
+  KdTreef tree;
+  tree.Build(points.data(), points.size());
+  KdNeighbor<f32> result[8];
+
+  EXPECT_EQ(tree.KNearest(Vector3f(), 8, result), 5u);
+  for (std::size_t i = 1; i < 5; ++i)
+    EXPECT_LE(result[i - 1].distanceSquared, result[i].distanceSquared);
+}
+
+TEST(KdTreeTest, RadiusMatchesBruteForce)
+{
+  std::vector<Vector3f> points = RandomPoints(2000, 4);
+  std::vector<Vector3f> queries = RandomPoints(50, 5);
+  KdTreef tree;
+  tree.Build(points.data(), points.size());
+
+  std::vector<KdNeighbor<f32>> found;
+  for (const Vector3f& query : queries) {
+    std::vector<u32> expected;
+    for (u32 i = 0; i < points.size(); ++i) {
+      if ((points[i] - query).LengthSquared() <= 4.0f)
+        expected.push_back(i);
+    }
+
+    tree.Radius(query, 2.0f, found);
+    std::vector<u32> actual;
+    for (const KdNeighbor<f32>& neighbor : found)
+      actual.push_back(neighbor.index);
+    std::sort(actual.begin(), actual.end());
+    EXPECT_EQ(actual, expected);
+  }
+}
+
+TEST(KdTreeTest, Points2D)
+{
+  std::vector<Vector2d> points;
+  for (int i = 0; i < 100; ++i)
+    points.push_back(Vector2d(i % 10, i / 10));
+  KdTree2d tree;
+  tree.Build(points.data(), points.size());
+  KdNeighbor<f64> result[5];
+
+  ASSERT_EQ(tree.KNearest(Vector2d(4.0, 4.0), 5, result), 5u);
+  EXPECT_EQ(result[0].index, 44u);
+  EXPECT_DOUBLE_EQ(result[4].distanceSquared, 1.0);
+}
+
+/* ------------------------------------------- Batches ----------------------------------------- */
+
+TEST(KdTreeTest, ParallelBuildAndBatch)
+{
+  std::vector<Vector3f> points = RandomPoints(5000, 6);
+  std::vector<Vector3f> queries = RandomPoints(300, 7);
+  ThreadPool pool(3);
+  KdTreef serial;
+  KdTreef parallel;
+  serial.Build(points.data(), points.size());
+  parallel.Build(points.data(), points.size(), pool);
+
+  const std::size_t k = 4;
+  std::vector<KdNeighbor<f32>> expected(queries.size() * k);
+  std::vector<KdNeighbor<f32>> actual(queries.size() * k);
+  serial.KNearestBatch(queries.data(), queries.size(), k, expected.data());
+  parallel.KNearestBatch(queries.data(), queries.size(), k, actual.data(), pool, 16);
+
+  for (std::size_t i = 0; i < expected.size(); ++i)
+    EXPECT_FLOAT_EQ(actual[i].distanceSquared, expected[i].distanceSquared);
+}
+
+TEST(KdTreeTest, BatchMissingEntries)
+{
+  std::vector<Vector3f> points = RandomPoints(2, 8);
+  std::vector<Vector3f> queries = RandomPoints(2, 9);
+  KdTreef tree;
+  tree.Build(points.data(), points.size());
+  KdNeighbor<f32> result[6];
+
+  tree.KNearestBatch(queries.data(), queries.size(), 3, result);
+
+  EXPECT_NE(result[1].index, KdTreef::invalidIndex);
+  EXPECT_EQ(result[2].index, KdTreef::invalidIndex);
+  EXPECT_EQ(result[5].index, KdTreef::invalidIndex);
+}
+
+TEST(KdTreeTest, RadiusBatch)
+{
+  std::vector<Vector3f> points = RandomPoints(1000, 10);
+  std::vector<Vector3f> queries = RandomPoints(20, 11);
+  KdTreef tree;
+  tree.Build(points.data(), points.size());
+  std::vector<KdNeighbor<f32>> found;
+  std::vector<KdNeighbor<f32>> all;
+  std::vector<u32> offsets;
+
+  tree.RadiusBatch(queries.data(), queries.size(), 3.0f, all, offsets);
+
+  ASSERT_EQ(offsets.size(), queries.size() + 1);
+  EXPECT_EQ(offsets.back(), all.size());
+  for (std::size_t i = 0; i < queries.size(); ++i)
+    EXPECT_EQ(offsets[i + 1] - offsets[i], tree.Radius(queries[i], 3.0f, found));
+}
@@ -0,0 +1,149 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file LooseOctree.test.cpp
+ * @brief Tests for LooseOctree class
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/spatial/LooseOctree.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Math;
+using namespace Engine::Core::Spatial;
+
+namespace
+{
+
+AABBf Box(f32 x, f32 y, f32 z, f32 halfSize)
+{
+  return AABBf::FromCenterExtents(Vector3f(x, y, z), Vector3f(halfSize, halfSize, halfSize));
+}
+
+std::vector<u32> Sorted(std::vector<u32> handles)
+{
+  std::sort(handles.begin(), handles.end());
+  return handles;
+}
+
+} // namespace
+
+/* ------------------------------------------ Updates ------------------------------------------ */
+
+TEST(LooseOctreeTest, AddRemove)
+{
+  LooseOctreef tree(Box(0.0f, 0.0f, 0.0f, 100.0f), 6);
+
+  u32 a = tree.Add(Box(10.0f, 10.0f, 10.0f, 1.0f));
+  u32 b = tree.Add(Box(-50.0f, 20.0f, 0.0f, 1.0f));
+  EXPECT_EQ(tree.Size(), 2u);
+  EXPECT_GT(tree.NodeCount(), 1u);
+
+  tree.Remove(a);
+  tree.Remove(b);
+  EXPECT_EQ(tree.Size(), 0u);
+  EXPECT_EQ(tree.NodeCount(), 1u);
+}
+
+TEST(LooseOctreeTest, MoveWithinLooseBoundsKeepsNodes)
+{
+  LooseOctreef tree(Box(0.0f, 0.0f, 0.0f, 64.0f), 4);
+  u32 handle = tree.Add(Box(10.0f, 10.0f, 10.0f, 0.5f));
+  u32 nodes = tree.NodeCount();
+  std::vector<u32> found;
+
+  tree.SetBounds(handle, Box(10.5f, 10.0f, 10.0f, 0.5f));
+  EXPECT_EQ(tree.NodeCount(), nodes);
+
+  tree.SetBounds(handle, Box(-40.0f, -40.0f, 30.0f, 0.5f));
+  EXPECT_EQ(tree.NodeCount(), nodes);
+  tree.QuerySphere(Vector3f(-40.0f, -40.0f, 30.0f), 1.0f, found);
+  EXPECT_EQ(found, std::vector<u32>{handle});
+  tree.QuerySphere(Vector3f(10.0f, 10.0f, 10.0f), 1.0f, found);
+  EXPECT_TRUE(found.empty());
+}
+
+TEST(LooseOctreeTest, ObjectsOutsideWorld)
+{
+  LooseOctreef tree(Box(0.0f, 0.0f, 0.0f, 10.0f), 4);
+  u32 handle = tree.Add(Box(500.0f, 0.0f, 0.0f, 1.0f));
+  std::vector<u32> found;
+
+  tree.QuerySphere(Vector3f(500.0f, 0.0f, 0.0f), 2.0f, found);
+  EXPECT_EQ(found, std::vector<u32>{handle});
+}
+
+/* ------------------------------------------ Queries ------------------------------------------ */
+
+TEST(LooseOctreeTest, QueriesMatchBruteForce)
+{
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<f32> coordinate(-90.0f, 90.0f);
+  std::uniform_real_distribution<f32> size(0.1f, 8.0f);
+  LooseOctreef tree(Box(0.0f, 0.0f, 0.0f, 100.0f), 6);
+  std::vector<AABBf> boxes;
+  for (int i = 0; i < 500; ++i) {
+    boxes.push_back(Box(coordinate(generator), coordinate(generator), coordinate(generator),
+                        size(generator)));
+    tree.Add(boxes.back());
+  }
+  // move half of the objects
+  for (u32 i = 0; i < boxes.size(); i += 2) {
+    boxes[i] = Box(coordinate(generator), coordinate(generator), coordinate(generator), 1.0f);
+    tree.SetBounds(i, boxes[i]);
+  }
+
+  std::vector<u32> found;
+  std::vector<u32> expected;
+
+  Vector3f center(10.0f, -20.0f, 5.0f);
+  tree.QuerySphere(center, 30.0f, found);
+  for (u32 i = 0; i < boxes.size(); ++i) {
+    if (boxes[i].DistanceSquaredTo(center) <= 900.0f)
+      expected.push_back(i);
+  }
+  EXPECT_EQ(Sorted(found), expected);
+
+  Frustumf frustum = Frustumf::FromPerspective(
+      Vector3f(0.0f, 0.0f, -120.0f), Vector3f(0.0f, 0.0f, 1.0f), Vector3f(0.0f, 1.0f, 0.0f), 0.6f,
+      1.5f, 1.0f, 150.0f
+  );
+  tree.QueryFrustum(frustum, found);
+  expected.clear();
+  for (u32 i = 0; i < boxes.size(); ++i) {
+    if (frustum.IntersectsAABB(boxes[i].min, boxes[i].max))
+      expected.push_back(i);
+  }
+  EXPECT_FALSE(expected.empty());
+  EXPECT_EQ(Sorted(found), expected);
+
+  AABBf region = Box(-30.0f, 30.0f, 0.0f, 25.0f);
+  tree.QueryAABB(region, found);
+  expected.clear();
+  for (u32 i = 0; i < boxes.size(); ++i) {
+    if (region.Overlaps(boxes[i]))
+      expected.push_back(i);
+  }
+  EXPECT_EQ(Sorted(found), expected);
+}
+
+TEST(LooseOctreeTest, QueryRay)
+{
+  LooseOctreef tree(Box(0.0f, 0.0f, 0.0f, 100.0f), 6);
+  u32 near = tree.Add(Box(10.0f, 0.0f, 0.0f, 1.0f));
+  u32 far = tree.Add(Box(60.0f, 0.0f, 0.0f, 1.0f));
+  tree.Add(Box(10.0f, 5.0f, 0.0f, 1.0f));
+  std::vector<u32> found;
+
+  tree.QueryRay(Vector3f(), Vector3f(1.0f, 0.0f, 0.0f), 100.0f, found);
+  EXPECT_EQ(Sorted(found), (std::vector<u32>{near, far}));
+
+  tree.QueryRay(Vector3f(), Vector3f(1.0f, 0.0f, 0.0f), 20.0f, found);
+  EXPECT_EQ(found, std::vector<u32>{near});
+}
@@ -0,0 +1,181 @@
+/**
+ * SPDX-License-Identifier: MIT
+ *
+ * @file PointCloudFilter.test.cpp
+ * @brief Tests for point cloud downsampling, sampling and outlier removal
+ *
+ * @author Alexey Demin (AlexeyDeminA@gmail.com)
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <core/spatial/PointCloudFilter.h>
+#include <random>
+#include <vector>
+
+using namespace Engine::Core;
+using namespace Engine::Core::Spatial;
+using Engine::Core::Math::Vector3f;
+using Engine::Core::Parallel::ThreadPool;
+
+namespace
+{
+
+std::vector<Vector3f> RandomPoints(std::size_t count, u32 seed, f32 extent = 10.0f)
+{
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<f32> distribution(0.0f, extent);
+  std::vector<Vector3f> points(count);
+  for (Vector3f& p : points)
+    p = Vector3f(distribution(generator), distribution(generator), distribution(generator));
+  return points;
+}
+
+} // namespace
+
+/* ---- Voxel downsampling ---- */
+TEST(PointCloudFilterTest, VoxelCentroids)
+{
+  std::vector<Vector3f> points = {
+      {0.1f, 0.1f, 0.1f}, {0.3f, 0.5f, 0.1f}, {1.5f, 0.2f, 0.2f}, {0.2f, 0.3f, 0.1f},
+  };
+  std::vector<Vector3f> out;
+  VoxelDownsample(points.data(), points.size(), 1.0f, out);
+
+  ASSERT_EQ(out.size(), 2u);
+  EXPECT_EQ(out[0], Vector3f(0.2f, 0.3f, 0.1f));
+  EXPECT_EQ(out[1], Vector3f(1.5f, 0.2f, 0.2f));
+}
+
+TEST(PointCloudFilterTest, VoxelOnePointPerCell)
+{
+  std::vector<Vector3f> points = RandomPoints(20000, 1);
+  std::vector<Vector3f> out;
+  VoxelDownsample(points.data(), points.size(), 2.5f, out);
+
+  // a 10^3 cube splits into at most 5^3 cells of 2.5 measured from the minimum corner
+  EXPECT_LE(out.size(), 125u);
+  EXPECT_GE(out.size(), 64u);
+
+  ThreadPool pool(3);
+  std::vector<Vector3f> parallel;
+  VoxelDownsample(points.data(), points.size(), 2.5f, parallel, pool, 1024);
+  ASSERT_EQ(parallel.size(), out.size());
+  for (std::size_t i = 0; i < out.size(); ++i)
+    EXPECT_EQ(parallel[i], out[i]);
+}
+
+TEST(PointCloudFilterTest, VoxelEmpty)
+{
+  std::vector<Vector3f> out(3);
+  VoxelDownsample(static_cast<const Vector3f*>(nullptr), 0, 1.0f, out);
+  EXPECT_TRUE(out.empty());
+}
+
+/* ---- Sampling ---- */
+TEST(PointCloudFilterTest, RandomSample)
+{
+  std::vector<u32> indices;
+  RandomSample(1000, 100, 42, indices);
+  ASSERT_EQ(indices.size(), 100u);
+  EXPECT_TRUE(std::is_sorted(indices.begin(), indices.end()));
+  EXPECT_EQ(std::adjacent_find(indices.begin(), indices.end()), indices.end());
+  EXPECT_LT(indices.back(), 1000u);
+
+  std::vector<u32> same;
+  ThreadPool pool(3);
+  RandomSample(1000, 100, 42, same, pool, 64);
+  EXPECT_EQ(same, indices);
+
+  std::vector<u32> other;
+  RandomSample(1000, 100, 43, other);
+  EXPECT_NE(other, indices);
+
+  RandomSample(10, 50, 1, indices);
+  EXPECT_EQ(indices.size(), 10u);
+
+  // the cost follows the sample size, not the index range
+  RandomSample(4000000000u, 5, 7, indices);
+  ASSERT_EQ(indices.size(), 5u);
+  EXPECT_TRUE(std::is_sorted(indices.begin(), indices.end()));
+  EXPECT_EQ(std::adjacent_find(indices.begin(), indices.end()), indices.end());
+}
+
+TEST(PointCloudFilterTest, RandomSampleUniform)
+{
+  // every index is picked with probability 1 / 4
+  std::vector<u32> hits(64, 0);
+  std::vector<u32> indices;
+  for (u64 seed = 0; seed < 4000; ++seed) {
+    RandomSample(64, 16, seed, indices);
+    for (u32 index : indices)
+      ++hits[index];
+  }
+  for (u32 count : hits) {
+    EXPECT_GT(count, 850u);
+    EXPECT_LT(count, 1150u);
+  }
+}
+
+TEST(PointCloudFilterTest, FarthestPointSample)
+{
+  std::vector<Vector3f> points = {
+      {0.0f, 0.0f, 0.0f}, {0.1f, 0.0f, 0.0f}, {10.0f, 0.0f, 0.0f}, {5.0f, 0.0f, 0.0f},
+      {9.9f, 0.0f, 0.0f},
+  };
+  std::vector<u32> indices;
+  FarthestPointSample(points.data(), points.size(), 3, indices);
+  EXPECT_EQ(indices, (std::vector<u32>{0, 2, 3}));
+
+  FarthestPointSample(points.data(), points.size(), 10, indices, 3);
+  ASSERT_EQ(indices.size(), points.size());
+  EXPECT_EQ(indices[0], 3u);
+}
+
+TEST(PointCloudFilterTest, FarthestPointSampleDuplicates)
+{
+  // two distinct positions can give only two samples
+  std::vector<Vector3f> points = {
+      {1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 2.0f, 0.0f}, {0.0f, 2.0f, 0.0f},
+      {1.0f, 0.0f, 0.0f},
+  };
+  std::vector<u32> indices;
+  FarthestPointSample(points.data(), points.size(), 4, indices);
+  EXPECT_EQ(indices, (std::vector<u32>{0, 2}));
+
+  ThreadPool pool(3);
+  FarthestPointSample(points.data(), points.size(), 4, indices, pool, 1, 2);
+  EXPECT_EQ(indices, (std::vector<u32>{1, 2}));
+}
+
+TEST(PointCloudFilterTest, FarthestPointSampleParallel)
+{
+  std::vector<Vector3f> points = RandomPoints(30000, 2);
+  std::vector<u32> serial;
+  FarthestPointSample(points.data(), points.size(), 64, serial);
+
+  ThreadPool pool(3);
+  std::vector<u32> parallel;
+  FarthestPointSample(points.data(), points.size(), 64, parallel, pool, 0, 1024);
+  EXPECT_EQ(parallel, serial);
+}
+
+/* ---- Outlier removal ---- */
+TEST(PointCloudFilterTest, StatisticalOutliers)
+{
+  std::vector<Vector3f> points = RandomPoints(5000, 3, 1.0f);
+  points.push_back(Vector3f(50.0f, 50.0f, 50.0f));
+  points.push_back(Vector3f(-40.0f, 0.0f, 0.0f));
+
+  std::vector<u32> inliers;
+  RemoveStatisticalOutliers(points.data(), points.size(), 8, 1.0f, inliers);
+  EXPECT_TRUE(std::is_sorted(inliers.begin(), inliers.end()));
+  EXPECT_GT(inliers.size(), 4500u);
+  EXPECT_LT(inliers.back(), 5000u);
+
+  ThreadPool pool(3);
+  std::vector<u32> parallel;
+  RemoveStatisticalOutliers(points.data(), points.size(), 8, 1.0f, parallel, pool);
+  EXPECT_EQ(parallel, inliers);
+}